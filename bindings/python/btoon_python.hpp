@@ -15,8 +15,10 @@
 #include "btoon/btoon.h"
 #include "btoon/schema.h"
 #include "btoon/validator.h"
+#include "btoon/batch_processor.h"
 #include <sstream>
 #include <optional>
+#include <mutex>
 
 namespace py = pybind11;
 namespace btoon_py {
@@ -65,26 +67,77 @@ public:
      */
     py::bytes encode(const py::object& obj) {
         btoon::Value value = pythonToValue(obj);
-        auto encoded = btoon::encode(value, options_);
-        return py::bytes(reinterpret_cast<const char*>(encoded.data()), 
+        std::vector<uint8_t> encoded;
+        {
+            // The encode (and any compression) is pure C++; let other
+            // Python threads run while it works.
+            py::gil_scoped_release release;
+            encoded = btoon::encode(value, options_);
+        }
+        return py::bytes(reinterpret_cast<const char*>(encoded.data()),
                         encoded.size());
     }
-    
+
     /**
      * @brief Encode with schema validation
      */
-    py::bytes encode_with_schema(const py::object& obj, 
+    py::bytes encode_with_schema(const py::object& obj,
                                  const btoon::Schema& schema) {
         btoon::Value value = pythonToValue(obj);
-        
-        if (!schema.validate(value)) {
-            throw std::runtime_error("Value does not match schema");
+        std::vector<uint8_t> encoded;
+        {
+            py::gil_scoped_release release;
+            if (!schema.validate(value)) {
+                throw std::runtime_error("Value does not match schema");
+            }
+            encoded = btoon::encode(value, options_);
         }
-        
-        auto encoded = btoon::encode(value, options_);
-        return py::bytes(reinterpret_cast<const char*>(encoded.data()), 
+        return py::bytes(reinterpret_cast<const char*>(encoded.data()),
                         encoded.size());
     }
+
+    /**
+     * @brief Encode a list of objects with one GIL round-trip
+     *
+     * Objects are converted to values under the GIL, then the GIL is
+     * released and the encodes run on ParallelBatchProcessor workers.
+     * Results are returned as a list of bytes in input order.
+     */
+    py::list encode_many(const py::sequence& objs) {
+        std::vector<btoon::Value> values;
+        values.reserve(py::len(objs));
+        for (auto item : objs) {
+            values.push_back(pythonToValue(py::reinterpret_borrow<py::object>(item)));
+        }
+
+        std::vector<std::vector<uint8_t>> encoded;
+        std::mutex error_mutex;
+        std::string first_error;
+        {
+            py::gil_scoped_release release;
+            btoon::batch::ParallelBatchProcessor<btoon::Value, std::vector<uint8_t>> processor(
+                [&](const btoon::Value& value) -> std::vector<uint8_t> {
+                    try {
+                        return btoon::encode(value, options_);
+                    } catch (const std::exception& e) {
+                        std::lock_guard<std::mutex> lock(error_mutex);
+                        if (first_error.empty()) first_error = e.what();
+                        return {};
+                    }
+                });
+            encoded = processor.process(values);
+        }
+        if (!first_error.empty()) {
+            throw std::runtime_error(first_error);
+        }
+
+        py::list result;
+        for (const auto& buffer : encoded) {
+            result.append(py::bytes(reinterpret_cast<const char*>(buffer.data()),
+                                    buffer.size()));
+        }
+        return result;
+    }
     
     /**
      * @brief Enable compression (fluent interface)
@@ -177,8 +230,23 @@ private:
     }
     
     btoon::Value encodeNumpyArray(const py::object& arr) {
-        // Simplified numpy array encoding
-        // In production, would optimize for different dtypes
+        // 1-D float arrays map onto the native vector types through the
+        // buffer protocol: one bulk copy, no per-element round trip.
+        if (py::isinstance<py::array_t<float>>(arr)) {
+            auto typed = py::array_t<float, py::array::c_style | py::array::forcecast>(arr);
+            if (typed.ndim() == 1) {
+                const float* begin = typed.data();
+                return btoon::VectorFloat{{begin, begin + typed.size()}};
+            }
+        } else if (py::isinstance<py::array_t<double>>(arr)) {
+            auto typed = py::array_t<double, py::array::c_style | py::array::forcecast>(arr);
+            if (typed.ndim() == 1) {
+                const double* begin = typed.data();
+                return btoon::VectorDouble{{begin, begin + typed.size()}};
+            }
+        }
+
+        // Other dtypes and shapes fall back to element-wise conversion.
         btoon::Array result;
         for (auto item : arr) {
             result.push_back(pythonToValue(py::reinterpret_borrow<py::object>(item)));
@@ -217,48 +285,114 @@ public:
     py::object decode(const py::bytes& data) {
         std::string str_data = data;
         std::vector<uint8_t> vec_data(str_data.begin(), str_data.end());
-        
-        btoon::Decoder decoder(options_);
-        btoon::Value value = decoder.decode(vec_data);
-        
+
+        btoon::Value value = decodeWithoutGil(vec_data);
         return valueToPython(value);
     }
-    
+
     /**
      * @brief Decode with schema validation
      */
-    py::object decode_with_schema(const py::bytes& data, 
+    py::object decode_with_schema(const py::bytes& data,
                                   const btoon::Schema& schema) {
         std::string str_data = data;
         std::vector<uint8_t> vec_data(str_data.begin(), str_data.end());
-        
-        btoon::Decoder decoder(options_);
-        btoon::Value value = decoder.decode(vec_data);
-        
-        if (!schema.validate(value)) {
-            throw std::runtime_error("Decoded value does not match schema");
+
+        btoon::Value value;
+        {
+            py::gil_scoped_release release;
+            btoon::Decoder decoder(options_);
+            value = decoder.decode(vec_data);
+            if (!schema.validate(value)) {
+                throw std::runtime_error("Decoded value does not match schema");
+            }
         }
-        
         return valueToPython(value);
     }
+
+    /**
+     * @brief Decode a list of buffers with one GIL round-trip
+     *
+     * Buffers are copied out under the GIL, then the GIL is released
+     * and the decodes run on ParallelBatchProcessor workers. Results
+     * are converted back to Python objects in input order.
+     */
+    py::list decode_many(const py::sequence& buffers) {
+        std::vector<std::vector<uint8_t>> inputs;
+        inputs.reserve(py::len(buffers));
+        for (auto item : buffers) {
+            std::string str_data = py::reinterpret_borrow<py::bytes>(item);
+            inputs.emplace_back(str_data.begin(), str_data.end());
+        }
+
+        std::vector<btoon::Value> values;
+        std::mutex error_mutex;
+        std::string first_error;
+        {
+            py::gil_scoped_release release;
+            btoon::batch::ParallelBatchProcessor<std::vector<uint8_t>, btoon::Value> processor(
+                [&](const std::vector<uint8_t>& buffer) -> btoon::Value {
+                    try {
+                        btoon::Decoder decoder(options_);
+                        return decoder.decode(buffer);
+                    } catch (const std::exception& e) {
+                        std::lock_guard<std::mutex> lock(error_mutex);
+                        if (first_error.empty()) first_error = e.what();
+                        return btoon::Nil{};
+                    }
+                });
+            values = processor.process(inputs);
+        }
+        if (!first_error.empty()) {
+            throw std::runtime_error(first_error);
+        }
+
+        py::list result;
+        for (auto& value : values) {
+            result.append(valueToPython(value));
+        }
+        return result;
+    }
     
+    /**
+     * @brief Decode tabular data as a dict of columns
+     *
+     * For an array of maps, numeric columns (Int/Uint/Float throughout)
+     * come back as NumPy arrays filled through a raw pointer — one
+     * allocation per column, no per-element PyObject. Mixed or
+     * non-numeric columns fall back to Python lists.
+     */
+    py::dict decode_columns(const py::bytes& data) {
+        std::string str_data = data;
+        std::vector<uint8_t> vec_data(str_data.begin(), str_data.end());
+
+        btoon::Value value = decodeWithoutGil(vec_data);
+        auto* rows = std::get_if<btoon::Array>(&value);
+        if (!rows) {
+            throw std::runtime_error("Columnar decoding expects an array of maps");
+        }
+        return rowsToColumns(*rows);
+    }
+
     /**
      * @brief Decode and return as pandas DataFrame (if tabular)
      */
     py::object decode_as_dataframe(const py::bytes& data) {
-        auto obj = decode(data);
-        
-        // Check if it's tabular data
-        if (py::isinstance<py::list>(obj)) {
-            py::list lst = obj.cast<py::list>();
-            if (!lst.empty() && py::isinstance<py::dict>(lst[0])) {
-                // Convert to pandas DataFrame
+        std::string str_data = data;
+        std::vector<uint8_t> vec_data(str_data.begin(), str_data.end());
+
+        btoon::Value value = decodeWithoutGil(vec_data);
+
+        // Array-of-maps input goes through the columnar path so the
+        // DataFrame is built from NumPy arrays, not lists of PyObjects.
+        if (auto* rows = std::get_if<btoon::Array>(&value)) {
+            if (!rows->empty() && std::holds_alternative<btoon::Map>(rows->front())) {
                 auto pd = py::module_::import("pandas");
-                return pd.attr("DataFrame")(lst);
+                return pd.attr("DataFrame")(rowsToColumns(*rows));
             }
         }
-        
-        return obj;
+
+        return valueToPython(value);
     }
     
     // Context manager support
@@ -268,11 +402,107 @@ public:
 private:
     btoon::DecodeOptions options_;
     bool use_decimal_;
-    
-    py::object valueToPython(const btoon::Value& value) {
+
+    btoon::Value decodeWithoutGil(const std::vector<uint8_t>& data) {
+        py::gil_scoped_release release;
+        btoon::Decoder decoder(options_);
+        return decoder.decode(data);
+    }
+
+    /**
+     * Hand a decoded numeric vector to NumPy without copying: the array
+     * wraps the vector's storage through the buffer protocol, and a
+     * capsule keeps the vector alive until the array is collected.
+     */
+    template <typename T>
+    static py::array takeAsNumpy(std::vector<T>&& vec) {
+        auto* owner = new std::vector<T>(std::move(vec));
+        py::capsule base(owner, [](void* p) {
+            delete static_cast<std::vector<T>*>(p);
+        });
+        return py::array_t<T>({static_cast<py::ssize_t>(owner->size())},
+                              {static_cast<py::ssize_t>(sizeof(T))},
+                              owner->data(), base);
+    }
+
+    py::dict rowsToColumns(btoon::Array& rows) {
+        // First pass: a column stays numeric only if every row has it
+        // and every value is Int/Uint/Float.
+        enum class ColKind { Int64, Float64, Object };
+        std::map<std::string, ColKind> kinds;
+        for (auto& row : rows) {
+            auto* map = std::get_if<btoon::Map>(&row);
+            if (!map) {
+                throw std::runtime_error("Columnar decoding expects an array of maps");
+            }
+            for (auto& [key, val] : *map) {
+                auto [it, inserted] = kinds.emplace(key, ColKind::Int64);
+                if (it->second == ColKind::Object) continue;
+                if (std::holds_alternative<btoon::Float>(val)) {
+                    it->second = ColKind::Float64;
+                } else if (!std::holds_alternative<btoon::Int>(val) &&
+                           !std::holds_alternative<btoon::Uint>(val)) {
+                    it->second = ColKind::Object;
+                }
+                (void)inserted;
+            }
+        }
+        for (auto& [key, kind] : kinds) {
+            if (kind == ColKind::Object) continue;
+            for (auto& row : rows) {
+                if (std::get<btoon::Map>(row).find(key) == std::get<btoon::Map>(row).end()) {
+                    kind = ColKind::Object;
+                    break;
+                }
+            }
+        }
+
+        // Second pass: fill numeric columns through raw pointers.
+        py::dict columns;
+        for (auto& [key, kind] : kinds) {
+            if (kind == ColKind::Float64) {
+                py::array_t<double> column(rows.size());
+                double* out = column.mutable_data();
+                for (size_t i = 0; i < rows.size(); ++i) {
+                    out[i] = numericAsDouble(std::get<btoon::Map>(rows[i]).at(key));
+                }
+                columns[py::str(key)] = column;
+            } else if (kind == ColKind::Int64) {
+                py::array_t<int64_t> column(rows.size());
+                int64_t* out = column.mutable_data();
+                for (size_t i = 0; i < rows.size(); ++i) {
+                    out[i] = numericAsInt64(std::get<btoon::Map>(rows[i]).at(key));
+                }
+                columns[py::str(key)] = column;
+            } else {
+                py::list column;
+                for (auto& row : rows) {
+                    auto& map = std::get<btoon::Map>(row);
+                    auto it = map.find(key);
+                    column.append(it != map.end() ? valueToPython(it->second)
+                                                  : py::object(py::none()));
+                }
+                columns[py::str(key)] = column;
+            }
+        }
+        return columns;
+    }
+
+    static double numericAsDouble(const btoon::Value& value) {
+        if (auto* f = std::get_if<btoon::Float>(&value)) return *f;
+        if (auto* i = std::get_if<btoon::Int>(&value)) return static_cast<double>(*i);
+        return static_cast<double>(std::get<btoon::Uint>(value));
+    }
+
+    static int64_t numericAsInt64(const btoon::Value& value) {
+        if (auto* i = std::get_if<btoon::Int>(&value)) return *i;
+        return static_cast<int64_t>(std::get<btoon::Uint>(value));
+    }
+
+    py::object valueToPython(btoon::Value& value) {
         return std::visit([this](auto&& arg) -> py::object {
             using T = std::decay_t<decltype(arg)>;
-            
+
             if constexpr (std::is_same_v<T, btoon::Nil>) {
                 return py::none();
             } else if constexpr (std::is_same_v<T, btoon::Bool>) {
@@ -293,16 +523,22 @@ private:
                 return py::bytes(reinterpret_cast<const char*>(arg.data()), arg.size());
             } else if constexpr (std::is_same_v<T, btoon::Array>) {
                 py::list result;
-                for (const auto& item : arg) {
+                for (auto& item : arg) {
                     result.append(valueToPython(item));
                 }
                 return result;
             } else if constexpr (std::is_same_v<T, btoon::Map>) {
                 py::dict result;
-                for (const auto& [key, val] : arg) {
+                for (auto& [key, val] : arg) {
                     result[py::str(key)] = valueToPython(val);
                 }
                 return result;
+            } else if constexpr (std::is_same_v<T, btoon::VectorFloat>) {
+                // Buffer-protocol handoff: NumPy wraps the decoded
+                // storage directly, no per-element conversion.
+                return takeAsNumpy(std::move(arg.data));
+            } else if constexpr (std::is_same_v<T, btoon::VectorDouble>) {
+                return takeAsNumpy(std::move(arg.data));
             } else if constexpr (std::is_same_v<T, btoon::Timestamp>) {
                 auto dt = py::module_::import("datetime");
                 return dt.attr("datetime").attr("fromtimestamp")(arg.seconds);
@@ -84,6 +84,9 @@ PYBIND11_MODULE(btoon, m) {
              py::arg("obj"),
              py::arg("schema"),
              "Encode with schema validation")
+        .def("encode_many", &PyEncoder::encode_many,
+             py::arg("objs"),
+             "Encode a list of objects in parallel with one GIL round-trip")
         .def("with_compression", &PyEncoder::with_compression,
              py::arg("algorithm") = "auto",
              py::arg("level") = -1,
@@ -111,6 +114,13 @@ PYBIND11_MODULE(btoon, m) {
              py::arg("data"),
              py::arg("schema"),
              "Decode with schema validation")
+        .def("decode_many", &PyDecoder::decode_many,
+             py::arg("buffers"),
+             "Decode a list of buffers in parallel with one GIL round-trip")
+        .def("decode_columns", &PyDecoder::decode_columns,
+             py::arg("data"),
+             "Decode an array of maps as a dict of columns; numeric "
+             "columns come back as NumPy arrays")
         .def("decode_as_dataframe", &PyDecoder::decode_as_dataframe,
              py::arg("data"),
              "Decode tabular data as pandas DataFrame")
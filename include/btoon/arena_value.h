@@ -0,0 +1,120 @@
+/**
+ * @file arena_value.h
+ * @brief Arena-backed Value tree decoded entirely out of a MemoryPool.
+ *
+ * The regular Decoder returns btoon::Value, whose Array/Map/String/Binary
+ * alternatives allocate through the default allocators, so every small map
+ * node and short string is an individual malloc/free. ArenaValue mirrors the
+ * Value variant but routes all container and string storage through a
+ * PoolAllocator, so an entire decoded message lives in one MemoryPool arena
+ * and is released wholesale with MemoryPool::reset() — no per-node frees.
+ *
+ * Intended for high-rate decode loops (e.g. message brokers) where a pool is
+ * reset between messages.
+ */
+
+#ifndef BTOON_ARENA_VALUE_H
+#define BTOON_ARENA_VALUE_H
+
+#include "btoon.h"
+#include "memory_pool.h"
+#include <map>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace btoon {
+
+struct ArenaValue;
+
+using ArenaString = std::basic_string<char, std::char_traits<char>, PoolAllocator<char>>;
+using ArenaBinary = std::vector<uint8_t, PoolAllocator<uint8_t>>;
+using ArenaArray = std::vector<ArenaValue, PoolAllocator<ArenaValue>>;
+using ArenaMap = std::map<ArenaString, ArenaValue, std::less<>,
+                          PoolAllocator<std::pair<const ArenaString, ArenaValue>>>;
+
+/**
+ * @brief Pool-allocated counterpart of btoon::Value.
+ *
+ * Scalar and extension alternatives are identical to Value; the container and
+ * string alternatives draw their storage from the MemoryPool the tree was
+ * decoded with. An ArenaValue must not outlive its pool, and must be
+ * discarded (not destroyed element-by-element) before the pool is reset.
+ */
+struct ArenaValue : std::variant<
+    Nil,
+    Bool,
+    Int,
+    Uint,
+    Float,
+    ArenaString,
+    ArenaBinary,
+    ArenaArray,
+    ArenaMap,
+    Extension,
+    Timestamp,
+    Date,
+    DateTime,
+    BigInt,
+    VectorFloat,
+    VectorDouble
+> {
+    using variant::variant;
+};
+
+/**
+ * @brief Decoder that materializes the result tree inside a MemoryPool arena.
+ *
+ * Usage pattern for a decode loop:
+ * @code
+ * MemoryPool pool;
+ * ArenaDecoder decoder(pool);
+ * for (auto& message : messages) {
+ *     ArenaValue v = decoder.decode(message);
+ *     handle(v);
+ *     pool.reset();  // frees the whole tree at once
+ * }
+ * @endcode
+ */
+class ArenaDecoder {
+public:
+    /**
+     * @brief Construct a decoder bound to a pool.
+     * @param pool Arena that will own all decoded container/string storage.
+     *             Must outlive every ArenaValue produced by this decoder.
+     */
+    explicit ArenaDecoder(MemoryPool& pool) : pool_(&pool) {}
+
+    /**
+     * @brief Decode a BTOON binary buffer into an arena-backed value tree.
+     * @param buffer The binary data buffer to decode.
+     * @return An ArenaValue whose containers live in the bound pool.
+     * @throws BtoonException if the buffer is invalid or decoding fails.
+     */
+    ArenaValue decode(std::span<const uint8_t> buffer) const;
+
+    /**
+     * @brief Deep-copy an arena tree into a heap-allocated btoon::Value.
+     *
+     * Escape hatch for values that must outlive the pool.
+     */
+    static Value toValue(const ArenaValue& value);
+
+private:
+    ArenaValue decode(std::span<const uint8_t> buffer, size_t& pos) const;
+    ArenaString decodeString(std::span<const uint8_t> buffer, size_t& pos) const;
+    ArenaBinary decodeBinary(std::span<const uint8_t> buffer, size_t& pos) const;
+    ArenaArray decodeArray(std::span<const uint8_t> buffer, size_t& pos) const;
+    ArenaMap decodeMap(std::span<const uint8_t> buffer, size_t& pos) const;
+    ArenaValue decodeExtension(std::span<const uint8_t> buffer, size_t& pos) const;
+
+    /// Deep-convert a heap Value (from the extension fallback path) into the arena.
+    ArenaValue fromValue(const Value& value) const;
+
+    MemoryPool* pool_; /**< Arena backing all decoded containers (not owned). */
+};
+
+} // namespace btoon
+
+#endif // BTOON_ARENA_VALUE_H
@@ -0,0 +1,357 @@
+//  ██████╗ ████████╗ ██████╗  ██████╗ ███╗   ██╗
+//  ██╔══██╗╚══██╔══╝██╔═══██╗██╔═══██╗████╗  ██║
+//  ██████╔╝   ██║   ██║   ██║██║   ██║██╔██╗ ██║
+//  ██╔══██╗   ██║   ██║   ██║██║   ██║██║╚██╗██║
+//  ██████╔╝   ██║   ╚██████╔╝╚██████╔╝██║ ╚████║
+//  ╚═════╝    ╚═╝    ╚═════╝  ╚═════╝ ╚═╝  ╚═══╝
+//
+//  BTOON Core
+//  Version 0.0.1
+//  https://btoon.net & https://github.com/BTOON-project/btoon-core
+//
+// SPDX-FileCopyrightText: 2025 Alvar Laigna <https://alvarlaigna.com>
+// SPDX-License-Identifier: MIT
+/**
+ * @file async_stream.h
+ * @brief Coroutine-friendly streaming interfaces for BTOON record streams.
+ *
+ * The blocking StreamEncoder/StreamDecoder pair wraps std::iostream, which
+ * forces a thread per stream in event-loop servers. The classes here are
+ * sans-I/O counterparts: AsyncStreamDecoder is fed raw bytes by whatever
+ * transport the event loop uses (io_uring completions, sockets, pipes) and
+ * offers an awaitable read() that suspends until a complete record has
+ * arrived; AsyncStreamEncoder hands encoded records to any sink whose
+ * write() returns an awaitable, suspending instead of blocking when the
+ * sink applies backpressure. Neither class owns a thread or a file
+ * descriptor, so thousands of streams multiplex onto a few threads.
+ *
+ * Both operate on the plain (unframed, uncompressed) record stream the
+ * default StreamEncoder options produce. Framed archives already have
+ * random-access readers (FramedStreamReader, IndexedRecordReader) built
+ * for memory-mapped files.
+ */
+#ifndef BTOON_ASYNC_STREAM_H
+#define BTOON_ASYNC_STREAM_H
+
+#include "btoon.h"
+#include "encoder.h"
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace btoon {
+
+/**
+ * @brief Minimal lazy coroutine task used by the async streaming classes.
+ *
+ * Starts suspended; start() runs it until it completes or suspends on an
+ * awaitable. Awaiting a CoTask from another coroutine chains them with
+ * symmetric transfer. result() returns the value once done() is true, or
+ * rethrows whatever the coroutine threw. Single-consumer and move-only.
+ */
+template <typename T>
+class [[nodiscard]] CoTask {
+public:
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(handle_type handle) const noexcept {
+            auto continuation = handle.promise().continuation_;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        std::optional<T> value_;
+        std::exception_ptr error_;
+        std::coroutine_handle<> continuation_;
+
+        CoTask get_return_object() {
+            return CoTask(handle_type::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_value(T value) { value_ = std::move(value); }
+        void unhandled_exception() { error_ = std::current_exception(); }
+    };
+
+    CoTask() = default;
+    explicit CoTask(handle_type handle) : handle_(handle) {}
+    CoTask(CoTask&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    CoTask& operator=(CoTask&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+    ~CoTask() { destroy(); }
+
+    /// Runs the coroutine until it completes or first suspends.
+    void start() { handle_.resume(); }
+
+    bool done() const { return handle_ && handle_.done(); }
+
+    /// The coroutine's result; rethrows its exception. Requires done().
+    T result() {
+        if (handle_.promise().error_) {
+            std::rethrow_exception(handle_.promise().error_);
+        }
+        return std::move(*handle_.promise().value_);
+    }
+
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            handle_type handle_;
+            bool await_ready() const noexcept {
+                return !handle_ || handle_.done();
+            }
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> caller) const noexcept {
+                handle_.promise().continuation_ = caller;
+                return handle_;
+            }
+            T await_resume() {
+                if (handle_.promise().error_) {
+                    std::rethrow_exception(handle_.promise().error_);
+                }
+                return std::move(*handle_.promise().value_);
+            }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    void destroy() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    handle_type handle_;
+};
+
+template <>
+class [[nodiscard]] CoTask<void> {
+public:
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(handle_type handle) const noexcept {
+            auto continuation = handle.promise().continuation_;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        std::exception_ptr error_;
+        std::coroutine_handle<> continuation_;
+
+        CoTask get_return_object() {
+            return CoTask(handle_type::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { error_ = std::current_exception(); }
+    };
+
+    CoTask() = default;
+    explicit CoTask(handle_type handle) : handle_(handle) {}
+    CoTask(CoTask&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    CoTask& operator=(CoTask&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+    ~CoTask() { destroy(); }
+
+    void start() { handle_.resume(); }
+
+    bool done() const { return handle_ && handle_.done(); }
+
+    void result() {
+        if (handle_.promise().error_) {
+            std::rethrow_exception(handle_.promise().error_);
+        }
+    }
+
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            handle_type handle_;
+            bool await_ready() const noexcept {
+                return !handle_ || handle_.done();
+            }
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> caller) const noexcept {
+                handle_.promise().continuation_ = caller;
+                return handle_;
+            }
+            void await_resume() {
+                if (handle_.promise().error_) {
+                    std::rethrow_exception(handle_.promise().error_);
+                }
+            }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    void destroy() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    handle_type handle_;
+};
+
+/**
+ * @brief Incremental decoder for a BTOON record stream, fed by the caller.
+ *
+ * The transport (an io_uring read completion, a socket callback) appends
+ * whatever bytes arrived with feed(); co_awaiting read() yields the next
+ * record, completing without suspension when one is already buffered and
+ * parking the awaiting coroutine otherwise. feed() resumes the parked
+ * coroutine inline once a complete record is available, so decoded values
+ * surface on the thread that drives the transport. finish() signals end
+ * of stream: pending and subsequent reads complete with std::nullopt, or
+ * throw if the stream ends mid-record.
+ *
+ * One read() may be in flight at a time, and feed()/finish()/read() must
+ * come from a single thread — the intended shape is one decoder per
+ * connection on its event-loop thread.
+ */
+class AsyncStreamDecoder {
+public:
+    // No options: the plain record stream carries raw uncompressed values,
+    // so none of the DecodeOptions knobs (decompression, framing) apply.
+    AsyncStreamDecoder() = default;
+
+    /**
+     * @brief Appends transport bytes; resumes a parked read() inline when
+     *        they complete a record.
+     * @throws BtoonException if called after finish().
+     */
+    void feed(std::span<const uint8_t> bytes);
+
+    /**
+     * @brief Signals end of stream and resumes a parked read().
+     */
+    void finish();
+
+    /// True when a complete record is buffered and read() will not suspend.
+    bool record_ready() const;
+
+    class ReadAwaitable {
+    public:
+        explicit ReadAwaitable(AsyncStreamDecoder& decoder) : decoder_(decoder) {}
+        bool await_ready() const noexcept {
+            return decoder_.record_ready() || decoder_.finished_;
+        }
+        void await_suspend(std::coroutine_handle<> handle) noexcept {
+            decoder_.reader_ = handle;
+        }
+        std::optional<Value> await_resume() { return decoder_.takeRecord(); }
+
+    private:
+        AsyncStreamDecoder& decoder_;
+    };
+
+    /**
+     * @brief Awaitable yielding the next record, or std::nullopt at end of
+     *        stream.
+     * @throws BtoonException (from co_await) on malformed input or a
+     *         stream that ends mid-record.
+     */
+    ReadAwaitable read() { return ReadAwaitable(*this); }
+
+private:
+    friend class ReadAwaitable;
+
+    std::optional<Value> takeRecord();
+    void wakeReader();
+
+    std::vector<uint8_t> buffer_;
+    bool finished_ = false;
+    std::coroutine_handle<> reader_;
+};
+
+/**
+ * @brief Sink the async encoder writes encoded records into.
+ *
+ * write() takes the encoded bytes of one record and returns an awaitable;
+ * a sink under backpressure suspends the encoding coroutine instead of
+ * blocking the thread. The bytes are only valid until the awaitable
+ * completes.
+ */
+template <typename S>
+concept AsyncByteSink = requires(S& sink, std::span<const uint8_t> bytes) {
+    { sink.write(bytes).await_resume() };
+} || requires(S& sink, std::span<const uint8_t> bytes) {
+    { sink.write(bytes).operator co_await() };
+};
+
+/**
+ * @brief Coroutine counterpart of StreamEncoder writing through an async sink.
+ *
+ * Encoding itself is synchronous (it is CPU work); only delivery to the
+ * sink can suspend. Records are written in the plain stream format, so
+ * StreamDecoder and AsyncStreamDecoder both read the output.
+ */
+template <AsyncByteSink Sink>
+class AsyncStreamEncoder {
+public:
+    explicit AsyncStreamEncoder(Sink& sink, const EncodeOptions& options = {})
+        : sink_(sink), options_(options) {
+        if (options_.stream_frame_size != 0 || options_.stream_seek_index) {
+            throw BtoonException(
+                "framed streams and seek indexes are not supported on the "
+                "async encoder; use StreamEncoder for archive output");
+        }
+    }
+
+    /**
+     * @brief Encodes one record and co_awaits the sink's write().
+     *
+     * Encoding happens at the call, before the task first runs, so the
+     * value does not need to outlive the returned task — only delivery
+     * of the encoded bytes can suspend.
+     */
+    CoTask<void> write(const Value& value) {
+        Encoder encoder;
+        encoder.setOptions(options_);
+        encoder.encode(value);
+        return deliver(encoder.takeBuffer());
+    }
+
+private:
+    // The bytes live in the coroutine frame until the sink takes them.
+    CoTask<void> deliver(std::vector<uint8_t> encoded) {
+        co_await sink_.write(std::span<const uint8_t>(encoded));
+    }
+
+    Sink& sink_;
+    EncodeOptions options_;
+};
+
+} // namespace btoon
+
+#endif // BTOON_ASYNC_STREAM_H
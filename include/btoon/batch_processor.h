@@ -11,13 +11,20 @@
 
 #include "btoon/btoon.h"
 #include "btoon/memory_pool.h"
+#include <algorithm>
 #include <functional>
 #include <vector>
 #include <thread>
 #include <future>
 #include <queue>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
 #include <memory>
+#include <mutex>
+#include <optional>
 
 namespace btoon {
 namespace batch {
@@ -30,6 +37,7 @@ struct BatchStatistics {
     size_t processed_items = 0;
     size_t failed_items = 0;
     size_t bytes_processed = 0;
+    size_t work_steals = 0;       // Batches executed by a non-owning worker
     double processing_time_ms = 0.0;
     double items_per_second = 0.0;
     double bytes_per_second = 0.0;
@@ -48,6 +56,58 @@ struct BatchOptions {
     bool preserve_order = false;        // Maintain input order in output
     size_t queue_size = 100;            // Maximum queued batches
     CompressionAlgorithm compression = CompressionAlgorithm::NONE;
+
+    // Pin ParallelBatchProcessor workers across the host's NUMA nodes and
+    // prefer same-node victims when stealing, so memory-bound jobs keep their
+    // batches on the node whose worker first touched them. Detected from
+    // /sys/devices/system/node on Linux; a no-op on single-node hosts and on
+    // platforms without topology information.
+    bool numa_aware = false;
+
+    // Per-stage concurrency caps for ProcessingPipeline::process_parallel:
+    // stage_concurrency[s] bounds how many batches may run stage s at once
+    // (0 = unlimited; stages beyond the vector's size are unlimited). Useful
+    // to stop a memory-hungry stage from running on every worker at once.
+    std::vector<size_t> stage_concurrency;
+};
+
+/**
+ * @brief NUMA topology of the host
+ *
+ * Read once from /sys/devices/system/node on Linux; other platforms (and
+ * hosts where sysfs is unavailable) report a single node covering every CPU,
+ * which makes all NUMA-aware code paths degrade to plain behavior.
+ */
+struct NumaTopology {
+    struct Node {
+        size_t id = 0;
+        std::vector<int> cpus;
+    };
+
+    std::vector<Node> nodes;
+
+    /**
+     * @brief Cached topology of the current host
+     */
+    static const NumaTopology& detect();
+
+    size_t num_nodes() const { return nodes.size(); }
+
+    /**
+     * @brief Node a worker should run on, spreading workers round-robin
+     */
+    size_t node_for_worker(size_t worker_id) const {
+        return worker_id % nodes.size();
+    }
+
+    /**
+     * @brief Pin the calling thread to the CPUs of one node (best effort)
+     *
+     * Does nothing on platforms without thread affinity support; a failed
+     * pin is ignored rather than surfaced, since placement is a performance
+     * hint and never affects correctness.
+     */
+    void pin_current_thread(size_t node_index) const;
 };
 
 /**
@@ -80,7 +140,7 @@ public:
     PipelineStage(const std::string& name, BatchTransformFunc func)
         : name_(name), batch_transform_(func), is_batch_(true) {}
     
-    std::vector<Output> process(const std::vector<Input>& input) {
+    std::vector<Output> process(const std::vector<Input>& input) const {
         if (is_batch_) {
             return batch_transform_(input);
         } else {
@@ -130,6 +190,127 @@ public:
         return input;
     }
     
+    /**
+     * @brief Process items through the pipeline with a worker pool
+     *
+     * The input is split into batches and every (batch, stage) pair becomes
+     * a task; a task is ready once the batch has finished the previous
+     * stage. Workers claim whichever ready task is furthest along the
+     * pipeline, so no thread is pinned to a stage and a slow stage cannot
+     * idle the rest of the pool — upstream batches keep advancing while it
+     * runs. BatchOptions::stage_concurrency can cap how many batches run a
+     * given stage at once; worker_threads sizes the pool (0 = auto).
+     *
+     * Per-item stages behave exactly as in process(). Batch-transform
+     * stages see one batch at a time rather than the whole input, so
+     * whole-input aggregations should keep using process().
+     */
+    std::vector<T> process_parallel(std::vector<T> input) {
+        size_t workers_n = options_.worker_threads;
+        if (workers_n == 0) {
+            workers_n = std::thread::hardware_concurrency();
+        }
+        size_t num_batches = (input.size() + options_.batch_size - 1) / options_.batch_size;
+        if (stages_.empty() || input.empty() || workers_n <= 1 || num_batches <= 1) {
+            return process(std::move(input));
+        }
+
+        std::vector<std::vector<T>> batches(num_batches);
+        for (size_t b = 0; b < num_batches; ++b) {
+            size_t begin = b * options_.batch_size;
+            size_t end = std::min(begin + options_.batch_size, input.size());
+            batches[b].assign(
+                std::make_move_iterator(input.begin() + static_cast<ptrdiff_t>(begin)),
+                std::make_move_iterator(input.begin() + static_cast<ptrdiff_t>(end)));
+        }
+
+        std::vector<size_t> next_stage(num_batches, 0);  // per batch
+        std::vector<bool> in_flight(num_batches, false);
+        std::vector<size_t> stage_running(stages_.size(), 0);
+        size_t finished_batches = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        auto stage_limit = [this](size_t stage) {
+            if (stage >= options_.stage_concurrency.size()) return size_t(0);
+            return options_.stage_concurrency[stage];
+        };
+
+        auto worker = [&] {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                if (error || finished_batches == num_batches) {
+                    return;
+                }
+                // Claim the ready task furthest along the pipeline: finishing
+                // downstream work first keeps memory bounded and lets fresh
+                // batches enter behind it.
+                size_t best = num_batches;
+                for (size_t b = 0; b < num_batches; ++b) {
+                    if (in_flight[b] || next_stage[b] >= stages_.size()) continue;
+                    size_t limit = stage_limit(next_stage[b]);
+                    if (limit != 0 && stage_running[next_stage[b]] >= limit) continue;
+                    if (best == num_batches || next_stage[b] > next_stage[best]) {
+                        best = b;
+                    }
+                }
+                if (best == num_batches) {
+                    cv.wait(lock);
+                    continue;
+                }
+
+                size_t b = best;
+                size_t s = next_stage[b];
+                in_flight[b] = true;
+                stage_running[s]++;
+                lock.unlock();
+
+                std::vector<T> out;
+                std::exception_ptr task_error;
+                try {
+                    out = stages_[s].process(batches[b]);
+                } catch (...) {
+                    task_error = std::current_exception();
+                }
+
+                lock.lock();
+                in_flight[b] = false;
+                stage_running[s]--;
+                if (task_error) {
+                    if (!error) error = task_error;
+                } else {
+                    batches[b] = std::move(out);
+                    if (++next_stage[b] == stages_.size()) {
+                        finished_batches++;
+                    }
+                }
+                cv.notify_all();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(workers_n);
+        for (size_t i = 0; i < workers_n; ++i) {
+            workers.emplace_back(worker);
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        std::vector<T> output;
+        output.reserve(input.size());
+        for (auto& batch : batches) {
+            for (auto& item : batch) {
+                output.push_back(std::move(item));
+            }
+        }
+        return output;
+    }
+
     /**
      * @brief Process with progress callback
      */
@@ -152,103 +333,176 @@ private:
 
 /**
  * @brief Parallel batch processor
+ *
+ * Scheduling uses per-worker batch ranges with work stealing instead of a
+ * shared mutex-protected queue: the input is split into batches, each worker
+ * owns a contiguous range of batch indices and claims them through an atomic
+ * cursor, and a worker whose range is exhausted claims batches from other
+ * workers' cursors. Claiming is a single fetch_add, so small items scale
+ * without lock contention; BatchStatistics::work_steals reports how many
+ * batches ran on a non-owning worker.
  */
 template<typename Input, typename Output>
 class ParallelBatchProcessor {
 public:
     using ProcessFunc = std::function<Output(const Input&)>;
     using ErrorHandler = std::function<void(const Input&, const std::exception&)>;
-    
+
     ParallelBatchProcessor(ProcessFunc func, const BatchOptions& options = BatchOptions{})
         : process_func_(func), options_(options) {
-        
+
         num_workers_ = options_.worker_threads;
         if (num_workers_ == 0) {
             num_workers_ = std::thread::hardware_concurrency();
         }
     }
-    
+
     /**
      * @brief Process items in parallel batches
+     *
+     * Results are returned in input order: each batch writes a dedicated
+     * output slot, so the merge is deterministic regardless of which worker
+     * processed which batch (items whose processing failed are skipped).
      */
     std::vector<Output> process(const std::vector<Input>& items) {
         if (items.empty()) return {};
-        
+
         auto start_time = std::chrono::steady_clock::now();
-        
-        // Initialize workers
-        std::vector<std::thread> workers;
-        std::queue<std::vector<Input>> work_queue;
-        std::mutex queue_mutex;
-        std::condition_variable queue_cv;
-        std::atomic<bool> done{false};
-        
-        // Results storage
-        std::vector<std::vector<Output>> results(num_workers_);
-        std::vector<size_t> result_indices(num_workers_);
-        
-        // Split input into batches
-        for (size_t i = 0; i < items.size(); i += options_.batch_size) {
-            size_t end = std::min(i + options_.batch_size, items.size());
-            work_queue.push(std::vector<Input>(items.begin() + i, items.begin() + end));
+
+        size_t num_batches = (items.size() + options_.batch_size - 1) / options_.batch_size;
+        size_t workers_used = std::min(num_workers_, num_batches);
+
+        // NUMA placement: workers are spread round-robin across nodes and
+        // steal from same-node victims before crossing the interconnect, so
+        // batches tend to be processed on the node whose worker first touched
+        // them. With one node (or numa_aware off) this collapses to the plain
+        // round-robin victim order.
+        const NumaTopology* topology = nullptr;
+        std::vector<size_t> worker_node(workers_used, 0);
+        if (options_.numa_aware) {
+            topology = &NumaTopology::detect();
+            for (size_t w = 0; w < workers_used; ++w) {
+                worker_node[w] = topology->node_for_worker(w);
+            }
         }
-        
-        // Worker function
-        auto worker = [&](size_t worker_id) {
-            while (true) {
-                std::vector<Input> batch;
-                {
-                    std::unique_lock<std::mutex> lock(queue_mutex);
-                    queue_cv.wait(lock, [&] { return !work_queue.empty() || done; });
-                    
-                    if (done && work_queue.empty()) break;
-                    
-                    batch = std::move(work_queue.front());
-                    work_queue.pop();
+        std::vector<std::vector<size_t>> victim_order(workers_used);
+        for (size_t w = 0; w < workers_used; ++w) {
+            auto& order = victim_order[w];
+            order.reserve(workers_used - 1);
+            for (size_t v = 1; v < workers_used; ++v) {
+                size_t victim = (w + v) % workers_used;
+                if (worker_node[victim] == worker_node[w]) {
+                    order.push_back(victim);
                 }
-                
-                // Process batch
-                for (const auto& item : batch) {
+            }
+            for (size_t v = 1; v < workers_used; ++v) {
+                size_t victim = (w + v) % workers_used;
+                if (worker_node[victim] != worker_node[w]) {
+                    order.push_back(victim);
+                }
+            }
+        }
+
+        // Each worker owns the batch range [range_begin[w], range_end[w])
+        // and claims indices through its cursor; thieves claim from the same
+        // cursor, so a fetch_add uniquely assigns every batch exactly once.
+        struct alignas(64) BatchRange {
+            std::atomic<size_t> cursor{0};
+            size_t end = 0;
+        };
+        std::vector<BatchRange> ranges(workers_used);
+        size_t per_worker = num_batches / workers_used;
+        size_t remainder = num_batches % workers_used;
+        size_t next_begin = 0;
+        for (size_t w = 0; w < workers_used; ++w) {
+            size_t count = per_worker + (w < remainder ? 1 : 0);
+            ranges[w].cursor.store(next_begin, std::memory_order_relaxed);
+            ranges[w].end = next_begin + count;
+            next_begin += count;
+        }
+
+        // Results storage: one slot per batch, written only by the claiming
+        // worker, merged in batch order after the join.
+        std::vector<std::vector<Output>> batch_results(num_batches);
+        std::vector<size_t> worker_processed(workers_used, 0);
+        std::vector<size_t> worker_failed(workers_used, 0);
+        std::vector<size_t> worker_steals(workers_used, 0);
+
+        auto worker = [&](size_t worker_id) {
+            if (topology) {
+                topology->pin_current_thread(worker_node[worker_id]);
+            }
+            auto run_batch = [&](size_t batch) {
+                size_t begin = batch * options_.batch_size;
+                size_t end = std::min(begin + options_.batch_size, items.size());
+                auto& out = batch_results[batch];
+                out.reserve(end - begin);
+                for (size_t i = begin; i < end; ++i) {
                     try {
-                        results[worker_id].push_back(process_func_(item));
-                        stats_.processed_items++;
+                        out.push_back(process_func_(items[i]));
+                        worker_processed[worker_id]++;
                     } catch (const std::exception& e) {
                         if (error_handler_) {
-                            error_handler_(item, e);
+                            error_handler_(items[i], e);
                         }
-                        stats_.failed_items++;
+                        worker_failed[worker_id]++;
+                    }
+                }
+            };
+
+            // Drain the owned range first.
+            for (;;) {
+                size_t batch = ranges[worker_id].cursor.fetch_add(1, std::memory_order_relaxed);
+                if (batch >= ranges[worker_id].end) break;
+                run_batch(batch);
+            }
+            // Then steal from whoever still has work, same-node victims first.
+            for (;;) {
+                bool found = false;
+                for (size_t victim : victim_order[worker_id]) {
+                    size_t batch = ranges[victim].cursor.fetch_add(1, std::memory_order_relaxed);
+                    if (batch < ranges[victim].end) {
+                        worker_steals[worker_id]++;
+                        run_batch(batch);
+                        found = true;
+                        break;
                     }
                 }
+                if (!found) break;
             }
         };
-        
-        // Start workers
-        for (size_t i = 0; i < num_workers_; ++i) {
+
+        std::vector<std::thread> workers;
+        workers.reserve(workers_used);
+        for (size_t i = 0; i < workers_used; ++i) {
             workers.emplace_back(worker, i);
         }
-        
-        // Wait for completion
-        done = true;
-        queue_cv.notify_all();
         for (auto& w : workers) {
             w.join();
         }
-        
-        // Merge results
+
+        // Merge results in batch (= input) order
         std::vector<Output> final_results;
-        for (const auto& worker_results : results) {
-            final_results.insert(final_results.end(), 
-                               worker_results.begin(), 
-                               worker_results.end());
+        final_results.reserve(items.size());
+        for (auto& batch : batch_results) {
+            for (auto& output : batch) {
+                final_results.push_back(std::move(output));
+            }
         }
-        
+
         // Update statistics
+        for (size_t w = 0; w < workers_used; ++w) {
+            stats_.processed_items += worker_processed[w];
+            stats_.failed_items += worker_failed[w];
+            stats_.work_steals += worker_steals[w];
+        }
         auto end_time = std::chrono::steady_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
             end_time - start_time);
-        stats_.processing_time_ms = duration.count();
-        stats_.items_per_second = stats_.processed_items * 1000.0 / stats_.processing_time_ms;
-        
+        stats_.processing_time_ms = static_cast<double>(duration.count());
+        stats_.items_per_second =
+            static_cast<double>(stats_.processed_items) * 1000.0 / stats_.processing_time_ms;
+
         return final_results;
     }
     
@@ -305,7 +559,10 @@ public:
         process_stream(input, [&](const Value& value, size_t index) {
             Value transformed = transform_func(value, index);
             // Write transformed value
-            auto encoded = encode(transformed, {options_.compression});
+            EncodeOptions encode_options;
+            encode_options.compress = options_.compression != CompressionAlgorithm::NONE;
+            encode_options.compression_algorithm = options_.compression;
+            auto encoded = encode(transformed, encode_options);
             output.write(reinterpret_cast<const char*>(encoded.data()), 
                         encoded.size());
         });
@@ -319,6 +576,16 @@ private:
     BatchStatistics stats_;
 };
 
+/**
+ * @brief Decode every record of one BTOON shard file
+ *
+ * Memory-maps the file; framed streams ("BTFM") yield their records frame
+ * by frame, any other file yields its root value — except an array root,
+ * which yields its elements. Used by MapReduceProcessor::process_files.
+ * @throws BtoonException if the file cannot be mapped or decoded
+ */
+std::vector<btoon::Value> load_shard_values(const std::string& filename);
+
 /**
  * @brief Map-Reduce processor for aggregation operations
  */
@@ -357,13 +624,75 @@ public:
         
         return results;
     }
-    
+
+    /**
+     * @brief Run map-reduce over a set of BTOON shard files
+     *
+     * Each file is one shard: the worker that claims it memory-maps the
+     * file, decodes its records (framed streams frame by frame, otherwise
+     * the root value — an array root contributes its elements), maps them
+     * and groups the pairs locally, so at most one shard's records are
+     * materialized per worker at a time rather than the whole dataset.
+     * Shard groups are then merged and reduced exactly as in process().
+     * Shards are scheduled through ParallelBatchProcessor with one file per
+     * batch, so work stealing and numa_aware placement apply unchanged.
+     */
+    std::unordered_map<Key, Result> process_files(
+        const std::vector<std::string>& filenames) {
+        using Grouped = std::unordered_map<Key, std::vector<Value>>;
+
+        BatchOptions shard_options = options_;
+        shard_options.batch_size = 1;  // one shard per claimable batch
+        ParallelBatchProcessor<std::string, Grouped> shard_processor(
+            [this](const std::string& filename) {
+                Grouped grouped;
+                for (auto& record : load_shard_values(filename)) {
+                    auto [key, value] = mapper_(record);
+                    grouped[std::move(key)].push_back(std::move(value));
+                }
+                return grouped;
+            },
+            shard_options);
+        auto shard_groups = shard_processor.process(filenames);
+
+        Grouped mapped;
+        for (auto& group : shard_groups) {
+            for (auto& [key, values] : group) {
+                auto& dst = mapped[key];
+                if (dst.empty()) {
+                    dst = std::move(values);
+                } else {
+                    dst.insert(dst.end(),
+                               std::make_move_iterator(values.begin()),
+                               std::make_move_iterator(values.end()));
+                }
+            }
+        }
+
+        std::unordered_map<Key, Result> results;
+        for (const auto& [key, values] : mapped) {
+            results[key] = reducer_(key, values);
+        }
+        return results;
+    }
+
 private:
     MapFunc mapper_;
     ReduceFunc reducer_;
     BatchOptions options_;
 };
 
+/**
+ * @brief Decomposable aggregates of one window
+ */
+template<typename T>
+struct WindowAggregate {
+    size_t count = 0;
+    T sum{};
+    T min{};
+    T max{};
+};
+
 /**
  * @brief Window-based processor for time series and streaming data
  */
@@ -394,7 +723,32 @@ public:
             process_session(items, func);
         }
     }
-    
+
+    /**
+     * @brief Compute sum/min/max per window without materializing windows
+     *
+     * Aggregates are maintained incrementally as the window advances: the
+     * running sum adds entering items and subtracts expiring ones, and
+     * min/max come from monotonic deques, so each slide costs O(slide)
+     * amortized work instead of O(window). The callback mirrors process():
+     * func(const WindowAggregate<T>&, window_id), with the same window ids
+     * the materializing path would produce. Requires T to support +=, -=
+     * and operator<; note that subtract-based running sums accumulate
+     * floating-point rounding over very long runs.
+     */
+    template<typename AggregateFunc>
+    void process_aggregates(const std::vector<T>& items, AggregateFunc func) {
+        if (items.empty() || window_size_ == 0) {
+            return;
+        }
+        if (type_ == SLIDING) {
+            process_sliding_aggregates(items, func);
+        } else {
+            // SESSION falls back to tumbling, matching process().
+            process_tumbling_aggregates(items, func);
+        }
+    }
+
 private:
     WindowType type_;
     size_t window_size_;
@@ -404,7 +758,8 @@ private:
     void process_tumbling(const std::vector<T>& items, ProcessFunc func) {
         for (size_t i = 0; i < items.size(); i += window_size_) {
             size_t end = std::min(i + window_size_, items.size());
-            std::vector<T> window(items.begin() + i, items.begin() + end);
+            std::vector<T> window(items.begin() + static_cast<ptrdiff_t>(i),
+                                  items.begin() + static_cast<ptrdiff_t>(end));
             func(window, i / window_size_);
         }
     }
@@ -413,7 +768,9 @@ private:
     void process_sliding(const std::vector<T>& items, ProcessFunc func) {
         size_t window_id = 0;
         for (size_t i = 0; i + window_size_ <= items.size(); i += slide_interval_) {
-            std::vector<T> window(items.begin() + i, items.begin() + i + window_size_);
+            std::vector<T> window(
+                items.begin() + static_cast<ptrdiff_t>(i),
+                items.begin() + static_cast<ptrdiff_t>(i + window_size_));
             func(window, window_id++);
         }
     }
@@ -424,6 +781,76 @@ private:
         // Simplified implementation - would need timestamp comparison
         process_tumbling(items, func);
     }
+
+    template<typename AggregateFunc>
+    void process_tumbling_aggregates(const std::vector<T>& items, AggregateFunc func) {
+        for (size_t i = 0; i < items.size(); i += window_size_) {
+            size_t end = std::min(i + window_size_, items.size());
+            WindowAggregate<T> agg;
+            agg.count = end - i;
+            agg.sum = items[i];
+            agg.min = items[i];
+            agg.max = items[i];
+            for (size_t j = i + 1; j < end; ++j) {
+                agg.sum += items[j];
+                if (items[j] < agg.min) agg.min = items[j];
+                if (agg.max < items[j]) agg.max = items[j];
+            }
+            func(agg, i / window_size_);
+        }
+    }
+
+    template<typename AggregateFunc>
+    void process_sliding_aggregates(const std::vector<T>& items, AggregateFunc func) {
+        // min_q/max_q hold indices with monotone values, so the front is
+        // always the current window's extremum; every index enters and
+        // leaves each deque at most once, giving O(1) amortized slides.
+        std::deque<size_t> min_q;
+        std::deque<size_t> max_q;
+        T sum{};
+        size_t low = 0;   // first index included in the running sum
+        size_t next = 0;  // next index to absorb into the running sum
+        size_t window_id = 0;
+
+        for (size_t begin = 0; begin + window_size_ <= items.size();
+             begin += slide_interval_) {
+            if (begin > next) {
+                // Disjoint windows (slide > window): nothing carries over.
+                sum = T{};
+                min_q.clear();
+                max_q.clear();
+                low = begin;
+                next = begin;
+            }
+            while (low < begin) {
+                sum -= items[low];
+                ++low;
+            }
+            while (!min_q.empty() && min_q.front() < begin) min_q.pop_front();
+            while (!max_q.empty() && max_q.front() < begin) max_q.pop_front();
+
+            size_t end = begin + window_size_;
+            while (next < end) {
+                sum += items[next];
+                while (!min_q.empty() && items[next] < items[min_q.back()]) {
+                    min_q.pop_back();
+                }
+                min_q.push_back(next);
+                while (!max_q.empty() && items[max_q.back()] < items[next]) {
+                    max_q.pop_back();
+                }
+                max_q.push_back(next);
+                ++next;
+            }
+
+            WindowAggregate<T> agg;
+            agg.count = window_size_;
+            agg.sum = sum;
+            agg.min = items[min_q.front()];
+            agg.max = items[max_q.front()];
+            func(agg, window_id++);
+        }
+    }
 };
 
 // ============= Utility Functions =============
@@ -437,11 +864,48 @@ std::vector<std::pair<size_t, size_t>> split_file_chunks(
 
 /**
  * @brief Merge sorted batches efficiently
+ *
+ * K-way merge through a binary heap of per-batch cursors: O(n log k) for n
+ * total items across k batches, visiting every item exactly once. Each
+ * input batch must already be sorted by @p comp.
  */
 template<typename T, typename Compare = std::less<T>>
 std::vector<T> merge_sorted_batches(
     const std::vector<std::vector<T>>& batches,
-    Compare comp = Compare{});
+    Compare comp = Compare{}) {
+    struct Cursor {
+        size_t batch;
+        size_t pos;
+    };
+    // Min-heap: the cursor with the smallest current value sorts last.
+    auto heap_order = [&](const Cursor& a, const Cursor& b) {
+        return comp(batches[b.batch][b.pos], batches[a.batch][a.pos]);
+    };
+
+    std::vector<Cursor> heap;
+    size_t total = 0;
+    for (size_t b = 0; b < batches.size(); ++b) {
+        total += batches[b].size();
+        if (!batches[b].empty()) {
+            heap.push_back({b, 0});
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), heap_order);
+
+    std::vector<T> merged;
+    merged.reserve(total);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), heap_order);
+        Cursor cursor = heap.back();
+        heap.pop_back();
+        merged.push_back(batches[cursor.batch][cursor.pos]);
+        if (++cursor.pos < batches[cursor.batch].size()) {
+            heap.push_back(cursor);
+            std::push_heap(heap.begin(), heap.end(), heap_order);
+        }
+    }
+    return merged;
+}
 
 /**
  * @brief Memory-mapped batch processing
@@ -22,6 +22,8 @@
 #define BTOON_H
 
 #include "btoon/compression.h"
+#include "btoon/stats.h"
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -171,6 +173,52 @@ struct BigInt {
     }
 };
 
+/**
+ * @brief Cache-friendly flat map of string keys to values.
+ *
+ * Stores all entries in one sorted vector instead of a tree node per key,
+ * so typical 10-40 key messages decode and iterate with contiguous memory
+ * access and a single allocation. Lookup is binary search; mutation keeps
+ * the vector sorted. Opt-in: Decoder::setFlatMaps(true) materializes map
+ * markers as FlatMap instead of Map, and the Encoder emits identical
+ * bytes for either representation. Note that a FlatMap and a Map with the
+ * same contents are distinct Value alternatives and compare unequal.
+ */
+struct FlatMap {
+    using value_type = std::pair<String, struct Value>;
+    using iterator = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    std::vector<value_type> entries; /**< Entries sorted by key. */
+
+    iterator begin() noexcept { return entries.begin(); }
+    iterator end() noexcept { return entries.end(); }
+    const_iterator begin() const noexcept { return entries.begin(); }
+    const_iterator end() const noexcept { return entries.end(); }
+    size_t size() const noexcept { return entries.size(); }
+    bool empty() const noexcept { return entries.empty(); }
+    void reserve(size_t n) { entries.reserve(n); }
+    void clear() noexcept { entries.clear(); }
+
+    iterator find(const String& key);
+    const_iterator find(const String& key) const;
+    bool contains(const String& key) const;
+    struct Value& at(const String& key);
+    const struct Value& at(const String& key) const;
+    struct Value& operator[](const String& key);
+    void insert_or_assign(String key, struct Value value);
+
+    /**
+     * @brief Restores the sorted invariant after bulk push_backs.
+     *
+     * Sorts entries by key; on duplicate keys the last occurrence wins,
+     * matching std::map::operator[] overwrite semantics.
+     */
+    void finalize();
+
+    bool operator==(const FlatMap& other) const;
+};
+
 struct Value : std::variant<
     Nil,
     Bool,
@@ -181,6 +229,7 @@ struct Value : std::variant<
     Binary,
     std::vector<struct Value>,
     std::map<String, struct Value>,
+    FlatMap,
     Extension,
     Timestamp,
     Date,
@@ -210,6 +259,80 @@ struct Value : std::variant<
 using Array = std::vector<Value>;
 using Map = std::map<String, Value>;
 
+// FlatMap members are defined once Value is complete.
+inline FlatMap::iterator FlatMap::find(const String& key) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), key,
+        [](const value_type& entry, const String& k) { return entry.first < k; });
+    return (it != entries.end() && it->first == key) ? it : entries.end();
+}
+
+inline FlatMap::const_iterator FlatMap::find(const String& key) const {
+    auto it = std::lower_bound(entries.begin(), entries.end(), key,
+        [](const value_type& entry, const String& k) { return entry.first < k; });
+    return (it != entries.end() && it->first == key) ? it : entries.end();
+}
+
+inline bool FlatMap::contains(const String& key) const {
+    return find(key) != entries.end();
+}
+
+inline Value& FlatMap::at(const String& key) {
+    auto it = find(key);
+    if (it == entries.end()) {
+        throw std::out_of_range("FlatMap::at: key not found: " + key);
+    }
+    return it->second;
+}
+
+inline const Value& FlatMap::at(const String& key) const {
+    auto it = find(key);
+    if (it == entries.end()) {
+        throw std::out_of_range("FlatMap::at: key not found: " + key);
+    }
+    return it->second;
+}
+
+inline Value& FlatMap::operator[](const String& key) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), key,
+        [](const value_type& entry, const String& k) { return entry.first < k; });
+    if (it == entries.end() || it->first != key) {
+        it = entries.insert(it, value_type{key, Value{}});
+    }
+    return it->second;
+}
+
+inline void FlatMap::insert_or_assign(String key, Value value) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), key,
+        [](const value_type& entry, const String& k) { return entry.first < k; });
+    if (it != entries.end() && it->first == key) {
+        it->second = std::move(value);
+    } else {
+        entries.insert(it, value_type{std::move(key), std::move(value)});
+    }
+}
+
+inline void FlatMap::finalize() {
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const value_type& a, const value_type& b) { return a.first < b.first; });
+    // Keep the last occurrence of each key.
+    auto out = entries.begin();
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        auto next = std::next(it);
+        if (next != entries.end() && next->first == it->first) {
+            continue;
+        }
+        if (out != it) {
+            *out = std::move(*it);
+        }
+        ++out;
+    }
+    entries.erase(out, entries.end());
+}
+
+inline bool FlatMap::operator==(const FlatMap& other) const {
+    return entries == other.entries;
+}
+
 struct EncodeOptions {
     bool compress = false;
     int compression_level = 0;  // Numeric level for backward compatibility
@@ -224,13 +347,81 @@ struct EncodeOptions {
     // Adaptive compression
     bool adaptive_compression = false;  // Auto-select best algorithm based on data
     size_t min_compression_size = 256;  // Minimum size to compress
-    
+
+    // Shared-dictionary compression. A non-zero ID selects a dictionary from
+    // the DictionaryRegistry (its algorithm overrides compression_algorithm)
+    // and is carried in the compression header so the decoder can resolve it.
+    uint16_t compression_dictionary_id = 0;  // 0 = no dictionary
+
+    // Chunked columnar (tabular v2) layout. When columnar_row_group_size is
+    // non-zero, tabular data is written as row groups of that many rows, and
+    // each column chunk is compressed independently so readers can process
+    // the payload with bounded memory. Per-column algorithm overrides allow
+    // e.g. ZSTD for string columns and LZ4 for numeric ones.
+    size_t columnar_row_group_size = 0;  // 0 = monolithic v1 layout
+    CompressionAlgorithm columnar_compression = CompressionAlgorithm::NONE;
+    std::map<std::string, CompressionAlgorithm> columnar_column_compression;
+
+    // Parallel columnar encode: columns are independent, so they can be
+    // serialized (and, for the chunked layout, compressed) concurrently.
+    // 1 = serial (default), 0 = one worker per hardware core, N = N workers.
+    size_t columnar_encode_threads = 1;
+
+    // Validity bitmaps (tabular v4): nulls are recorded in an Arrow-style
+    // per-column bitmap instead of inline nil markers, and the non-null
+    // values pack contiguously. Float columns additionally pack as raw
+    // fixed-width doubles, so numeric columns bulk-decode without a branch
+    // per value, and low-cardinality string columns are dictionary-encoded
+    // (tabular v5) as a dictionary page plus per-row indices. Applies to
+    // the monolithic layout.
+    bool columnar_validity_bitmaps = false;
+
+    // Seek index footer: StreamEncoder::close() appends a table of record
+    // byte offsets plus a magic trailer, so IndexedRecordReader can jump
+    // straight to record N in a file instead of decoding everything before
+    // it. Readers without index support ignore the footer only if they stop
+    // at the record count they expect; the footer is opt-in for that reason.
+    bool stream_seek_index = false;
+
+    // Framed streams: when non-zero, StreamEncoder groups records into
+    // independently compressed frames of roughly this many encoded bytes,
+    // each carrying its own checksum, and close() appends a frame directory
+    // footer. FramedStreamReader (and StreamDecoder, transparently) can then
+    // reach any frame without decompressing the ones before it. Frame-level
+    // compression uses compression_algorithm/compress from these options.
+    // Mutually exclusive with stream_seek_index.
+    size_t stream_frame_size = 0;  // 0 = unframed stream
+
+    // Pipelined framed streams: frame compression and the ostream write run
+    // on a background thread while the caller keeps encoding the next frame,
+    // so producers no longer stall on the compressor. Frames are written in
+    // order and the output is byte-identical to the synchronous path; at most
+    // two frames are in flight, so memory stays bounded. Worker failures are
+    // rethrown from the next write() or close(). Requires stream_frame_size.
+    bool stream_background_compression = false;
+
     // Potentially add security options here in the future
 };
 
 struct DecodeOptions {
     bool auto_decompress = true;
     bool strict = true;
+
+    // Read-ahead for framed streams: StreamDecoder fetches and decompresses
+    // the next frame on a background thread while the caller drains the
+    // current one, overlapping I/O and decompression with record decoding.
+    // At most two decompressed frames are held at a time. Ignored for
+    // unframed input.
+    bool stream_read_ahead = false;
+
+    // Parallel decode for framed streams: a reader thread fans raw frames
+    // out to this many worker threads, which decompress, verify and decode
+    // them concurrently; records are still delivered strictly in stream
+    // order. 1 = single-threaded, 0 = one worker per hardware thread
+    // (matching BatchOptions::worker_threads). Subsumes stream_read_ahead.
+    // Ignored for unframed input.
+    size_t stream_decode_threads = 1;
+
     // Potentially add security options here in the future
 };
 
@@ -239,6 +430,14 @@ struct DecodeOptions {
 std::vector<uint8_t> encode(const Value& value, const EncodeOptions& options = {});
 Value decode(std::span<const uint8_t> data, const DecodeOptions& options = {});
 
+// Statistics-collecting overloads: counters (including the compression
+// ratio achieved, which only these free functions can see) are merged
+// into the caller's CodecStats. See stats.h.
+std::vector<uint8_t> encode(const Value& value, const EncodeOptions& options,
+                            CodecStats& stats);
+Value decode(std::span<const uint8_t> data, const DecodeOptions& options,
+             CodecStats& stats);
+
 // --- Utility Functions ---
 
 bool is_tabular(const Array& arr);
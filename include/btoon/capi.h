@@ -183,6 +183,105 @@ BTOON_API btoon_value_t* btoon_decode(const uint8_t* data, size_t size, const bt
 
 BTOON_API void btoon_free_result(btoon_result_t result);
 
+// --- Arena Allocation ---
+//
+// btoon_decode() makes one heap allocation per tree node, and freeing a
+// large document through btoon_value_destroy() walks the whole tree
+// again. The arena variant places every node, string, and element table
+// of a decoded tree in a single btoon_arena_t; btoon_arena_destroy()
+// releases the document in one operation. Values decoded into an arena
+// must NOT be passed to btoon_value_destroy() — their lifetime is the
+// arena's.
+
+typedef struct btoon_arena btoon_arena_t;
+
+/**
+ * Create an arena. initial_capacity is a size hint in bytes for the first
+ * backing block (0 selects a default); the arena grows as needed.
+ */
+BTOON_API btoon_arena_t* btoon_arena_create(size_t initial_capacity);
+
+/**
+ * Decode into the arena. The returned tree and everything it references
+ * live until btoon_arena_destroy(). Returns NULL on failure, with *error
+ * set to a message owned by the arena (do not free it separately).
+ */
+BTOON_API btoon_value_t* btoon_decode_arena(btoon_arena_t* arena, const uint8_t* data, size_t size, const btoon_decode_options_t* options, const char** error);
+
+/** Total bytes currently backed by the arena. */
+BTOON_API size_t btoon_arena_total_allocated(const btoon_arena_t* arena);
+
+/** Free the arena and every value decoded into it. NULL is a no-op. */
+BTOON_API void btoon_arena_destroy(btoon_arena_t* arena);
+
+// --- Zero-Copy Views ---
+//
+// btoon_decode_view() decodes a buffer into an arena-owned tree like
+// btoon_decode_arena(), but string, binary, and map-key payloads are
+// pointers into the CALLER'S buffer rather than copies — only the node
+// structures themselves live in the arena. The buffer must outlive the
+// returned tree, and view strings are NOT NUL-terminated (use the len
+// field). Combined with btoon_mmap_open() this lets bindings read large
+// documents without ever copying field payloads across the FFI boundary.
+
+BTOON_API btoon_value_t* btoon_decode_view(btoon_arena_t* arena, const uint8_t* data, size_t size, const char** error);
+
+// Memory-mapped file helpers for feeding btoon_decode_view().
+typedef struct btoon_mmap btoon_mmap_t;
+
+/** Map a file read-only. Returns NULL on failure. */
+BTOON_API btoon_mmap_t* btoon_mmap_open(const char* path);
+BTOON_API const uint8_t* btoon_mmap_data(const btoon_mmap_t* file);
+BTOON_API size_t btoon_mmap_size(const btoon_mmap_t* file);
+/** Unmap the file. Views decoded from it must no longer be used. */
+BTOON_API void btoon_mmap_close(btoon_mmap_t* file);
+
+// --- Streaming and Batched Decoding ---
+//
+// One FFI crossing per message dominates decode cost for small records
+// (cgo and ctypes transitions are hundreds of nanoseconds). A stream
+// decoder holds its position across calls, and the batch entry point
+// decodes up to N messages per crossing into a caller-preallocated
+// array, amortizing the boundary over the whole batch. Decoded values
+// are arena-owned, like btoon_decode_arena().
+
+typedef struct btoon_stream_decoder btoon_stream_decoder_t;
+
+/**
+ * Create a stream decoder over a caller-owned buffer of concatenated
+ * BTOON messages. The buffer is not copied and must outlive the
+ * decoder. Returns NULL on failure.
+ */
+BTOON_API btoon_stream_decoder_t* btoon_stream_decoder_create_buffer(const uint8_t* data, size_t size, const btoon_decode_options_t* options);
+
+/**
+ * Create a stream decoder reading from an open file descriptor. The
+ * decoder reads ahead internally; the caller must not read from the fd
+ * while the decoder exists, and remains responsible for closing it.
+ */
+BTOON_API btoon_stream_decoder_t* btoon_stream_decoder_create_fd(int fd, const btoon_decode_options_t* options);
+
+/**
+ * Decode the next message into the arena. Returns NULL at end of stream
+ * (with *error left NULL) or on failure (*error set to an arena-owned
+ * message).
+ */
+BTOON_API btoon_value_t* btoon_stream_decoder_next(btoon_stream_decoder_t* decoder, btoon_arena_t* arena, const char** error);
+
+/**
+ * Decode up to max_values messages in one crossing, storing the trees
+ * in the caller-preallocated out_values array. Returns the number
+ * decoded; fewer than max_values means end of stream unless *error was
+ * set.
+ */
+BTOON_API size_t btoon_stream_decoder_next_batch(btoon_stream_decoder_t* decoder, btoon_arena_t* arena, btoon_value_t** out_values, size_t max_values, const char** error);
+
+/** True if another message is available. */
+BTOON_API bool btoon_stream_decoder_has_next(btoon_stream_decoder_t* decoder);
+
+/** Destroy the decoder. Does not close a wrapped fd. NULL is a no-op. */
+BTOON_API void btoon_stream_decoder_destroy(btoon_stream_decoder_t* decoder);
+
 // --- Version Info ---
 BTOON_API const char* btoon_version(void);
 
@@ -21,6 +21,9 @@
 #include <cstdint>
 #include <vector>
 #include <span>
+#include <map>
+#include <memory>
+#include <mutex>
 
 namespace btoon {
 
@@ -113,6 +116,98 @@ std::vector<uint8_t> compress(const CompressionProfile& profile, std::span<const
  */
 std::vector<uint8_t> decompress(CompressionAlgorithm algorithm, std::span<const uint8_t> compressed_data);
 
+// --- Dictionary compression ---
+
+/**
+ * @brief A trained compression dictionary shared between peers.
+ *
+ * Small messages compress poorly on their own; a dictionary trained on
+ * representative payloads lets the compressor reference common substrings
+ * it has never seen in the current message. Both sides must hold the same
+ * dictionary bytes under the same ID.
+ */
+struct CompressionDictionary {
+    uint16_t id = 0;  /**< Non-zero identifier; carried in the compression header. */
+    CompressionAlgorithm algorithm = CompressionAlgorithm::ZSTD; /**< Algorithm the dictionary is for. */
+    std::vector<uint8_t> data;  /**< Raw dictionary bytes as produced by training. */
+};
+
+/**
+ * @brief Trains a zstd dictionary from sample payloads.
+ *
+ * Feed a few hundred representative messages; the resulting dictionary
+ * can be registered on both peers and used via compress_with_dictionary.
+ *
+ * @param samples Representative payloads, one vector per message.
+ * @param max_dict_size Upper bound on the trained dictionary size.
+ * @param id Identifier to assign to the trained dictionary.
+ * @return The trained dictionary.
+ * @throws BtoonException if zstd support is compiled out, the sample set
+ *         is insufficient, or training fails.
+ */
+CompressionDictionary train_zstd_dictionary(const std::vector<std::vector<uint8_t>>& samples,
+                                            size_t max_dict_size = 16 * 1024,
+                                            uint16_t id = 1);
+
+/**
+ * @brief Process-wide registry of compression dictionaries by ID.
+ *
+ * The compression header only carries the dictionary ID, so encoder and
+ * decoder resolve the actual bytes through this registry. Registration is
+ * thread-safe; lookups return shared ownership so a dictionary stays valid
+ * even if it is replaced concurrently.
+ */
+class DictionaryRegistry {
+public:
+    static DictionaryRegistry& instance();
+
+    /**
+     * @brief Registers (or replaces) a dictionary.
+     * @throws BtoonException if the dictionary ID is 0 (reserved for "none").
+     */
+    void registerDictionary(CompressionDictionary dictionary);
+
+    /**
+     * @brief Looks up a dictionary by ID.
+     * @return The dictionary, or nullptr if no dictionary has that ID.
+     */
+    std::shared_ptr<const CompressionDictionary> find(uint16_t id) const;
+
+    /**
+     * @brief Removes all registered dictionaries.
+     */
+    void clear();
+
+private:
+    DictionaryRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::map<uint16_t, std::shared_ptr<const CompressionDictionary>> dictionaries_;
+};
+
+/**
+ * @brief Compresses data with a registered dictionary.
+ * @param data The binary data to compress.
+ * @param dictionary_id ID of a dictionary in the DictionaryRegistry.
+ * @param level The compression level (algorithm-specific).
+ * @return A vector of bytes representing the compressed data.
+ * @throws BtoonException if the dictionary is unknown or its algorithm
+ *         is not compiled in.
+ */
+std::vector<uint8_t> compress_with_dictionary(std::span<const uint8_t> data,
+                                              uint16_t dictionary_id, int level = 0);
+
+/**
+ * @brief Decompresses data produced with a registered dictionary.
+ * @param compressed_data The compressed binary data.
+ * @param dictionary_id ID of a dictionary in the DictionaryRegistry.
+ * @return A vector of bytes representing the decompressed data.
+ * @throws BtoonException if the dictionary is unknown or its algorithm
+ *         is not compiled in.
+ */
+std::vector<uint8_t> decompress_with_dictionary(std::span<const uint8_t> compressed_data,
+                                                uint16_t dictionary_id);
+
 // --- Algorithm-specific implementations ---
 
 std::vector<uint8_t> compress_zlib(std::span<const uint8_t> data, int level);
@@ -143,6 +238,11 @@ std::vector<uint8_t> decompress_lz4(std::span<const uint8_t> compressed_data);
 #ifdef BTOON_WITH_ZSTD
 std::vector<uint8_t> compress_zstd(std::span<const uint8_t> data, int level);
 std::vector<uint8_t> decompress_zstd(std::span<const uint8_t> compressed_data);
+std::vector<uint8_t> compress_zstd_with_dictionary(std::span<const uint8_t> data,
+                                                   const CompressionDictionary& dictionary,
+                                                   int level);
+std::vector<uint8_t> decompress_zstd_with_dictionary(std::span<const uint8_t> compressed_data,
+                                                     const CompressionDictionary& dictionary);
 #endif
 
 #ifdef BTOON_WITH_BROTLI
@@ -154,8 +154,8 @@ public:
     explicit Percentage(const Decimal& value); // Value as percentage (e.g., 5.5 for 5.5%)
     explicit Percentage(double value);
     
-    Decimal as_decimal() const { return value_ / Decimal(100); }
-    Decimal as_basis_points() const { return value_ * Decimal(100); }
+    Decimal as_decimal() const { return value_ / Decimal(int64_t{100}); }
+    Decimal as_basis_points() const { return value_ * Decimal(int64_t{100}); }
     
     Decimal apply_to(const Decimal& base) const;
     Currency apply_to(const Currency& base) const;
@@ -0,0 +1,126 @@
+#ifndef BTOON_DECIMAL_COLUMN_H
+#define BTOON_DECIMAL_COLUMN_H
+
+#include "btoon.h"
+#include "decimal.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace btoon {
+
+/**
+ * @brief Columnar batch of Decimal values with a shared scale.
+ *
+ * Stores one column of fixed-point values as a contiguous int64 mantissa
+ * array, all interpreted at the same scale (number of decimal places), so
+ * batch operations run as tight loops over plain integers the compiler
+ * can vectorize — no per-cell Decimal objects and no conversion through
+ * doubles. A value like 12.34 at scale 2 is the mantissa 1234.
+ *
+ * Serializes as extension type -7: a 4-byte big-endian scale followed by
+ * big-endian int64 mantissas. The generic decoder hands the payload back
+ * as an Extension; from_value() reconstructs the column.
+ */
+class DecimalColumn {
+public:
+    /// Extension type carrying a serialized decimal column.
+    static constexpr int8_t EXT_TYPE = -7;
+
+    /**
+     * @param scale Number of decimal places shared by every value.
+     */
+    explicit DecimalColumn(int32_t scale = 2);
+
+    /**
+     * @brief Builds a column from scalar Decimals, rescaling each to scale.
+     * @param values The decimals to pack.
+     * @param scale Number of decimal places for the column.
+     * @throws BtoonException if a value cannot be represented at the scale
+     *         without overflow.
+     */
+    static DecimalColumn from_values(const std::vector<Decimal>& values,
+                                     int32_t scale);
+
+    /**
+     * @brief Appends one value, rescaled (rounding half away from zero)
+     *        to the column's scale.
+     */
+    void push_back(const Decimal& value);
+
+    /**
+     * @brief Appends a raw mantissa already at the column's scale.
+     */
+    void push_back_mantissa(int64_t mantissa) { mantissas_.push_back(mantissa); }
+
+    /// The value at index as a scalar Decimal.
+    Decimal at(size_t index) const;
+
+    size_t size() const { return mantissas_.size(); }
+    bool empty() const { return mantissas_.empty(); }
+    void reserve(size_t n) { mantissas_.reserve(n); }
+    int32_t scale() const { return scale_; }
+    std::span<const int64_t> mantissas() const { return mantissas_; }
+
+    // --- Batch operations ---
+
+    /**
+     * @brief Exact sum of the whole column.
+     *
+     * Accumulates in 128 bits, so intermediate totals cannot overflow;
+     * only a final result outside int64 throws.
+     *
+     * @return The column total as a Decimal at the column's scale.
+     * @throws BtoonException if the total overflows the mantissa range.
+     */
+    Decimal sum() const;
+
+    /**
+     * @brief The column converted to a different scale.
+     *
+     * Widening multiplies every mantissa; narrowing rounds half away
+     * from zero, the same policy as Decimal::round().
+     *
+     * @param new_scale Number of decimal places for the result.
+     * @throws BtoonException if widening overflows a mantissa.
+     */
+    DecimalColumn rescaled(int32_t new_scale) const;
+
+    /**
+     * @brief Element-wise threshold comparison over the whole column.
+     *
+     * The threshold is rescaled once; the comparison loop is a plain
+     * integer compare per cell.
+     *
+     * @param threshold Value to compare against.
+     * @return One byte per cell: 1 where cell < threshold, else 0.
+     */
+    std::vector<uint8_t> less_than(const Decimal& threshold) const;
+
+    /// @copydoc less_than, with cell > threshold.
+    std::vector<uint8_t> greater_than(const Decimal& threshold) const;
+
+    // --- BTOON serialization ---
+
+    /**
+     * @brief The column as an extension Value (type EXT_TYPE).
+     */
+    Value to_value() const;
+
+    /**
+     * @brief Reconstructs a column from a decoded extension Value.
+     * @throws BtoonException if the value is not a type -7 extension or
+     *         the payload is malformed.
+     */
+    static DecimalColumn from_value(const Value& value);
+
+private:
+    int64_t rescale_mantissa(const Decimal& value) const;
+
+    std::vector<int64_t> mantissas_;
+    int32_t scale_;
+};
+
+} // namespace btoon
+
+#endif // BTOON_DECIMAL_COLUMN_H
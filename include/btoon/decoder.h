@@ -26,12 +26,15 @@
 #include "btoon.h"
 #include "security.h"
 #include "memory_pool.h"
+#include "stats.h"
 #include <vector>
 #include <span>
 
 namespace btoon {
 
 class MemoryPool;
+struct ValidationOptions;
+struct ValidationResult;
 
 /**
  * @brief Class responsible for decoding data from BTOON binary format.
@@ -77,6 +80,58 @@ public:
      */
     void setSecurityEnabled(bool enable) { useSecurity_ = enable; }
 
+    /**
+     * @brief Materializes map markers as FlatMap instead of Map.
+     *
+     * With flat maps enabled, every decoded map is a sorted vector of
+     * entries (one allocation, contiguous iteration) rather than a
+     * node-based std::map. Re-encoding produces identical bytes either
+     * way.
+     *
+     * @param enable Boolean to enable (true) or disable (false) flat maps.
+     */
+    void setFlatMaps(bool enable) { useFlatMaps_ = enable; }
+
+    /**
+     * @brief Materializes dictionary-encoded tabular columns as indices.
+     *
+     * Dictionary-encoded string columns (tabular v5) normally come back as
+     * the looked-up strings. With this enabled, each non-null cell is the
+     * column's Uint dictionary index instead — useful for group-by style
+     * processing, where equal strings only need equal indices and the
+     * per-row string copies are wasted work.
+     *
+     * @param enable Boolean to enable (true) or disable (false) index output.
+     */
+    void setDictionaryIndices(bool enable) { useDictionaryIndices_ = enable; }
+
+    /**
+     * @brief Enables or disables statistics collection.
+     *
+     * Off by default; when off, the decode entry points pay a single
+     * branch.
+     *
+     * @param enable Boolean to enable (true) or disable (false) collection.
+     */
+    void setStatsEnabled(bool enable) { collectStats_ = enable; }
+
+    /**
+     * @brief Snapshot of this decoder's statistics.
+     *
+     * Counters accumulated since construction or the last
+     * resetStatistics(), with the memory pool's free-list numbers
+     * sampled at call time. Aggregate across instances with
+     * CodecStats::merge().
+     *
+     * @return The current statistics.
+     */
+    CodecStats statistics() const;
+
+    /**
+     * @brief Clears the accumulated statistics.
+     */
+    void resetStatistics() { stats_ = CodecStats{}; }
+
     /**
      * @brief Decodes a BTOON binary buffer into a btoon::Value.
      * 
@@ -91,8 +146,64 @@ public:
     Value decode(std::span<const uint8_t> buffer) const;
     std::pair<Value, size_t> decode_and_get_pos(std::span<const uint8_t> buffer) const;
 
+    /**
+     * @brief Decodes a BTOON binary buffer without per-level recursion.
+     *
+     * Equivalent to decode(), but containers are processed with an explicit
+     * work stack instead of recursive calls, so stack usage stays constant
+     * regardless of document nesting depth. Prefer this entry point for
+     * untrusted or deeply nested input; decode() remains the reference
+     * implementation and the two are kept behaviorally identical.
+     *
+     * @param buffer The binary data buffer to decode.
+     * @return A btoon::Value containing the decoded value.
+     * @throws BtoonException if the buffer is invalid, decoding fails, or signature verification fails.
+     */
+    Value decodeIterative(std::span<const uint8_t> buffer) const;
+
+    /**
+     * @brief Decodes a buffer while validating it in the same pass.
+     *
+     * Runs the structural checks of Validator::validate — string, binary,
+     * array and map size limits, nesting depth, UTF-8 strings, float and
+     * extension constraints, duplicate map keys — inline as the buffer is
+     * walked once, instead of a validation pass followed by a second
+     * decode pass. Violations are recorded in @p result rather than
+     * thrown; input that cannot be parsed at all still throws
+     * BtoonException. Prefer Validator::decodeValidated, which wraps this
+     * together with the upfront envelope checks.
+     *
+     * @param buffer The binary data buffer to decode.
+     * @param options Validation options controlling the inline checks.
+     * @param result Destination for validation errors, warnings and stats.
+     * @return A btoon::Value containing the decoded value.
+     */
+    Value decodeValidated(std::span<const uint8_t> buffer,
+                          const ValidationOptions& options,
+                          ValidationResult& result);
+
+    /**
+     * @brief Decodes only the requested columns of a tabular payload.
+     *
+     * The buffer must contain a tabular extension as written by
+     * Encoder::encodeColumnar. For version 3 payloads the column offset
+     * table is used to seek directly to each projected column; for older
+     * versions the per-column size prefixes are used to skip unrequested
+     * columns without decoding them. Either way, only the bytes of the
+     * requested columns are decoded.
+     *
+     * @param buffer The binary data buffer containing a tabular payload.
+     * @param columns Names of the columns to materialize.
+     * @return An Array of row Maps containing only the requested columns.
+     * @throws BtoonException if the payload is not tabular or a requested
+     *         column does not exist.
+     */
+    Array decodeColumns(std::span<const uint8_t> buffer,
+                        const std::vector<std::string>& columns) const;
+
 private:
     Value decode(std::span<const uint8_t> buffer, size_t& pos) const;
+    Value decodeIterative(std::span<const uint8_t> buffer, size_t& pos) const;
     Nil decodeNil(size_t& pos) const;
     Bool decodeBool(std::span<const uint8_t> buffer, size_t& pos) const;
     Int decodeInt(std::span<const uint8_t> buffer, size_t& pos) const;
@@ -102,6 +213,7 @@ private:
     Binary decodeBinary(std::span<const uint8_t> buffer, size_t& pos) const;
     Array decodeArray(std::span<const uint8_t> buffer, size_t& pos) const;
     Map decodeMap(std::span<const uint8_t> buffer, size_t& pos) const;
+    FlatMap decodeFlatMap(std::span<const uint8_t> buffer, size_t& pos) const;
 
     Value decodeExtension(std::span<const uint8_t> buffer, size_t& pos) const;
     Date decodeDate(std::span<const uint8_t> buffer, size_t& pos, size_t len) const;
@@ -111,13 +223,31 @@ private:
     VectorDouble decodeVectorDouble(std::span<const uint8_t> buffer, size_t& pos, size_t len) const;
 
     uint64_t readVarInt(std::span<const uint8_t> buffer, size_t& pos, uint8_t bits) const;
+
+    /// Decode a v4/v5 column entry (flags, validity bitmap, optional
+    /// dictionary page, packed values) into rows [row_base, row_base + rows)
+    /// of arr under the given column name.
+    void decodeBitmapColumn(std::span<const uint8_t> column, const std::string& name,
+                            Array& arr, size_t row_base, size_t rows) const;
     
     std::span<const uint8_t> verifyAndExtractData(std::span<const uint8_t> buffer) const;
 
     const Security* security_ = nullptr; /**< Pointer to Security object for HMAC verification. */
     bool useSecurity_ = false;           /**< Flag to enable/disable security verification. */
+    bool useFlatMaps_ = false;           /**< Flag to decode maps as FlatMap instead of Map. */
+    bool useDictionaryIndices_ = false;  /**< Flag to keep dictionary columns as indices. */
     MemoryPool* pool_;                   /**< Pointer to MemoryPool for allocations. */
     bool owns_pool_ = false;             /**< Flag to indicate if the Decoder owns the MemoryPool. */
+
+    const ValidationOptions* validation_ = nullptr; /**< Inline validation options, set during decodeValidated. */
+    ValidationResult* validationResult_ = nullptr;  /**< Destination for inline validation findings. */
+    mutable size_t validationDepth_ = 0;            /**< Container depth during inline validation. */
+
+    /// Tallies one completed top-level decode when collection is enabled.
+    void noteDecoded(const Value& value, size_t bytes) const;
+
+    bool collectStats_ = false;          /**< Flag to enable/disable statistics collection. */
+    mutable CodecStats stats_;           /**< Accumulated statistics when collection is enabled. */
 };
 
 } // namespace btoon
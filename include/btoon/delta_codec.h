@@ -11,6 +11,26 @@ class DeltaCodec {
 public:
     static std::vector<uint8_t> encode(const Array& data);
     static Array decode(const std::vector<uint8_t>& data);
+
+    /**
+     * @brief Second-order delta encoding for timestamp-like columns
+     *
+     * Stores the first value, the first delta, then delta-of-deltas, each
+     * zigzag-mapped and packed as a variable-width (LEB128) integer. For
+     * near-regular sequences — monotonic timestamps, counters — almost every
+     * delta-of-delta is zero and costs one byte.
+     */
+    static std::vector<uint8_t> encode_delta_of_delta(const Array& data);
+
+    /**
+     * @brief Decode encode_delta_of_delta output
+     *
+     * Reconstruction runs two vectorized prefix-sum passes (delta-of-deltas
+     * to deltas, deltas to values) instead of one serial carry chain per
+     * element.
+     * @throws BtoonException on truncated or malformed input
+     */
+    static Array decode_delta_of_delta(const std::vector<uint8_t>& data);
 };
 
 } // namespace btoon
@@ -2,6 +2,7 @@
 #define BTOON_DICTIONARY_CODEC_H
 
 #include "btoon.h"
+#include <map>
 #include <vector>
 #include <span>
 
@@ -13,6 +14,53 @@ public:
     static Array decode(const std::vector<uint8_t>& data);
 };
 
+/**
+ * @brief Dictionary codec whose dictionary persists across messages.
+ *
+ * The static DictionaryCodec relearns its dictionary per buffer; this one
+ * keeps it between calls, so a value repeated across the millions of
+ * messages in one stream is serialized once and referenced by index ever
+ * after. Each message carries only the entries that are new to it:
+ *
+ *     [varint new entry count][new entries...][varint index count][indices]
+ *
+ * One instance per stream direction: feeding the decoder the encoder's
+ * messages in order keeps both dictionaries identical, the same way the
+ * streaming compression dictionaries stay in sync. The per-message format
+ * is self-delimiting so it can ride inside StreamEncoder frames, and the
+ * class is the building block for dictionary-encoded string columns and
+ * map keys.
+ */
+class StreamingDictionaryCodec {
+public:
+    /**
+     * @brief Encode one message, extending the dictionary with new values
+     */
+    std::vector<uint8_t> encode(const Array& data);
+
+    /**
+     * @brief Decode one message, learning its new dictionary entries
+     * @throws BtoonException on truncated input or out-of-range indices
+     */
+    Array decode(const std::vector<uint8_t>& data);
+
+    /**
+     * @brief Number of distinct values learned so far
+     */
+    size_t dictionary_size() const { return dictionary_.size(); }
+
+    /**
+     * @brief Forget the dictionary (both sides must reset together)
+     */
+    void clear();
+
+private:
+    std::vector<Value> dictionary_;  // index -> value, in learning order
+    // Encode-side lookup keyed by the value's serialized bytes (Value has
+    // no ordering across all its alternatives).
+    std::map<std::vector<uint8_t>, uint64_t> indices_;
+};
+
 } // namespace btoon
 
 #endif // BTOON_DICTIONARY_CODEC_H
@@ -0,0 +1,151 @@
+/**
+ * @file document_cursor.h
+ * @brief Lazy, on-demand navigation over encoded BTOON buffers.
+ *
+ * Provides the DocumentCursor class, which walks an encoded buffer without
+ * materializing a full Value tree. Unrequested map entries and array elements
+ * are skipped using the length prefixes already present in the format, so a
+ * field lookup costs O(fields skipped) and performs no allocation. Leaves that
+ * are actually touched are surfaced as ValueView (see zero_copy.h), keeping
+ * strings and binary data as views into the original buffer.
+ */
+
+#ifndef BTOON_DOCUMENT_CURSOR_H
+#define BTOON_DOCUMENT_CURSOR_H
+
+#include "btoon.h"
+#include "zero_copy.h"
+#include <span>
+#include <string_view>
+
+namespace btoon {
+
+/**
+ * @brief Cursor positioned on a single encoded value inside a BTOON buffer.
+ *
+ * A DocumentCursor never decodes more than it is asked to. Navigation methods
+ * (find, at) return new cursors positioned on child values; only value() pays
+ * the cost of materializing the element under the cursor, and it does so as a
+ * zero-copy ValueView.
+ *
+ * Typical usage for partial deserialization:
+ * @code
+ * DocumentCursor doc(encoded);
+ * auto name = doc.find("name");
+ * if (name.valid()) {
+ *     auto view = name.value();  // only this field is decoded
+ * }
+ * @endcode
+ *
+ * The cursor does not own the buffer; the caller must keep the encoded data
+ * alive for as long as the cursor (and any ValueView obtained from it) is used.
+ */
+class DocumentCursor {
+public:
+    /**
+     * @brief Coarse type of the element under the cursor.
+     */
+    enum class Type {
+        Nil,
+        Bool,
+        Int,
+        Uint,
+        Float,
+        String,
+        Binary,
+        Array,
+        Map,
+        Extension
+    };
+
+    /**
+     * @brief Create a cursor positioned on the first value in the buffer.
+     * @param buffer Encoded BTOON data (not owned).
+     * @throws BtoonException if the buffer is empty.
+     */
+    explicit DocumentCursor(std::span<const uint8_t> buffer);
+
+    /**
+     * @brief Whether the cursor points at a value.
+     *
+     * An invalid cursor is returned by find() when the key is absent. All
+     * other accessors throw when called on an invalid cursor.
+     */
+    bool valid() const { return valid_; }
+
+    /**
+     * @brief Type of the element under the cursor.
+     * @throws BtoonException if the cursor is invalid or the marker is unknown.
+     */
+    Type type() const;
+
+    /**
+     * @brief Number of elements (arrays) or entries (maps) in the container.
+     * @throws BtoonException if the cursor is not on an array or map.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Look up a map entry by key, skipping over other entries.
+     *
+     * Keys are compared as raw UTF-8 without decoding the associated values.
+     * Cost is proportional to the encoded size of the entries skipped.
+     *
+     * @param key Key to search for.
+     * @return Cursor on the matching value, or an invalid cursor if absent.
+     * @throws BtoonException if the cursor is not on a map.
+     */
+    DocumentCursor find(std::string_view key) const;
+
+    /**
+     * @brief Position a cursor on the index-th element of an array.
+     * @param index Zero-based element index.
+     * @return Cursor on the element.
+     * @throws BtoonException if the cursor is not on an array or the index
+     *         is out of range.
+     */
+    DocumentCursor at(size_t index) const;
+
+    /**
+     * @brief Decode only the element under the cursor into a ValueView.
+     *
+     * Strings and binary payloads in the result are views into the original
+     * buffer. Container elements are decoded recursively, so prefer find()/
+     * at() to narrow the cursor before calling value() on large documents.
+     *
+     * @throws BtoonException if the cursor is invalid or the data is malformed.
+     */
+    ValueView value() const;
+
+    /**
+     * @brief Encoded bytes of the element under the cursor (marker included).
+     *
+     * Useful for re-emitting a subtree without a decode/encode round trip.
+     * @throws BtoonException if the cursor is invalid or the data is malformed.
+     */
+    std::span<const uint8_t> raw() const;
+
+private:
+    DocumentCursor(std::span<const uint8_t> buffer, size_t pos, bool valid)
+        : buffer_(buffer), pos_(pos), valid_(valid) {}
+
+    /// Skip one complete value starting at pos; returns position past it.
+    static size_t skipValue(std::span<const uint8_t> buffer, size_t pos);
+
+    /// Read a string header at pos and return a view of its payload.
+    static std::string_view readStringKey(std::span<const uint8_t> buffer, size_t& pos);
+
+    /// Read an array/map header at pos, returning the element/entry count.
+    static size_t readContainerHeader(std::span<const uint8_t> buffer, size_t& pos,
+                                      bool& is_map);
+
+    void requireValid() const;
+
+    std::span<const uint8_t> buffer_;  /**< Whole encoded document (not owned). */
+    size_t pos_;                       /**< Offset of the value under the cursor. */
+    bool valid_;                       /**< False for "key not found" cursors. */
+};
+
+} // namespace btoon
+
+#endif // BTOON_DOCUMENT_CURSOR_H
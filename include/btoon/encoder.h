@@ -25,6 +25,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 
@@ -32,6 +33,7 @@
 #include "memory_pool.h"
 #include "memory_pool.h"
 #include "security.h"
+#include "stats.h"
 
 namespace btoon {
 
@@ -85,6 +87,31 @@ public:
      */
     std::span<const uint8_t> getBuffer();
 
+    /**
+     * @brief Clears the encoded data while keeping the buffer capacity.
+     *
+     * After reset() the encoder is ready for the next message without
+     * re-growing its buffer from zero, so a long-lived per-connection
+     * encoder settles on its working-set capacity after the first few
+     * messages. Pairs with the MemoryPool constructor for reuse of the
+     * backing arena as well.
+     */
+    void reset();
+
+    /**
+     * @brief Takes the encoded data as an owned buffer and resets the encoder.
+     *
+     * Returns the (signed, if security is enabled) message as a
+     * std::vector the caller owns, then resets the encoder for the next
+     * message. The internal buffer lives in the MemoryPool arena and so
+     * cannot be transplanted into the vector; this performs one bulk copy
+     * — the same cost as copying out of getBuffer() — but keeps the
+     * encoder's capacity warm across messages.
+     *
+     * @return The encoded message as an owned, movable buffer.
+     */
+    std::vector<uint8_t> takeBuffer();
+
     // Encode basic types
     /**
      * @brief Encodes a null value.
@@ -120,7 +147,15 @@ public:
      * @param value The string to encode.
      */
     void encodeString(const std::string& value);
-    
+
+    /**
+     * @brief Encodes a string value from a non-owning view.
+     *
+     * Lets generated code emit compile-time map keys without constructing
+     * a temporary std::string per field.
+     */
+    void encodeString(std::string_view value);
+
     /**
      * @brief Encodes binary data.
      * @param value The vector of bytes to encode as binary data.
@@ -157,16 +192,85 @@ public:
     // Generic extension type
     void encodeExtension(int8_t type, std::span<const uint8_t> data);
 
+    // Container headers (fixarray/16/32, fixmap/16/32) from an element
+    // count. Public so callers with a statically known shape — e.g. code
+    // generated from a schema — can emit containers element by element
+    // without building a Value or a map of pre-encoded buffers.
+    void encodeArrayHeader(size_t len);
+    void encodeMapHeader(size_t len);
+
     // Columnar encoding
     void encodeColumnar(const Array& data);
 
     // Encode a Value
     void encode(const Value& value);
+
+    /**
+     * @brief Consuming encode overload for producers that discard the Value.
+     *
+     * Nested arrays and maps are encoded directly into this encoder's
+     * buffer instead of through per-element temporary encoders, so the
+     * payload bytes of large String/Binary members are written to the
+     * output exactly once. The Value is left in a moved-from state.
+     */
+    void encode(Value&& value);
     void setOptions(const EncodeOptions& opts) { options_ = opts; }
 
+    /**
+     * @brief Enables or disables statistics collection.
+     *
+     * Off by default; when off, the encode paths pay a single branch.
+     *
+     * @param enable Boolean to enable (true) or disable (false) collection.
+     */
+    void setStatsEnabled(bool enable) { collectStats_ = enable; }
+
+    /**
+     * @brief Snapshot of this encoder's statistics.
+     *
+     * Counters accumulated since construction or the last
+     * resetStatistics(), with the memory pool's free-list numbers
+     * sampled at call time. Aggregate across instances with
+     * CodecStats::merge().
+     *
+     * @return The current statistics.
+     */
+    CodecStats statistics() const;
+
+    /**
+     * @brief Clears the accumulated statistics.
+     */
+    void resetStatistics() { stats_ = CodecStats{}; }
+
 private:
+    // RAII tally for one public encode() call: counts the value tree on
+    // entry (before a consuming encode moves it away) and the emitted
+    // bytes on exit. Nested recursive calls and disabled collection are
+    // no-ops.
+    class StatsFrame {
+    public:
+        StatsFrame(Encoder& encoder, const Value& value);
+        ~StatsFrame();
+
+    private:
+        Encoder& encoder_;
+        bool top_ = false;
+        size_t start_size_ = 0;
+    };
+
     // Helper methods for encoding variable-length integers
     void encodeVarInt(uint64_t value, uint8_t prefix, uint8_t bits);
+
+    // Payload headers (marker + length) without the payload bytes, used by
+    // VectoredEncoder to frame blobs it references in place.
+    void encodeStringHeader(size_t len);
+    void encodeBinaryHeader(size_t len);
+
+    friend class VectoredEncoder;
+
+    // Chunked (v2) columnar layout: row groups with independently compressed
+    // column chunks. Selected via EncodeOptions::columnar_row_group_size.
+    void encodeColumnarChunked(const Array& data);
     
     /**
      * @brief Adds an HMAC signature to the encoded data if security is enabled.
@@ -186,6 +290,64 @@ private:
     uint8_t* buffer_ = nullptr;          /**< Buffer for encoded data. */
     size_t capacity_ = 0;                /**< Capacity of the buffer. */
     size_t size_ = 0;                    /**< Current size of the encoded data. */
+    bool collectStats_ = false;          /**< Flag to enable/disable statistics collection. */
+    size_t encodeDepth_ = 0;             /**< Recursion depth, so only top-level calls tally. */
+    CodecStats stats_;                   /**< Accumulated statistics when collection is enabled. */
+};
+
+/**
+ * @brief Encoder producing scatter/gather segments for vectored I/O.
+ *
+ * Instead of serializing into one contiguous buffer, encode() returns a
+ * list of buffer segments suitable for writev-style output: framing bytes
+ * and small values are accumulated in internal storage, while String and
+ * Binary payloads at or above the inline threshold are referenced in
+ * place inside the Value, so multi-megabyte blobs are never copied.
+ * Concatenating the segments yields exactly the bytes Encoder would
+ * produce for the same Value and options.
+ *
+ * Lifetime: the returned spans point into the encoder's internal storage
+ * and into the encoded Value. They remain valid until the next encode()
+ * call or the destruction of either; the Value must stay alive until the
+ * segments have been written out.
+ */
+class VectoredEncoder {
+public:
+    /**
+     * @brief Construct with encoding options.
+     * @param options Options applied to framing (tabular detection etc.).
+     */
+    explicit VectoredEncoder(const EncodeOptions& options = {});
+
+    /**
+     * @brief Sets the minimum payload size referenced in place.
+     *
+     * String/Binary payloads smaller than this are copied into the
+     * framing segment to keep the segment count (and syscall iovec
+     * length) low. Defaults to 256 bytes.
+     */
+    void setInlineThreshold(size_t bytes) { inline_threshold_ = bytes; }
+
+    /**
+     * @brief Encodes a Value into a list of output segments.
+     * @param value The value to encode; must outlive the segments.
+     * @return Segments that, concatenated, form the encoded message.
+     */
+    std::vector<std::span<const uint8_t>> encode(const Value& value);
+
+    /**
+     * @brief Total byte size of the segments from the last encode().
+     */
+    size_t total_size() const;
+
+private:
+    void encodeValue(const Value& value);
+    void flushFraming();
+
+    Encoder framing_;
+    size_t inline_threshold_ = 256;
+    std::vector<std::vector<uint8_t>> arena_;           // owns framing bytes
+    std::vector<std::span<const uint8_t>> segments_;
 };
 
 } // namespace btoon
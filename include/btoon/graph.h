@@ -10,6 +10,7 @@
 #define BTOON_GRAPH_H
 
 #include "btoon/btoon.h"
+#include "btoon/zero_copy.h"
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -17,6 +18,12 @@
 #include <limits>
 #include <optional>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <string_view>
 
 namespace btoon {
 namespace graph {
@@ -74,6 +81,9 @@ enum class GraphFormat {
     COMPRESSED_SPARSE
 };
 
+template<typename NodeId, typename Weight>
+class CsrGraph;
+
 /**
  * @brief Generic graph data structure
  */
@@ -131,10 +141,20 @@ public:
     size_t diameter() const;
     double density() const;
     
+    /**
+     * @brief Freeze the adjacency into a compressed-sparse-row snapshot
+     *
+     * Node ids are sorted (NodeId must be ordered), so the layout is
+     * deterministic and neighbors of a node sit in one contiguous run.
+     * Traversals and GraphMetrics run against the snapshot; this mutable
+     * graph stays the construction API.
+     */
+    CsrGraph<NodeId, Weight> freeze() const;
+
     // Serialization
     Value to_btoon() const;
     static Graph from_btoon(const Value& value);
-    
+
     // Export formats
     std::string to_dot() const;  // GraphViz format
     std::string to_gml() const;  // Graph Modeling Language
@@ -152,6 +172,628 @@ private:
                    std::vector<NodeId>& result) const;
 };
 
+namespace detail {
+
+/**
+ * @brief BFS parent array over any CSR-shaped adjacency
+ *
+ * Works against anything exposing node_count() and neighbors(index); the
+ * owned CsrGraph and the memory-mapped view share this kernel so both run
+ * the identical frontier sweep over contiguous arrays.
+ */
+template<typename Csr>
+std::vector<uint32_t> bfs_parents(const Csr& graph, uint32_t source) {
+    constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> parents(graph.node_count(), kNoNode);
+    parents[source] = source;
+    std::vector<uint32_t> frontier = {source};
+    std::vector<uint32_t> next;
+    while (!frontier.empty()) {
+        next.clear();
+        for (uint32_t u : frontier) {
+            for (uint32_t v : graph.neighbors(u)) {
+                if (parents[v] == kNoNode) {
+                    parents[v] = u;
+                    next.push_back(v);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    return parents;
+}
+
+/**
+ * @brief Dijkstra distances over any CSR-shaped adjacency
+ */
+template<typename Weight, typename Csr>
+std::vector<Weight> dijkstra(const Csr& graph, uint32_t source) {
+    constexpr Weight kInf = std::numeric_limits<Weight>::max();
+    std::vector<Weight> dist(graph.node_count(), kInf);
+    dist[source] = Weight{};
+    using Item = std::pair<Weight, uint32_t>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    queue.emplace(Weight{}, source);
+    while (!queue.empty()) {
+        auto [d, u] = queue.top();
+        queue.pop();
+        if (d > dist[u]) {
+            continue;
+        }
+        auto adj = graph.neighbors(u);
+        auto w = graph.weights(u);
+        for (size_t i = 0; i < adj.size(); ++i) {
+            Weight candidate = d + w[i];
+            if (candidate < dist[adj[i]]) {
+                dist[adj[i]] = candidate;
+                queue.emplace(candidate, adj[i]);
+            }
+        }
+    }
+    return dist;
+}
+
+/**
+ * @brief Canonical hash key for a scalar property value, if indexable
+ *
+ * Non-negative Int and Uint share one key so a lookup finds a value no
+ * matter which variant the decoder produced; Float keys on the bit
+ * pattern. Containers and other composite values return nullopt and fall
+ * back to a verification scan.
+ */
+inline std::optional<std::string> scalar_index_key(const Value& value) {
+    if (const auto* s = std::get_if<String>(&value)) {
+        return "s:" + *s;
+    }
+    if (const auto* b = std::get_if<Bool>(&value)) {
+        return std::string(*b ? "b:1" : "b:0");
+    }
+    if (const auto* i = std::get_if<Int>(&value)) {
+        if (*i >= 0) {
+            return "u:" + std::to_string(*i);
+        }
+        return "i:" + std::to_string(*i);
+    }
+    if (const auto* u = std::get_if<Uint>(&value)) {
+        return "u:" + std::to_string(*u);
+    }
+    if (const auto* f = std::get_if<Float>(&value)) {
+        uint64_t bits;
+        std::memcpy(&bits, f, 8);
+        return "f:" + std::to_string(bits);
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Property equality with the Int/Uint coercion the decoder applies
+ */
+inline bool property_values_equal(const Value& a, const Value& b) {
+    if (a == b) {
+        return true;
+    }
+    auto key_a = scalar_index_key(a);
+    auto key_b = scalar_index_key(b);
+    return key_a && key_b && *key_a == *key_b;
+}
+
+} // namespace detail
+
+/**
+ * @brief Frozen compressed-sparse-row adjacency
+ *
+ * A read-only snapshot built by Graph::freeze(): nodes become dense
+ * indices, and each node's neighbors (with their weights) occupy one
+ * contiguous run of the neighbor array addressed by an offset table.
+ * Traversal touches sequential memory instead of chasing one hash-map
+ * node per edge, which is what makes BFS over large graphs fast.
+ */
+template<typename NodeId = std::string, typename Weight = double>
+class CsrGraph {
+public:
+    /// Sentinel index for "no node" (unreached parents, unknown ids).
+    static constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+
+    CsrGraph(std::vector<NodeId> ids, std::vector<size_t> offsets,
+             std::vector<uint32_t> neighbors, std::vector<Weight> weights)
+        : ids_(std::move(ids)), offsets_(std::move(offsets)),
+          neighbors_(std::move(neighbors)), weights_(std::move(weights)) {
+        for (uint32_t i = 0; i < ids_.size(); ++i) {
+            index_.emplace(ids_[i], i);
+        }
+    }
+
+    size_t node_count() const { return ids_.size(); }
+    size_t edge_count() const { return neighbors_.size(); }
+
+    const NodeId& id_of(uint32_t index) const { return ids_[index]; }
+
+    /// Dense index of a node id, or kNoNode if absent.
+    uint32_t index_of(const NodeId& id) const {
+        auto it = index_.find(id);
+        return it == index_.end() ? kNoNode : it->second;
+    }
+
+    std::span<const uint32_t> neighbors(uint32_t index) const {
+        return {neighbors_.data() + offsets_[index],
+                offsets_[index + 1] - offsets_[index]};
+    }
+
+    std::span<const Weight> weights(uint32_t index) const {
+        return {weights_.data() + offsets_[index],
+                offsets_[index + 1] - offsets_[index]};
+    }
+
+    /**
+     * @brief BFS parent array from a source index
+     *
+     * parents[v] is the index v was discovered from (the source is its
+     * own parent); unreached nodes hold kNoNode.
+     */
+    std::vector<uint32_t> bfs_parents(uint32_t source) const {
+        return detail::bfs_parents(*this, source);
+    }
+
+    /**
+     * @brief Single-source shortest path distances (non-negative weights)
+     */
+    std::vector<Weight> dijkstra(uint32_t source) const {
+        return detail::dijkstra<Weight>(*this, source);
+    }
+
+    /// Raw CSR arrays, in layout order, for serialization.
+    std::span<const NodeId> ids() const { return ids_; }
+    std::span<const size_t> row_offsets() const { return offsets_; }
+    std::span<const uint32_t> neighbor_indices() const { return neighbors_; }
+    std::span<const Weight> edge_weights() const { return weights_; }
+
+private:
+    std::vector<NodeId> ids_;
+    std::unordered_map<NodeId, uint32_t> index_;
+    std::vector<size_t> offsets_;
+    std::vector<uint32_t> neighbors_;
+    std::vector<Weight> weights_;
+};
+
+template<typename NodeId, typename NodeData, typename Weight>
+void Graph<NodeId, NodeData, Weight>::add_node(const NodeId& id, const NodeData& data) {
+    nodes_.try_emplace(id, NodeType(id, data));
+    adjacency_.try_emplace(id);
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+bool Graph<NodeId, NodeData, Weight>::has_node(const NodeId& id) const {
+    return nodes_.count(id) != 0;
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+typename Graph<NodeId, NodeData, Weight>::NodeType*
+Graph<NodeId, NodeData, Weight>::get_node(const NodeId& id) {
+    auto it = nodes_.find(id);
+    return it == nodes_.end() ? nullptr : &it->second;
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+const typename Graph<NodeId, NodeData, Weight>::NodeType*
+Graph<NodeId, NodeData, Weight>::get_node(const NodeId& id) const {
+    auto it = nodes_.find(id);
+    return it == nodes_.end() ? nullptr : &it->second;
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+void Graph<NodeId, NodeData, Weight>::add_edge(const NodeId& from, const NodeId& to,
+                                               Weight weight) {
+    if (!has_node(from)) add_node(from);
+    if (!has_node(to)) add_node(to);
+    adjacency_[from].emplace_back(to, weight);
+    if (type_ == GraphType::UNDIRECTED) {
+        adjacency_[to].emplace_back(from, weight);
+    }
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+bool Graph<NodeId, NodeData, Weight>::has_edge(const NodeId& from, const NodeId& to) const {
+    auto it = adjacency_.find(from);
+    if (it == adjacency_.end()) {
+        return false;
+    }
+    for (const auto& [neighbor, weight] : it->second) {
+        if (neighbor == to) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+Weight Graph<NodeId, NodeData, Weight>::get_edge_weight(const NodeId& from,
+                                                        const NodeId& to) const {
+    auto it = adjacency_.find(from);
+    if (it != adjacency_.end()) {
+        for (const auto& [neighbor, weight] : it->second) {
+            if (neighbor == to) {
+                return weight;
+            }
+        }
+    }
+    throw BtoonException("Edge not found");
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+size_t Graph<NodeId, NodeData, Weight>::edge_count() const {
+    size_t count = 0;
+    for (const auto& [id, edges] : adjacency_) {
+        count += edges.size();
+    }
+    return type_ == GraphType::UNDIRECTED ? count / 2 : count;
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+size_t Graph<NodeId, NodeData, Weight>::out_degree(const NodeId& node) const {
+    auto it = adjacency_.find(node);
+    return it == adjacency_.end() ? 0 : it->second.size();
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+size_t Graph<NodeId, NodeData, Weight>::degree(const NodeId& node) const {
+    return out_degree(node);
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+std::vector<NodeId> Graph<NodeId, NodeData, Weight>::neighbors(const NodeId& node) const {
+    std::vector<NodeId> result;
+    auto it = adjacency_.find(node);
+    if (it != adjacency_.end()) {
+        result.reserve(it->second.size());
+        for (const auto& [neighbor, weight] : it->second) {
+            result.push_back(neighbor);
+        }
+    }
+    return result;
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+CsrGraph<NodeId, Weight> Graph<NodeId, NodeData, Weight>::freeze() const {
+    std::vector<NodeId> ids;
+    ids.reserve(nodes_.size());
+    for (const auto& [id, node] : nodes_) {
+        ids.push_back(id);
+    }
+    std::sort(ids.begin(), ids.end());
+
+    std::unordered_map<NodeId, uint32_t> index;
+    index.reserve(ids.size());
+    for (uint32_t i = 0; i < ids.size(); ++i) {
+        index.emplace(ids[i], i);
+    }
+
+    std::vector<size_t> offsets(ids.size() + 1, 0);
+    std::vector<uint32_t> neighbors;
+    std::vector<Weight> weights;
+    size_t total_edges = 0;
+    for (const auto& [id, edges] : adjacency_) {
+        total_edges += edges.size();
+    }
+    neighbors.reserve(total_edges);
+    weights.reserve(total_edges);
+    for (uint32_t i = 0; i < ids.size(); ++i) {
+        offsets[i] = neighbors.size();
+        auto it = adjacency_.find(ids[i]);
+        if (it != adjacency_.end()) {
+            for (const auto& [neighbor, weight] : it->second) {
+                neighbors.push_back(index.at(neighbor));
+                weights.push_back(weight);
+            }
+        }
+    }
+    offsets[ids.size()] = neighbors.size();
+    return CsrGraph<NodeId, Weight>(std::move(ids), std::move(offsets),
+                                    std::move(neighbors), std::move(weights));
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+std::unordered_map<NodeId, NodeId>
+Graph<NodeId, NodeData, Weight>::bfs(const NodeId& source) const {
+    std::unordered_map<NodeId, NodeId> parents;
+    auto csr = freeze();
+    uint32_t src = csr.index_of(source);
+    if (src == CsrGraph<NodeId, Weight>::kNoNode) {
+        return parents;
+    }
+    auto parent_indices = csr.bfs_parents(src);
+    for (uint32_t v = 0; v < parent_indices.size(); ++v) {
+        if (parent_indices[v] != CsrGraph<NodeId, Weight>::kNoNode) {
+            parents.emplace(csr.id_of(v), csr.id_of(parent_indices[v]));
+        }
+    }
+    return parents;
+}
+
+template<typename NodeId, typename NodeData, typename Weight>
+std::unordered_map<NodeId, Weight>
+Graph<NodeId, NodeData, Weight>::dijkstra(const NodeId& source) const {
+    std::unordered_map<NodeId, Weight> distances;
+    auto csr = freeze();
+    uint32_t src = csr.index_of(source);
+    if (src == CsrGraph<NodeId, Weight>::kNoNode) {
+        return distances;
+    }
+    auto dist = csr.dijkstra(src);
+    for (uint32_t v = 0; v < dist.size(); ++v) {
+        if (dist[v] != std::numeric_limits<Weight>::max()) {
+            distances.emplace(csr.id_of(v), dist[v]);
+        }
+    }
+    return distances;
+}
+
+/**
+ * Flat binary graph files.
+ *
+ * A CsrGraph snapshot serialized as the CSR arrays themselves — offset
+ * table, neighbor indices, edge weights, plus a sorted node-id string
+ * table — in host byte order with 8-byte aligned sections. A reader
+ * opens the file through MemoryMappedFile and runs the traversal kernels
+ * directly over the mapped arrays: load cost is a 64-byte header check,
+ * not a node-by-node decode through the Value tree. Node and edge
+ * property columns ride along as opaque BTOON-encoded blobs that decode
+ * on demand, so cold start never pays for properties a query does not
+ * touch.
+ */
+namespace csr_file {
+
+constexpr char kCsrFileMagic[8] = {'B', 'T', 'O', 'N', 'C', 'S', 'R', '1'};
+constexpr uint64_t kCsrByteOrderCheck = 0x0102030405060708ULL;
+constexpr size_t kCsrHeaderSize = 64;
+
+namespace detail {
+
+inline void append_raw(std::vector<uint8_t>& out, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+template<typename T>
+inline void append_value(std::vector<uint8_t>& out, T value) {
+    append_raw(out, &value, sizeof(T));
+}
+
+inline void pad_to_alignment(std::vector<uint8_t>& out) {
+    while (out.size() % 8 != 0) {
+        out.push_back(0);
+    }
+}
+
+inline size_t padded(size_t size) {
+    return (size + 7) & ~size_t{7};
+}
+
+} // namespace detail
+
+/**
+ * @brief Serialize a frozen graph into the flat CSR file layout
+ *
+ * Property blobs are stored verbatim; callers typically pass
+ * BTOON-encoded tabular columns keyed by the dense node/edge index.
+ */
+inline std::vector<uint8_t> encode(const CsrGraph<std::string, double>& csr,
+                                   std::span<const uint8_t> node_properties = {},
+                                   std::span<const uint8_t> edge_properties = {}) {
+    const size_t n = csr.node_count();
+    const size_t m = csr.edge_count();
+    size_t id_bytes_size = 0;
+    for (const auto& id : csr.ids()) {
+        id_bytes_size += id.size();
+    }
+
+    std::vector<uint8_t> out;
+    out.reserve(kCsrHeaderSize + (n + 1) * 8 + detail::padded(m * 4) + m * 8 +
+                (n + 1) * 8 + detail::padded(id_bytes_size) +
+                detail::padded(node_properties.size()) + edge_properties.size());
+
+    detail::append_raw(out, kCsrFileMagic, 8);
+    detail::append_value(out, kCsrByteOrderCheck);
+    detail::append_value(out, static_cast<uint64_t>(n));
+    detail::append_value(out, static_cast<uint64_t>(m));
+    detail::append_value(out, static_cast<uint64_t>(id_bytes_size));
+    detail::append_value(out, static_cast<uint64_t>(node_properties.size()));
+    detail::append_value(out, static_cast<uint64_t>(edge_properties.size()));
+    detail::append_value(out, uint64_t{0});  // reserved
+
+    for (size_t offset : csr.row_offsets()) {
+        detail::append_value(out, static_cast<uint64_t>(offset));
+    }
+    detail::append_raw(out, csr.neighbor_indices().data(), m * 4);
+    detail::pad_to_alignment(out);
+    detail::append_raw(out, csr.edge_weights().data(), m * 8);
+
+    uint64_t id_offset = 0;
+    for (const auto& id : csr.ids()) {
+        detail::append_value(out, id_offset);
+        id_offset += id.size();
+    }
+    detail::append_value(out, id_offset);
+    for (const auto& id : csr.ids()) {
+        detail::append_raw(out, id.data(), id.size());
+    }
+    detail::pad_to_alignment(out);
+
+    detail::append_raw(out, node_properties.data(), node_properties.size());
+    detail::pad_to_alignment(out);
+    detail::append_raw(out, edge_properties.data(), edge_properties.size());
+    return out;
+}
+
+/**
+ * @brief Write a frozen graph to a flat CSR file
+ */
+inline void write(const CsrGraph<std::string, double>& csr, const std::string& filename,
+                  std::span<const uint8_t> node_properties = {},
+                  std::span<const uint8_t> edge_properties = {}) {
+    auto bytes = encode(csr, node_properties, edge_properties);
+    std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+        throw BtoonException("Cannot open CSR graph file: " + filename);
+    }
+    stream.write(reinterpret_cast<const char*>(bytes.data()),
+                 static_cast<std::streamsize>(bytes.size()));
+    stream.flush();
+    if (!stream) {
+        throw BtoonException("Failed to write CSR graph file");
+    }
+}
+
+/**
+ * @brief Read-only CSR graph over a mapped buffer
+ *
+ * A non-owning view: when opened over a MemoryMappedFile the file must
+ * outlive the view. open() validates the header and section bounds only
+ * — it never walks the edge arrays, which is what keeps load time flat
+ * regardless of graph size. Node lookup binary-searches the sorted id
+ * table instead of materializing a hash index up front.
+ */
+class MappedCsrGraph {
+public:
+    /// Sentinel index for "no node" (unreached parents, unknown ids).
+    static constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Check whether a buffer starts with a CSR graph header
+     */
+    static bool is_csr_file(std::span<const uint8_t> buffer) {
+        return buffer.size() >= kCsrHeaderSize &&
+               std::memcmp(buffer.data(), kCsrFileMagic, 8) == 0;
+    }
+
+    /**
+     * @brief Open a buffer holding a flat CSR graph
+     * @throws BtoonException if the header or section bounds are invalid
+     */
+    static MappedCsrGraph open(std::span<const uint8_t> buffer) {
+        if (!is_csr_file(buffer)) {
+            throw BtoonException("Not a BTOON CSR graph file");
+        }
+        auto read_u64 = [&](size_t pos) {
+            uint64_t value;
+            std::memcpy(&value, buffer.data() + pos, 8);
+            return value;
+        };
+        if (read_u64(8) != kCsrByteOrderCheck) {
+            throw BtoonException("CSR graph file written with different byte order");
+        }
+        const size_t n = static_cast<size_t>(read_u64(16));
+        const size_t m = static_cast<size_t>(read_u64(24));
+        // Reject counts whose section sizes would wrap before the bounds
+        // checks below run; no valid file can hold more than size/8
+        // nodes or edges anyway.
+        if (n >= buffer.size() / 8 || m > buffer.size() / 8) {
+            throw BtoonException("Truncated CSR graph file");
+        }
+        const size_t id_bytes_size = static_cast<size_t>(read_u64(32));
+        const size_t node_props_size = static_cast<size_t>(read_u64(40));
+        const size_t edge_props_size = static_cast<size_t>(read_u64(48));
+
+        MappedCsrGraph graph;
+        graph.node_count_ = n;
+        graph.edge_count_ = m;
+        size_t pos = kCsrHeaderSize;
+        auto section = [&](size_t size) {
+            if (pos + size > buffer.size() || pos + size < pos) {
+                throw BtoonException("Truncated CSR graph file");
+            }
+            const uint8_t* start = buffer.data() + pos;
+            pos += detail::padded(size);
+            return start;
+        };
+        graph.offsets_ = reinterpret_cast<const uint64_t*>(section((n + 1) * 8));
+        graph.neighbors_ = reinterpret_cast<const uint32_t*>(section(m * 4));
+        graph.weights_ = reinterpret_cast<const double*>(section(m * 8));
+        graph.id_offsets_ = reinterpret_cast<const uint64_t*>(section((n + 1) * 8));
+        graph.id_bytes_ = reinterpret_cast<const char*>(section(id_bytes_size));
+        graph.node_properties_ = {section(node_props_size), node_props_size};
+        graph.edge_properties_ = {section(edge_props_size), edge_props_size};
+        if (graph.offsets_[n] != m || graph.id_offsets_[n] != id_bytes_size) {
+            throw BtoonException("Corrupt CSR graph file");
+        }
+        return graph;
+    }
+
+    /**
+     * @brief Open a memory-mapped file (the file must outlive the view)
+     */
+    static MappedCsrGraph open(const MemoryMappedFile& file) {
+        return open(file.view().span());
+    }
+
+    size_t node_count() const { return node_count_; }
+    size_t edge_count() const { return edge_count_; }
+
+    /// Node id as a view into the mapped string table.
+    std::string_view id_of(uint32_t index) const {
+        return {id_bytes_ + id_offsets_[index],
+                static_cast<size_t>(id_offsets_[index + 1] - id_offsets_[index])};
+    }
+
+    /// Dense index of a node id, or kNoNode if absent. O(log n) over the
+    /// sorted id table — no index is built at load time.
+    uint32_t index_of(std::string_view id) const {
+        size_t lo = 0;
+        size_t hi = node_count_;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (id_of(static_cast<uint32_t>(mid)) < id) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo < node_count_ && id_of(static_cast<uint32_t>(lo)) == id) {
+            return static_cast<uint32_t>(lo);
+        }
+        return kNoNode;
+    }
+
+    std::span<const uint32_t> neighbors(uint32_t index) const {
+        return {neighbors_ + offsets_[index],
+                static_cast<size_t>(offsets_[index + 1] - offsets_[index])};
+    }
+
+    std::span<const double> weights(uint32_t index) const {
+        return {weights_ + offsets_[index],
+                static_cast<size_t>(offsets_[index + 1] - offsets_[index])};
+    }
+
+    /// BFS parent array from a source index (same kernel as CsrGraph).
+    std::vector<uint32_t> bfs_parents(uint32_t source) const {
+        return graph::detail::bfs_parents(*this, source);
+    }
+
+    /// Single-source shortest path distances (non-negative weights).
+    std::vector<double> dijkstra(uint32_t source) const {
+        return graph::detail::dijkstra<double>(*this, source);
+    }
+
+    /// BTOON-encoded property blobs, verbatim as written; empty if the
+    /// file carries none. Decode on demand with a Decoder.
+    std::span<const uint8_t> node_properties() const { return node_properties_; }
+    std::span<const uint8_t> edge_properties() const { return edge_properties_; }
+
+private:
+    MappedCsrGraph() = default;
+
+    size_t node_count_ = 0;
+    size_t edge_count_ = 0;
+    const uint64_t* offsets_ = nullptr;
+    const uint32_t* neighbors_ = nullptr;
+    const double* weights_ = nullptr;
+    const uint64_t* id_offsets_ = nullptr;
+    const char* id_bytes_ = nullptr;
+    std::span<const uint8_t> node_properties_;
+    std::span<const uint8_t> edge_properties_;
+};
+
+} // namespace csr_file
+
 /**
  * @brief Specialized tree structure
  */
@@ -224,9 +866,27 @@ public:
         std::unordered_map<std::string, Value> properties;
     };
     
+    /**
+     * Patterns alternate node, edge, node, ... (odd length, node at both
+     * ends). Each match binds "node0", "edge0", "node1", ... to the ids
+     * along the path. The matcher anchors at the most selective node
+     * pattern — smallest label or indexed-property bucket — and expands
+     * outward, so a label + indexed-property constraint never scans the
+     * whole node set.
+     */
     std::vector<std::unordered_map<std::string, Value>> match_pattern(
         const std::vector<Pattern>& patterns) const;
-    
+
+    /**
+     * @brief Build (or rebuild) a hash index over one node property key
+     *
+     * Indexed keys are maintained on add_node and update_node_property
+     * and consulted by query_nodes and match_pattern. Only scalar values
+     * (String, Bool, Int, Uint, Float) are indexed; rows whose value for
+     * the key is composite or absent simply stay out of the index.
+     */
+    void create_node_property_index(const std::string& key);
+
     // Graph algorithms on property graphs
     std::vector<PropertyNode> shortest_path_with_properties(
         const std::string& from,
@@ -238,11 +898,386 @@ public:
     static PropertyGraph from_btoon(const Value& value);
     
 private:
+    using IdList = std::vector<std::string>;
+
+    void index_node(const PropertyNode& node);
+    void deindex_node(const PropertyNode& node);
+    bool node_matches(const PropertyNode& node, const Pattern& pattern) const;
+    bool edge_matches(const PropertyEdge& edge, const Pattern& pattern) const;
+    std::vector<const PropertyNode*> node_candidates(const Pattern& pattern) const;
+    size_t candidate_estimate(const Pattern& pattern) const;
+
     std::unordered_map<std::string, PropertyNode> nodes_;
     std::unordered_map<std::string, PropertyEdge> edges_;
     std::unordered_map<std::string, std::vector<std::string>> node_edges_;
+
+    // Secondary indexes: label -> node ids, and per indexed property key,
+    // canonical value key -> node ids.
+    std::unordered_map<std::string, IdList> label_index_;
+    std::unordered_map<std::string, std::unordered_map<std::string, IdList>>
+        node_property_index_;
 };
 
+inline void PropertyGraph::index_node(const PropertyNode& node) {
+    label_index_[node.label].push_back(node.id);
+    for (auto& [key, buckets] : node_property_index_) {
+        auto prop = node.properties.find(key);
+        if (prop == node.properties.end()) {
+            continue;
+        }
+        if (auto index_key = detail::scalar_index_key(prop->second)) {
+            buckets[*index_key].push_back(node.id);
+        }
+    }
+}
+
+inline void PropertyGraph::deindex_node(const PropertyNode& node) {
+    auto scrub = [&](IdList& bucket) {
+        bucket.erase(std::remove(bucket.begin(), bucket.end(), node.id), bucket.end());
+    };
+    auto label_it = label_index_.find(node.label);
+    if (label_it != label_index_.end()) {
+        scrub(label_it->second);
+    }
+    for (auto& [key, buckets] : node_property_index_) {
+        auto prop = node.properties.find(key);
+        if (prop == node.properties.end()) {
+            continue;
+        }
+        if (auto index_key = detail::scalar_index_key(prop->second)) {
+            auto bucket = buckets.find(*index_key);
+            if (bucket != buckets.end()) {
+                scrub(bucket->second);
+            }
+        }
+    }
+}
+
+inline void PropertyGraph::add_node(const PropertyNode& node) {
+    auto it = nodes_.find(node.id);
+    if (it != nodes_.end()) {
+        deindex_node(it->second);
+        it->second = node;
+    } else {
+        it = nodes_.emplace(node.id, node).first;
+        node_edges_.try_emplace(node.id);
+    }
+    index_node(it->second);
+}
+
+inline void PropertyGraph::add_edge(const PropertyEdge& edge) {
+    if (nodes_.find(edge.from) == nodes_.end()) {
+        add_node(PropertyNode{edge.from, {}, {}});
+    }
+    if (nodes_.find(edge.to) == nodes_.end()) {
+        add_node(PropertyNode{edge.to, {}, {}});
+    }
+    edges_[edge.id] = edge;
+    node_edges_[edge.from].push_back(edge.id);
+    if (edge.to != edge.from) {
+        node_edges_[edge.to].push_back(edge.id);
+    }
+}
+
+inline void PropertyGraph::update_node_property(const std::string& node_id,
+                                                const std::string& key,
+                                                const Value& value) {
+    auto it = nodes_.find(node_id);
+    if (it == nodes_.end()) {
+        throw BtoonException("Node not found: " + node_id);
+    }
+    auto index_it = node_property_index_.find(key);
+    if (index_it != node_property_index_.end()) {
+        auto prop = it->second.properties.find(key);
+        if (prop != it->second.properties.end()) {
+            if (auto old_key = detail::scalar_index_key(prop->second)) {
+                auto bucket = index_it->second.find(*old_key);
+                if (bucket != index_it->second.end()) {
+                    auto& ids = bucket->second;
+                    ids.erase(std::remove(ids.begin(), ids.end(), node_id), ids.end());
+                }
+            }
+        }
+        if (auto new_key = detail::scalar_index_key(value)) {
+            index_it->second[*new_key].push_back(node_id);
+        }
+    }
+    it->second.properties[key] = value;
+}
+
+inline void PropertyGraph::update_edge_property(const std::string& edge_id,
+                                                const std::string& key,
+                                                const Value& value) {
+    auto it = edges_.find(edge_id);
+    if (it == edges_.end()) {
+        throw BtoonException("Edge not found: " + edge_id);
+    }
+    it->second.properties[key] = value;
+}
+
+inline void PropertyGraph::create_node_property_index(const std::string& key) {
+    auto& buckets = node_property_index_[key];
+    buckets.clear();
+    for (const auto& [id, node] : nodes_) {
+        auto prop = node.properties.find(key);
+        if (prop == node.properties.end()) {
+            continue;
+        }
+        if (auto index_key = detail::scalar_index_key(prop->second)) {
+            buckets[*index_key].push_back(id);
+        }
+    }
+}
+
+inline std::vector<PropertyGraph::PropertyNode> PropertyGraph::query_nodes(
+    const std::unordered_map<std::string, Value>& criteria) const {
+    std::vector<PropertyNode> result;
+    // Most selective indexed criterion; an indexed key with no bucket
+    // means no node can match at all.
+    const IdList* best_bucket = nullptr;
+    for (const auto& [key, value] : criteria) {
+        auto index_it = node_property_index_.find(key);
+        if (index_it == node_property_index_.end()) {
+            continue;
+        }
+        auto index_key = detail::scalar_index_key(value);
+        if (!index_key) {
+            continue;
+        }
+        auto bucket = index_it->second.find(*index_key);
+        if (bucket == index_it->second.end()) {
+            return result;
+        }
+        if (!best_bucket || bucket->second.size() < best_bucket->size()) {
+            best_bucket = &bucket->second;
+        }
+    }
+    auto matches = [&](const PropertyNode& node) {
+        for (const auto& [key, value] : criteria) {
+            auto prop = node.properties.find(key);
+            if (prop == node.properties.end() ||
+                !detail::property_values_equal(prop->second, value)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (best_bucket) {
+        for (const auto& id : *best_bucket) {
+            const auto& node = nodes_.at(id);
+            if (matches(node)) {
+                result.push_back(node);
+            }
+        }
+    } else {
+        for (const auto& [id, node] : nodes_) {
+            if (matches(node)) {
+                result.push_back(node);
+            }
+        }
+    }
+    return result;
+}
+
+inline std::vector<PropertyGraph::PropertyEdge> PropertyGraph::query_edges(
+    const std::unordered_map<std::string, Value>& criteria) const {
+    std::vector<PropertyEdge> result;
+    for (const auto& [id, edge] : edges_) {
+        bool matches = true;
+        for (const auto& [key, value] : criteria) {
+            auto prop = edge.properties.find(key);
+            if (prop == edge.properties.end() ||
+                !detail::property_values_equal(prop->second, value)) {
+                matches = false;
+                break;
+            }
+        }
+        if (matches) {
+            result.push_back(edge);
+        }
+    }
+    return result;
+}
+
+inline bool PropertyGraph::node_matches(const PropertyNode& node,
+                                        const Pattern& pattern) const {
+    if (pattern.node_label && node.label != *pattern.node_label) {
+        return false;
+    }
+    for (const auto& [key, value] : pattern.properties) {
+        auto prop = node.properties.find(key);
+        if (prop == node.properties.end() ||
+            !detail::property_values_equal(prop->second, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool PropertyGraph::edge_matches(const PropertyEdge& edge,
+                                        const Pattern& pattern) const {
+    if (pattern.edge_type && edge.type != *pattern.edge_type) {
+        return false;
+    }
+    for (const auto& [key, value] : pattern.properties) {
+        auto prop = edge.properties.find(key);
+        if (prop == edge.properties.end() ||
+            !detail::property_values_equal(prop->second, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline size_t PropertyGraph::candidate_estimate(const Pattern& pattern) const {
+    size_t best = nodes_.size();
+    if (pattern.node_label) {
+        auto it = label_index_.find(*pattern.node_label);
+        best = std::min(best, it == label_index_.end() ? size_t{0} : it->second.size());
+    }
+    for (const auto& [key, value] : pattern.properties) {
+        auto index_it = node_property_index_.find(key);
+        if (index_it == node_property_index_.end()) {
+            continue;
+        }
+        auto index_key = detail::scalar_index_key(value);
+        if (!index_key) {
+            continue;
+        }
+        auto bucket = index_it->second.find(*index_key);
+        best = std::min(best,
+                        bucket == index_it->second.end() ? size_t{0} : bucket->second.size());
+    }
+    return best;
+}
+
+inline std::vector<const PropertyGraph::PropertyNode*>
+PropertyGraph::node_candidates(const Pattern& pattern) const {
+    std::vector<const PropertyNode*> result;
+    const IdList* bucket = nullptr;
+    if (pattern.node_label) {
+        auto it = label_index_.find(*pattern.node_label);
+        if (it == label_index_.end()) {
+            return result;
+        }
+        bucket = &it->second;
+    }
+    for (const auto& [key, value] : pattern.properties) {
+        auto index_it = node_property_index_.find(key);
+        if (index_it == node_property_index_.end()) {
+            continue;
+        }
+        auto index_key = detail::scalar_index_key(value);
+        if (!index_key) {
+            continue;
+        }
+        auto candidate = index_it->second.find(*index_key);
+        if (candidate == index_it->second.end()) {
+            return result;
+        }
+        if (!bucket || candidate->second.size() < bucket->size()) {
+            bucket = &candidate->second;
+        }
+    }
+    if (bucket) {
+        for (const auto& id : *bucket) {
+            const auto& node = nodes_.at(id);
+            if (node_matches(node, pattern)) {
+                result.push_back(&node);
+            }
+        }
+    } else {
+        for (const auto& [id, node] : nodes_) {
+            if (node_matches(node, pattern)) {
+                result.push_back(&node);
+            }
+        }
+    }
+    return result;
+}
+
+inline std::vector<std::unordered_map<std::string, Value>>
+PropertyGraph::match_pattern(const std::vector<Pattern>& patterns) const {
+    std::vector<std::unordered_map<std::string, Value>> results;
+    if (patterns.empty() || patterns.size() % 2 == 0) {
+        return results;
+    }
+    const size_t num_nodes = patterns.size() / 2 + 1;
+
+    // Anchor the walk at the node pattern with the fewest candidates and
+    // expand along the chain in both directions from there.
+    size_t anchor = 0;
+    size_t best = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i < num_nodes; ++i) {
+        size_t estimate = candidate_estimate(patterns[2 * i]);
+        if (estimate < best) {
+            best = estimate;
+            anchor = i;
+        }
+    }
+
+    std::vector<std::string> node_ids(num_nodes);
+    std::vector<std::string> edge_ids(num_nodes - 1);
+    std::function<void(size_t)> extend_left;
+    std::function<void(size_t)> extend_right = [&](size_t i) {
+        if (i + 1 == num_nodes) {
+            extend_left(anchor);
+            return;
+        }
+        auto edges_at = node_edges_.find(node_ids[i]);
+        if (edges_at == node_edges_.end()) {
+            return;
+        }
+        for (const auto& edge_id : edges_at->second) {
+            const auto& edge = edges_.at(edge_id);
+            if (edge.from != node_ids[i] || !edge_matches(edge, patterns[2 * i + 1])) {
+                continue;
+            }
+            if (!node_matches(nodes_.at(edge.to), patterns[2 * (i + 1)])) {
+                continue;
+            }
+            edge_ids[i] = edge_id;
+            node_ids[i + 1] = edge.to;
+            extend_right(i + 1);
+        }
+    };
+    extend_left = [&](size_t i) {
+        if (i == 0) {
+            std::unordered_map<std::string, Value> binding;
+            for (size_t v = 0; v < num_nodes; ++v) {
+                binding.emplace("node" + std::to_string(v), Value(String(node_ids[v])));
+            }
+            for (size_t e = 0; e + 1 < num_nodes; ++e) {
+                binding.emplace("edge" + std::to_string(e), Value(String(edge_ids[e])));
+            }
+            results.push_back(std::move(binding));
+            return;
+        }
+        auto edges_at = node_edges_.find(node_ids[i]);
+        if (edges_at == node_edges_.end()) {
+            return;
+        }
+        for (const auto& edge_id : edges_at->second) {
+            const auto& edge = edges_.at(edge_id);
+            if (edge.to != node_ids[i] || !edge_matches(edge, patterns[2 * i - 1])) {
+                continue;
+            }
+            if (!node_matches(nodes_.at(edge.from), patterns[2 * (i - 1)])) {
+                continue;
+            }
+            edge_ids[i - 1] = edge_id;
+            node_ids[i - 1] = edge.from;
+            extend_left(i - 1);
+        }
+    };
+
+    for (const PropertyNode* candidate : node_candidates(patterns[2 * anchor])) {
+        node_ids[anchor] = candidate->id;
+        extend_right(anchor);
+    }
+    return results;
+}
+
 /**
  * @brief Graph layout algorithms for visualization
  */
@@ -324,6 +1359,48 @@ public:
         const Graph<NodeId, NodeData, Weight>& graph);
 };
 
+template<typename NodeId, typename NodeData, typename Weight>
+std::unordered_map<NodeId, double> GraphMetrics::pagerank(
+    const Graph<NodeId, NodeData, Weight>& graph, double damping, size_t iterations) {
+    // Runs against the frozen CSR snapshot: each iteration is two passes
+    // over contiguous arrays instead of a hash-map walk per edge.
+    auto csr = graph.freeze();
+    size_t n = csr.node_count();
+    std::unordered_map<NodeId, double> result;
+    if (n == 0) {
+        return result;
+    }
+
+    std::vector<double> ranks(n, 1.0 / static_cast<double>(n));
+    std::vector<double> next(n);
+    for (size_t iter = 0; iter < iterations; ++iter) {
+        double dangling = 0.0;
+        std::fill(next.begin(), next.end(), (1.0 - damping) / static_cast<double>(n));
+        for (uint32_t u = 0; u < n; ++u) {
+            auto adj = csr.neighbors(u);
+            if (adj.empty()) {
+                dangling += ranks[u];
+                continue;
+            }
+            double share = damping * ranks[u] / static_cast<double>(adj.size());
+            for (uint32_t v : adj) {
+                next[v] += share;
+            }
+        }
+        double dangling_share = damping * dangling / static_cast<double>(n);
+        for (double& rank : next) {
+            rank += dangling_share;
+        }
+        ranks.swap(next);
+    }
+
+    result.reserve(n);
+    for (uint32_t v = 0; v < n; ++v) {
+        result.emplace(csr.id_of(v), ranks[v]);
+    }
+    return result;
+}
+
 // ============= Utility Functions =============
 
 /**
@@ -10,6 +10,7 @@
 #define BTOON_GRAPHQL_SCHEMA_H
 
 #include "btoon/schema.h"
+#include <functional>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -125,7 +126,8 @@ public:
         std::string id_field_name = "id";
     };
     
-    BtoonToGraphQL(const ConversionOptions& options = ConversionOptions{});
+    BtoonToGraphQL();
+    explicit BtoonToGraphQL(const ConversionOptions& options);
     
     /**
      * @brief Convert BTOON schema to GraphQL schema
@@ -163,7 +165,8 @@ public:
         bool generate_validators = true;
     };
     
-    GraphQLToBtoon(const ConversionOptions& options = ConversionOptions{});
+    GraphQLToBtoon();
+    explicit GraphQLToBtoon(const ConversionOptions& options);
     
     /**
      * @brief Convert GraphQL schema to BTOON schema
@@ -186,6 +189,43 @@ private:
     GraphQLSchema parse_sdl_internal(const std::string& sdl);
 };
 
+/**
+ * @brief Generates typed C++ structs with encode/decode from GraphQL types
+ *
+ * Emits, for every OBJECT type in a schema, a plain struct whose fields
+ * follow the schema's declared order plus an encodeTo(Encoder&) that
+ * writes the map header and per-field keys as string_view literals —
+ * no Value variant, no runtime key construction — and a decodeFrom()
+ * that pulls fields out of an encoded buffer through DocumentCursor
+ * without materializing a Value tree. ENUM types become enum classes
+ * encoded as integers. Generated code depends only on the public
+ * Encoder/DocumentCursor primitives.
+ */
+class StructCodegen {
+public:
+    struct Options {
+        std::string namespace_name = "btoon_gen";
+        bool generate_decode = true;    // Emit decodeFrom() alongside encodeTo()
+    };
+
+    StructCodegen();
+    explicit StructCodegen(const Options& options);
+
+    /**
+     * @brief Generate a self-contained header for all OBJECT/ENUM types
+     *
+     * Structs are emitted in dependency order so nested object fields are
+     * complete types.
+     *
+     * @throws BtoonException on a field referencing an unknown type or on
+     *         cyclic object composition (which has no by-value layout)
+     */
+    std::string generate(const GraphQLSchema& schema) const;
+
+private:
+    Options options_;
+};
+
 /**
  * @brief GraphQL query executor for BTOON data
  */
@@ -250,7 +290,7 @@ public:
 private:
     GraphQLSchema schema_;
     std::unordered_map<std::string, std::vector<std::pair<std::string, Callback>>> subscriptions_;
-    std::unordered_map<std::string, ParsedQuery> subscription_queries_;
+    std::unordered_map<std::string, std::string> subscription_queries_;
 };
 
 /**
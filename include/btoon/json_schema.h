@@ -158,7 +158,8 @@ public:
     std::string to_json(bool pretty = true) const;
     static JsonSchema from_json(const std::string& json);
     
-    // Validation
+    // Validation. Compiles the schema on every call; hot paths should
+    // build a JsonSchemaValidator once and reuse it.
     bool validate(const Value& data, std::vector<std::string>& errors) const;
     
 private:
@@ -185,7 +186,8 @@ public:
         bool preserve_btoon_types = true;   // Preserve BTOON-specific types as extensions
     };
     
-    BtoonToJsonSchema(const ConversionOptions& options = ConversionOptions{});
+    BtoonToJsonSchema();
+    explicit BtoonToJsonSchema(const ConversionOptions& options);
     
     /**
      * @brief Convert BTOON schema to JSON Schema
@@ -221,7 +223,8 @@ public:
         bool infer_btoon_types = true;     // Infer BTOON-specific types from formats
     };
     
-    JsonSchemaToBtoon(const ConversionOptions& options = ConversionOptions{});
+    JsonSchemaToBtoon();
+    explicit JsonSchemaToBtoon(const ConversionOptions& options);
     
     /**
      * @brief Convert JSON Schema to BTOON schema
@@ -250,16 +253,35 @@ private:
 
 /**
  * @brief JSON Schema validator for BTOON data
+ *
+ * The constructor compiles the schema once: $refs are resolved against
+ * the document's definitions, pattern/patternProperties regexes and
+ * format checkers are precompiled, and constraints are flattened into a
+ * node list evaluated in document order. Validating a document never
+ * touches the JsonSchemaProperty tree again, so one validator instance
+ * can be reused across many documents (and from many threads — the
+ * compiled program is immutable).
  */
 class JsonSchemaValidator {
 public:
+    /**
+     * @brief Compile @p schema into a reusable validation program
+     *
+     * @throws BtoonException on an unresolvable $ref
+     */
     JsonSchemaValidator(const JsonSchema& schema);
-    
+    ~JsonSchemaValidator();
+
+    JsonSchemaValidator(JsonSchemaValidator&&) noexcept;
+    JsonSchemaValidator& operator=(JsonSchemaValidator&&) noexcept;
+    JsonSchemaValidator(const JsonSchemaValidator&) = delete;
+    JsonSchemaValidator& operator=(const JsonSchemaValidator&) = delete;
+
     /**
      * @brief Validate BTOON value against JSON Schema
      */
     bool validate(const Value& value, std::vector<std::string>& errors) const;
-    
+
     /**
      * @brief Validate with detailed error reporting
      */
@@ -269,25 +291,13 @@ public:
         std::string schema_path;
         Value invalid_value;
     };
-    
-    bool validate_detailed(const Value& value, 
+
+    bool validate_detailed(const Value& value,
                           std::vector<ValidationError>& errors) const;
-    
+
 private:
-    JsonSchema schema_;
-    
-    bool validate_property(const Value& value,
-                          const JsonSchemaProperty& prop,
-                          const std::string& path,
-                          std::vector<ValidationError>& errors) const;
-    
-    bool validate_type(const Value& value, 
-                      const std::vector<JsonSchemaType>& types) const;
-    
-    bool validate_constraints(const Value& value,
-                            const JsonSchemaProperty& prop,
-                            const std::string& path,
-                            std::vector<ValidationError>& errors) const;
+    class ValidatorImpl;
+    std::unique_ptr<ValidatorImpl> pimpl_;
 };
 
 /**
@@ -15,10 +15,12 @@
 #ifndef BTOON_MEMORY_POOL_H
 #define BTOON_MEMORY_POOL_H
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <vector>
 #include <memory>
-#include <stack>
+#include <mutex>
 #include <cstdint>
 
 namespace btoon {
@@ -28,7 +30,7 @@ namespace btoon {
  * 
  * Features:
  * - SIMD-aligned allocations (32-byte alignment for AVX2)
- * - Block reuse through free list
+ * - Chunk reuse through size-class segregated free lists
  * - Configurable growth strategy
  * - Thread-safe option (disabled by default)
  */
@@ -37,7 +39,27 @@ public:
     static constexpr size_t SIMD_ALIGNMENT = 32;  // 32-byte alignment for AVX2
     static constexpr size_t DEFAULT_BLOCK_SIZE = 65536;  // 64KB default block
 
-    explicit MemoryPool(size_t initial_size = DEFAULT_BLOCK_SIZE);
+    /**
+     * @brief Free-list statistics for one power-of-two size class
+     */
+    struct SizeClassStats {
+        size_t min_size = 0;      // Smallest chunk size binned here
+        size_t max_size = 0;      // Largest (inclusive; SIZE_MAX for the top class)
+        size_t free_chunks = 0;   // Chunks currently waiting for reuse
+        size_t free_bytes = 0;    // Bytes across those chunks
+        size_t reuses = 0;        // Allocations served from this class so far
+    };
+
+    /**
+     * @param initial_size Size of the first block in bytes.
+     * @param prefault When true, every new block is touched page by page as
+     *        soon as it is allocated. On NUMA hosts the kernel binds a page to
+     *        the node of the thread that first writes it, so a pool created on
+     *        a pinned worker thread gets node-local memory instead of faulting
+     *        pages in lazily from whichever thread happens to use them first.
+     */
+    explicit MemoryPool(size_t initial_size = DEFAULT_BLOCK_SIZE,
+                        bool prefault = false);
     ~MemoryPool();
 
     // Non-copyable, non-movable
@@ -75,6 +97,16 @@ public:
      */
     void reset();
 
+    /**
+     * @brief Per-size-class free-list statistics, smallest class first
+     *
+     * Freed chunks are binned by power-of-two size class (32 bytes up to
+     * 1 MB, with everything larger in the top class), so the returned
+     * vector shows where free space is accumulating and which classes are
+     * actually being recycled.
+     */
+    std::vector<SizeClassStats> size_class_stats() const;
+
 private:
     struct Block {
         std::unique_ptr<uint8_t[], decltype(&std::free)> data;
@@ -90,18 +122,159 @@ private:
         FreeChunk(void* p, size_t s) : ptr(p), size(s) {}
     };
     
+    // Power-of-two size classes for the segregated free lists: class k bins
+    // chunks of size [2^(k+kMinClassShift), 2^(k+kMinClassShift+1)), except
+    // the top class which also takes everything larger. A chunk in class k
+    // is therefore always big enough for any request that rounds up into
+    // class k or below, so allocation pops in O(1) without a first-fit scan
+    // (only oversized requests scan the top class).
+    static constexpr size_t kMinClassShift = 5;   // 32 bytes = SIMD_ALIGNMENT
+    static constexpr size_t kMaxClassShift = 20;  // 1 MB = largest block size
+    static constexpr size_t kNumClasses = kMaxClassShift - kMinClassShift + 1;
+    // Split a reused chunk when the leftover is at least this big.
+    static constexpr size_t kSplitThreshold = 64;
+
+    static size_t floor_class(size_t size);
+
     void* allocate_from_block(size_t size);
     void new_block(size_t min_size);
     void* align_ptr(void* ptr, size_t alignment);
-    
+    void bin_chunk(void* ptr, size_t size);
+    void* take_from_bins(size_t aligned_size);
+
     std::vector<Block> blocks_;
-    std::stack<FreeChunk> free_list_;
-    
+    std::array<std::vector<FreeChunk>, kNumClasses> bins_;
+    std::array<size_t, kNumClasses> bin_reuses_{};
+
     uint8_t* current_pos_;
     size_t remaining_;
     size_t block_size_;
     size_t total_allocated_;
     size_t current_usage_;
+    bool prefault_;
+};
+
+/**
+ * @brief Thread-safe memory pool with per-thread magazine caches.
+ *
+ * Lets N threads share one arena without a mutex on the hot path: each
+ * thread owns a small cache holding a private bump region (a slab carved
+ * from the shared arena) and a magazine of freed chunks. allocate() serves
+ * from the magazine or the slab without synchronization and only takes the
+ * shared lock to refill the slab or to satisfy an oversized request;
+ * deallocate() pushes into the calling thread's magazine — freeing memory
+ * allocated by another thread is fine, chunks are plain (pointer, size)
+ * records — and spills half the magazine back to the shared free list when
+ * it fills up, so free space migrates between threads instead of stranding.
+ *
+ * Caches are owned by the pool, so chunks cached by an exited thread are
+ * reclaimed when the pool is destroyed. The pool must outlive all threads
+ * that use it; there is deliberately no reset(), since no thread can know
+ * when the others' cached pointers die.
+ */
+class SharedMemoryPool {
+public:
+    explicit SharedMemoryPool(size_t initial_size = MemoryPool::DEFAULT_BLOCK_SIZE,
+                              bool prefault = false);
+    ~SharedMemoryPool();
+
+    // Non-copyable, non-movable (caches hold pointers into the arena)
+    SharedMemoryPool(const SharedMemoryPool&) = delete;
+    SharedMemoryPool& operator=(const SharedMemoryPool&) = delete;
+    SharedMemoryPool(SharedMemoryPool&&) = delete;
+    SharedMemoryPool& operator=(SharedMemoryPool&&) = delete;
+
+    /**
+     * @brief Allocate aligned memory (thread-safe, usually lock-free)
+     * @param size Number of bytes to allocate
+     * @return Pointer aligned to MemoryPool::SIMD_ALIGNMENT
+     */
+    void* allocate(size_t size);
+
+    /**
+     * @brief Return memory for reuse (thread-safe, any thread may free)
+     */
+    void deallocate(void* ptr, size_t size);
+
+    /**
+     * @brief Total memory reserved from the system by the shared arena
+     */
+    size_t total_allocated() const;
+
+    /**
+     * @brief Bytes currently handed out across all threads
+     */
+    size_t current_usage() const {
+        return current_usage_.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Slabs are carved from the shared arena and bumped through privately;
+    // magazines buffer this thread's frees until they spill to the arena.
+    static constexpr size_t kSlabSize = 16 * 1024;
+    static constexpr size_t kMagazineCapacity = 64;
+
+    struct CachedChunk {
+        void* ptr;
+        size_t size;
+    };
+
+    struct ThreadCache {
+        uint8_t* slab_pos = nullptr;
+        size_t slab_remaining = 0;
+        std::vector<CachedChunk> magazine;
+    };
+
+    ThreadCache& local_cache();
+
+    const uint64_t id_;  // Globally unique; lets thread-local slots outlive us safely
+    mutable std::mutex mutex_;
+    MemoryPool arena_;  // Guarded by mutex_
+    std::vector<std::unique_ptr<ThreadCache>> caches_;  // Guarded by mutex_
+    std::atomic<size_t> current_usage_{0};
+};
+
+/**
+ * @brief Standard-conforming allocator adapter over MemoryPool.
+ *
+ * Lets STL containers draw their element and node storage from a MemoryPool
+ * arena, so an entire decoded message can live in one pool and be released
+ * with a single MemoryPool::reset(). The allocator is stateful and holds a
+ * non-owning pointer to the pool; the pool must outlive every container that
+ * uses it.
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(MemoryPool* pool) noexcept : pool_(pool) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool()) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(pool_->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        pool_->deallocate(ptr, n * sizeof(T));
+    }
+
+    MemoryPool* pool() const noexcept { return pool_; }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept {
+        return pool_ == other.pool();
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept {
+        return pool_ != other.pool();
+    }
+
+private:
+    MemoryPool* pool_;
 };
 
 } // namespace btoon
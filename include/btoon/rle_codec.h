@@ -11,6 +11,22 @@ class RleCodec {
 public:
     static std::vector<uint8_t> encode(const Array& data);
     static Array decode(const std::vector<uint8_t>& data);
+
+    /**
+     * @brief RLE for raw byte buffers (bitmap, boolean and enum columns)
+     *
+     * Output is a sequence of [varint run length][byte] pairs, so a
+     * megabyte run of zeros costs four bytes. Run boundaries are found by
+     * comparing whole 16/32-byte blocks against the run byte instead of
+     * scanning byte by byte.
+     */
+    static std::vector<uint8_t> encode_bytes(std::span<const uint8_t> data);
+
+    /**
+     * @brief Decode encode_bytes output
+     * @throws BtoonException on truncated input
+     */
+    static std::vector<uint8_t> decode_bytes(const std::vector<uint8_t>& data);
 };
 
 } // namespace btoon
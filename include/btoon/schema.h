@@ -96,6 +96,40 @@ enum class EvolutionStrategy {
     FLEXIBLE          // Any changes allowed with migrations
 };
 
+/**
+ * @brief Flat, precompiled validation program for one schema version
+ *
+ * Schema::compile() lowers the field list into a linear instruction
+ * array: one entry per field carrying a numeric type tag, the required
+ * flag, and constraints resolved ahead of time (numeric bounds unpacked
+ * from the constraint map, patterns compiled to std::regex once, enum
+ * lists copied out). validate() executes that array in a tight loop and
+ * short-circuits on the first violation without building error strings;
+ * validateWithErrors() produces the same messages as the interpreted
+ * path.
+ */
+class CompiledSchema {
+public:
+    ~CompiledSchema();
+
+    // Move semantics
+    CompiledSchema(CompiledSchema&&) noexcept;
+    CompiledSchema& operator=(CompiledSchema&&) noexcept;
+
+    // Delete copy semantics
+    CompiledSchema(const CompiledSchema&) = delete;
+    CompiledSchema& operator=(const CompiledSchema&) = delete;
+
+    bool validate(const Value& value) const;
+    std::vector<std::string> validateWithErrors(const Value& value) const;
+
+private:
+    friend class SchemaImpl;
+    class Program;
+    explicit CompiledSchema(std::unique_ptr<Program> program);
+    std::unique_ptr<Program> program_;
+};
+
 /**
  * @brief Main Schema class with versioning support
  */
@@ -116,10 +150,20 @@ public:
     Schema(const Schema&) = delete;
     Schema& operator=(const Schema&) = delete;
     
-    // Validation
+    // Validation. Both entry points run the compiled program; the first
+    // call after a field or strategy change pays the one-time compile.
     bool validate(const Value& value) const;
     std::vector<std::string> validateWithErrors(const Value& value) const;
-    
+
+    /**
+     * @brief Compile the schema into a flat validation program
+     *
+     * The program is built once and cached until a field or the evolution
+     * strategy changes, so registered schemas validate repeatedly without
+     * re-dispatching on type strings or recompiling constraint patterns.
+     */
+    std::shared_ptr<const CompiledSchema> compile() const;
+
     // Version management
     SchemaVersion getVersion() const;
     std::string getName() const;
@@ -162,6 +206,13 @@ private:
 
 /**
  * @brief Schema Registry for managing multiple schema versions
+ *
+ * Safe for concurrent use: lookups read an immutable published snapshot
+ * without taking a lock, so decoder threads validating at high QPS never
+ * serialize on the registry. Registration and removal copy the table and
+ * publish a new snapshot under a writer mutex — rare-and-slow by design.
+ * Registered schemas are treated as immutable once published; mutate a
+ * copy and re-register to change one.
  */
 class SchemaRegistry {
 public:
@@ -185,7 +236,17 @@ public:
     std::shared_ptr<Schema> getSchema(const std::string& name, const SchemaVersion& version) const;
     std::vector<SchemaVersion> getVersions(const std::string& name) const;
     std::shared_ptr<Schema> getLatestSchema(const std::string& name) const;
-    
+
+    /**
+     * @brief Compiled validation program for a registered schema
+     *
+     * Programs are cached per schema version; repeat calls return the
+     * same instance. Returns nullptr for unknown names/versions.
+     */
+    std::shared_ptr<const CompiledSchema> getCompiledSchema(const std::string& name) const;
+    std::shared_ptr<const CompiledSchema> getCompiledSchema(const std::string& name,
+                                                            const SchemaVersion& version) const;
+
     // Validation with auto-detection
     bool validate(const Value& value) const;
     std::pair<bool, std::string> validateWithSchema(const Value& value) const;
@@ -265,6 +326,10 @@ struct InferenceOptions {
     size_t max_enum_values = 10;        // Max unique values to consider as enum
     bool infer_patterns = true;         // Try to detect string patterns
     bool merge_numeric_types = true;    // Treat int/uint/float as compatible
+    bool reservoir_sampling = false;    // Sample uniformly across the input instead of a prefix
+    uint64_t sampling_seed = 0;         // Fixed seed for reproducible sampling (0 = random)
+    size_t stability_window = 0;        // Stop after this many consecutive records that add
+                                        // no new field or type (0 = examine everything)
 };
 
 /**
@@ -297,7 +362,34 @@ public:
      * @brief Merge multiple inferred schemas
      */
     Schema merge(std::vector<Schema>&& schemas, const std::string& name = "MergedSchema");
-    
+
+    /**
+     * @brief Feed one record to the streaming inference pipeline
+     *
+     * Keeps at most InferenceOptions::sample_size records resident: with
+     * reservoir_sampling enabled each record has an equal chance of ending
+     * up in the sample regardless of input size, otherwise the first
+     * sample_size records are kept. Non-map records carry no fields and
+     * are ignored. Use with stable() and finish() to infer from inputs
+     * too large to hold in memory.
+     */
+    void observe(const Value& record);
+
+    /**
+     * @brief Whether the stability window has been satisfied
+     *
+     * True once stability_window consecutive records introduced no new
+     * field and changed no field type; further records are unlikely to
+     * alter the schema, so the caller can stop feeding. Always false
+     * when stability_window is 0.
+     */
+    bool stable() const;
+
+    /**
+     * @brief Build the schema from the records observed so far
+     */
+    Schema finish(const std::string& name = "InferredSchema");
+
     /**
      * @brief Get inference statistics
      */
@@ -306,6 +398,9 @@ public:
         size_t fields_discovered;
         size_t optional_fields;
         size_t enum_fields;
+        size_t records_seen;        // Total records offered, sampled or not
+        double sampling_fraction;   // samples_analyzed / records_seen
+        bool terminated_early;      // Stability window tripped before end of input
         std::unordered_map<std::string, std::string> field_types;
         std::unordered_map<std::string, double> field_presence_ratio;
     };
@@ -29,9 +29,81 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <memory>
 
 namespace btoon {
 
+/**
+ * @brief Integrity mechanisms selectable on Security.
+ *
+ * HMAC_SHA256 authenticates the data with the secret key; CRC32C is an
+ * unkeyed checksum that only detects corruption, at a fraction of the
+ * cost — suitable for trusted internal links where tampering is not a
+ * concern. Both travel in the same signature envelope, so the mode is
+ * chosen purely through the Security object handed to the Encoder and
+ * Decoder constructors.
+ */
+enum class IntegrityMode {
+    HMAC_SHA256,  /**< Keyed HMAC-SHA256 signature (default). */
+    CRC32C,       /**< Unkeyed CRC32C checksum; corruption detection only. */
+};
+
+/**
+ * @brief Incremental HMAC-SHA256 signer.
+ *
+ * Streams data into the HMAC in chunks instead of requiring the whole
+ * buffer up front, so producers like StreamEncoder can sign frames as
+ * they are written without re-buffering the stream. Backed by OpenSSL's
+ * EVP machinery, which dispatches to the CPU's SHA extensions (SHA-NI,
+ * ARMv8 crypto) at runtime when present.
+ *
+ * Obtain instances from Security::createSigner() so the signer shares
+ * the configured secret key.
+ */
+class HmacSigner {
+public:
+    ~HmacSigner();
+    HmacSigner(HmacSigner&&) noexcept;
+    HmacSigner& operator=(HmacSigner&&) noexcept;
+
+    /**
+     * @brief Absorbs the next chunk of data into the signature.
+     * @param data The next bytes of the message, in order.
+     * @throws BtoonException if the signer has already been finalized.
+     */
+    void update(std::span<const uint8_t> data);
+
+    /**
+     * @brief Completes the computation and returns the signature.
+     * @return A vector of bytes representing the HMAC signature.
+     * @throws BtoonException if the signer has already been finalized.
+     */
+    std::vector<uint8_t> finalize();
+
+    /**
+     * @brief Completes the computation and checks a signature.
+     *
+     * Uses a constant-time comparison, matching Security::verify.
+     *
+     * @param signature The signature to check against.
+     * @return True if the signature matches the absorbed data.
+     * @throws BtoonException if the signer has already been finalized.
+     */
+    bool finalizeAndVerify(const std::vector<uint8_t>& signature);
+
+    /**
+     * @brief Restarts the signer for a new message with the same key.
+     */
+    void reset();
+
+private:
+    friend class Security;
+    explicit HmacSigner(const std::string& key);
+
+    class HmacSignerImpl;
+    std::unique_ptr<HmacSignerImpl> pimpl_;
+};
+
 /**
  * @brief Class responsible for security features in BTOON.
  * 
@@ -61,6 +133,22 @@ public:
      */
     void setSecretKey(const std::string& key);
 
+    /**
+     * @brief Selects the integrity mechanism used by sign() and verify().
+     *
+     * CRC32C needs no secret key and uses the CPU's CRC instructions
+     * where available; HMAC_SHA256 (the default) requires a key set via
+     * setSecretKey().
+     *
+     * @param mode The integrity mode to use.
+     */
+    void setIntegrityMode(IntegrityMode mode);
+
+    /**
+     * @brief Returns the currently selected integrity mode.
+     */
+    IntegrityMode integrityMode() const;
+
     /**
      * @brief Signs data with an HMAC for integrity protection.
      * 
@@ -86,6 +174,23 @@ public:
      */
     bool verify(const std::vector<uint8_t>& data, const std::vector<uint8_t>& signature) const;
 
+    /**
+     * @brief Span overload of verify() that avoids copying the payload.
+     */
+    bool verify(std::span<const uint8_t> data, const std::vector<uint8_t>& signature) const;
+
+    /**
+     * @brief Creates an incremental signer bound to the secret key.
+     *
+     * The returned signer computes the same HMAC-SHA256 as sign(), but
+     * accepts the message in chunks via HmacSigner::update, so callers
+     * producing data incrementally do not have to buffer it first.
+     *
+     * @return An HmacSigner initialized with the configured key.
+     * @throws BtoonException if no secret key is set.
+     */
+    HmacSigner createSigner() const;
+
     /**
      * @brief Sets the allowed data types for deserialization.
      * 
@@ -109,6 +214,7 @@ public:
 
 private:
     std::string secretKey_;              /**< Secret key for HMAC operations. */
+    IntegrityMode integrityMode_ = IntegrityMode::HMAC_SHA256; /**< Selected integrity mechanism. */
     std::set<size_t> allowedTypes_;      /**< Set of allowed type indices for deserialization. */
     bool restrictTypes_ = false;         /**< Flag indicating if type restriction is active. */
 };
@@ -0,0 +1,78 @@
+#ifndef BTOON_STATS_H
+#define BTOON_STATS_H
+
+#include <cstddef>
+
+namespace btoon {
+
+struct Value;
+
+/**
+ * @brief Opt-in runtime statistics for Encoder and Decoder.
+ *
+ * A plain counter struct in the spirit of batch::BatchStatistics:
+ * queryable per instance through Encoder::statistics() and
+ * Decoder::statistics(), and aggregatable across instances with
+ * merge(). Collection is off by default; when disabled the hot paths
+ * pay a single predictable branch.
+ *
+ * The compression fields are only filled by the encode()/decode()
+ * overloads that take a CodecStats, since compression happens outside
+ * the Encoder/Decoder instances.
+ */
+struct CodecStats {
+    size_t messages = 0;         // Top-level encode/decode calls
+    size_t bytes_processed = 0;  // Encoded bytes produced or consumed
+
+    // Per-type value counts across the whole tree, containers included
+    size_t nils = 0;
+    size_t bools = 0;
+    size_t ints = 0;
+    size_t uints = 0;
+    size_t floats = 0;
+    size_t strings = 0;
+    size_t binaries = 0;
+    size_t arrays = 0;
+    size_t maps = 0;
+    size_t extensions = 0;
+    size_t timestamps = 0;
+    size_t dates = 0;
+    size_t datetimes = 0;
+    size_t bigints = 0;
+    size_t vector_floats = 0;
+    size_t vector_doubles = 0;
+
+    // Compression achieved by the free encode()/decode() functions
+    size_t bytes_before_compression = 0;
+    size_t bytes_after_compression = 0;
+
+    // MemoryPool free-list behaviour, snapshotted at query time
+    size_t pool_reuses = 0;
+    size_t pool_free_bytes = 0;
+
+    // HMAC signing/verification, when security is enabled
+    size_t signatures = 0;
+    double signature_time_ms = 0.0;
+
+    /**
+     * @brief Ratio of pre-compression to post-compression bytes.
+     * @return The achieved ratio, or 1.0 when nothing was compressed.
+     */
+    double compression_ratio() const;
+
+    /**
+     * @brief Accumulates another instance's counters into this one.
+     * @param other Statistics to fold in.
+     */
+    void merge(const CodecStats& other);
+
+    /**
+     * @brief Tallies one value tree into the per-type counters.
+     * @param value Root of the tree to count.
+     */
+    void count_value(const Value& value);
+};
+
+} // namespace btoon
+
+#endif // BTOON_STATS_H
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <vector>
 
 namespace btoon {
 
@@ -33,6 +34,17 @@ public:
     ~StreamDecoder();
 
     std::optional<Value> read();
+
+    /**
+     * @brief Decode up to @p max_records records in one call.
+     *
+     * Amortizes stream reads and decompressor setup across a batch: with
+     * framed input each frame is decompressed once and drained before the
+     * next is touched. Returns fewer than @p max_records only at end of
+     * stream; an empty vector means the stream is exhausted.
+     */
+    std::vector<Value> read_batch(size_t max_records);
+
     bool has_next();
 
 private:
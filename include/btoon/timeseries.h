@@ -12,12 +12,26 @@
 #include "btoon/btoon.h"
 #include "btoon/compression.h"
 #include "btoon/delta_codec.h"
+#include "btoon/batch_processor.h"
+#include "btoon/zero_copy.h"
+#include <fstream>
 #include <vector>
 #include <deque>
 #include <optional>
 #include <chrono>
 #include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
 #include <functional>
+#include <numeric>
+#include <span>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace btoon {
 namespace timeseries {
@@ -81,6 +95,861 @@ enum class TimeSeriesCompression {
     DICTIONARY       // Dictionary compression for repeated values
 };
 
+/**
+ * @brief Vectorized reductions over contiguous double data
+ *
+ * Inner loops for the aggregation engine: 4-wide AVX2 (2-wide NEON)
+ * accumulators with a scalar tail. Inputs are the contiguous value
+ * buffers the engine gathers per bucket, not the DataPoint structs.
+ */
+namespace simd {
+
+inline double sum(std::span<const double> values) {
+    size_t i = 0;
+    double total = 0.0;
+#if defined(__AVX2__)
+    __m256d acc = _mm256_setzero_pd();
+    for (; i + 3 < values.size(); i += 4) {
+        acc = _mm256_add_pd(acc, _mm256_loadu_pd(&values[i]));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__aarch64__)
+    float64x2_t acc = vdupq_n_f64(0.0);
+    for (; i + 1 < values.size(); i += 2) {
+        acc = vaddq_f64(acc, vld1q_f64(&values[i]));
+    }
+    total = vgetq_lane_f64(acc, 0) + vgetq_lane_f64(acc, 1);
+#endif
+    for (; i < values.size(); ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+inline double min(std::span<const double> values) {
+    double result = values[0];
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256d acc = _mm256_set1_pd(result);
+    for (; i + 3 < values.size(); i += 4) {
+        acc = _mm256_min_pd(acc, _mm256_loadu_pd(&values[i]));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    result = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+#elif defined(__aarch64__)
+    float64x2_t acc = vdupq_n_f64(result);
+    for (; i + 1 < values.size(); i += 2) {
+        acc = vminq_f64(acc, vld1q_f64(&values[i]));
+    }
+    result = std::min(vgetq_lane_f64(acc, 0), vgetq_lane_f64(acc, 1));
+#endif
+    for (; i < values.size(); ++i) {
+        result = std::min(result, values[i]);
+    }
+    return result;
+}
+
+inline double max(std::span<const double> values) {
+    double result = values[0];
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256d acc = _mm256_set1_pd(result);
+    for (; i + 3 < values.size(); i += 4) {
+        acc = _mm256_max_pd(acc, _mm256_loadu_pd(&values[i]));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    result = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#elif defined(__aarch64__)
+    float64x2_t acc = vdupq_n_f64(result);
+    for (; i + 1 < values.size(); i += 2) {
+        acc = vmaxq_f64(acc, vld1q_f64(&values[i]));
+    }
+    result = std::max(vgetq_lane_f64(acc, 0), vgetq_lane_f64(acc, 1));
+#endif
+    for (; i < values.size(); ++i) {
+        result = std::max(result, values[i]);
+    }
+    return result;
+}
+
+/// Sum of squared deviations from a known mean (the stddev/z-score pass).
+inline double sum_squared_deviations(std::span<const double> values, double mean) {
+    size_t i = 0;
+    double total = 0.0;
+#if defined(__AVX2__)
+    __m256d acc = _mm256_setzero_pd();
+    __m256d mean_v = _mm256_set1_pd(mean);
+    for (; i + 3 < values.size(); i += 4) {
+        __m256d diff = _mm256_sub_pd(_mm256_loadu_pd(&values[i]), mean_v);
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(diff, diff));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__aarch64__)
+    float64x2_t acc = vdupq_n_f64(0.0);
+    float64x2_t mean_v = vdupq_n_f64(mean);
+    for (; i + 1 < values.size(); i += 2) {
+        float64x2_t diff = vsubq_f64(vld1q_f64(&values[i]), mean_v);
+        acc = vfmaq_f64(acc, diff, diff);
+    }
+    total = vgetq_lane_f64(acc, 0) + vgetq_lane_f64(acc, 1);
+#endif
+    for (; i < values.size(); ++i) {
+        double diff = values[i] - mean;
+        total += diff * diff;
+    }
+    return total;
+}
+
+/// Append the indices of values outside [low, high]. The comparisons run
+/// 4 wide with a movemask, so the per-point branch only fires for the
+/// (rare) lanes that actually hold an outlier.
+inline void collect_outside_range(std::span<const double> values, double low,
+                                  double high, std::vector<size_t>& out) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256d low_v = _mm256_set1_pd(low);
+    __m256d high_v = _mm256_set1_pd(high);
+    for (; i + 3 < values.size(); i += 4) {
+        __m256d x = _mm256_loadu_pd(&values[i]);
+        __m256d outside = _mm256_or_pd(_mm256_cmp_pd(x, low_v, _CMP_LT_OQ),
+                                       _mm256_cmp_pd(x, high_v, _CMP_GT_OQ));
+        int mask = _mm256_movemask_pd(outside);
+        while (mask != 0) {
+            unsigned lane = static_cast<unsigned>(std::countr_zero(static_cast<unsigned>(mask)));
+            out.push_back(i + lane);
+            mask &= mask - 1;
+        }
+    }
+#elif defined(__aarch64__)
+    float64x2_t low_v = vdupq_n_f64(low);
+    float64x2_t high_v = vdupq_n_f64(high);
+    for (; i + 1 < values.size(); i += 2) {
+        float64x2_t x = vld1q_f64(&values[i]);
+        uint64x2_t outside = vorrq_u64(vcltq_f64(x, low_v), vcgtq_f64(x, high_v));
+        if (vgetq_lane_u64(outside, 0)) out.push_back(i);
+        if (vgetq_lane_u64(outside, 1)) out.push_back(i + 1);
+    }
+#endif
+    for (; i < values.size(); ++i) {
+        if (values[i] < low || values[i] > high) {
+            out.push_back(i);
+        }
+    }
+}
+
+} // namespace simd
+
+/**
+ * @brief Chunked Gorilla compression
+ *
+ * Facebook-style Gorilla compression (delta-of-delta timestamps, XOR'd
+ * float values), written as independent fixed-size blocks instead of one
+ * bitstream. Each block restarts the predictor state and is listed in a
+ * directory up front with its row count, first/last timestamp and payload
+ * size, so blocks compress and decompress in parallel across cores and a
+ * time-range read only decodes the blocks that overlap it.
+ */
+namespace gorilla {
+
+struct ChunkedOptions {
+    size_t block_size = 4096;  ///< Points per block; 0 falls back to 4096.
+    size_t threads = 1;        ///< 1 = serial, 0 = one worker per core, N = N workers.
+};
+
+namespace detail {
+
+/// MSB-first bit stream writer for the XOR'd value section.
+class BitWriter {
+public:
+    void write(uint64_t value, unsigned bits) {
+        for (unsigned i = bits; i-- > 0;) {
+            if (bit_ == 0) {
+                buffer_.push_back(0);
+            }
+            if ((value >> i) & 1u) {
+                buffer_.back() |= static_cast<uint8_t>(1u << (7 - bit_));
+            }
+            bit_ = (bit_ + 1) & 7;
+        }
+    }
+
+    std::vector<uint8_t> take() { return std::move(buffer_); }
+
+private:
+    std::vector<uint8_t> buffer_;
+    unsigned bit_ = 0;
+};
+
+/// MSB-first bit stream reader; throws instead of reading past the block.
+class BitReader {
+public:
+    explicit BitReader(std::span<const uint8_t> data) : data_(data) {}
+
+    uint64_t read(unsigned bits) {
+        uint64_t value = 0;
+        for (unsigned i = 0; i < bits; ++i) {
+            size_t byte = pos_ >> 3;
+            if (byte >= data_.size()) {
+                throw BtoonException("Truncated Gorilla block");
+            }
+            value = (value << 1) | ((data_[byte] >> (7 - (pos_ & 7))) & 1u);
+            ++pos_;
+        }
+        return value;
+    }
+
+private:
+    std::span<const uint8_t> data_;
+    size_t pos_ = 0;
+};
+
+inline uint64_t zigzag_encode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t value) {
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+inline void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+inline uint64_t get_varint(std::span<const uint8_t> data, size_t& pos) {
+    uint64_t value = 0;
+    unsigned shift = 0;
+    for (;;) {
+        if (pos >= data.size() || shift >= 64) {
+            throw BtoonException("Truncated varint in Gorilla block");
+        }
+        uint8_t byte = data[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+        shift += 7;
+    }
+}
+
+inline void put_u64(std::vector<uint8_t>& out, uint64_t value) {
+    for (unsigned shift = 64; shift > 0; shift -= 8) {
+        out.push_back(static_cast<uint8_t>(value >> (shift - 8)));
+    }
+}
+
+inline uint64_t get_u64(std::span<const uint8_t> data, size_t& pos) {
+    if (pos + 8 > data.size()) {
+        throw BtoonException("Truncated Gorilla container");
+    }
+    uint64_t value = 0;
+    for (unsigned i = 0; i < 8; ++i) {
+        value = (value << 8) | data[pos + i];
+    }
+    pos += 8;
+    return value;
+}
+
+inline void put_u32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+inline void put_i64(std::vector<uint8_t>& out, int64_t value) {
+    uint64_t v = static_cast<uint64_t>(value);
+    for (unsigned shift = 64; shift > 0; shift -= 8) {
+        out.push_back(static_cast<uint8_t>(v >> (shift - 8)));
+    }
+}
+
+inline uint32_t get_u32(std::span<const uint8_t> data, size_t& pos) {
+    if (pos + 4 > data.size()) {
+        throw BtoonException("Truncated Gorilla container");
+    }
+    uint32_t value = (static_cast<uint32_t>(data[pos]) << 24) |
+                     (static_cast<uint32_t>(data[pos + 1]) << 16) |
+                     (static_cast<uint32_t>(data[pos + 2]) << 8) |
+                     (static_cast<uint32_t>(data[pos + 3]));
+    pos += 4;
+    return value;
+}
+
+inline int64_t get_i64(std::span<const uint8_t> data, size_t& pos) {
+    if (pos + 8 > data.size()) {
+        throw BtoonException("Truncated Gorilla container");
+    }
+    uint64_t value = 0;
+    for (unsigned i = 0; i < 8; ++i) {
+        value = (value << 8) | data[pos + i];
+    }
+    pos += 8;
+    return static_cast<int64_t>(value);
+}
+
+/// Compress one block. The block's first timestamp lives in the directory;
+/// the payload carries the remaining timestamps as zigzag LEB128
+/// delta-of-deltas, then the values as a classic Gorilla XOR bitstream
+/// whose predictor state is local to the block.
+inline std::vector<uint8_t> compress_block(std::span<const int64_t> timestamps,
+                                           std::span<const double> values) {
+    std::vector<uint8_t> ts_bytes;
+    int64_t prev_delta = 0;
+    for (size_t i = 1; i < timestamps.size(); ++i) {
+        int64_t delta = timestamps[i] - timestamps[i - 1];
+        put_varint(ts_bytes, zigzag_encode(i == 1 ? delta : delta - prev_delta));
+        prev_delta = delta;
+    }
+
+    std::vector<uint8_t> out;
+    put_varint(out, ts_bytes.size());
+    out.insert(out.end(), ts_bytes.begin(), ts_bytes.end());
+
+    BitWriter writer;
+    uint64_t prev_bits = 0;
+    std::memcpy(&prev_bits, &values[0], 8);
+    writer.write(prev_bits, 64);
+
+    // prev window starts invalid so the first non-zero XOR opens a new one.
+    unsigned prev_leading = 65;
+    unsigned prev_trailing = 65;
+    for (size_t i = 1; i < values.size(); ++i) {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &values[i], 8);
+        uint64_t diff = bits ^ prev_bits;
+        prev_bits = bits;
+        if (diff == 0) {
+            writer.write(0, 1);
+            continue;
+        }
+        unsigned leading = static_cast<unsigned>(std::countl_zero(diff));
+        unsigned trailing = static_cast<unsigned>(std::countr_zero(diff));
+        if (leading > 31) leading = 31;  // 5-bit field
+        if (leading >= prev_leading && trailing >= prev_trailing) {
+            // Control bits 10: reuse the previous meaningful-bit window.
+            writer.write(0b10, 2);
+            writer.write(diff >> prev_trailing, 64 - prev_leading - prev_trailing);
+        } else {
+            // Control bits 11: new window — 5 bits of leading zeros, 6 bits
+            // of meaningful length minus one, then the meaningful bits.
+            unsigned meaningful = 64 - leading - trailing;
+            writer.write(0b11, 2);
+            writer.write(leading, 5);
+            writer.write(meaningful - 1, 6);
+            writer.write(diff >> trailing, meaningful);
+            prev_leading = leading;
+            prev_trailing = trailing;
+        }
+    }
+
+    auto value_bytes = writer.take();
+    out.insert(out.end(), value_bytes.begin(), value_bytes.end());
+    return out;
+}
+
+/// Decompress one block into caller-provided slots (blocks decode in
+/// parallel, each into its own disjoint output range).
+inline void decompress_block(std::span<const uint8_t> payload, size_t count,
+                             int64_t first_ts, int64_t* ts_out, double* val_out) {
+    size_t pos = 0;
+    uint64_t ts_len = get_varint(payload, pos);
+    if (ts_len > payload.size() - pos) {
+        throw BtoonException("Truncated Gorilla block");
+    }
+    std::span<const uint8_t> ts_bytes = payload.subspan(pos, ts_len);
+    pos += ts_len;
+
+    ts_out[0] = first_ts;
+    size_t ts_pos = 0;
+    int64_t prev_ts = first_ts;
+    int64_t prev_delta = 0;
+    for (size_t i = 1; i < count; ++i) {
+        int64_t entry = zigzag_decode(get_varint(ts_bytes, ts_pos));
+        int64_t delta = (i == 1) ? entry : prev_delta + entry;
+        prev_ts += delta;
+        ts_out[i] = prev_ts;
+        prev_delta = delta;
+    }
+    if (ts_pos != ts_bytes.size()) {
+        throw BtoonException("Gorilla block timestamp section size mismatch");
+    }
+
+    BitReader reader(payload.subspan(pos));
+    uint64_t prev_bits = reader.read(64);
+    std::memcpy(&val_out[0], &prev_bits, 8);
+    unsigned leading = 0;
+    unsigned trailing = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if (reader.read(1) == 0) {
+            std::memcpy(&val_out[i], &prev_bits, 8);
+            continue;
+        }
+        if (reader.read(1) != 0) {
+            leading = static_cast<unsigned>(reader.read(5));
+            trailing = 64 - leading - (static_cast<unsigned>(reader.read(6)) + 1);
+        }
+        uint64_t diff = reader.read(64 - leading - trailing) << trailing;
+        prev_bits ^= diff;
+        std::memcpy(&val_out[i], &prev_bits, 8);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Compress parallel timestamp/value arrays into chunked Gorilla form
+ *
+ * Layout: [u32 version][u32 block size][u32 block count], a directory of
+ * [u32 count][i64 first ts][i64 last ts][u32 payload size] per block, then
+ * the block payloads back to back. With ChunkedOptions::threads != 1 the
+ * blocks are compressed concurrently on a ParallelBatchProcessor pool.
+ */
+inline std::vector<uint8_t> compress_chunked(const std::vector<int64_t>& timestamps,
+                                             const std::vector<double>& values,
+                                             const ChunkedOptions& options = {}) {
+    if (timestamps.size() != values.size()) {
+        throw BtoonException("Gorilla timestamp/value count mismatch");
+    }
+    size_t block_size = options.block_size == 0 ? 4096 : options.block_size;
+    size_t num_blocks = (timestamps.size() + block_size - 1) / block_size;
+
+    auto build_block = [&](size_t block) -> std::vector<uint8_t> {
+        size_t begin = block * block_size;
+        size_t count = std::min(block_size, timestamps.size() - begin);
+        return detail::compress_block({timestamps.data() + begin, count},
+                                      {values.data() + begin, count});
+    };
+
+    std::vector<std::vector<uint8_t>> payloads(num_blocks);
+    if (options.threads != 1 && num_blocks > 1) {
+        batch::BatchOptions batch_options;
+        batch_options.worker_threads = options.threads;
+        batch_options.batch_size = 1;
+        batch::ParallelBatchProcessor<size_t, std::pair<size_t, std::vector<uint8_t>>> processor(
+            [&](const size_t& block) {
+                return std::make_pair(block, build_block(block));
+            },
+            batch_options);
+
+        std::vector<size_t> block_indices(num_blocks);
+        std::iota(block_indices.begin(), block_indices.end(), size_t{0});
+        auto results = processor.process(block_indices);
+        if (results.size() != num_blocks) {
+            throw BtoonException("Parallel Gorilla compression failed");
+        }
+        for (auto& [block, bytes] : results) {
+            payloads[block] = std::move(bytes);
+        }
+    } else {
+        for (size_t block = 0; block < num_blocks; ++block) {
+            payloads[block] = build_block(block);
+        }
+    }
+
+    std::vector<uint8_t> out;
+    detail::put_u32(out, 1);  // version
+    detail::put_u32(out, static_cast<uint32_t>(block_size));
+    detail::put_u32(out, static_cast<uint32_t>(num_blocks));
+    for (size_t block = 0; block < num_blocks; ++block) {
+        size_t begin = block * block_size;
+        size_t count = std::min(block_size, timestamps.size() - begin);
+        detail::put_u32(out, static_cast<uint32_t>(count));
+        detail::put_i64(out, timestamps[begin]);
+        detail::put_i64(out, timestamps[begin + count - 1]);
+        detail::put_u32(out, static_cast<uint32_t>(payloads[block].size()));
+    }
+    for (const auto& payload : payloads) {
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+    return out;
+}
+
+/**
+ * @brief Decompress a chunked Gorilla container back into parallel arrays
+ *
+ * Blocks are self-contained, so with threads != 1 they decode concurrently,
+ * each into its own pre-sized slice of the output.
+ * @throws BtoonException on truncated or malformed input
+ */
+inline std::pair<std::vector<int64_t>, std::vector<double>>
+decompress_chunked(std::span<const uint8_t> buffer, size_t threads = 1) {
+    size_t pos = 0;
+    uint32_t version = detail::get_u32(buffer, pos);
+    if (version != 1) {
+        throw BtoonException("Unsupported Gorilla container version");
+    }
+    detail::get_u32(buffer, pos);  // block size, informational
+    uint32_t num_blocks = detail::get_u32(buffer, pos);
+
+    struct BlockEntry {
+        size_t count;
+        int64_t first_ts;
+        size_t payload_offset;
+        size_t payload_size;
+        size_t row_offset;
+    };
+    std::vector<BlockEntry> entries;
+    entries.reserve(num_blocks);
+    size_t payload_offset = 0;
+    size_t total_rows = 0;
+    for (uint32_t block = 0; block < num_blocks; ++block) {
+        BlockEntry entry;
+        entry.count = detail::get_u32(buffer, pos);
+        entry.first_ts = detail::get_i64(buffer, pos);
+        detail::get_i64(buffer, pos);  // last ts, used by range reads
+        entry.payload_size = detail::get_u32(buffer, pos);
+        entry.payload_offset = payload_offset;
+        entry.row_offset = total_rows;
+        if (entry.count == 0) {
+            throw BtoonException("Empty Gorilla block");
+        }
+        payload_offset += entry.payload_size;
+        total_rows += entry.count;
+        entries.push_back(entry);
+    }
+    if (payload_offset > buffer.size() - pos) {
+        throw BtoonException("Truncated Gorilla container");
+    }
+    std::span<const uint8_t> payloads = buffer.subspan(pos, payload_offset);
+
+    std::vector<int64_t> timestamps(total_rows);
+    std::vector<double> values(total_rows);
+    auto decode_block = [&](size_t block) {
+        const auto& entry = entries[block];
+        detail::decompress_block(
+            payloads.subspan(entry.payload_offset, entry.payload_size),
+            entry.count, entry.first_ts,
+            timestamps.data() + entry.row_offset, values.data() + entry.row_offset);
+    };
+
+    if (threads != 1 && entries.size() > 1) {
+        batch::BatchOptions batch_options;
+        batch_options.worker_threads = threads;
+        batch_options.batch_size = 1;
+        batch::ParallelBatchProcessor<size_t, size_t> processor(
+            [&](const size_t& block) {
+                decode_block(block);
+                return block;
+            },
+            batch_options);
+
+        std::vector<size_t> block_indices(entries.size());
+        std::iota(block_indices.begin(), block_indices.end(), size_t{0});
+        auto results = processor.process(block_indices);
+        if (results.size() != entries.size()) {
+            throw BtoonException("Parallel Gorilla decompression failed");
+        }
+    } else {
+        for (size_t block = 0; block < entries.size(); ++block) {
+            decode_block(block);
+        }
+    }
+    return {std::move(timestamps), std::move(values)};
+}
+
+/**
+ * @brief Decompress only the points whose timestamp lies in [start, end]
+ *
+ * The block directory carries each block's first and last timestamp, so
+ * blocks entirely outside the range are skipped without touching their
+ * payload bytes; boundary blocks are decoded and trimmed.
+ */
+inline std::pair<std::vector<int64_t>, std::vector<double>>
+decompress_range(std::span<const uint8_t> buffer, int64_t start, int64_t end) {
+    size_t pos = 0;
+    uint32_t version = detail::get_u32(buffer, pos);
+    if (version != 1) {
+        throw BtoonException("Unsupported Gorilla container version");
+    }
+    detail::get_u32(buffer, pos);  // block size
+    uint32_t num_blocks = detail::get_u32(buffer, pos);
+
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    size_t payload_offset = 0;
+    struct Wanted {
+        size_t count;
+        int64_t first_ts;
+        size_t payload_offset;
+        size_t payload_size;
+    };
+    std::vector<Wanted> wanted;
+    for (uint32_t block = 0; block < num_blocks; ++block) {
+        size_t count = detail::get_u32(buffer, pos);
+        int64_t first_ts = detail::get_i64(buffer, pos);
+        int64_t last_ts = detail::get_i64(buffer, pos);
+        size_t payload_size = detail::get_u32(buffer, pos);
+        if (count == 0) {
+            throw BtoonException("Empty Gorilla block");
+        }
+        if (last_ts >= start && first_ts <= end) {
+            wanted.push_back({count, first_ts, payload_offset, payload_size});
+        }
+        payload_offset += payload_size;
+    }
+    if (payload_offset > buffer.size() - pos) {
+        throw BtoonException("Truncated Gorilla container");
+    }
+    std::span<const uint8_t> payloads = buffer.subspan(pos, payload_offset);
+
+    std::vector<int64_t> block_ts;
+    std::vector<double> block_vals;
+    for (const auto& entry : wanted) {
+        block_ts.resize(entry.count);
+        block_vals.resize(entry.count);
+        detail::decompress_block(
+            payloads.subspan(entry.payload_offset, entry.payload_size),
+            entry.count, entry.first_ts, block_ts.data(), block_vals.data());
+        for (size_t i = 0; i < entry.count; ++i) {
+            if (block_ts[i] >= start && block_ts[i] <= end) {
+                timestamps.push_back(block_ts[i]);
+                values.push_back(block_vals[i]);
+            }
+        }
+    }
+    return {std::move(timestamps), std::move(values)};
+}
+
+} // namespace gorilla
+
+/**
+ * @brief Time-indexed segment files for out-of-core range queries
+ *
+ * A segment file is a sequence of chunked Gorilla containers followed by a
+ * sparse time index footer listing each segment's byte range, first/last
+ * timestamp and point count. The fixed-size trailer mirrors the frame
+ * directory footer: a reader finds the magic at the end of the mapping and
+ * walks the table backwards, so files are written append-only. Opened over
+ * a MemoryMappedFile, a range query only pages in the segments (and, via
+ * the per-segment block directory, only the blocks) that overlap the
+ * requested window.
+ */
+namespace segments {
+
+constexpr char kSegmentDirectoryMagic[8] = {'B', 'T', 'O', 'N', 'S', 'E', 'G', '1'};
+constexpr size_t kSegmentDirEntrySize = 40;  // offset u64 + size u64 + 2 i64 + count u64
+
+/**
+ * @brief Appends time-ordered segments to a file and indexes them on close
+ */
+class SegmentWriter {
+public:
+    explicit SegmentWriter(const std::string& filename)
+        : stream_(filename, std::ios::binary | std::ios::trunc) {
+        if (!stream_) {
+            throw BtoonException("Cannot open segment file: " + filename);
+        }
+    }
+
+    /**
+     * @brief Compress one segment and append it
+     *
+     * Segments must be appended in time order; each is an independent
+     * chunked Gorilla container.
+     */
+    void append(const std::vector<int64_t>& timestamps,
+                const std::vector<double>& values,
+                const gorilla::ChunkedOptions& options = {}) {
+        if (closed_) {
+            throw BtoonException("Segment file already closed");
+        }
+        if (timestamps.empty()) {
+            return;
+        }
+        if (!entries_.empty() && timestamps.front() < entries_.back().last_ts) {
+            throw BtoonException("Segments must be appended in time order");
+        }
+        auto payload = gorilla::compress_chunked(timestamps, values, options);
+
+        Entry entry;
+        entry.offset = offset_;
+        entry.size = payload.size();
+        entry.first_ts = timestamps.front();
+        entry.last_ts = timestamps.back();
+        entry.count = timestamps.size();
+        entries_.push_back(entry);
+
+        stream_.write(reinterpret_cast<const char*>(payload.data()),
+                      static_cast<std::streamsize>(payload.size()));
+        offset_ += payload.size();
+        if (!stream_) {
+            throw BtoonException("Failed to write segment data");
+        }
+    }
+
+    /**
+     * @brief Write the time index footer and finish the file
+     */
+    void close() {
+        if (closed_) {
+            return;
+        }
+        std::vector<uint8_t> footer;
+        for (const auto& entry : entries_) {
+            gorilla::detail::put_u64(footer, entry.offset);
+            gorilla::detail::put_u64(footer, entry.size);
+            gorilla::detail::put_i64(footer, entry.first_ts);
+            gorilla::detail::put_i64(footer, entry.last_ts);
+            gorilla::detail::put_u64(footer, entry.count);
+        }
+        gorilla::detail::put_u64(footer, entries_.size());
+        footer.insert(footer.end(), kSegmentDirectoryMagic, kSegmentDirectoryMagic + 8);
+        stream_.write(reinterpret_cast<const char*>(footer.data()),
+                      static_cast<std::streamsize>(footer.size()));
+        stream_.flush();
+        if (!stream_) {
+            throw BtoonException("Failed to write segment directory");
+        }
+        closed_ = true;
+    }
+
+private:
+    struct Entry {
+        uint64_t offset;
+        uint64_t size;
+        int64_t first_ts;
+        int64_t last_ts;
+        uint64_t count;
+    };
+
+    std::ofstream stream_;
+    std::vector<Entry> entries_;
+    uint64_t offset_ = 0;
+    bool closed_ = false;
+};
+
+/**
+ * @brief Read-only view over a segment file (typically memory-mapped)
+ *
+ * The store does not own the buffer; when opened over a MemoryMappedFile
+ * the file must outlive the store.
+ */
+class SegmentStore {
+public:
+    /**
+     * @brief Check whether a buffer ends with a segment directory footer
+     */
+    static bool has_segments(std::span<const uint8_t> buffer) {
+        if (buffer.size() < 16) {
+            return false;
+        }
+        if (std::memcmp(&buffer[buffer.size() - 8], kSegmentDirectoryMagic, 8) != 0) {
+            return false;
+        }
+        size_t pos = buffer.size() - 16;
+        uint64_t count = gorilla::detail::get_u64(buffer, pos);
+        return count <= (buffer.size() - 16) / kSegmentDirEntrySize;
+    }
+
+    /**
+     * @brief Open a buffer containing segments plus a directory footer
+     * @throws BtoonException if no valid footer is present
+     */
+    static SegmentStore open(std::span<const uint8_t> buffer) {
+        if (!has_segments(buffer)) {
+            throw BtoonException("No segment directory footer");
+        }
+        size_t pos = buffer.size() - 16;
+        uint64_t count = gorilla::detail::get_u64(buffer, pos);
+        size_t table_start = buffer.size() - 16 - static_cast<size_t>(count) * kSegmentDirEntrySize;
+
+        std::vector<Entry> entries;
+        entries.reserve(count);
+        size_t total_points = 0;
+        pos = table_start;
+        for (uint64_t i = 0; i < count; ++i) {
+            Entry entry;
+            entry.offset = gorilla::detail::get_u64(buffer, pos);
+            entry.size = gorilla::detail::get_u64(buffer, pos);
+            entry.first_ts = gorilla::detail::get_i64(buffer, pos);
+            entry.last_ts = gorilla::detail::get_i64(buffer, pos);
+            entry.count = gorilla::detail::get_u64(buffer, pos);
+            if (entry.offset + entry.size > table_start ||
+                (!entries.empty() && entry.offset < entries.back().offset + entries.back().size)) {
+                throw BtoonException("Corrupt segment directory footer");
+            }
+            total_points += entry.count;
+            entries.push_back(entry);
+        }
+        return SegmentStore(buffer, std::move(entries), total_points);
+    }
+
+    /**
+     * @brief Open a memory-mapped file (the file must outlive the store)
+     */
+    static SegmentStore open(const MemoryMappedFile& file) {
+        return open(file.view().span());
+    }
+
+    size_t num_segments() const { return segments_.size(); }
+    size_t num_points() const { return total_points_; }
+
+    /**
+     * @brief Decode only the points whose timestamp lies in [start, end]
+     *
+     * Segments outside the window are skipped by the index without
+     * touching their bytes; overlapping ones decode through
+     * gorilla::decompress_range, which skips non-overlapping blocks too.
+     */
+    std::pair<std::vector<int64_t>, std::vector<double>>
+    query_range(int64_t start, int64_t end) const {
+        std::vector<int64_t> timestamps;
+        std::vector<double> values;
+        for (const auto& segment : segments_) {
+            if (segment.last_ts < start || segment.first_ts > end) {
+                continue;
+            }
+            auto [seg_ts, seg_vals] = gorilla::decompress_range(
+                buffer_.subspan(static_cast<size_t>(segment.offset),
+                                static_cast<size_t>(segment.size)),
+                start, end);
+            timestamps.insert(timestamps.end(), seg_ts.begin(), seg_ts.end());
+            values.insert(values.end(), seg_vals.begin(), seg_vals.end());
+        }
+        return {std::move(timestamps), std::move(values)};
+    }
+
+    /**
+     * @brief Value at an exact timestamp, or nullopt if absent
+     */
+    std::optional<double> at_time(int64_t timestamp) const {
+        auto [ts, vals] = query_range(timestamp, timestamp);
+        if (ts.empty()) {
+            return std::nullopt;
+        }
+        return vals.front();
+    }
+
+private:
+    struct Entry {
+        uint64_t offset;
+        uint64_t size;
+        int64_t first_ts;
+        int64_t last_ts;
+        uint64_t count;
+    };
+
+    SegmentStore(std::span<const uint8_t> buffer, std::vector<Entry> entries,
+                 size_t total_points)
+        : buffer_(buffer), segments_(std::move(entries)), total_points_(total_points) {}
+
+    std::span<const uint8_t> buffer_;
+    std::vector<Entry> segments_;
+    size_t total_points_;
+};
+
+} // namespace segments
+
 /**
  * @brief Optimized time-series storage
  */
@@ -177,12 +1046,307 @@ private:
     std::vector<uint8_t> compress_delta() const;
     std::vector<uint8_t> compress_gorilla() const;
     std::vector<uint8_t> compress_xor() const;
+
+    // Aggregation helper: reduce one contiguous run of points
+    static T aggregate_points(const DataPoint<T>* points, size_t count,
+                              AggregationFunction func);
     
     // Downsampling helpers
     TimeSeries<T> downsample_lttb(size_t target_points) const;
     TimeSeries<T> downsample_m4(size_t target_points) const;
 };
 
+template<typename T>
+void TimeSeries<T>::append(const Timestamp& timestamp, const T& value) {
+    data_.emplace_back(timestamp, value);
+}
+
+template<typename T>
+void TimeSeries<T>::append(const DataPoint<T>& point) {
+    data_.push_back(point);
+}
+
+template<typename T>
+void TimeSeries<T>::append_batch(const std::vector<DataPoint<T>>& points) {
+    data_.insert(data_.end(), points.begin(), points.end());
+}
+
+template<typename T>
+std::vector<DataPoint<T>> TimeSeries<T>::range(const Timestamp& start,
+                                               const Timestamp& end) const {
+    // Points are kept in append (time) order, so the window is found by
+    // binary search instead of a full scan.
+    auto lower = std::lower_bound(
+        data_.begin(), data_.end(), start,
+        [](const DataPoint<T>& point, const Timestamp& ts) { return point.timestamp < ts; });
+    auto upper = std::upper_bound(
+        lower, data_.end(), end,
+        [](const Timestamp& ts, const DataPoint<T>& point) { return ts < point.timestamp; });
+    return {lower, upper};
+}
+
+template<typename T>
+std::optional<DataPoint<T>> TimeSeries<T>::at_time(const Timestamp& timestamp) const {
+    auto it = std::lower_bound(
+        data_.begin(), data_.end(), timestamp,
+        [](const DataPoint<T>& point, const Timestamp& ts) { return point.timestamp < ts; });
+    if (it == data_.end() || timestamp < it->timestamp) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+template<typename T>
+T TimeSeries<T>::aggregate_points(const DataPoint<T>* points, size_t count,
+                                  AggregationFunction func) {
+    static_assert(std::is_arithmetic_v<T>,
+                  "Aggregation requires an arithmetic value type");
+    if (count == 0) {
+        return T{};
+    }
+    switch (func) {
+        case AggregationFunction::COUNT: return static_cast<T>(count);
+        case AggregationFunction::FIRST: return points[0].value;
+        case AggregationFunction::LAST: return points[count - 1].value;
+        default: break;
+    }
+
+    // Gather values into a contiguous buffer so sum/min/max run on the
+    // vectorized reductions instead of striding over DataPoint structs.
+    std::vector<double> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<double>(points[i].value);
+    }
+
+    switch (func) {
+        case AggregationFunction::SUM:
+            return static_cast<T>(simd::sum(values));
+        case AggregationFunction::MEAN:
+            return static_cast<T>(simd::sum(values) / static_cast<double>(count));
+        case AggregationFunction::MIN:
+            return static_cast<T>(simd::min(values));
+        case AggregationFunction::MAX:
+            return static_cast<T>(simd::max(values));
+        case AggregationFunction::MEDIAN: {
+            size_t mid = count / 2;
+            std::nth_element(values.begin(), values.begin() + static_cast<ptrdiff_t>(mid), values.end());
+            if (count % 2 == 1) {
+                return static_cast<T>(values[mid]);
+            }
+            double upper = values[mid];
+            double lower = *std::max_element(values.begin(), values.begin() + static_cast<ptrdiff_t>(mid));
+            return static_cast<T>((lower + upper) / 2.0);
+        }
+        case AggregationFunction::VARIANCE:
+        case AggregationFunction::STDDEV: {
+            double mean = simd::sum(values) / static_cast<double>(count);
+            double sum_sq = 0.0;
+            for (double v : values) {
+                sum_sq += (v - mean) * (v - mean);
+            }
+            double variance = sum_sq / static_cast<double>(count);
+            return static_cast<T>(func == AggregationFunction::VARIANCE
+                                      ? variance
+                                      : std::sqrt(variance));
+        }
+        default:
+            throw BtoonException("Aggregation function not implemented");
+    }
+}
+
+template<typename T>
+T TimeSeries<T>::aggregate(AggregationFunction func,
+                           const Timestamp& start, const Timestamp& end) const {
+    // Default-constructed bounds select the whole series.
+    if (start == Timestamp{} && end == Timestamp{}) {
+        return aggregate_points(data_.data(), data_.size(), func);
+    }
+    auto lower = std::lower_bound(
+        data_.begin(), data_.end(), start,
+        [](const DataPoint<T>& point, const Timestamp& ts) { return point.timestamp < ts; });
+    auto upper = std::upper_bound(
+        lower, data_.end(), end,
+        [](const Timestamp& ts, const DataPoint<T>& point) { return ts < point.timestamp; });
+    return aggregate_points(data_.data() + (lower - data_.begin()),
+                            static_cast<size_t>(upper - lower), func);
+}
+
+template<typename T>
+TimeSeries<T> TimeSeries<T>::resample(std::chrono::milliseconds interval,
+                                      AggregationFunction func) const {
+    TimeSeries<T> out;
+    if (data_.empty() || interval.count() <= 0) {
+        return out;
+    }
+    const int64_t interval_us = interval.count() * 1000;
+    auto bucket_start = [&](int64_t ts) {
+        int64_t q = ts / interval_us;
+        if (ts % interval_us < 0) --q;  // floor toward -inf for pre-epoch data
+        return q * interval_us;
+    };
+
+    // Points are time-ordered, so each bucket is a contiguous run; find the
+    // runs by binary search rather than walking point by point.
+    struct Bucket {
+        size_t begin;
+        size_t end;
+        int64_t start_us;
+    };
+    std::vector<Bucket> buckets;
+    size_t i = 0;
+    while (i < data_.size()) {
+        int64_t start_us = bucket_start(data_[i].timestamp.to_microseconds());
+        int64_t end_us = start_us + interval_us;
+        auto it = std::lower_bound(
+            data_.begin() + static_cast<ptrdiff_t>(i), data_.end(), end_us,
+            [](const DataPoint<T>& point, int64_t ts) {
+                return point.timestamp.to_microseconds() < ts;
+            });
+        size_t end_index = static_cast<size_t>(it - data_.begin());
+        buckets.push_back({i, end_index, start_us});
+        i = end_index;
+    }
+
+    // Buckets are independent, so enough of them are worth distributing
+    // over the worker pool; small resamples stay serial.
+    constexpr size_t kParallelBucketThreshold = 64;
+    std::vector<T> results(buckets.size());
+    if (buckets.size() >= kParallelBucketThreshold) {
+        batch::BatchOptions batch_options;
+        batch_options.worker_threads = 0;  // one worker per core
+        batch::ParallelBatchProcessor<size_t, std::pair<size_t, T>> processor(
+            [&](const size_t& bucket_index) {
+                const Bucket& bucket = buckets[bucket_index];
+                return std::make_pair(
+                    bucket_index,
+                    aggregate_points(data_.data() + bucket.begin,
+                                     bucket.end - bucket.begin, func));
+            },
+            batch_options);
+
+        std::vector<size_t> bucket_indices(buckets.size());
+        std::iota(bucket_indices.begin(), bucket_indices.end(), size_t{0});
+        auto reduced = processor.process(bucket_indices);
+        if (reduced.size() != buckets.size()) {
+            throw BtoonException("Parallel resample failed");
+        }
+        for (auto& [bucket_index, value] : reduced) {
+            results[bucket_index] = value;
+        }
+    } else {
+        for (size_t bucket_index = 0; bucket_index < buckets.size(); ++bucket_index) {
+            const Bucket& bucket = buckets[bucket_index];
+            results[bucket_index] = aggregate_points(
+                data_.data() + bucket.begin, bucket.end - bucket.begin, func);
+        }
+    }
+
+    for (size_t bucket_index = 0; bucket_index < buckets.size(); ++bucket_index) {
+        out.append(Timestamp::from_microseconds(buckets[bucket_index].start_us),
+                   results[bucket_index]);
+    }
+    return out;
+}
+
+template<typename T>
+std::vector<size_t> TimeSeries<T>::detect_outliers_zscore(double threshold) const {
+    static_assert(std::is_arithmetic_v<T>,
+                  "Outlier detection requires an arithmetic value type");
+    std::vector<size_t> outliers;
+    if (data_.size() < 2) {
+        return outliers;
+    }
+    std::vector<double> values(data_.size());
+    for (size_t i = 0; i < data_.size(); ++i) {
+        values[i] = static_cast<double>(data_[i].value);
+    }
+    double mean = simd::sum(values) / static_cast<double>(values.size());
+    double stddev = std::sqrt(simd::sum_squared_deviations(values, mean) /
+                              static_cast<double>(values.size()));
+    if (stddev == 0.0) {
+        return outliers;
+    }
+    simd::collect_outside_range(values, mean - threshold * stddev,
+                                mean + threshold * stddev, outliers);
+    return outliers;
+}
+
+template<typename T>
+std::vector<size_t> TimeSeries<T>::detect_outliers_iqr(double factor) const {
+    static_assert(std::is_arithmetic_v<T>,
+                  "Outlier detection requires an arithmetic value type");
+    std::vector<size_t> outliers;
+    if (data_.size() < 4) {
+        return outliers;
+    }
+    std::vector<double> values(data_.size());
+    for (size_t i = 0; i < data_.size(); ++i) {
+        values[i] = static_cast<double>(data_[i].value);
+    }
+
+    // Quartiles need order statistics, which stay scalar; the threshold
+    // sweep below is the vectorized part.
+    std::vector<double> sorted = values;
+    auto quartile = [&](double q) {
+        double rank = q * static_cast<double>(sorted.size() - 1);
+        size_t lo = static_cast<size_t>(rank);
+        std::nth_element(sorted.begin(), sorted.begin() + static_cast<ptrdiff_t>(lo), sorted.end());
+        double lower = sorted[lo];
+        if (lo + 1 >= sorted.size()) {
+            return lower;
+        }
+        double upper = *std::min_element(sorted.begin() + static_cast<ptrdiff_t>(lo) + 1, sorted.end());
+        return lower + (rank - static_cast<double>(lo)) * (upper - lower);
+    };
+    double q1 = quartile(0.25);
+    double q3 = quartile(0.75);
+    double iqr = q3 - q1;
+    simd::collect_outside_range(values, q1 - factor * iqr, q3 + factor * iqr, outliers);
+    return outliers;
+}
+
+template<typename T>
+std::vector<uint8_t> TimeSeries<T>::compress_gorilla() const {
+    static_assert(std::is_arithmetic_v<T>,
+                  "Gorilla compression requires an arithmetic value type");
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    timestamps.reserve(data_.size());
+    values.reserve(data_.size());
+    for (const auto& point : data_) {
+        timestamps.push_back(point.timestamp.to_microseconds());
+        values.push_back(static_cast<double>(point.value));
+    }
+    gorilla::ChunkedOptions options;
+    options.threads = 0;  // blocks are independent; use every core
+    return gorilla::compress_chunked(timestamps, values, options);
+}
+
+template<typename T>
+std::vector<uint8_t> TimeSeries<T>::compress(TimeSeriesCompression method) const {
+    switch (method) {
+        case TimeSeriesCompression::GORILLA:
+            return compress_gorilla();
+        default:
+            throw BtoonException("TimeSeries compression method not implemented");
+    }
+}
+
+template<typename T>
+TimeSeries<T> TimeSeries<T>::decompress(const std::vector<uint8_t>& data,
+                                        TimeSeriesCompression method) {
+    if (method != TimeSeriesCompression::GORILLA) {
+        throw BtoonException("TimeSeries compression method not implemented");
+    }
+    auto [timestamps, values] = gorilla::decompress_chunked(data, 0);
+    TimeSeries<T> series;
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        series.append(Timestamp::from_microseconds(timestamps[i]),
+                      static_cast<T>(values[i]));
+    }
+    return series;
+}
+
 /**
  * @brief Multi-variate time series
  */
@@ -369,6 +1533,81 @@ public:
 
 // ============= Utility Functions =============
 
+/**
+ * @brief Z-score outlier detection over many series in one call
+ *
+ * The ingest data-quality gate checks every series of a batch; running
+ * them through one call amortizes the pool setup, with the per-series
+ * kernels distributed over ParallelBatchProcessor workers once the batch
+ * is large enough to pay for them.
+ */
+template<typename T>
+std::vector<std::vector<size_t>> detect_outliers_zscore_batch(
+    const std::vector<TimeSeries<T>>& series, double threshold = 3.0) {
+    std::vector<std::vector<size_t>> results(series.size());
+    constexpr size_t kParallelSeriesThreshold = 4;
+    if (series.size() >= kParallelSeriesThreshold) {
+        batch::BatchOptions batch_options;
+        batch_options.worker_threads = 0;
+        batch_options.batch_size = 1;
+        batch::ParallelBatchProcessor<size_t, std::pair<size_t, std::vector<size_t>>> processor(
+            [&](const size_t& index) {
+                return std::make_pair(index, series[index].detect_outliers_zscore(threshold));
+            },
+            batch_options);
+
+        std::vector<size_t> indices(series.size());
+        std::iota(indices.begin(), indices.end(), size_t{0});
+        auto reduced = processor.process(indices);
+        if (reduced.size() != series.size()) {
+            throw BtoonException("Batched outlier detection failed");
+        }
+        for (auto& [index, outliers] : reduced) {
+            results[index] = std::move(outliers);
+        }
+    } else {
+        for (size_t index = 0; index < series.size(); ++index) {
+            results[index] = series[index].detect_outliers_zscore(threshold);
+        }
+    }
+    return results;
+}
+
+/**
+ * @brief IQR outlier detection over many series in one call
+ */
+template<typename T>
+std::vector<std::vector<size_t>> detect_outliers_iqr_batch(
+    const std::vector<TimeSeries<T>>& series, double factor = 1.5) {
+    std::vector<std::vector<size_t>> results(series.size());
+    constexpr size_t kParallelSeriesThreshold = 4;
+    if (series.size() >= kParallelSeriesThreshold) {
+        batch::BatchOptions batch_options;
+        batch_options.worker_threads = 0;
+        batch_options.batch_size = 1;
+        batch::ParallelBatchProcessor<size_t, std::pair<size_t, std::vector<size_t>>> processor(
+            [&](const size_t& index) {
+                return std::make_pair(index, series[index].detect_outliers_iqr(factor));
+            },
+            batch_options);
+
+        std::vector<size_t> indices(series.size());
+        std::iota(indices.begin(), indices.end(), size_t{0});
+        auto reduced = processor.process(indices);
+        if (reduced.size() != series.size()) {
+            throw BtoonException("Batched outlier detection failed");
+        }
+        for (auto& [index, outliers] : reduced) {
+            results[index] = std::move(outliers);
+        }
+    } else {
+        for (size_t index = 0; index < series.size(); ++index) {
+            results[index] = series[index].detect_outliers_iqr(factor);
+        }
+    }
+    return results;
+}
+
 /**
  * @brief Align multiple time-series to common timestamps
  */
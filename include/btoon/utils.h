@@ -271,12 +271,100 @@ public:
     size_t position() const { return pos_; }
     size_t remaining() const { return buffer_.size() - pos_; }
     bool eof() const { return pos_ >= buffer_.size(); }
-    
+
+    /**
+     * @brief Validate a frame once and hand out an unchecked reader for it.
+     *
+     * Bounds-checks that @p n bytes remain, advances this reader past
+     * them, and returns an UncheckedBufferReader over exactly that
+     * window. Inner-loop reads through the returned reader carry no
+     * per-read branches; the single check here stands in for all of them.
+     *
+     * @throws BtoonException if fewer than @p n bytes remain.
+     */
+    class UncheckedBufferReader unchecked(size_t n);
+
 private:
     std::span<const uint8_t> buffer_;
     size_t pos_;
 };
 
+/**
+ * @brief Buffer reader without per-read bounds checks
+ *
+ * Counterpart to BufferReader for buffers whose extent has already been
+ * validated — a frame whose length was checked on entry, or data vetted
+ * by validator::BoundsChecker. Reads are unconditional: fixed-width
+ * integers and floats are loaded with a single memcpy plus byte swap,
+ * with no branch per access. Reading past the window is undefined
+ * behavior, so construct one only from a validated range (most easily
+ * via BufferReader::unchecked()); keep using BufferReader for untrusted
+ * input.
+ */
+class UncheckedBufferReader {
+public:
+    explicit UncheckedBufferReader(std::span<const uint8_t> buffer)
+        : data_(buffer.data()), size_(buffer.size()), pos_(0) {}
+
+    void skip(size_t n) { pos_ += n; }
+
+    uint8_t readUint8() { return data_[pos_++]; }
+
+    uint16_t readUint16() {
+        uint16_t value;
+        std::memcpy(&value, data_ + pos_, 2);
+        pos_ += 2;
+        return ntoh16(value);
+    }
+
+    uint32_t readUint32() {
+        uint32_t value;
+        std::memcpy(&value, data_ + pos_, 4);
+        pos_ += 4;
+        return ntoh32(value);
+    }
+
+    uint64_t readUint64() {
+        uint64_t value;
+        std::memcpy(&value, data_ + pos_, 8);
+        pos_ += 8;
+        return ntoh64(value);
+    }
+
+    float readFloat32() {
+        uint32_t bits = readUint32();
+        float value;
+        std::memcpy(&value, &bits, 4);
+        return value;
+    }
+
+    double readFloat64() {
+        uint64_t bits = readUint64();
+        double value;
+        std::memcpy(&value, &bits, 8);
+        return value;
+    }
+
+    std::span<const uint8_t> readBytes(size_t n) {
+        std::span<const uint8_t> result(data_ + pos_, n);
+        pos_ += n;
+        return result;
+    }
+
+    size_t position() const { return pos_; }
+    size_t remaining() const { return size_ - pos_; }
+    bool eof() const { return pos_ >= size_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_;
+};
+
+inline UncheckedBufferReader BufferReader::unchecked(size_t n) {
+    return UncheckedBufferReader(readBytes(n));
+}
+
 } // namespace utils
 } // namespace btoon
 
@@ -23,6 +23,7 @@
 #include <limits>
 #include <optional>
 #include <memory>
+#include <utility>
 
 namespace btoon {
 
@@ -109,7 +110,25 @@ public:
      * @return Validation result with errors/warnings
      */
     ValidationResult validate(const Value& value) const;
-    
+
+    /**
+     * @brief Decode and validate in a single pass over the buffer
+     *
+     * validate() walks the buffer once for its pre-scans and then decodes
+     * it again; this entry point fuses the two, running the size, depth,
+     * UTF-8, float, extension and duplicate-key checks inline during the
+     * decode walk. The envelope checks (total size, compression header,
+     * zip-bomb ratio) still run up front; the SecurityValidator buffer
+     * pre-scans are subsumed by the inline enforcement.
+     *
+     * @param data Raw BTOON data to decode and validate
+     * @return The decoded value together with the validation result; on a
+     *         parse failure the value is Nil and the result carries the
+     *         decode error
+     */
+    std::pair<Value, ValidationResult> decodeValidated(std::span<const uint8_t> data) const;
+
+
     /**
      * @brief Quick validation check (less thorough but faster)
      * @param data Raw BTOON data to validate
@@ -129,6 +148,56 @@ private:
     std::unique_ptr<ValidatorImpl> pimpl_;
 };
 
+/**
+ * @brief Push-based incremental validator for frame-at-a-time input
+ *
+ * Mirrors how StreamDecoder consumes an istream: chunks are fed as they
+ * arrive and checked against the same structural limits as Validator —
+ * total size, nesting depth, string/binary/array/map sizes, UTF-8,
+ * float and extension constraints — in constant memory. Only the
+ * container stack and a few bytes of carry state are kept; payloads are
+ * never buffered. The first violation makes feed() return false, so an
+ * oversized or malformed upload is rejected after its first bad chunk
+ * instead of after full buffering.
+ *
+ * Checks that need whole-value visibility (duplicate map keys, timestamp
+ * ranges, the compression envelope) are not performed in streaming mode.
+ */
+class StreamingValidator {
+public:
+    explicit StreamingValidator(const ValidationOptions& options = ValidationOptions{});
+    ~StreamingValidator();
+
+    /**
+     * @brief Feed the next chunk of the stream
+     * @param chunk Bytes in arrival order; may split values anywhere
+     * @return True while the input seen so far is still valid
+     */
+    bool feed(std::span<const uint8_t> chunk);
+
+    /**
+     * @brief Whether any violation has been found so far
+     */
+    bool ok() const;
+
+    /**
+     * @brief Finish the stream and produce the final verdict
+     *
+     * Streams that end in the middle of a value are flagged as truncated.
+     * Use reset() to validate another stream with the same instance.
+     */
+    ValidationResult finish();
+
+    /**
+     * @brief Reset to validate a new stream
+     */
+    void reset();
+
+private:
+    class StreamingValidatorImpl;
+    std::unique_ptr<StreamingValidatorImpl> pimpl_;
+};
+
 /**
  * @brief Input bounds checker for safe parsing
  */
@@ -172,6 +241,11 @@ class UTF8Validator {
 public:
     /**
      * @brief Check if string is valid UTF-8
+     *
+     * Vectorized where the compiler targets SIMD: ASCII runs are scanned a
+     * block at a time, and on AVX2 multi-byte sequences go through a
+     * table-driven block validator instead of the byte-by-byte loop.
+     *
      * @param str String to validate
      * @return True if valid UTF-8
      */
@@ -14,6 +14,8 @@
 #include <string_view>
 #include <memory>
 #include <functional>
+#include <optional>
+#include <ostream>
 #include <unordered_map>
 #include <mutex>
 #include "btoon/capi.h"
@@ -34,7 +36,61 @@ namespace btoon {
 
 struct ValueView;
 using ArrayView = std::vector<ValueView>;
-using MapView = std::unordered_map<std::string_view, ValueView>;
+
+/**
+ * @brief Map of string keys to value views with lazy indexing
+ *
+ * Entries are stored in decode order in a flat vector; decoding never
+ * builds a hash table. Lookups on maps of up to LINEAR_SCAN_MAX keys are
+ * answered by a linear scan, which beats hashing at that size; larger
+ * maps build their hash index on the first lookup and reuse it for
+ * subsequent ones. Most decoded maps are small and read at most once, so
+ * the common case never hashes a key.
+ *
+ * Iteration yields entries in decode order. Duplicate keys are kept as
+ * decoded and lookups return the last occurrence, matching what Decoder
+ * produces for the same payload. The deferred index
+ * build mutates internal state, so concurrent lookups on the same
+ * MapView require external synchronization.
+ */
+class MapView {
+public:
+    using value_type = std::pair<std::string_view, ValueView>;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    /// Largest map answered by linear scan instead of a hash index.
+    static constexpr size_t LINEAR_SCAN_MAX = 16;
+
+    MapView();
+    MapView(const MapView& other);
+    MapView(MapView&& other) noexcept;
+    MapView& operator=(const MapView& other);
+    MapView& operator=(MapView&& other) noexcept;
+    ~MapView();
+
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+    void reserve(size_t n);
+
+    /// Appends an entry without checking for duplicates (the decode path).
+    void emplace_back(std::string_view key, ValueView value);
+
+    /// Pointer to the value for key, or nullptr if the key is absent.
+    const ValueView* find(std::string_view key) const;
+    bool contains(std::string_view key) const;
+
+    /// @throws BtoonException if the key is absent.
+    const ValueView& at(std::string_view key) const;
+
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+
+private:
+    std::vector<value_type> entries_;
+    // Built on first lookup of a map larger than LINEAR_SCAN_MAX;
+    // string_views point at the decoded buffer, not into entries_.
+    mutable std::unordered_map<std::string_view, size_t> index_;
+};
 
 struct ValueView : std::variant<
     Nil,
@@ -52,6 +108,36 @@ struct ValueView : std::variant<
     using variant::variant;
 };
 
+// MapView members that touch entries_ need ValueView to be complete, so
+// the trivial ones are defined here; lookups live in zero_copy.cpp.
+inline MapView::MapView() = default;
+inline MapView::MapView(MapView&& other) noexcept = default;
+inline MapView& MapView::operator=(MapView&& other) noexcept = default;
+inline MapView::~MapView() = default;
+
+inline size_t MapView::size() const noexcept { return entries_.size(); }
+inline bool MapView::empty() const noexcept { return entries_.empty(); }
+inline void MapView::reserve(size_t n) { entries_.reserve(n); }
+
+inline void MapView::emplace_back(std::string_view key, ValueView value) {
+    if (!index_.empty()) {
+        index_[key] = entries_.size();  // later occurrences overwrite earlier ones
+    }
+    entries_.emplace_back(key, std::move(value));
+}
+
+inline bool MapView::contains(std::string_view key) const {
+    return find(key) != nullptr;
+}
+
+inline MapView::const_iterator MapView::begin() const noexcept {
+    return entries_.begin();
+}
+
+inline MapView::const_iterator MapView::end() const noexcept {
+    return entries_.end();
+}
+
 /**
  * @brief Memory view for zero-copy access to BTOON data
  * 
@@ -181,12 +267,156 @@ public:
      * @brief Decode from raw pointer (caller manages lifetime)
      */
     ValueView decode(const uint8_t* data, size_t size);
-    
+
+    /**
+     * @brief Open a tabular payload as a typed column view
+     *
+     * Convenience wrapper around TabularView::open for buffers known to
+     * contain a columnar extension.
+     */
+    class TabularView decode_tabular(const MemoryView& view);
+
 private:
     ValueView decodeValue(const uint8_t* data, size_t size, size_t& pos, size_t depth);
     Options options_;
 };
 
+/**
+ * @brief Typed, zero-copy view over a tabular (columnar) payload
+ *
+ * Recognizes the columnar extension the encoder writes for arrays of
+ * uniform maps and exposes each column through typed accessors instead of
+ * a per-cell ValueView tree. String cells come back as string_views into
+ * the original buffer; numeric columns decode in one tight pass into
+ * caller-provided storage (the wire format is big-endian and
+ * variable-width, so a raw reinterpret of the mapped bytes is not
+ * possible, but the byte-swap pass is the only per-cell work done).
+ * Combined with MemoryMappedFile this lets scan jobs iterate columns
+ * straight over the mapped file.
+ *
+ * Only the uncompressed monolithic layouts (versions 1, 3 and 4) can be
+ * viewed in place; the chunked compressed layout requires a full decode.
+ */
+class TabularView {
+public:
+    /**
+     * @brief Column types as recorded in the tabular schema
+     */
+    enum class ColumnType : uint8_t {
+        Nil = 0,
+        Bool = 1,
+        Int = 2,
+        Uint = 3,
+        Float = 4,
+        String = 5
+    };
+
+    /**
+     * @brief Open a tabular payload
+     * @param buffer Buffer containing a columnar extension (ext type -10)
+     * @throws BtoonException if the buffer is not tabular or uses the
+     *         chunked layout
+     */
+    static TabularView open(std::span<const uint8_t> buffer);
+
+    /**
+     * @brief Open a tabular payload from a memory view
+     */
+    static TabularView open(const MemoryView& view) { return open(view.span()); }
+
+    /**
+     * @brief Check whether a buffer contains a columnar extension
+     */
+    static bool is_tabular(std::span<const uint8_t> buffer);
+
+    /**
+     * @brief Number of rows in the table
+     */
+    size_t num_rows() const { return num_rows_; }
+
+    /**
+     * @brief Number of columns in the table
+     */
+    size_t num_columns() const { return columns_.size(); }
+
+    /**
+     * @brief Name of a column (view into the original buffer)
+     */
+    std::string_view column_name(size_t col) const { return columns_.at(col).name; }
+
+    /**
+     * @brief Declared type of a column
+     */
+    ColumnType column_type(size_t col) const { return columns_.at(col).type; }
+
+    /**
+     * @brief Look up a column index by name
+     * @throws BtoonException if no column has that name
+     */
+    size_t column_index(std::string_view name) const;
+
+    /**
+     * @brief Raw value-stream bytes of a column (v4 flags/bitmap excluded)
+     */
+    std::span<const uint8_t> column_bytes(size_t col) const { return columns_.at(col).values; }
+
+    /**
+     * @brief Validity bitmap of a column (empty unless the payload is v4)
+     *
+     * Bit (row % 8) of byte (row / 8) is set for non-null rows.
+     */
+    std::span<const uint8_t> validity_bitmap(size_t col) const { return columns_.at(col).bitmap; }
+
+    /**
+     * @brief Decode an Int column into storage and return a span over it
+     *
+     * Null rows (v4) decode as 0; consult validity_bitmap() to tell them
+     * apart from genuine zeros.
+     */
+    std::span<const int64_t> int64_column(size_t col, std::vector<int64_t>& storage) const;
+
+    /**
+     * @brief Decode a Uint column into storage and return a span over it
+     *
+     * Null rows (v4) decode as 0.
+     */
+    std::span<const uint64_t> uint64_column(size_t col, std::vector<uint64_t>& storage) const;
+
+    /**
+     * @brief Decode a Float column into storage and return a span over it
+     *
+     * Null rows (v4) decode as quiet NaN. Packed v4 float columns are
+     * consumed with a single byte-swap pass.
+     */
+    std::span<const double> float64_column(size_t col, std::vector<double>& storage) const;
+
+    /**
+     * @brief String column as views into the original buffer
+     *
+     * One string_view per row, pointing at the cell's bytes in place.
+     * Null rows (v4) come back as empty views with their bitmap bit clear.
+     */
+    std::vector<std::string_view> string_column(size_t col) const;
+
+private:
+    struct Column {
+        std::string_view name;
+        ColumnType type;
+        std::span<const uint8_t> values;  // value stream, without flags/bitmap
+        std::span<const uint8_t> bitmap;  // validity bitmap, empty for v1/v3
+        bool packed_float = false;        // v4: values are raw big-endian doubles
+    };
+
+    TabularView(uint32_t version, size_t rows, std::vector<Column> columns)
+        : version_(version), num_rows_(rows), columns_(std::move(columns)) {}
+
+    bool rowValid(const Column& column, size_t row) const;
+
+    uint32_t version_;
+    size_t num_rows_;
+    std::vector<Column> columns_;
+};
+
 /**
  * @brief Memory-mapped file for zero-copy file access
  */
@@ -225,6 +455,212 @@ private:
     void* handle_;  // Platform-specific handle
 };
 
+/**
+ * @brief Memory-mapped write sink for encoding directly into a file
+ *
+ * The writable counterpart of MemoryMappedFile: creates (truncating) the
+ * target file, maps it read-write, and exposes a std::ostream whose put
+ * area IS the mapped region, so StreamEncoder frames land in the page
+ * cache with no intermediate buffer copy and no write() syscall per
+ * frame. The mapping grows by doubling (ftruncate plus remap) when the
+ * put area fills, and finish() trims the file to the bytes actually
+ * written. Intended for archive writers that are bounded by write()
+ * overhead rather than encoding speed.
+ *
+ * Usage:
+ *   MappedFileSink sink(path);
+ *   StreamEncoder encoder(sink.stream(), options);
+ *   encoder.write(...);
+ *   encoder.close();
+ *   sink.finish();  // also runs on destruction
+ */
+class MappedFileSink {
+public:
+    /// Initial file capacity; small files are trimmed by finish().
+    static constexpr size_t DEFAULT_INITIAL_CAPACITY = 1 << 20;
+
+    /**
+     * @brief Create (or truncate) path and map it for writing
+     * @throws BtoonException if the file cannot be created or mapped
+     */
+    explicit MappedFileSink(const std::string& path,
+                            size_t initial_capacity = DEFAULT_INITIAL_CAPACITY);
+    ~MappedFileSink();
+
+    MappedFileSink(const MappedFileSink&) = delete;
+    MappedFileSink& operator=(const MappedFileSink&) = delete;
+
+    /// Stream writing directly into the mapping; supports tellp().
+    std::ostream& stream() { return stream_; }
+
+    /**
+     * @brief Trim the file to the bytes written and release the mapping
+     *
+     * Idempotent; the stream must not be written to afterwards.
+     */
+    void finish();
+
+    /// Bytes written so far (the final file size once finished).
+    size_t bytes_written() const;
+
+private:
+    class MappedStreamBuf;
+
+    std::unique_ptr<MappedStreamBuf> buf_;
+    std::ostream stream_;
+};
+
+/**
+ * @brief Random access over a multi-record file with a seek index footer
+ *
+ * Reads the footer StreamEncoder::close() appends when
+ * EncodeOptions::stream_seek_index is set and provides O(1) access to any
+ * record's bytes, plus binary search over a key field for files whose
+ * records are written in ascending key order. Designed for use over
+ * MemoryMappedFile so point reads into large archives touch only the
+ * footer and the record they target.
+ */
+class IndexedRecordReader {
+public:
+    /**
+     * @brief Check whether a buffer ends with a seek index footer
+     */
+    static bool has_index(std::span<const uint8_t> buffer);
+
+    /**
+     * @brief Open a buffer containing records plus a seek index footer
+     * @throws BtoonException if no valid footer is present
+     */
+    static IndexedRecordReader open(std::span<const uint8_t> buffer);
+
+    /**
+     * @brief Open a memory-mapped file (the file must outlive the reader)
+     */
+    static IndexedRecordReader open(const MemoryMappedFile& file) {
+        return open(file.view().span());
+    }
+
+    /**
+     * @brief Number of records in the file
+     */
+    size_t num_records() const { return offsets_.size(); }
+
+    /**
+     * @brief Encoded bytes of record n, without decoding
+     */
+    std::span<const uint8_t> record_bytes(size_t n) const;
+
+    /**
+     * @brief Decode record n
+     */
+    Value record(size_t n) const;
+
+    /**
+     * @brief Binary-search for the record whose key field equals target
+     *
+     * Records must be Maps written in ascending order of the key field.
+     * Int/Uint/Float keys compare numerically, String keys lexically.
+     *
+     * @return The record index, or std::nullopt if no record matches.
+     * @throws BtoonException if a probed record is not a Map, lacks the
+     *         key field, or the key type is not comparable.
+     */
+    std::optional<size_t> find(std::string_view key, const Value& target) const;
+
+private:
+    IndexedRecordReader(std::span<const uint8_t> buffer, size_t data_end,
+                        std::vector<uint64_t> offsets)
+        : buffer_(buffer), data_end_(data_end), offsets_(std::move(offsets)) {}
+
+    Value recordKey(size_t n, std::string_view key) const;
+
+    std::span<const uint8_t> buffer_;
+    size_t data_end_;  // byte offset where record data ends and the index begins
+    std::vector<uint64_t> offsets_;
+};
+
+/**
+ * @brief Random access over a framed compressed stream
+ *
+ * Reads the frame directory footer StreamEncoder::close() appends when
+ * EncodeOptions::stream_frame_size is set. Each frame is independently
+ * compressed and checksummed, so reaching any record decompresses only the
+ * frame that contains it — reading the tail of a large archive no longer
+ * pays for the frames before it. Designed for use over MemoryMappedFile;
+ * the buffer must outlive the reader.
+ */
+class FramedStreamReader {
+public:
+    /**
+     * @brief Check whether a buffer ends with a frame directory footer
+     */
+    static bool has_frames(std::span<const uint8_t> buffer);
+
+    /**
+     * @brief Open a buffer containing frames plus a directory footer
+     * @throws BtoonException if no valid footer is present
+     */
+    static FramedStreamReader open(std::span<const uint8_t> buffer);
+
+    /**
+     * @brief Open a memory-mapped file (the file must outlive the reader)
+     */
+    static FramedStreamReader open(const MemoryMappedFile& file) {
+        return open(file.view().span());
+    }
+
+    /**
+     * @brief Number of frames in the stream
+     */
+    size_t num_frames() const { return frames_.size(); }
+
+    /**
+     * @brief Total number of records across all frames
+     */
+    size_t num_records() const { return total_records_; }
+
+    /**
+     * @brief Decompressed payload of frame n, after checksum verification
+     * @throws BtoonException on checksum or size mismatch
+     */
+    std::vector<uint8_t> frame_payload(size_t n) const;
+
+    /**
+     * @brief Decode every record in frame n
+     */
+    std::vector<Value> frame_records(size_t n) const;
+
+    /**
+     * @brief Decode record n (global index across the stream)
+     *
+     * Decompresses only the containing frame; the last decompressed frame
+     * is cached, so sequential reads within a frame pay for it once.
+     */
+    Value record(size_t n) const;
+
+private:
+    struct FrameEntry {
+        uint64_t offset;            // file offset of the frame header
+        uint32_t compressed_size;   // stored payload bytes
+        uint32_t uncompressed_size; // payload bytes after decompression
+        uint32_t checksum;          // crc32 of the stored payload
+        uint32_t record_count;      // records encoded into the frame
+        uint64_t first_record;      // global index of the frame's first record
+    };
+
+    FramedStreamReader(std::span<const uint8_t> buffer,
+                       std::vector<FrameEntry> frames, size_t total_records)
+        : buffer_(buffer), frames_(std::move(frames)), total_records_(total_records) {}
+
+    const std::vector<uint8_t>& framePayloadCached(size_t n) const;
+
+    std::span<const uint8_t> buffer_;
+    std::vector<FrameEntry> frames_;
+    size_t total_records_;
+    mutable size_t cached_frame_ = static_cast<size_t>(-1);
+    mutable std::vector<uint8_t> cached_payload_;
+};
+
 /**
  * @brief Shared memory buffer for inter-process communication
  */
@@ -0,0 +1,135 @@
+#include "btoon/async_stream.h"
+#include "btoon/decoder.h"
+
+namespace btoon {
+
+namespace {
+
+/**
+ * Bytes of the complete value at the front of data, or nullopt if data is
+ * a prefix of a longer value. Walks headers only — container children are
+ * counted, not decoded — so the cost is one pass over the markers.
+ */
+std::optional<size_t> encoded_record_size(std::span<const uint8_t> data) {
+    size_t pos = 0;
+    uint64_t items = 1;
+    while (items > 0) {
+        if (pos >= data.size()) {
+            return std::nullopt;
+        }
+        uint8_t marker = data[pos];
+        size_t header = 1;    // marker plus any length/count field
+        uint64_t payload = 0; // opaque bytes following the header
+        uint64_t children = 0;
+
+        if (marker <= 0x7f || marker >= 0xe0) {
+            // Fixints: the marker is the whole value.
+        } else if (marker >= 0x80 && marker <= 0x8f) {
+            children = 2ull * (marker & 0x0f);
+        } else if (marker >= 0x90 && marker <= 0x9f) {
+            children = marker & 0x0f;
+        } else if (marker >= 0xa0 && marker <= 0xbf) {
+            payload = marker & 0x1f;
+        } else {
+            switch (marker) {
+                case 0xc0: case 0xc2: case 0xc3:
+                    break;
+                case 0xcc: case 0xd0: payload = 1; break;
+                case 0xcd: case 0xd1: payload = 2; break;
+                case 0xce: case 0xd2: case 0xca: payload = 4; break;
+                case 0xcf: case 0xd3: case 0xcb: payload = 8; break;
+                case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8:
+                    payload = 1 + (uint64_t{1} << (marker - 0xd4));
+                    break;
+                case 0xc4: case 0xd9: header = 2; break;
+                case 0xc5: case 0xda: header = 3; break;
+                case 0xc6: case 0xdb: header = 5; break;
+                case 0xc7: header = 2; payload = 1; break;
+                case 0xc8: header = 3; payload = 1; break;
+                case 0xc9: header = 5; payload = 1; break;
+                case 0xdc: header = 3; break;
+                case 0xdd: header = 5; break;
+                case 0xde: header = 3; break;
+                case 0xdf: header = 5; break;
+                default:
+                    throw BtoonException("Invalid marker in record stream");
+            }
+            if (header > 1) {
+                if (pos + header > data.size()) {
+                    return std::nullopt;
+                }
+                uint64_t length = 0;
+                for (size_t i = 1; i < header; ++i) {
+                    length = (length << 8) | data[pos + i];
+                }
+                if (marker == 0xdc || marker == 0xdd) {
+                    children = length;
+                } else if (marker == 0xde || marker == 0xdf) {
+                    children = 2 * length;
+                } else {
+                    payload += length;
+                }
+            }
+        }
+
+        pos += header + payload;
+        if (pos > data.size()) {
+            return std::nullopt;
+        }
+        items = items - 1 + children;
+    }
+    return pos;
+}
+
+} // namespace
+
+void AsyncStreamDecoder::feed(std::span<const uint8_t> bytes) {
+    if (finished_) {
+        throw BtoonException("feed() after finish() on async stream decoder");
+    }
+    buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+    if (record_ready()) {
+        wakeReader();
+    }
+}
+
+void AsyncStreamDecoder::finish() {
+    finished_ = true;
+    wakeReader();
+}
+
+bool AsyncStreamDecoder::record_ready() const {
+    return !buffer_.empty() && encoded_record_size(buffer_).has_value();
+}
+
+void AsyncStreamDecoder::wakeReader() {
+    if (!reader_) {
+        return;
+    }
+    // Clear before resuming: the coroutine may co_await read() again and
+    // park itself, or finish and destroy its frame.
+    auto reader = std::exchange(reader_, {});
+    reader.resume();
+}
+
+std::optional<Value> AsyncStreamDecoder::takeRecord() {
+    std::optional<size_t> record_size;
+    if (!buffer_.empty()) {
+        record_size = encoded_record_size(buffer_);
+    }
+    if (record_size) {
+        Decoder decoder;
+        auto [value, consumed] = decoder.decode_and_get_pos(
+            std::span<const uint8_t>(buffer_.data(), *record_size));
+        buffer_.erase(buffer_.begin(),
+                      buffer_.begin() + static_cast<ptrdiff_t>(consumed));
+        return value;
+    }
+    if (!buffer_.empty()) {
+        // finished_ is set, otherwise the awaitable would have suspended.
+        throw BtoonException("Stream ended in the middle of a record");
+    }
+    return std::nullopt;
+}
+
+} // namespace btoon
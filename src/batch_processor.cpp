@@ -0,0 +1,195 @@
+#include "btoon/batch_processor.h"
+#include "btoon/zero_copy.h"
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace btoon {
+namespace batch {
+
+namespace {
+
+#if defined(__linux__)
+// Parses a sysfs cpulist such as "0-3,8,10-11" into CPU numbers.
+std::vector<int> parse_cpulist(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || !std::isdigit(static_cast<unsigned char>(range[0]))) {
+            continue;
+        }
+        size_t dash = range.find('-');
+        int first = std::stoi(range);
+        int last = dash == std::string::npos ? first
+                                             : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+#endif
+
+NumaTopology detect_topology() {
+    NumaTopology topology;
+#if defined(__linux__)
+    for (size_t node = 0;; ++node) {
+        std::ifstream cpulist("/sys/devices/system/node/node" +
+                              std::to_string(node) + "/cpulist");
+        if (!cpulist) {
+            break;
+        }
+        std::string list;
+        std::getline(cpulist, list);
+        auto cpus = parse_cpulist(list);
+        if (!cpus.empty()) {
+            topology.nodes.push_back({node, std::move(cpus)});
+        }
+    }
+#endif
+    if (topology.nodes.empty()) {
+        // Single-node fallback covering every CPU the runtime reports.
+        NumaTopology::Node node;
+        unsigned count = std::thread::hardware_concurrency();
+        for (unsigned cpu = 0; cpu < count; ++cpu) {
+            node.cpus.push_back(static_cast<int>(cpu));
+        }
+        topology.nodes.push_back(std::move(node));
+    }
+    return topology;
+}
+
+} // namespace
+
+const NumaTopology& NumaTopology::detect() {
+    static const NumaTopology topology = detect_topology();
+    return topology;
+}
+
+void NumaTopology::pin_current_thread(size_t node_index) const {
+    // On a single-node host pinning would only narrow the scheduler's
+    // choices without any locality benefit, so leave the thread free.
+    if (node_index >= nodes.size() || nodes.size() < 2) {
+        return;
+    }
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : nodes[node_index].cpus) {
+        CPU_SET(static_cast<size_t>(cpu), &set);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+std::vector<btoon::Value> load_shard_values(const std::string& filename) {
+    auto file = MemoryMappedFile::open(filename);
+    if (!file) {
+        throw BtoonException("Cannot memory-map file: " + filename);
+    }
+    auto span = file->view().span();
+
+    std::vector<Value> values;
+    if (FramedStreamReader::has_frames(span)) {
+        auto reader = FramedStreamReader::open(span);
+        values.reserve(reader.num_records());
+        for (size_t f = 0; f < reader.num_frames(); ++f) {
+            auto records = reader.frame_records(f);
+            values.insert(values.end(),
+                          std::make_move_iterator(records.begin()),
+                          std::make_move_iterator(records.end()));
+        }
+        return values;
+    }
+
+    Value root = decode(span);
+    if (std::holds_alternative<Array>(root)) {
+        values = std::move(std::get<Array>(root));
+    } else {
+        values.push_back(std::move(root));
+    }
+    return values;
+}
+
+std::vector<std::pair<size_t, size_t>> split_file_chunks(
+    const std::string& filename,
+    size_t num_chunks) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw BtoonException("Cannot open file: " + filename);
+    }
+    size_t file_size = static_cast<size_t>(file.tellg());
+
+    if (num_chunks == 0) {
+        num_chunks = 1;
+    }
+    num_chunks = std::min(num_chunks, std::max<size_t>(file_size, 1));
+
+    std::vector<std::pair<size_t, size_t>> chunks;
+    chunks.reserve(num_chunks);
+    size_t per_chunk = file_size / num_chunks;
+    size_t remainder = file_size % num_chunks;
+    size_t offset = 0;
+    for (size_t c = 0; c < num_chunks; ++c) {
+        size_t length = per_chunk + (c < remainder ? 1 : 0);
+        chunks.emplace_back(offset, length);
+        offset += length;
+    }
+    return chunks;
+}
+
+void process_mmap_file(const std::string& filename,
+                       std::function<void(const uint8_t*, size_t)> processor,
+                       const BatchOptions& options) {
+    auto file = MemoryMappedFile::open(filename);
+    if (!file) {
+        throw BtoonException("Cannot memory-map file: " + filename);
+    }
+    if (file->size() == 0) {
+        return;
+    }
+
+    size_t workers = options.worker_threads;
+    if (workers == 0) {
+        workers = std::thread::hardware_concurrency();
+    }
+    auto chunks = split_file_chunks(filename, workers);
+    if (chunks.size() <= 1) {
+        processor(file->data(), file->size());
+        return;
+    }
+
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    std::vector<std::thread> threads;
+    threads.reserve(chunks.size());
+    for (const auto& [offset, length] : chunks) {
+        threads.emplace_back([&, offset = offset, length = length] {
+            try {
+                processor(file->data() + offset, length);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace batch
+} // namespace btoon
@@ -45,6 +45,7 @@ const char* Value::type_name() const {
         else if constexpr (std::is_same_v<T, Binary>) return "binary";
         else if constexpr (std::is_same_v<T, Array>) return "array";
         else if constexpr (std::is_same_v<T, Map>) return "map";
+        else if constexpr (std::is_same_v<T, FlatMap>) return "map";
         else if constexpr (std::is_same_v<T, Extension>) return "extension";
         else if constexpr (std::is_same_v<T, Timestamp>) return "timestamp";
         else if constexpr (std::is_same_v<T, Date>) return "date";
@@ -56,13 +57,10 @@ const char* Value::type_name() const {
     }, *this);
 }
 
-std::vector<uint8_t> encode(const Value& value, const btoon::EncodeOptions& options) {
-    Encoder encoder;
-    encoder.setOptions(options);
-    encoder.encode(value);
-    auto encoded_data = encoder.getBuffer();
-    std::vector<uint8_t> result(encoded_data.begin(), encoded_data.end());
-
+// Compression stage of the free encode() functions: frames and returns the
+// compressed form when it pays off, or the input unchanged otherwise.
+static std::vector<uint8_t> maybe_compress(std::vector<uint8_t> result,
+                                           const btoon::EncodeOptions& options) {
     if (options.compress) {
         // Skip compression for small data
         if (result.size() < options.min_compression_size) {
@@ -70,7 +68,8 @@ std::vector<uint8_t> encode(const Value& value, const btoon::EncodeOptions& opti
         }
         
         std::vector<uint8_t> compressed;
-        
+        uint16_t dictionary_id = 0;
+
         if (options.use_profile) {
             // Use compression profile
             compressed = compress(options.compression_profile, result);
@@ -88,18 +87,24 @@ std::vector<uint8_t> encode(const Value& value, const btoon::EncodeOptions& opti
             } else {
                 return result; // No compression beneficial
             }
+        } else if (options.compression_dictionary_id != 0) {
+            // Shared-dictionary compression; the registered dictionary
+            // determines the algorithm.
+            dictionary_id = options.compression_dictionary_id;
+            compressed = compress_with_dictionary(result, dictionary_id,
+                                                  options.compression_level);
         } else {
             // Use specified algorithm and level
             CompressionAlgorithm algo = options.compression_algorithm;
             if (algo == CompressionAlgorithm::NONE) {
                 return result;
             }
-            
+
             int level = options.compression_level;
             if (level == 0 && options.compression_preset != CompressionLevel::CUSTOM) {
                 level = get_numeric_level(algo, options.compression_preset);
             }
-            
+
             compressed = compress(algo, result, level);
         }
         
@@ -120,11 +125,16 @@ std::vector<uint8_t> encode(const Value& value, const btoon::EncodeOptions& opti
                 header.algorithm = static_cast<uint8_t>(actual_algo);
             } else if (options.use_profile) {
                 header.algorithm = static_cast<uint8_t>(options.compression_profile.algorithm);
+            } else if (dictionary_id != 0) {
+                auto dict = DictionaryRegistry::instance().find(dictionary_id);
+                header.algorithm = static_cast<uint8_t>(dict->algorithm);
             } else {
                 header.algorithm = static_cast<uint8_t>(options.compression_algorithm);
             }
-            
-            header.reserved = 0;
+
+            // The reserved field doubles as the dictionary ID (0 = none),
+            // so pre-dictionary frames remain readable unchanged.
+            header.reserved = htons(dictionary_id);
             header.compressed_size = htonl(compressed.size());
             header.uncompressed_size = htonl(result.size());
             
@@ -142,10 +152,40 @@ std::vector<uint8_t> encode(const Value& value, const btoon::EncodeOptions& opti
     return result;
 }
 
-Value decode(std::span<const uint8_t> data, const btoon::DecodeOptions& options) {
+std::vector<uint8_t> encode(const Value& value, const btoon::EncodeOptions& options) {
+    Encoder encoder;
+    encoder.setOptions(options);
+    encoder.encode(value);
+    auto encoded_data = encoder.getBuffer();
+    return maybe_compress({encoded_data.begin(), encoded_data.end()}, options);
+}
+
+std::vector<uint8_t> encode(const Value& value, const btoon::EncodeOptions& options,
+                            CodecStats& stats) {
+    Encoder encoder;
+    encoder.setOptions(options);
+    encoder.setStatsEnabled(true);
+    encoder.encode(value);
+    auto encoded_data = encoder.getBuffer();
+    std::vector<uint8_t> raw(encoded_data.begin(), encoded_data.end());
+    size_t raw_size = raw.size();
+    auto result = maybe_compress(std::move(raw), options);
+    stats.merge(encoder.statistics());
+    if (options.compress) {
+        stats.bytes_before_compression += raw_size;
+        stats.bytes_after_compression += result.size();
+    }
+    return result;
+}
+
+// Decompression stage of the free decode() functions: when the buffer
+// carries a compression header, decompresses into storage and returns a
+// span over it; otherwise returns the input unchanged.
+static std::span<const uint8_t> maybe_decompress(std::span<const uint8_t> data,
+                                                 const btoon::DecodeOptions& options,
+                                                 std::vector<uint8_t>& decompressed) {
     std::span<const uint8_t> actual_data = data;
-    std::vector<uint8_t> decompressed;
-    
+
     if (options.auto_decompress && data.size() >= sizeof(CompressionHeader)) {
         // Check for compression header
         CompressionHeader header;
@@ -162,9 +202,12 @@ Value decode(std::span<const uint8_t> data, const btoon::DecodeOptions& options)
                 
                 auto compressed_data = data.subspan(sizeof(header), header.compressed_size);
                 CompressionAlgorithm algo = static_cast<CompressionAlgorithm>(header.algorithm);
-                
+                uint16_t dictionary_id = ntohs(header.reserved);
+
                 try {
-                    decompressed = decompress(algo, compressed_data);
+                    decompressed = dictionary_id != 0
+                        ? decompress_with_dictionary(compressed_data, dictionary_id)
+                        : decompress(algo, compressed_data);
                     
                     // Validate decompressed size
                     if (decompressed.size() != header.uncompressed_size) {
@@ -182,10 +225,31 @@ Value decode(std::span<const uint8_t> data, const btoon::DecodeOptions& options)
         }
     }
 
+    return actual_data;
+}
+
+Value decode(std::span<const uint8_t> data, const btoon::DecodeOptions& options) {
+    std::vector<uint8_t> decompressed;
+    auto actual_data = maybe_decompress(data, options, decompressed);
     Decoder decoder;
     return decoder.decode(actual_data);
 }
 
+Value decode(std::span<const uint8_t> data, const btoon::DecodeOptions& options,
+             CodecStats& stats) {
+    std::vector<uint8_t> decompressed;
+    auto actual_data = maybe_decompress(data, options, decompressed);
+    Decoder decoder;
+    decoder.setStatsEnabled(true);
+    Value result = decoder.decode(actual_data);
+    stats.merge(decoder.statistics());
+    if (!decompressed.empty()) {
+        stats.bytes_before_compression += actual_data.size();
+        stats.bytes_after_compression += data.size();
+    }
+    return result;
+}
+
 bool is_tabular(const Array& arr) {
     if (arr.size() < 2) {
         return false;
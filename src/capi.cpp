@@ -1,9 +1,92 @@
 #include "btoon/capi.h"
 #include "btoon/btoon.h"
+#include "btoon/memory_pool.h"
+#include "btoon/zero_copy.h"
+#include "btoon/stream_decoder.h"
+#include <array>
+#include <istream>
+#include <memory>
+#include <streambuf>
 #include <vector>
 #include <string>
 #include <cstring>
 
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+// An arena owns a MemoryPool; every node, string, and element table of a
+// tree decoded via btoon_decode_arena() comes out of it, so destroying
+// the arena frees the document without walking it.
+struct btoon_arena {
+    btoon::MemoryPool pool;
+
+    explicit btoon_arena(size_t initial_capacity)
+        : pool(initial_capacity != 0 ? initial_capacity
+                                     : btoon::MemoryPool::DEFAULT_BLOCK_SIZE) {}
+};
+
+// A mapped file is just a handle around the C++ mapping; closing it
+// unmaps the region, so any views decoded from it die with it.
+struct btoon_mmap {
+    std::unique_ptr<btoon::MemoryMappedFile> file;
+};
+
+namespace {
+
+// A streambuf over a caller-owned buffer; no copy is made.
+class BufferStreambuf : public std::streambuf {
+public:
+    BufferStreambuf(const uint8_t* data, size_t size) {
+        // std::streambuf's get area is non-const; the decoder only reads.
+        char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+        setg(begin, begin, begin + size);
+    }
+};
+
+// A streambuf reading from an open file descriptor with a small
+// read-ahead buffer, so each decoded message does not mean a syscall.
+class FdStreambuf : public std::streambuf {
+public:
+    explicit FdStreambuf(int fd) : fd_(fd) {}
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+#ifdef _WIN32
+        int n = _read(fd_, buffer_.data(), static_cast<unsigned int>(buffer_.size()));
+#else
+        ssize_t n = ::read(fd_, buffer_.data(), buffer_.size());
+#endif
+        if (n <= 0) {
+            return traits_type::eof();
+        }
+        setg(buffer_.data(), buffer_.data(), buffer_.data() + n);
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    int fd_;
+    std::array<char, 8192> buffer_;
+};
+
+}  // namespace
+
+// A stream decoder bundles the source streambuf, the istream over it,
+// and the C++ StreamDecoder that holds the position between calls.
+struct btoon_stream_decoder {
+    std::unique_ptr<std::streambuf> source;
+    std::istream stream;
+    btoon::StreamDecoder decoder;
+
+    btoon_stream_decoder(std::unique_ptr<std::streambuf> src, const btoon::DecodeOptions& options)
+        : source(std::move(src)), stream(source.get()), decoder(stream, options) {}
+};
+
 // --- Helper Functions ---
 
 // Convert C++ btoon::Value to C btoon_value_t
@@ -104,6 +187,190 @@ static btoon_value_t* to_c_value(const btoon::Value& cpp_value) {
     return c_value;
 }
 
+// Arena-backed counterpart of to_c_value: identical tree shape, but every
+// allocation is served by the arena's pool and nothing is individually
+// freed. All C-side node types are trivial, so raw pool memory suffices.
+template <typename T>
+static T* arena_alloc(btoon::MemoryPool& pool, size_t count) {
+    if (count == 0) return nullptr;
+    return static_cast<T*>(pool.allocate(count * sizeof(T)));
+}
+
+static char* arena_copy_chars(btoon::MemoryPool& pool, const char* data, size_t len) {
+    char* copy = static_cast<char*>(pool.allocate(len + 1));
+    std::memcpy(copy, data, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+// Copies an exception message into the arena for an error out-parameter.
+// The copy is itself an allocation that can throw; fall back to a static
+// string rather than let bad_alloc escape across the C boundary.
+static const char* arena_error_message(btoon::MemoryPool& pool, const char* what) noexcept {
+    try {
+        return arena_copy_chars(pool, what, std::strlen(what));
+    } catch (...) {
+        return "BTOON error (message allocation failed)";
+    }
+}
+
+static btoon_value_t* to_c_value_arena(const btoon::Value& cpp_value, btoon::MemoryPool& pool) {
+    btoon_value_t* c_value = arena_alloc<btoon_value_t>(pool, 1);
+
+    std::visit([&](auto&& arg) {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, btoon::Nil>) {
+            c_value->type = BTOON_TYPE_NIL;
+        } else if constexpr (std::is_same_v<T, btoon::Bool>) {
+            c_value->type = BTOON_TYPE_BOOL;
+            c_value->as.b = arg;
+        } else if constexpr (std::is_same_v<T, btoon::Int>) {
+            c_value->type = BTOON_TYPE_INT;
+            c_value->as.i = arg;
+        } else if constexpr (std::is_same_v<T, btoon::Uint>) {
+            c_value->type = BTOON_TYPE_UINT;
+            c_value->as.u = arg;
+        } else if constexpr (std::is_same_v<T, btoon::Float>) {
+            c_value->type = BTOON_TYPE_FLOAT;
+            c_value->as.f = arg;
+        } else if constexpr (std::is_same_v<T, btoon::String>) {
+            c_value->type = BTOON_TYPE_STRING;
+            c_value->as.s.ptr = arena_copy_chars(pool, arg.data(), arg.length());
+            c_value->as.s.len = arg.length();
+        } else if constexpr (std::is_same_v<T, btoon::Binary>) {
+            c_value->type = BTOON_TYPE_BINARY;
+            uint8_t* bin_data = arena_alloc<uint8_t>(pool, arg.size());
+            std::memcpy(bin_data, arg.data(), arg.size());
+            c_value->as.bin.ptr = bin_data;
+            c_value->as.bin.len = arg.size();
+        } else if constexpr (std::is_same_v<T, btoon::Array>) {
+            c_value->type = BTOON_TYPE_ARRAY;
+            c_value->as.a.len = arg.size();
+            c_value->as.a.elements = arena_alloc<btoon_value_t*>(pool, arg.size());
+            for (size_t i = 0; i < arg.size(); ++i) {
+                c_value->as.a.elements[i] = to_c_value_arena(arg[i], pool);
+            }
+        } else if constexpr (std::is_same_v<T, btoon::Map>) {
+            c_value->type = BTOON_TYPE_MAP;
+            c_value->as.m.len = arg.size();
+            c_value->as.m.keys = arena_alloc<btoon_string_t>(pool, arg.size());
+            c_value->as.m.values = arena_alloc<btoon_value_t*>(pool, arg.size());
+            size_t i = 0;
+            for (const auto& [key, val] : arg) {
+                c_value->as.m.keys[i] = {arena_copy_chars(pool, key.data(), key.length()),
+                                         key.length()};
+                c_value->as.m.values[i] = to_c_value_arena(val, pool);
+                i++;
+            }
+        } else if constexpr (std::is_same_v<T, btoon::Extension>) {
+            c_value->type = BTOON_TYPE_EXTENSION;
+            c_value->as.ext.type = arg.type;
+            uint8_t* ext_data = arena_alloc<uint8_t>(pool, arg.data.size());
+            std::memcpy(ext_data, arg.data.data(), arg.data.size());
+            c_value->as.ext.ptr = ext_data;
+            c_value->as.ext.len = arg.data.size();
+        } else if constexpr (std::is_same_v<T, btoon::Timestamp>) {
+            c_value->type = BTOON_TYPE_TIMESTAMP;
+            c_value->as.ts.seconds = arg.seconds;
+        } else if constexpr (std::is_same_v<T, btoon::Date>) {
+            c_value->type = BTOON_TYPE_DATE;
+            c_value->as.date.milliseconds = arg.milliseconds;
+        } else if constexpr (std::is_same_v<T, btoon::DateTime>) {
+            c_value->type = BTOON_TYPE_DATETIME;
+            c_value->as.dt.nanoseconds = arg.nanoseconds;
+        } else if constexpr (std::is_same_v<T, btoon::BigInt>) {
+            c_value->type = BTOON_TYPE_BIGINT;
+            uint8_t* bi_bytes = arena_alloc<uint8_t>(pool, arg.bytes.size());
+            std::memcpy(bi_bytes, arg.bytes.data(), arg.bytes.size());
+            c_value->as.bi.ptr = bi_bytes;
+            c_value->as.bi.len = arg.bytes.size();
+        } else if constexpr (std::is_same_v<T, btoon::VectorFloat>) {
+            c_value->type = BTOON_TYPE_VECTOR_FLOAT;
+            c_value->as.vf.len = arg.data.size();
+            float* vf_data = arena_alloc<float>(pool, arg.data.size());
+            std::memcpy(vf_data, arg.data.data(), arg.data.size() * sizeof(float));
+            c_value->as.vf.ptr = vf_data;
+        } else if constexpr (std::is_same_v<T, btoon::VectorDouble>) {
+            c_value->type = BTOON_TYPE_VECTOR_DOUBLE;
+            c_value->as.vd.len = arg.data.size();
+            double* vd_data = arena_alloc<double>(pool, arg.data.size());
+            std::memcpy(vd_data, arg.data.data(), arg.data.size() * sizeof(double));
+            c_value->as.vd.ptr = vd_data;
+        } else {
+            c_value->type = BTOON_TYPE_NIL; // Fallback for unsupported types
+        }
+    }, cpp_value);
+
+    return c_value;
+}
+
+// View-based counterpart: node structures come from the arena, but
+// string/binary payloads and map keys point straight into the buffer the
+// ValueView was decoded from. Extension payloads are owned by the
+// ValueView, so those are the one case that still copies.
+static btoon_value_t* view_to_c_value(const btoon::ValueView& view, btoon::MemoryPool& pool) {
+    btoon_value_t* c_value = arena_alloc<btoon_value_t>(pool, 1);
+
+    std::visit([&](auto&& arg) {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, btoon::Nil>) {
+            c_value->type = BTOON_TYPE_NIL;
+        } else if constexpr (std::is_same_v<T, btoon::Bool>) {
+            c_value->type = BTOON_TYPE_BOOL;
+            c_value->as.b = arg;
+        } else if constexpr (std::is_same_v<T, btoon::Int>) {
+            c_value->type = BTOON_TYPE_INT;
+            c_value->as.i = arg;
+        } else if constexpr (std::is_same_v<T, btoon::Uint>) {
+            c_value->type = BTOON_TYPE_UINT;
+            c_value->as.u = arg;
+        } else if constexpr (std::is_same_v<T, btoon::Float>) {
+            c_value->type = BTOON_TYPE_FLOAT;
+            c_value->as.f = arg;
+        } else if constexpr (std::is_same_v<T, std::string_view>) {
+            c_value->type = BTOON_TYPE_STRING;
+            c_value->as.s.ptr = arg.data();  // into the caller's buffer
+            c_value->as.s.len = arg.size();
+        } else if constexpr (std::is_same_v<T, std::span<const uint8_t>>) {
+            c_value->type = BTOON_TYPE_BINARY;
+            c_value->as.bin.ptr = arg.data();  // into the caller's buffer
+            c_value->as.bin.len = arg.size();
+        } else if constexpr (std::is_same_v<T, btoon::ArrayView>) {
+            c_value->type = BTOON_TYPE_ARRAY;
+            c_value->as.a.len = arg.size();
+            c_value->as.a.elements = arena_alloc<btoon_value_t*>(pool, arg.size());
+            for (size_t i = 0; i < arg.size(); ++i) {
+                c_value->as.a.elements[i] = view_to_c_value(arg[i], pool);
+            }
+        } else if constexpr (std::is_same_v<T, btoon::MapView>) {
+            c_value->type = BTOON_TYPE_MAP;
+            c_value->as.m.len = arg.size();
+            c_value->as.m.keys = arena_alloc<btoon_string_t>(pool, arg.size());
+            c_value->as.m.values = arena_alloc<btoon_value_t*>(pool, arg.size());
+            size_t i = 0;
+            for (const auto& [key, val] : arg) {
+                c_value->as.m.keys[i] = {key.data(), key.size()};  // buffer-backed
+                c_value->as.m.values[i] = view_to_c_value(val, pool);
+                i++;
+            }
+        } else if constexpr (std::is_same_v<T, btoon::Timestamp>) {
+            c_value->type = BTOON_TYPE_TIMESTAMP;
+            c_value->as.ts.seconds = arg.seconds;
+        } else if constexpr (std::is_same_v<T, btoon::Extension>) {
+            c_value->type = BTOON_TYPE_EXTENSION;
+            c_value->as.ext.type = arg.type;
+            uint8_t* ext_data = arena_alloc<uint8_t>(pool, arg.data.size());
+            std::memcpy(ext_data, arg.data.data(), arg.data.size());
+            c_value->as.ext.ptr = ext_data;
+            c_value->as.ext.len = arg.data.size();
+        } else {
+            c_value->type = BTOON_TYPE_NIL; // Fallback for unsupported types
+        }
+    }, view);
+
+    return c_value;
+}
+
 static btoon::Value to_cpp_value(const btoon_value_t* c_value) {
     if (!c_value) {
         return btoon::Nil();
@@ -284,6 +551,164 @@ BTOON_API btoon_value_t* btoon_decode(const uint8_t* data, size_t size, const bt
     }
 }
 
+BTOON_API btoon_arena_t* btoon_arena_create(size_t initial_capacity) {
+    try {
+        return new btoon_arena(initial_capacity);
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+BTOON_API btoon_value_t* btoon_decode_arena(btoon_arena_t* arena, const uint8_t* data, size_t size, const btoon_decode_options_t* options, const char** error) {
+    if (!arena) {
+        if (error) *error = "Arena is NULL";
+        return nullptr;
+    }
+    try {
+        btoon::DecodeOptions cpp_options;
+        if (options) {
+            cpp_options.auto_decompress = options->decompress;
+            cpp_options.strict = options->strict;
+        }
+        btoon::Value cpp_value = btoon::decode({data, size}, cpp_options);
+        return to_c_value_arena(cpp_value, arena->pool);
+    } catch (const std::exception& e) {
+        if (error) {
+            // The message lives in the arena like everything else.
+            *error = arena_error_message(arena->pool, e.what());
+        }
+        return nullptr;
+    }
+}
+
+BTOON_API size_t btoon_arena_total_allocated(const btoon_arena_t* arena) {
+    return arena ? arena->pool.total_allocated() : 0;
+}
+
+BTOON_API void btoon_arena_destroy(btoon_arena_t* arena) {
+    delete arena;
+}
+
+BTOON_API btoon_value_t* btoon_decode_view(btoon_arena_t* arena, const uint8_t* data, size_t size, const char** error) {
+    if (!arena) {
+        if (error) *error = "Arena is NULL";
+        return nullptr;
+    }
+    try {
+        btoon::ZeroCopyDecoder decoder;
+        btoon::ValueView view = decoder.decode(data, size);
+        return view_to_c_value(view, arena->pool);
+    } catch (const std::exception& e) {
+        if (error) {
+            *error = arena_error_message(arena->pool, e.what());
+        }
+        return nullptr;
+    }
+}
+
+BTOON_API btoon_mmap_t* btoon_mmap_open(const char* path) {
+    if (!path) return nullptr;
+    try {
+        auto file = btoon::MemoryMappedFile::open(path);
+        if (!file) return nullptr;
+        return new btoon_mmap{std::move(file)};
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+BTOON_API const uint8_t* btoon_mmap_data(const btoon_mmap_t* file) {
+    return file ? file->file->data() : nullptr;
+}
+
+BTOON_API size_t btoon_mmap_size(const btoon_mmap_t* file) {
+    return file ? file->file->size() : 0;
+}
+
+BTOON_API void btoon_mmap_close(btoon_mmap_t* file) {
+    delete file;
+}
+
+static btoon::DecodeOptions stream_decode_options(const btoon_decode_options_t* options) {
+    btoon::DecodeOptions cpp_options;
+    if (options) {
+        cpp_options.auto_decompress = options->decompress;
+        cpp_options.strict = options->strict;
+    }
+    return cpp_options;
+}
+
+BTOON_API btoon_stream_decoder_t* btoon_stream_decoder_create_buffer(const uint8_t* data, size_t size, const btoon_decode_options_t* options) {
+    if (!data && size != 0) return nullptr;
+    try {
+        auto source = std::make_unique<BufferStreambuf>(data, size);
+        return new btoon_stream_decoder(std::move(source), stream_decode_options(options));
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+BTOON_API btoon_stream_decoder_t* btoon_stream_decoder_create_fd(int fd, const btoon_decode_options_t* options) {
+    if (fd < 0) return nullptr;
+    try {
+        auto source = std::make_unique<FdStreambuf>(fd);
+        return new btoon_stream_decoder(std::move(source), stream_decode_options(options));
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+BTOON_API btoon_value_t* btoon_stream_decoder_next(btoon_stream_decoder_t* decoder, btoon_arena_t* arena, const char** error) {
+    if (error) *error = nullptr;
+    if (!decoder || !arena) {
+        if (error) *error = "Decoder or arena is NULL";
+        return nullptr;
+    }
+    try {
+        auto value = decoder->decoder.read();
+        if (!value) return nullptr;  // end of stream, *error stays NULL
+        return to_c_value_arena(*value, arena->pool);
+    } catch (const std::exception& e) {
+        if (error) {
+            *error = arena_error_message(arena->pool, e.what());
+        }
+        return nullptr;
+    }
+}
+
+BTOON_API size_t btoon_stream_decoder_next_batch(btoon_stream_decoder_t* decoder, btoon_arena_t* arena, btoon_value_t** out_values, size_t max_values, const char** error) {
+    if (error) *error = nullptr;
+    if (!decoder || !arena || !out_values) {
+        if (error) *error = "Decoder, arena, or output array is NULL";
+        return 0;
+    }
+    try {
+        std::vector<btoon::Value> batch = decoder->decoder.read_batch(max_values);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            out_values[i] = to_c_value_arena(batch[i], arena->pool);
+        }
+        return batch.size();
+    } catch (const std::exception& e) {
+        if (error) {
+            *error = arena_error_message(arena->pool, e.what());
+        }
+        return 0;
+    }
+}
+
+BTOON_API bool btoon_stream_decoder_has_next(btoon_stream_decoder_t* decoder) {
+    if (!decoder) return false;
+    try {
+        return decoder->decoder.has_next();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+BTOON_API void btoon_stream_decoder_destroy(btoon_stream_decoder_t* decoder) {
+    delete decoder;
+}
+
 BTOON_API void btoon_free_result(btoon_result_t result) {
     delete[] result.data;
     delete[] result.error;
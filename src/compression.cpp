@@ -11,6 +11,7 @@
 
 #ifdef BTOON_WITH_ZSTD
 #include <zstd.h>
+#include <zdict.h>
 #endif
 
 #ifdef BTOON_WITH_BROTLI
@@ -23,10 +24,72 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 
 namespace btoon {
 
+namespace {
+
+/// Cheap statistical probe of a buffer's compressibility.
+///
+/// Samples a bounded number of bytes spread across the payload (not just its
+/// head, which for framed formats is unrepresentative), so the cost is a few
+/// microseconds regardless of payload size.
+struct DataProbe {
+    float entropy_bits;     ///< Shannon entropy of sampled bytes, 0..8 bits/byte.
+    float repeat_fraction;  ///< Fraction of sampled bytes equal to a nearby byte.
+};
+
+DataProbe probe_data(std::span<const uint8_t> data) {
+    // Up to four 1 KiB windows: head, two interior strides, and tail.
+    constexpr size_t kWindow = 1024;
+    constexpr size_t kWindows = 4;
+
+    std::array<uint32_t, 256> freq = {0};
+    size_t sampled = 0;
+    size_t repeats = 0;
+
+    auto scan = [&](size_t offset, size_t len) {
+        for (size_t i = 0; i < len; ++i) {
+            uint8_t b = data[offset + i];
+            freq[b]++;
+            // Two cheap repetition signals: runs, and 8-byte-period matches
+            // (struct arrays and columnar numeric data repeat at that pitch).
+            if (offset + i >= 8 &&
+                (b == data[offset + i - 1] || b == data[offset + i - 8])) {
+                repeats++;
+            }
+        }
+        sampled += len;
+    };
+
+    if (data.size() <= kWindow * kWindows) {
+        scan(0, data.size());
+    } else {
+        size_t stride = (data.size() - kWindow) / (kWindows - 1);
+        for (size_t w = 0; w < kWindows; ++w) {
+            scan(w * stride, kWindow);
+        }
+    }
+
+    if (sampled == 0) {
+        return {0.0f, 0.0f};
+    }
+
+    float entropy = 0.0f;
+    for (uint32_t f : freq) {
+        if (f > 0) {
+            float p = static_cast<float>(f) / static_cast<float>(sampled);
+            entropy -= p * std::log2(p);
+        }
+    }
+
+    return {entropy, static_cast<float>(repeats) / static_cast<float>(sampled)};
+}
+
+} // namespace
+
 // --- Compression Profile Implementations ---
 
 CompressionProfile CompressionProfile::realtime() {
@@ -129,34 +192,26 @@ int get_numeric_level(CompressionAlgorithm algo, CompressionLevel level) {
 }
 
 CompressionAlgorithm select_best_algorithm(std::span<const uint8_t> data, bool prefer_speed) {
-    // Simple heuristic-based selection
+    // Selection runs on a bounded sample, so AUTO mode costs the same for a
+    // 1 KB message and a 100 MB blob.
     size_t size = data.size();
-    
+
     // For very small data, prefer no compression
     if (size < 128) {
         return CompressionAlgorithm::NONE;
     }
-    
-    // Check data entropy (simple check for compressibility)
-    bool highly_compressible = false;
-    if (size >= 256) {
-        // Sample first 256 bytes for patterns
-        std::array<int, 256> freq = {0};
-        size_t sample_size = std::min(size_t(1024), size);
-        for (size_t i = 0; i < sample_size; ++i) {
-            freq[data[i]]++;
-        }
-        
-        // Count unique bytes
-        int unique_bytes = 0;
-        for (int f : freq) {
-            if (f > 0) unique_bytes++;
-        }
-        
-        // If less than 50% unique bytes, data is likely highly compressible
-        highly_compressible = (unique_bytes < 128);
+
+    DataProbe probe = probe_data(data);
+
+    // Near-random bytes (already compressed or encrypted) are not worth the
+    // CPU: any codec will just burn cycles to break even.
+    if (probe.entropy_bits > 7.8f && probe.repeat_fraction < 0.05f) {
+        return CompressionAlgorithm::NONE;
     }
-    
+
+    // Low entropy or strong short-range repetition both predict good ratios.
+    bool highly_compressible = probe.entropy_bits < 5.5f || probe.repeat_fraction > 0.3f;
+
     if (prefer_speed) {
 #ifdef BTOON_WITH_LZ4
         return CompressionAlgorithm::LZ4;
@@ -194,20 +249,12 @@ float estimate_compression_ratio(CompressionAlgorithm algo, std::span<const uint
     // This is a simplified heuristic
     size_t size = data.size();
     if (size < 64) return 1.0f; // No compression for tiny data
-    
-    // Sample entropy
-    std::array<int, 256> freq = {0};
-    size_t sample_size = std::min(size_t(1024), size);
-    for (size_t i = 0; i < sample_size; ++i) {
-        freq[data[i]]++;
-    }
-    
-    int unique_bytes = 0;
-    for (int f : freq) {
-        if (f > 0) unique_bytes++;
-    }
-    
-    float entropy_factor = unique_bytes / 256.0f;
+
+    // Shannon entropy of a spread sample is the compressibility signal; a
+    // byte-level codec cannot beat entropy_bits/8 of the original size, and
+    // repetition lets dictionary codecs do better than the byte entropy alone.
+    DataProbe probe = probe_data(data);
+    float entropy_factor = std::max(0.0f, probe.entropy_bits / 8.0f - 0.5f * probe.repeat_fraction);
     
     // Rough estimates based on algorithm and entropy
     switch (algo) {
@@ -334,6 +381,100 @@ std::vector<uint8_t> decompress(CompressionAlgorithm algorithm, std::span<const
     }
 }
 
+// --- Dictionary Compression ---
+
+DictionaryRegistry& DictionaryRegistry::instance() {
+    static DictionaryRegistry registry;
+    return registry;
+}
+
+void DictionaryRegistry::registerDictionary(CompressionDictionary dictionary) {
+    if (dictionary.id == 0) {
+        throw BtoonException("Dictionary ID 0 is reserved for 'no dictionary'");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    dictionaries_[dictionary.id] =
+        std::make_shared<const CompressionDictionary>(std::move(dictionary));
+}
+
+std::shared_ptr<const CompressionDictionary> DictionaryRegistry::find(uint16_t id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = dictionaries_.find(id);
+    return it == dictionaries_.end() ? nullptr : it->second;
+}
+
+void DictionaryRegistry::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dictionaries_.clear();
+}
+
+CompressionDictionary train_zstd_dictionary(const std::vector<std::vector<uint8_t>>& samples,
+                                            size_t max_dict_size, uint16_t id) {
+#ifdef BTOON_WITH_ZSTD
+    if (samples.empty()) {
+        throw BtoonException("Dictionary training requires sample payloads");
+    }
+
+    std::vector<uint8_t> flat;
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        flat.insert(flat.end(), sample.begin(), sample.end());
+        sizes.push_back(sample.size());
+    }
+
+    std::vector<uint8_t> dict(max_dict_size);
+    size_t dict_size = ZDICT_trainFromBuffer(dict.data(), max_dict_size, flat.data(),
+                                             sizes.data(), static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(dict_size)) {
+        throw BtoonException("Dictionary training failed: " +
+                             std::string(ZDICT_getErrorName(dict_size)));
+    }
+    dict.resize(dict_size);
+
+    CompressionDictionary result;
+    result.id = id;
+    result.algorithm = CompressionAlgorithm::ZSTD;
+    result.data = std::move(dict);
+    return result;
+#else
+    (void)samples; (void)max_dict_size; (void)id;
+    throw BtoonException("ZSTD support not compiled in");
+#endif
+}
+
+std::vector<uint8_t> compress_with_dictionary(std::span<const uint8_t> data,
+                                              uint16_t dictionary_id, int level) {
+    auto dictionary = DictionaryRegistry::instance().find(dictionary_id);
+    if (!dictionary) {
+        throw BtoonException("Unknown compression dictionary: " + std::to_string(dictionary_id));
+    }
+    switch (dictionary->algorithm) {
+#ifdef BTOON_WITH_ZSTD
+        case CompressionAlgorithm::ZSTD:
+            return compress_zstd_with_dictionary(data, *dictionary, level);
+#endif
+        default:
+            throw BtoonException("Dictionary compression not supported for this algorithm");
+    }
+}
+
+std::vector<uint8_t> decompress_with_dictionary(std::span<const uint8_t> compressed_data,
+                                                uint16_t dictionary_id) {
+    auto dictionary = DictionaryRegistry::instance().find(dictionary_id);
+    if (!dictionary) {
+        throw BtoonException("Unknown compression dictionary: " + std::to_string(dictionary_id));
+    }
+    switch (dictionary->algorithm) {
+#ifdef BTOON_WITH_ZSTD
+        case CompressionAlgorithm::ZSTD:
+            return decompress_zstd_with_dictionary(compressed_data, *dictionary);
+#endif
+        default:
+            throw BtoonException("Dictionary decompression not supported for this algorithm");
+    }
+}
+
 // --- Zlib Implementation ---
 
 std::vector<uint8_t> compress_zlib(std::span<const uint8_t> data, int level) {
@@ -518,6 +659,64 @@ std::vector<uint8_t> decompress_zstd(std::span<const uint8_t> compressed_data) {
     }
     return decompressed;
 }
+
+std::vector<uint8_t> compress_zstd_with_dictionary(std::span<const uint8_t> data,
+                                                   const CompressionDictionary& dictionary,
+                                                   int level) {
+    if (data.empty()) return {};
+
+    std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> cctx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    if (!cctx) {
+        throw BtoonException("Failed to allocate ZSTD compression context");
+    }
+
+    size_t max_dst_size = ZSTD_compressBound(data.size());
+    std::vector<uint8_t> compressed(max_dst_size);
+
+    size_t compressed_size = ZSTD_compress_usingDict(
+        cctx.get(),
+        compressed.data(), max_dst_size,
+        data.data(), data.size(),
+        dictionary.data.data(), dictionary.data.size(),
+        level == 0 ? 1 : level  // ZSTD level 0 is invalid
+    );
+
+    if (ZSTD_isError(compressed_size)) {
+        throw BtoonException("ZSTD dictionary compression failed: " +
+                             std::string(ZSTD_getErrorName(compressed_size)));
+    }
+    compressed.resize(compressed_size);
+    return compressed;
+}
+
+std::vector<uint8_t> decompress_zstd_with_dictionary(std::span<const uint8_t> compressed_data,
+                                                     const CompressionDictionary& dictionary) {
+    unsigned long long const decompressed_size =
+        ZSTD_getFrameContentSize(compressed_data.data(), compressed_data.size());
+    if (decompressed_size == ZSTD_CONTENTSIZE_ERROR || decompressed_size == ZSTD_CONTENTSIZE_UNKNOWN) {
+        throw BtoonException("ZSTD decompression failed: unable to determine decompressed size.");
+    }
+
+    std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> dctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    if (!dctx) {
+        throw BtoonException("Failed to allocate ZSTD decompression context");
+    }
+
+    std::vector<uint8_t> decompressed(decompressed_size);
+
+    size_t actual_size = ZSTD_decompress_usingDict(
+        dctx.get(),
+        decompressed.data(), decompressed_size,
+        compressed_data.data(), compressed_data.size(),
+        dictionary.data.data(), dictionary.data.size()
+    );
+
+    if (ZSTD_isError(actual_size) || actual_size != decompressed_size) {
+        throw BtoonException("ZSTD dictionary decompression failed: " +
+                             std::string(ZSTD_getErrorName(actual_size)));
+    }
+    return decompressed;
+}
 #endif
 
 #ifdef BTOON_WITH_BROTLI
@@ -0,0 +1,428 @@
+#include "btoon/decimal.h"
+#include "btoon/btoon.h"
+
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+
+namespace btoon {
+
+namespace {
+
+__extension__ using int128 = __int128;
+
+// Checked int64 multiply through __int128; financial mantissas should
+// never be anywhere near the edge, so overflow is a caller error.
+int64_t checked_mul(int64_t a, int64_t b) {
+    int128 product = static_cast<int128>(a) * b;
+    if (product > INT64_MAX || product < INT64_MIN) {
+        throw BtoonException("Decimal overflow");
+    }
+    return static_cast<int64_t>(product);
+}
+
+int64_t checked_add(int64_t a, int64_t b) {
+    int128 sum = static_cast<int128>(a) + b;
+    if (sum > INT64_MAX || sum < INT64_MIN) {
+        throw BtoonException("Decimal overflow");
+    }
+    return static_cast<int64_t>(sum);
+}
+
+} // namespace
+
+int64_t Decimal::ipow10(int32_t exp) {
+    if (exp < 0 || exp > 18) {
+        throw BtoonException("Decimal exponent out of range");
+    }
+    static constexpr std::array<int64_t, 19> powers = {
+        1LL,
+        10LL,
+        100LL,
+        1000LL,
+        10000LL,
+        100000LL,
+        1000000LL,
+        10000000LL,
+        100000000LL,
+        1000000000LL,
+        10000000000LL,
+        100000000000LL,
+        1000000000000LL,
+        10000000000000LL,
+        100000000000000LL,
+        1000000000000000LL,
+        10000000000000000LL,
+        100000000000000000LL,
+        1000000000000000000LL,
+    };
+    return powers[static_cast<size_t>(exp)];
+}
+
+Decimal::Decimal() : coefficient_(0), exponent_(0) {}
+
+Decimal::Decimal(int64_t value) : coefficient_(value), exponent_(0) {}
+
+Decimal::Decimal(double value) {
+    *this = from_double(value);
+}
+
+Decimal::Decimal(const std::string& str) : coefficient_(0), exponent_(0) {
+    size_t pos = 0;
+    bool negative = false;
+    if (pos < str.size() && (str[pos] == '+' || str[pos] == '-')) {
+        negative = str[pos] == '-';
+        pos++;
+    }
+    bool any_digits = false;
+    int32_t fraction_digits = 0;
+    bool in_fraction = false;
+    for (; pos < str.size(); ++pos) {
+        char c = str[pos];
+        if (c == '.') {
+            if (in_fraction) {
+                throw BtoonException("Invalid decimal string: " + str);
+            }
+            in_fraction = true;
+            continue;
+        }
+        if (!std::isdigit(static_cast<unsigned char>(c))) {
+            throw BtoonException("Invalid decimal string: " + str);
+        }
+        any_digits = true;
+        coefficient_ = checked_add(checked_mul(coefficient_, 10), c - '0');
+        if (in_fraction) {
+            fraction_digits++;
+        }
+    }
+    if (!any_digits) {
+        throw BtoonException("Invalid decimal string: " + str);
+    }
+    if (negative) {
+        coefficient_ = -coefficient_;
+    }
+    exponent_ = -fraction_digits;
+    reduce();
+}
+
+Decimal::Decimal(int64_t coefficient, int32_t exponent)
+    : coefficient_(coefficient), exponent_(exponent) {}
+
+Decimal Decimal::from_string(const std::string& str) {
+    return Decimal(str);
+}
+
+Decimal Decimal::from_double(double value, int32_t precision) {
+    if (precision < 0 || precision > 18) {
+        throw BtoonException("Decimal precision out of range");
+    }
+    double scaled = value * static_cast<double>(ipow10(precision));
+    if (scaled > static_cast<double>(INT64_MAX) ||
+        scaled < static_cast<double>(INT64_MIN)) {
+        throw BtoonException("Decimal overflow");
+    }
+    Decimal result(static_cast<int64_t>(std::llround(scaled)), -precision);
+    result.reduce();
+    return result;
+}
+
+Decimal Decimal::from_cents(int64_t cents) {
+    return Decimal(cents, -2);
+}
+
+std::string Decimal::to_string() const {
+    if (exponent_ >= 0) {
+        std::string digits = std::to_string(coefficient_);
+        digits.append(static_cast<size_t>(exponent_), '0');
+        return digits;
+    }
+    uint64_t magnitude = coefficient_ < 0
+        ? ~static_cast<uint64_t>(coefficient_) + 1
+        : static_cast<uint64_t>(coefficient_);
+    std::string digits = std::to_string(magnitude);
+    size_t places = static_cast<size_t>(-exponent_);
+    if (digits.size() <= places) {
+        digits.insert(0, places - digits.size() + 1, '0');
+    }
+    digits.insert(digits.size() - places, ".");
+    if (coefficient_ < 0) {
+        digits.insert(0, "-");
+    }
+    return digits;
+}
+
+double Decimal::to_double() const {
+    return static_cast<double>(coefficient_) * std::pow(10.0, exponent_);
+}
+
+int64_t Decimal::to_cents() const {
+    Decimal rounded = round(2);
+    return checked_mul(rounded.coefficient_, ipow10(rounded.exponent_ + 2));
+}
+
+Decimal Decimal::normalize() const {
+    Decimal result = *this;
+    result.reduce();
+    return result;
+}
+
+Decimal Decimal::round(int32_t decimal_places) const {
+    int32_t target_exponent = -decimal_places;
+    if (exponent_ >= target_exponent) {
+        return *this;
+    }
+    int64_t divisor = ipow10(target_exponent - exponent_);
+    int64_t quotient = coefficient_ / divisor;
+    int64_t remainder = coefficient_ % divisor;
+    // Round half away from zero
+    if (remainder >= divisor / 2) {
+        quotient++;
+    } else if (-remainder >= divisor / 2) {
+        quotient--;
+    }
+    return Decimal(quotient, target_exponent);
+}
+
+Decimal Decimal::truncate(int32_t decimal_places) const {
+    int32_t target_exponent = -decimal_places;
+    if (exponent_ >= target_exponent) {
+        return *this;
+    }
+    return Decimal(coefficient_ / ipow10(target_exponent - exponent_),
+                   target_exponent);
+}
+
+void Decimal::reduce() {
+    if (coefficient_ == 0) {
+        exponent_ = 0;
+        return;
+    }
+    while (exponent_ < 0 && coefficient_ % 10 == 0) {
+        coefficient_ /= 10;
+        exponent_++;
+    }
+}
+
+Decimal Decimal::align_exponents(const Decimal& a, const Decimal& b,
+                                 int64_t& coeff_a, int64_t& coeff_b) {
+    int32_t common = std::min(a.exponent_, b.exponent_);
+    coeff_a = checked_mul(a.coefficient_, ipow10(a.exponent_ - common));
+    coeff_b = checked_mul(b.coefficient_, ipow10(b.exponent_ - common));
+    return Decimal(0, common);
+}
+
+Decimal Decimal::operator+(const Decimal& other) const {
+    int64_t coeff_a;
+    int64_t coeff_b;
+    Decimal common = align_exponents(*this, other, coeff_a, coeff_b);
+    Decimal result(checked_add(coeff_a, coeff_b), common.exponent_);
+    result.reduce();
+    return result;
+}
+
+Decimal Decimal::operator-(const Decimal& other) const {
+    return *this + (-other);
+}
+
+Decimal Decimal::operator*(const Decimal& other) const {
+    Decimal result(checked_mul(coefficient_, other.coefficient_),
+                   exponent_ + other.exponent_);
+    result.reduce();
+    return result;
+}
+
+Decimal Decimal::operator/(const Decimal& other) const {
+    if (other.coefficient_ == 0) {
+        throw BtoonException("Decimal division by zero");
+    }
+    // Widen the dividend by 18 digits so the quotient keeps full int64
+    // precision, then strip what is not needed.
+    int128 scaled = static_cast<int128>(coefficient_) * ipow10(18);
+    int128 quotient = scaled / other.coefficient_;
+    int32_t exponent = exponent_ - other.exponent_ - 18;
+    while (quotient > INT64_MAX || quotient < INT64_MIN) {
+        quotient /= 10;
+        exponent++;
+    }
+    Decimal result(static_cast<int64_t>(quotient), exponent);
+    result.reduce();
+    return result;
+}
+
+Decimal Decimal::operator%(const Decimal& other) const {
+    Decimal quotient = (*this / other).truncate(0);
+    return *this - quotient * other;
+}
+
+Decimal& Decimal::operator+=(const Decimal& other) { return *this = *this + other; }
+Decimal& Decimal::operator-=(const Decimal& other) { return *this = *this - other; }
+Decimal& Decimal::operator*=(const Decimal& other) { return *this = *this * other; }
+Decimal& Decimal::operator/=(const Decimal& other) { return *this = *this / other; }
+
+Decimal Decimal::operator-() const {
+    return Decimal(-coefficient_, exponent_);
+}
+
+Decimal Decimal::abs() const {
+    return coefficient_ < 0 ? -*this : *this;
+}
+
+bool Decimal::operator==(const Decimal& other) const {
+    int32_t common = std::min(exponent_, other.exponent_);
+    int128 a = static_cast<int128>(coefficient_) * ipow10(exponent_ - common);
+    int128 b = static_cast<int128>(other.coefficient_) * ipow10(other.exponent_ - common);
+    return a == b;
+}
+
+bool Decimal::operator!=(const Decimal& other) const { return !(*this == other); }
+
+bool Decimal::operator<(const Decimal& other) const {
+    int32_t common = std::min(exponent_, other.exponent_);
+    int128 a = static_cast<int128>(coefficient_) * ipow10(exponent_ - common);
+    int128 b = static_cast<int128>(other.coefficient_) * ipow10(other.exponent_ - common);
+    return a < b;
+}
+
+bool Decimal::operator<=(const Decimal& other) const { return !(other < *this); }
+bool Decimal::operator>(const Decimal& other) const { return other < *this; }
+bool Decimal::operator>=(const Decimal& other) const { return !(*this < other); }
+
+Decimal Decimal::multiply_and_round(const Decimal& other, int32_t decimal_places) const {
+    return (*this * other).round(decimal_places);
+}
+
+Decimal Decimal::divide_and_round(const Decimal& other, int32_t decimal_places) const {
+    return (*this / other).round(decimal_places);
+}
+
+std::vector<uint8_t> Decimal::to_bytes() const {
+    // 8 bytes coefficient + 4 bytes exponent, big-endian
+    std::vector<uint8_t> bytes(12);
+    uint64_t coeff = static_cast<uint64_t>(coefficient_);
+    for (int i = 7; i >= 0; --i) {
+        bytes[static_cast<size_t>(i)] = static_cast<uint8_t>(coeff & 0xff);
+        coeff >>= 8;
+    }
+    uint32_t exp = static_cast<uint32_t>(exponent_);
+    for (int i = 3; i >= 0; --i) {
+        bytes[static_cast<size_t>(8 + i)] = static_cast<uint8_t>(exp & 0xff);
+        exp >>= 8;
+    }
+    return bytes;
+}
+
+Decimal Decimal::from_bytes(const std::vector<uint8_t>& bytes) {
+    if (bytes.size() != 12) {
+        throw BtoonException("Invalid decimal payload length");
+    }
+    uint64_t coeff = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        coeff = (coeff << 8) | bytes[i];
+    }
+    uint32_t exp = 0;
+    for (size_t i = 8; i < 12; ++i) {
+        exp = (exp << 8) | bytes[i];
+    }
+    return Decimal(static_cast<int64_t>(coeff), static_cast<int32_t>(exp));
+}
+
+std::ostream& operator<<(std::ostream& os, const Decimal& dec) {
+    return os << dec.to_string();
+}
+
+std::istream& operator>>(std::istream& is, Decimal& dec) {
+    std::string token;
+    is >> token;
+    dec = Decimal(token);
+    return is;
+}
+
+// ===== Currency =====
+
+Currency::Currency(const Decimal& amount, Precision precision)
+    : amount_(amount), precision_(precision) {
+    round_to_precision();
+}
+
+Currency::Currency(double amount, Precision precision)
+    : amount_(Decimal::from_double(amount, precision)), precision_(precision) {
+    round_to_precision();
+}
+
+Currency::Currency(int64_t cents)
+    : amount_(Decimal::from_cents(cents)), precision_(CENTS) {}
+
+void Currency::round_to_precision() {
+    amount_ = amount_.round(static_cast<int32_t>(precision_));
+}
+
+Currency Currency::operator+(const Currency& other) const {
+    return Currency(amount_ + other.amount_,
+                    std::max(precision_, other.precision_));
+}
+
+Currency Currency::operator-(const Currency& other) const {
+    return Currency(amount_ - other.amount_,
+                    std::max(precision_, other.precision_));
+}
+
+Currency Currency::operator*(const Decimal& multiplier) const {
+    return Currency(amount_ * multiplier, precision_);
+}
+
+Currency Currency::operator/(const Decimal& divisor) const {
+    return Currency(amount_ / divisor, precision_);
+}
+
+bool Currency::operator==(const Currency& other) const {
+    return amount_ == other.amount_;
+}
+
+bool Currency::operator<(const Currency& other) const {
+    return amount_ < other.amount_;
+}
+
+std::string Currency::to_string(bool with_symbol, const std::string& symbol) const {
+    // Fixed number of decimal places, so $1.50 never prints as "1.5"
+    int32_t places = static_cast<int32_t>(precision_);
+    Decimal rounded = amount_.round(places);
+    int64_t subunits = rounded.coefficient();
+    for (int32_t i = 0; i < rounded.exponent() + places; ++i) {
+        subunits = checked_mul(subunits, 10);
+    }
+    bool negative = subunits < 0;
+    uint64_t magnitude = negative
+        ? ~static_cast<uint64_t>(subunits) + 1
+        : static_cast<uint64_t>(subunits);
+    std::string digits = std::to_string(magnitude);
+    if (digits.size() <= static_cast<size_t>(places)) {
+        digits.insert(0, static_cast<size_t>(places) - digits.size() + 1, '0');
+    }
+    digits.insert(digits.size() - static_cast<size_t>(places), ".");
+    if (negative) {
+        digits.insert(0, "-");
+    }
+    return with_symbol ? symbol + digits : digits;
+}
+
+int64_t Currency::to_cents() const {
+    return amount_.to_cents();
+}
+
+// ===== Percentage =====
+
+Percentage::Percentage(const Decimal& value) : value_(value) {}
+
+Percentage::Percentage(double value) : value_(Decimal::from_double(value)) {}
+
+Decimal Percentage::apply_to(const Decimal& base) const {
+    return base * as_decimal();
+}
+
+Currency Percentage::apply_to(const Currency& base) const {
+    return base * as_decimal();
+}
+
+} // namespace btoon
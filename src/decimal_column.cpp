@@ -0,0 +1,162 @@
+#include "btoon/decimal_column.h"
+
+namespace btoon {
+
+namespace {
+
+__extension__ using int128 = __int128;
+
+int64_t pow10_checked(int32_t exp) {
+    if (exp < 0 || exp > 18) {
+        throw BtoonException("Decimal column scale out of range");
+    }
+    int64_t result = 1;
+    for (int32_t i = 0; i < exp; ++i) {
+        result *= 10;
+    }
+    return result;
+}
+
+} // namespace
+
+DecimalColumn::DecimalColumn(int32_t scale) : scale_(scale) {
+    if (scale < 0 || scale > 18) {
+        throw BtoonException("Decimal column scale out of range");
+    }
+}
+
+DecimalColumn DecimalColumn::from_values(const std::vector<Decimal>& values,
+                                         int32_t scale) {
+    DecimalColumn column(scale);
+    column.reserve(values.size());
+    for (const auto& value : values) {
+        column.push_back(value);
+    }
+    return column;
+}
+
+int64_t DecimalColumn::rescale_mantissa(const Decimal& value) const {
+    Decimal scaled = value.round(scale_);
+    // scaled.exponent() >= -scale_ after rounding; widen to the column scale
+    int128 mantissa = static_cast<int128>(scaled.coefficient()) *
+                      pow10_checked(scaled.exponent() + scale_);
+    if (mantissa > INT64_MAX || mantissa < INT64_MIN) {
+        throw BtoonException("Decimal overflow");
+    }
+    return static_cast<int64_t>(mantissa);
+}
+
+void DecimalColumn::push_back(const Decimal& value) {
+    mantissas_.push_back(rescale_mantissa(value));
+}
+
+Decimal DecimalColumn::at(size_t index) const {
+    if (index >= mantissas_.size()) {
+        throw BtoonException("Decimal column index out of range");
+    }
+    return Decimal(mantissas_[index], -scale_);
+}
+
+Decimal DecimalColumn::sum() const {
+    int128 total = 0;
+    for (int64_t mantissa : mantissas_) {
+        total += mantissa;
+    }
+    if (total > INT64_MAX || total < INT64_MIN) {
+        throw BtoonException("Decimal overflow");
+    }
+    return Decimal(static_cast<int64_t>(total), -scale_);
+}
+
+DecimalColumn DecimalColumn::rescaled(int32_t new_scale) const {
+    DecimalColumn result(new_scale);
+    result.mantissas_.resize(mantissas_.size());
+    if (new_scale >= scale_) {
+        int64_t factor = pow10_checked(new_scale - scale_);
+        for (size_t i = 0; i < mantissas_.size(); ++i) {
+            int128 widened = static_cast<int128>(mantissas_[i]) * factor;
+            if (widened > INT64_MAX || widened < INT64_MIN) {
+                throw BtoonException("Decimal overflow");
+            }
+            result.mantissas_[i] = static_cast<int64_t>(widened);
+        }
+    } else {
+        int64_t divisor = pow10_checked(scale_ - new_scale);
+        int64_t half = divisor / 2;
+        for (size_t i = 0; i < mantissas_.size(); ++i) {
+            int64_t quotient = mantissas_[i] / divisor;
+            int64_t remainder = mantissas_[i] % divisor;
+            // Round half away from zero, matching Decimal::round()
+            if (remainder >= half) {
+                quotient++;
+            } else if (-remainder >= half) {
+                quotient--;
+            }
+            result.mantissas_[i] = quotient;
+        }
+    }
+    return result;
+}
+
+std::vector<uint8_t> DecimalColumn::less_than(const Decimal& threshold) const {
+    int64_t limit = rescale_mantissa(threshold);
+    std::vector<uint8_t> mask(mantissas_.size());
+    for (size_t i = 0; i < mantissas_.size(); ++i) {
+        mask[i] = mantissas_[i] < limit ? 1 : 0;
+    }
+    return mask;
+}
+
+std::vector<uint8_t> DecimalColumn::greater_than(const Decimal& threshold) const {
+    int64_t limit = rescale_mantissa(threshold);
+    std::vector<uint8_t> mask(mantissas_.size());
+    for (size_t i = 0; i < mantissas_.size(); ++i) {
+        mask[i] = mantissas_[i] > limit ? 1 : 0;
+    }
+    return mask;
+}
+
+Value DecimalColumn::to_value() const {
+    Extension ext;
+    ext.type = EXT_TYPE;
+    ext.data.reserve(4 + mantissas_.size() * 8);
+    uint32_t scale_be = static_cast<uint32_t>(scale_);
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        ext.data.push_back(static_cast<uint8_t>((scale_be >> shift) & 0xff));
+    }
+    for (int64_t mantissa : mantissas_) {
+        uint64_t bits = static_cast<uint64_t>(mantissa);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            ext.data.push_back(static_cast<uint8_t>((bits >> shift) & 0xff));
+        }
+    }
+    return ext;
+}
+
+DecimalColumn DecimalColumn::from_value(const Value& value) {
+    const auto* ext = std::get_if<Extension>(&value);
+    if (!ext || ext->type != EXT_TYPE) {
+        throw BtoonException("Not a decimal column payload");
+    }
+    if (ext->data.size() < 4 || (ext->data.size() - 4) % 8 != 0) {
+        throw BtoonException("Invalid decimal column payload length");
+    }
+    uint32_t scale = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        scale = (scale << 8) | ext->data[i];
+    }
+    DecimalColumn column(static_cast<int32_t>(scale));
+    size_t count = (ext->data.size() - 4) / 8;
+    column.mantissas_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t bits = 0;
+        const uint8_t* p = ext->data.data() + 4 + i * 8;
+        for (size_t b = 0; b < 8; ++b) {
+            bits = (bits << 8) | p[b];
+        }
+        column.mantissas_.push_back(static_cast<int64_t>(bits));
+    }
+    return column;
+}
+
+} // namespace btoon
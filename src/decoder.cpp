@@ -9,9 +9,20 @@
 #endif
 
 #include "btoon/decoder.h"
+#include "btoon/validator.h"
 #include <algorithm>
+#include <bit>
+#include <chrono>
 #include <cstring>
 #include <stdexcept>
+#include <string_view>
+#include <unordered_set>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace btoon {
 
@@ -32,6 +43,54 @@ inline uint64_t ntohll(uint64_t value) {
 }
 #endif
 
+// Length of the run of fixint markers (positive 0x00-0x7f or negative
+// 0xe0-0xff) starting at data. Fixints are self-contained single bytes, so a
+// run of n bytes is exactly n array elements; scanning them in SIMD blocks
+// avoids the per-element type-tag dispatch on integer-heavy arrays. Mirrors
+// the compile-time SIMD selection used by Encoder::simd_copy.
+static size_t scan_fixint_run(const uint8_t* data, size_t max) {
+    size_t i = 0;
+    // As a signed byte, every fixint marker is >= -32; container, string and
+    // width-prefixed markers all fall in [0x80, 0xdf] (signed < -32).
+#if defined(__AVX2__)
+    const __m256i threshold = _mm256_set1_epi8(-33);
+    while (i + 32 <= max) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t fixint_mask = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpgt_epi8(chunk, threshold)));
+        if (fixint_mask != 0xffffffffu) {
+            return i + static_cast<size_t>(std::countr_one(fixint_mask));
+        }
+        i += 32;
+    }
+#elif defined(__SSE2__)
+    const __m128i threshold = _mm_set1_epi8(-33);
+    while (i + 16 <= max) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t fixint_mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(chunk, threshold)));
+        if (fixint_mask != 0xffffu) {
+            return i + static_cast<size_t>(std::countr_one(fixint_mask));
+        }
+        i += 16;
+    }
+#elif defined(__ARM_NEON)
+    const int8x16_t threshold = vdupq_n_s8(-32);
+    while (i + 16 <= max) {
+        int8x16_t chunk = vld1q_s8(reinterpret_cast<const int8_t*>(data + i));
+        uint8x16_t is_fixint = vcgeq_s8(chunk, threshold);
+        if (vminvq_u8(is_fixint) != 0xff) {
+            break;  // mixed chunk: finish with the scalar tail below
+        }
+        i += 16;
+    }
+#endif
+    while (i < max && (data[i] <= 0x7f || data[i] >= 0xe0)) {
+        ++i;
+    }
+    return i;
+}
+
 static void check_overflow(size_t pos, size_t count, size_t buffer_size) {
     // Check for integer overflow first
     if (count > buffer_size || pos > buffer_size - count) {
@@ -53,10 +112,26 @@ Decoder::~Decoder() {
     }
 }
 
+void Decoder::noteDecoded(const Value& value, size_t bytes) const {
+    stats_.messages++;
+    stats_.bytes_processed += bytes;
+    stats_.count_value(value);
+}
+
+CodecStats Decoder::statistics() const {
+    CodecStats snapshot = stats_;
+    for (const auto& size_class : pool_->size_class_stats()) {
+        snapshot.pool_reuses += size_class.reuses;
+        snapshot.pool_free_bytes += size_class.free_bytes;
+    }
+    return snapshot;
+}
+
 Value Decoder::decode(std::span<const uint8_t> buffer) const {
     size_t pos = 0;
     auto data_span = useSecurity_ ? verifyAndExtractData(buffer) : buffer;
     Value result = decode(data_span, pos);
+    if (collectStats_) noteDecoded(result, pos);
     return result;
 }
 
@@ -64,16 +139,138 @@ std::pair<Value, size_t> Decoder::decode_and_get_pos(std::span<const uint8_t> bu
     size_t pos = 0;
     auto data_span = useSecurity_ ? verifyAndExtractData(buffer) : buffer;
     Value result = decode(data_span, pos);
+    if (collectStats_) noteDecoded(result, pos);
     return {result, pos};
 }
 
+Value Decoder::decodeIterative(std::span<const uint8_t> buffer) const {
+    size_t pos = 0;
+    auto data_span = useSecurity_ ? verifyAndExtractData(buffer) : buffer;
+    Value result = decodeIterative(data_span, pos);
+    if (collectStats_) noteDecoded(result, pos);
+    return result;
+}
+
+Value Decoder::decodeValidated(std::span<const uint8_t> buffer,
+                               const ValidationOptions& options,
+                               ValidationResult& result) {
+    validation_ = &options;
+    validationResult_ = &result;
+    validationDepth_ = 0;
+    try {
+        Value value = decode(buffer);
+        validation_ = nullptr;
+        validationResult_ = nullptr;
+        return value;
+    } catch (...) {
+        validation_ = nullptr;
+        validationResult_ = nullptr;
+        throw;
+    }
+}
+
+Value Decoder::decodeIterative(std::span<const uint8_t> buffer, size_t& pos) const {
+    // One frame per open container. Frames live on the heap, so nesting depth
+    // is bounded by memory rather than thread stack size.
+    struct Frame {
+        Value container;  // Array or Map under construction
+        size_t remaining; // elements (array) or entries (map) still expected
+        String key;       // pending key for the next map entry
+    };
+    std::vector<Frame> stack;
+    Value completed;
+
+    // Attach a finished value to the enclosing frame; cascades upward when a
+    // container fills. Returns true once the document root is complete.
+    auto place = [&](Value&& v) -> bool {
+        for (;;) {
+            if (stack.empty()) {
+                completed = std::move(v);
+                return true;
+            }
+            Frame& top = stack.back();
+            if (auto* arr = std::get_if<Array>(&top.container)) {
+                arr->push_back(std::move(v));
+            } else if (auto* flat = std::get_if<FlatMap>(&top.container)) {
+                flat->entries.emplace_back(std::move(top.key), std::move(v));
+            } else {
+                std::get<Map>(top.container).insert_or_assign(std::move(top.key), std::move(v));
+            }
+            if (--top.remaining > 0) {
+                return false;
+            }
+            v = std::move(top.container);
+            if (auto* flat = std::get_if<FlatMap>(&v)) {
+                flat->finalize();
+            }
+            stack.pop_back();
+        }
+    };
+
+    for (;;) {
+        if (!stack.empty() && !std::holds_alternative<Array>(stack.back().container)) {
+            stack.back().key = decodeString(buffer, pos);
+        }
+
+        check_overflow(pos, 1, buffer.size());
+        uint8_t marker = buffer[pos];
+
+        bool is_map = (marker >= 0x80 && marker <= 0x8f) || marker == 0xde || marker == 0xdf;
+        bool is_array = (marker >= 0x90 && marker <= 0x9f) || marker == 0xdc || marker == 0xdd;
+
+        if (is_map || is_array) {
+            pos++;
+            size_t len = 0;
+            if (marker >= 0x80 && marker <= 0x9f) {
+                len = marker & 0x0f;
+            } else if (marker == 0xdc || marker == 0xde) {
+                check_overflow(pos, 2, buffer.size());
+                uint16_t l; std::memcpy(&l, &buffer[pos], 2); len = ntohs(l); pos += 2;
+            } else {
+                check_overflow(pos, 4, buffer.size());
+                uint32_t l; std::memcpy(&l, &buffer[pos], 4); len = ntohl(l); pos += 4;
+            }
+            if (len == 0) {
+                Value empty = is_map ? (useFlatMaps_ ? Value(FlatMap{}) : Value(Map{}))
+                                     : Value(Array{});
+                if (place(std::move(empty))) return completed;
+                continue;
+            }
+            Frame frame;
+            if (is_map) {
+                if (useFlatMaps_) {
+                    FlatMap flat;
+                    flat.reserve(len);
+                    frame.container = std::move(flat);
+                } else {
+                    frame.container = Map{};
+                }
+            } else {
+                Array arr;
+                arr.reserve(len);
+                frame.container = std::move(arr);
+            }
+            frame.remaining = len;
+            stack.push_back(std::move(frame));
+            continue;
+        }
+
+        // Leaf markers (including extensions) share the recursive reference
+        // path, which does not recurse for non-container values.
+        Value leaf = decode(buffer, pos);
+        if (place(std::move(leaf))) return completed;
+    }
+}
+
 Value Decoder::decode(std::span<const uint8_t> buffer, size_t& pos) const {
     check_overflow(pos, 1, buffer.size());
     uint8_t marker = buffer[pos];
 
     if (marker <= 0x7f) { pos++; return Value(static_cast<uint64_t>(marker)); }
     if (marker >= 0xe0) { pos++; return Value(static_cast<int64_t>(static_cast<int8_t>(marker))); }
-    if (marker >= 0x80 && marker <= 0x8f) { return Value(decodeMap(buffer, pos)); }
+    if (marker >= 0x80 && marker <= 0x8f) {
+        return useFlatMaps_ ? Value(decodeFlatMap(buffer, pos)) : Value(decodeMap(buffer, pos));
+    }
     if (marker >= 0x90 && marker <= 0x9f) { return Value(decodeArray(buffer, pos)); }
     if (marker >= 0xa0 && marker <= 0xbf) { return Value(decodeString(buffer, pos)); }
 
@@ -86,11 +283,26 @@ Value Decoder::decode(std::span<const uint8_t> buffer, size_t& pos) const {
         case 0xd0: case 0xd1: case 0xd2: case 0xd3: return Value(decodeInt(buffer, pos));
         case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8: // Fixed extensions
         case 0xc7: case 0xc8: case 0xc9: { // Variable extensions
-            return decodeExtension(buffer, pos);
+            Value ext = decodeExtension(buffer, pos);
+            if (validation_) {
+                if (const auto* ts = std::get_if<Timestamp>(&ext)) {
+                    if (!TypeValidator::validateTimestamp(*ts)) {
+                        validationResult_->addError("Invalid timestamp value");
+                    }
+                } else if (const auto* generic = std::get_if<Extension>(&ext)) {
+                    if (validation_->validate_extension_types &&
+                        !TypeValidator::validateExtension(*generic)) {
+                        validationResult_->addError("Invalid extension type: " +
+                                                    std::to_string(generic->type));
+                    }
+                }
+            }
+            return ext;
         }
         case 0xd9: case 0xda: case 0xdb: return Value(decodeString(buffer, pos)); // str8, str16, str32
         case 0xdc: case 0xdd: return Value(decodeArray(buffer, pos)); // array16, array32
-        case 0xde: case 0xdf: return Value(decodeMap(buffer, pos)); // map16, map32
+        case 0xde: case 0xdf: // map16, map32
+            return useFlatMaps_ ? Value(decodeFlatMap(buffer, pos)) : Value(decodeMap(buffer, pos));
         default: throw BtoonException("Unknown marker");
     }
 }
@@ -136,6 +348,10 @@ Float Decoder::decodeFloat(std::span<const uint8_t> buffer, size_t& pos) const {
             uint32_t val; std::memcpy(&val, &buffer[pos], 4); val = ntohl(val);
             float f; std::memcpy(&f, &val, 4);
             pos += 4;
+            if (validation_ && !TypeValidator::validateFloat(f, validation_->allow_nan_float,
+                                                             validation_->allow_inf_float)) {
+                validationResult_->addError("Invalid float value");
+            }
             return f;
         }
         case 0xcb: {
@@ -143,6 +359,10 @@ Float Decoder::decodeFloat(std::span<const uint8_t> buffer, size_t& pos) const {
             uint64_t val; std::memcpy(&val, &buffer[pos], 8); val = ntohll(val);
             double d; std::memcpy(&d, &val, 8);
             pos += 8;
+            if (validation_ && !TypeValidator::validateFloat(d, validation_->allow_nan_float,
+                                                             validation_->allow_inf_float)) {
+                validationResult_->addError("Invalid float value");
+            }
             return d;
         }
         default: throw BtoonException("Invalid float marker");
@@ -158,10 +378,25 @@ String Decoder::decodeString(std::span<const uint8_t> buffer, size_t& pos) const
     else if (marker == 0xdb) { check_overflow(pos, 4, buffer.size()); uint32_t l; std::memcpy(&l, &buffer[pos], 4); len = ntohl(l); pos += 4; }
     else { throw BtoonException("Invalid string marker"); }
     check_overflow(pos, len, buffer.size());
-    char* str_data = static_cast<char*>(pool_->allocate(len));
-    std::memcpy(str_data, &buffer[pos], len);
+    // Construct straight from the input buffer: short strings land in the
+    // string's inline (SSO) storage with no heap allocation at all, and long
+    // strings are copied once instead of being staged through the pool.
+    String str(reinterpret_cast<const char*>(&buffer[pos]), len);
     pos += len;
-    return String(str_data, len);
+    if (validation_) {
+        if (len > validation_->max_string_length) {
+            validationResult_->addError("String exceeds maximum length");
+        }
+        if (validation_->require_utf8_strings && !UTF8Validator::isValid(str)) {
+            validationResult_->addError("Invalid UTF-8 string");
+        }
+        if (validation_->collect_stats && validationResult_->stats) {
+            validationResult_->stats->string_count++;
+            validationResult_->stats->largest_string =
+                std::max(validationResult_->stats->largest_string, str.length());
+        }
+    }
+    return str;
 }
 
 Binary Decoder::decodeBinary(std::span<const uint8_t> buffer, size_t& pos) const {
@@ -172,10 +407,20 @@ Binary Decoder::decodeBinary(std::span<const uint8_t> buffer, size_t& pos) const
     else if (marker == 0xc6) { check_overflow(pos, 4, buffer.size()); uint32_t l; std::memcpy(&l, &buffer[pos], 4); len = ntohl(l); pos += 4; }
     else { throw BtoonException("Invalid binary marker"); }
     check_overflow(pos, len, buffer.size());
-    uint8_t* bin_data = static_cast<uint8_t*>(pool_->allocate(len));
-    std::memcpy(bin_data, &buffer[pos], len);
+    // Single copy from the input buffer; no pool staging.
+    Binary bin(&buffer[pos], &buffer[pos] + len);
     pos += len;
-    return Binary(bin_data, bin_data + len);
+    if (validation_) {
+        if (len > validation_->max_binary_length) {
+            validationResult_->addError("Binary data exceeds maximum length");
+        }
+        if (validation_->collect_stats && validationResult_->stats) {
+            validationResult_->stats->binary_count++;
+            validationResult_->stats->largest_binary =
+                std::max(validationResult_->stats->largest_binary, bin.size());
+        }
+    }
+    return bin;
 }
 
 Array Decoder::decodeArray(std::span<const uint8_t> buffer, size_t& pos) const {
@@ -185,11 +430,49 @@ Array Decoder::decodeArray(std::span<const uint8_t> buffer, size_t& pos) const {
     else if (marker == 0xdc) { check_overflow(pos, 2, buffer.size()); uint16_t l; std::memcpy(&l, &buffer[pos], 2); len = ntohs(l); pos += 2; }
     else if (marker == 0xdd) { check_overflow(pos, 4, buffer.size()); uint32_t l; std::memcpy(&l, &buffer[pos], 4); len = ntohl(l); pos += 4; }
     else { throw BtoonException("Invalid array marker"); }
+    if (validation_) {
+        if (len > validation_->max_array_size) {
+            validationResult_->addError("Array exceeds maximum size");
+        }
+        if (validation_->collect_stats && validationResult_->stats) {
+            validationResult_->stats->array_count++;
+            validationResult_->stats->largest_array =
+                std::max(validationResult_->stats->largest_array, len);
+            validationResult_->stats->max_depth_reached =
+                std::max(validationResult_->stats->max_depth_reached, validationDepth_);
+        }
+        // Report the first crossing of the depth limit; the elements below
+        // it are still decoded, mirroring the two-pass validator.
+        if (++validationDepth_ == validation_->max_depth + 1 && len > 0) {
+            validationResult_->addError("Maximum nesting depth exceeded");
+        }
+    }
     Array arr;
     arr.reserve(len);
-    for (size_t i = 0; i < len; ++i) {
-        arr.push_back(decode(buffer, pos));
+    for (size_t i = 0; i < len; ) {
+        // Fast path: decode whole runs of single-byte fixints without going
+        // through the marker dispatch for each element.
+        if (pos < buffer.size() && (buffer[pos] <= 0x7f || buffer[pos] >= 0xe0)) {
+            size_t max = std::min(len - i, buffer.size() - pos);
+            size_t run = scan_fixint_run(&buffer[pos], max);
+            for (size_t j = 0; j < run; ++j) {
+                uint8_t marker = buffer[pos + j];
+                if (marker <= 0x7f) {
+                    arr.emplace_back(static_cast<Uint>(marker));
+                } else {
+                    arr.emplace_back(static_cast<Int>(static_cast<int8_t>(marker)));
+                }
+            }
+            pos += run;
+            i += run;
+            if (run == max) continue;
+        }
+        if (i < len) {
+            arr.push_back(decode(buffer, pos));
+            ++i;
+        }
     }
+    if (validation_) --validationDepth_;
     return arr;
 }
 
@@ -200,11 +483,79 @@ Map Decoder::decodeMap(std::span<const uint8_t> buffer, size_t& pos) const {
     else if (marker == 0xde) { check_overflow(pos, 2, buffer.size()); uint16_t l; std::memcpy(&l, &buffer[pos], 2); len = ntohs(l); pos += 2; }
     else if (marker == 0xdf) { check_overflow(pos, 4, buffer.size()); uint32_t l; std::memcpy(&l, &buffer[pos], 4); len = ntohl(l); pos += 4; }
     else { throw BtoonException("Invalid map marker"); }
+    if (validation_) {
+        if (len > validation_->max_map_size) {
+            validationResult_->addError("Map exceeds maximum size");
+        }
+        if (validation_->collect_stats && validationResult_->stats) {
+            validationResult_->stats->map_count++;
+            validationResult_->stats->largest_map =
+                std::max(validationResult_->stats->largest_map, len);
+            validationResult_->stats->max_depth_reached =
+                std::max(validationResult_->stats->max_depth_reached, validationDepth_);
+        }
+        if (++validationDepth_ == validation_->max_depth + 1 && len > 0) {
+            validationResult_->addError("Maximum nesting depth exceeded");
+        }
+    }
     Map map;
     for (size_t i = 0; i < len; ++i) {
         String key(decodeString(buffer, pos));
-        map[key] = decode(buffer, pos);
+        // Move the key into the node instead of copying it via operator[];
+        // insert_or_assign keeps the last-occurrence-wins semantics for
+        // duplicate keys.
+        auto inserted = map.insert_or_assign(std::move(key), decode(buffer, pos));
+        if (!inserted.second && validation_ && !validation_->allow_duplicate_map_keys) {
+            validationResult_->addError("Duplicate map key: " + inserted.first->first);
+        }
+    }
+    if (validation_) --validationDepth_;
+    return map;
+}
+
+FlatMap Decoder::decodeFlatMap(std::span<const uint8_t> buffer, size_t& pos) const {
+    uint8_t marker = buffer[pos++];
+    size_t len = 0;
+    if (marker >= 0x80 && marker <= 0x8f) { len = marker & 0x0f; }
+    else if (marker == 0xde) { check_overflow(pos, 2, buffer.size()); uint16_t l; std::memcpy(&l, &buffer[pos], 2); len = ntohs(l); pos += 2; }
+    else if (marker == 0xdf) { check_overflow(pos, 4, buffer.size()); uint32_t l; std::memcpy(&l, &buffer[pos], 4); len = ntohl(l); pos += 4; }
+    else { throw BtoonException("Invalid map marker"); }
+    if (validation_) {
+        if (len > validation_->max_map_size) {
+            validationResult_->addError("Map exceeds maximum size");
+        }
+        if (validation_->collect_stats && validationResult_->stats) {
+            validationResult_->stats->map_count++;
+            validationResult_->stats->largest_map =
+                std::max(validationResult_->stats->largest_map, len);
+            validationResult_->stats->max_depth_reached =
+                std::max(validationResult_->stats->max_depth_reached, validationDepth_);
+        }
+        if (++validationDepth_ == validation_->max_depth + 1 && len > 0) {
+            validationResult_->addError("Maximum nesting depth exceeded");
+        }
+    }
+    FlatMap map;
+    map.reserve(len);
+    // Bulk-append entries, then restore the sorted invariant once; input
+    // written by our own encoder is already key-sorted, so the sort is a
+    // no-op pass in the common case.
+    for (size_t i = 0; i < len; ++i) {
+        String key(decodeString(buffer, pos));
+        map.entries.emplace_back(std::move(key), decode(buffer, pos));
+    }
+    if (validation_ && !validation_->allow_duplicate_map_keys) {
+        // Duplicates are collapsed by finalize(), so inspect the raw
+        // entries before it runs.
+        std::unordered_set<std::string_view> keys;
+        for (const auto& [key, _] : map) {
+            if (!keys.insert(key).second) {
+                validationResult_->addError("Duplicate map key: " + std::string(key));
+            }
+        }
     }
+    map.finalize();
+    if (validation_) --validationDepth_;
     return map;
 }
 
@@ -242,7 +593,7 @@ Value Decoder::decodeExtension(std::span<const uint8_t> buffer, size_t& pos) con
                                (static_cast<uint32_t>(buffer[pos + current_ext_data_pos + 3]));
             current_ext_data_pos += 4;
 
-            if (version != 1) {
+            if (version < 1 || version > 5) {
                 throw BtoonException("Unsupported tabular version");
             }
 
@@ -295,12 +646,100 @@ Value Decoder::decodeExtension(std::span<const uint8_t> buffer, size_t& pos) con
                 current_ext_data_pos += 1;
             }
 
+            // Versions 3 and later insert a column offset table between the
+            // schema and data sections; the sequential full decode does not
+            // need it.
+            if (version >= 3) {
+                size_t table_size = static_cast<size_t>(num_columns) * 4;
+                if (table_size > len || current_ext_data_pos > len - table_size) {
+                    throw BtoonException("Decoder overflow in tabular offset table");
+                }
+                current_ext_data_pos += table_size;
+            }
+
             // --- Data Section ---
             Array arr(num_rows);
             for (uint32_t i = 0; i < num_rows; ++i) {
                 arr[i] = Map{};
             }
 
+            if (version == 2) {
+                // Chunked layout: row groups with independently compressed
+                // column chunks, decoded one chunk at a time so memory stays
+                // bounded by the row-group size rather than the payload size.
+                auto read_u32 = [&](const char* what) -> uint32_t {
+                    if (current_ext_data_pos + 4 > len) {
+                        throw BtoonException(std::string("Decoder overflow in tabular ") + what);
+                    }
+                    uint32_t v = (static_cast<uint32_t>(buffer[pos + current_ext_data_pos]) << 24) |
+                                 (static_cast<uint32_t>(buffer[pos + current_ext_data_pos + 1]) << 16) |
+                                 (static_cast<uint32_t>(buffer[pos + current_ext_data_pos + 2]) << 8) |
+                                 (static_cast<uint32_t>(buffer[pos + current_ext_data_pos + 3]));
+                    current_ext_data_pos += 4;
+                    return v;
+                };
+
+                uint32_t group_size = read_u32("row group size");
+                uint32_t num_chunks = read_u32("chunk count");
+                if (group_size == 0) {
+                    throw BtoonException("Invalid tabular row group size");
+                }
+
+                uint32_t row_base = 0;
+                for (uint32_t chunk = 0; chunk < num_chunks; ++chunk) {
+                    uint32_t chunk_rows = read_u32("chunk row count");
+                    if (chunk_rows > group_size ||
+                        static_cast<uint64_t>(row_base) + chunk_rows > num_rows) {
+                        throw BtoonException("Invalid tabular chunk row count");
+                    }
+
+                    for (uint32_t i = 0; i < num_columns; ++i) {
+                        if (current_ext_data_pos + 1 > len) {
+                            throw BtoonException("Decoder overflow in tabular chunk algorithm");
+                        }
+                        auto algo = static_cast<CompressionAlgorithm>(buffer[pos + current_ext_data_pos]);
+                        current_ext_data_pos += 1;
+
+                        uint32_t uncompressed_size = read_u32("chunk uncompressed size");
+                        uint32_t stored_size = read_u32("chunk stored size");
+                        if (stored_size > len || current_ext_data_pos > len - stored_size) {
+                            throw BtoonException("Decoder overflow in tabular chunk data");
+                        }
+
+                        std::span<const uint8_t> stored =
+                            buffer.subspan(pos + current_ext_data_pos, stored_size);
+                        current_ext_data_pos += stored_size;
+
+                        std::vector<uint8_t> decompressed;
+                        std::span<const uint8_t> chunk_buffer = stored;
+                        if (algo != CompressionAlgorithm::NONE) {
+                            decompressed = decompress(algo, stored);
+                            if (decompressed.size() != uncompressed_size) {
+                                throw BtoonException("Tabular chunk size mismatch after decompression");
+                            }
+                            chunk_buffer = decompressed;
+                        } else if (stored_size != uncompressed_size) {
+                            throw BtoonException("Tabular chunk size mismatch");
+                        }
+
+                        size_t sub_pos = 0;
+                        for (uint32_t j = 0; j < chunk_rows; ++j) {
+                            auto& row_map = std::get<Map>(arr[row_base + j]);
+                            row_map[column_names[i]] = decode(chunk_buffer, sub_pos);
+                        }
+                        if (sub_pos != chunk_buffer.size()) {
+                            throw BtoonException("Column data size mismatch during decoding");
+                        }
+                    }
+                    row_base += chunk_rows;
+                }
+                if (row_base != num_rows) {
+                    throw BtoonException("Tabular chunk rows do not cover all rows");
+                }
+                pos += len;
+                return arr;
+            }
+
             for (uint32_t i = 0; i < num_columns; ++i) {
                 if (current_ext_data_pos + 4 > len) {
                     throw BtoonException("Decoder overflow in tabular column data size");
@@ -321,19 +760,22 @@ Value Decoder::decodeExtension(std::span<const uint8_t> buffer, size_t& pos) con
                 // We've already validated that pos + column_data_start_in_ext + column_data_size <= buffer.size()
                 std::span<const uint8_t> column_buffer = buffer.subspan(pos + column_data_start_in_ext, column_data_size);
 
-                size_t sub_pos = 0;
-                for (uint32_t j = 0; j < num_rows; ++j) {
-                    auto& row_map = std::get<Map>(arr[j]);
-                    // Use the generic decode function which handles all encoding formats
-                    Value decoded_value = decode(column_buffer, sub_pos);
-                    row_map[column_names[i]] = decoded_value;
+                if (version >= 4) {
+                    decodeBitmapColumn(column_buffer, column_names[i], arr, 0, num_rows);
+                } else {
+                    size_t sub_pos = 0;
+                    for (uint32_t j = 0; j < num_rows; ++j) {
+                        auto& row_map = std::get<Map>(arr[j]);
+                        // Use the generic decode function which handles all encoding formats
+                        Value decoded_value = decode(column_buffer, sub_pos);
+                        row_map[column_names[i]] = decoded_value;
+                    }
+                    // Ensure we consumed exactly column_data_size bytes for this column
+                    if (sub_pos != column_data_size) {
+                        throw BtoonException("Column data size mismatch during decoding");
+                    }
                 }
                 current_ext_data_pos += column_data_size; // Advance current_ext_data_pos by the total column data size
-
-                // Ensure we consumed exactly column_data_size bytes for this column
-                if (sub_pos != column_data_size) {
-                    throw BtoonException("Column data size mismatch during decoding");
-                }
             }
             pos += len; // Advance the main position by the total length of the extension
             return arr;
@@ -388,16 +830,18 @@ Value Decoder::decodeExtension(std::span<const uint8_t> buffer, size_t& pos) con
                 throw BtoonException("Invalid timestamp length");
             }
         }
-        case -2: return decodeDate(buffer, pos, len - 1);
-        case -3: return decodeDateTime(buffer, pos, len - 1);
-        case -4: return decodeBigInt(buffer, pos, len - 1);
-        case -5: return decodeVectorFloat(buffer, pos, len - 1);
-        case -6: return decodeVectorDouble(buffer, pos, len - 1);
+        // `len` is the payload size and already excludes the type byte,
+        // which was consumed above.
+        case -2: return decodeDate(buffer, pos, len);
+        case -3: return decodeDateTime(buffer, pos, len);
+        case -4: return decodeBigInt(buffer, pos, len);
+        case -5: return decodeVectorFloat(buffer, pos, len);
+        case -6: return decodeVectorDouble(buffer, pos, len);
         default: { // Generic extension
             Extension ext;
             ext.type = ext_type;
-            ext.data.assign(buffer.begin() + pos, buffer.begin() + pos + len - 1); // len - 1 because ext_type is already read
-            pos += (len - 1);
+            ext.data.assign(buffer.begin() + pos, buffer.begin() + pos + len);
+            pos += len;
             return ext;
         }
     }
@@ -448,11 +892,307 @@ VectorDouble Decoder::decodeVectorDouble(std::span<const uint8_t> buffer, size_t
 }
 
 
+void Decoder::decodeBitmapColumn(std::span<const uint8_t> column, const std::string& name,
+                                 Array& arr, size_t row_base, size_t rows) const {
+    if (column.empty()) {
+        throw BtoonException("Decoder overflow in tabular bitmap column");
+    }
+    uint8_t flags = column[0];
+    if (!(flags & 0x01)) {
+        throw BtoonException("Tabular bitmap column missing validity bitmap");
+    }
+    size_t bitmap_bytes = (rows + 7) / 8;
+    if (1 + bitmap_bytes > column.size()) {
+        throw BtoonException("Decoder overflow in tabular validity bitmap");
+    }
+    std::span<const uint8_t> bitmap = column.subspan(1, bitmap_bytes);
+    auto is_set = [&](size_t row) {
+        return (bitmap[row / 8] >> (row % 8)) & 1u;
+    };
+
+    if (flags & 0x04) {
+        // Dictionary-encoded strings (v5): a dictionary page of distinct
+        // values followed by one varint index per non-null row. Rows are
+        // materialized as the looked-up strings by default, or as their
+        // raw Uint indices when setDictionaryIndices is enabled.
+        size_t sub_pos = 1 + bitmap_bytes;
+        auto get_varint = [&]() -> uint64_t {
+            uint64_t value = 0;
+            unsigned shift = 0;
+            for (;;) {
+                if (sub_pos >= column.size() || shift >= 64) {
+                    throw BtoonException("Truncated varint in tabular dictionary column");
+                }
+                uint8_t byte = column[sub_pos++];
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+                shift += 7;
+            }
+        };
+
+        uint64_t dict_count = get_varint();
+        std::vector<Value> dictionary;
+        dictionary.reserve(dict_count);
+        for (uint64_t i = 0; i < dict_count; ++i) {
+            dictionary.push_back(decode(column, sub_pos));
+        }
+
+        for (size_t j = 0; j < rows; ++j) {
+            auto& row_map = std::get<Map>(arr[row_base + j]);
+            if (!is_set(j)) {
+                row_map[name] = Nil{};
+                continue;
+            }
+            uint64_t index = get_varint();
+            if (index >= dictionary.size()) {
+                throw BtoonException("Dictionary index out of range in tabular column");
+            }
+            row_map[name] = useDictionaryIndices_ ? Value(Uint(index)) : dictionary[index];
+        }
+        if (sub_pos != column.size()) {
+            throw BtoonException("Column data size mismatch during decoding");
+        }
+        return;
+    }
+
+    if (flags & 0x02) {
+        // Packed float64: non-null values are raw big-endian doubles at a
+        // fixed 8-byte stride, so the payload is consumed by bulk copy.
+        size_t payload_pos = 1 + bitmap_bytes;
+        for (size_t j = 0; j < rows; ++j) {
+            auto& row_map = std::get<Map>(arr[row_base + j]);
+            if (!is_set(j)) {
+                row_map[name] = Nil{};
+                continue;
+            }
+            if (payload_pos + 8 > column.size()) {
+                throw BtoonException("Decoder overflow in packed float column");
+            }
+            uint64_t bits;
+            std::memcpy(&bits, &column[payload_pos], 8);
+            bits = ntohll(bits);
+            double d;
+            std::memcpy(&d, &bits, 8);
+            row_map[name] = Float(d);
+            payload_pos += 8;
+        }
+        if (payload_pos != column.size()) {
+            throw BtoonException("Column data size mismatch during decoding");
+        }
+        return;
+    }
+
+    size_t sub_pos = 1 + bitmap_bytes;
+    for (size_t j = 0; j < rows; ++j) {
+        auto& row_map = std::get<Map>(arr[row_base + j]);
+        if (!is_set(j)) {
+            row_map[name] = Nil{};
+            continue;
+        }
+        row_map[name] = decode(column, sub_pos);
+    }
+    if (sub_pos != column.size()) {
+        throw BtoonException("Column data size mismatch during decoding");
+    }
+}
+
+Array Decoder::decodeColumns(std::span<const uint8_t> buffer,
+                             const std::vector<std::string>& columns) const {
+    auto data_span = useSecurity_ ? verifyAndExtractData(buffer) : buffer;
+
+    // --- Extension envelope ---
+    size_t pos = 0;
+    check_overflow(pos, 1, data_span.size());
+    uint8_t marker = data_span[pos++];
+    size_t len = 0;
+    if (marker == 0xc7) { check_overflow(pos, 1, data_span.size()); len = data_span[pos]; pos += 1; }
+    else if (marker == 0xc8) { check_overflow(pos, 2, data_span.size()); uint16_t l; std::memcpy(&l, &data_span[pos], 2); len = ntohs(l); pos += 2; }
+    else if (marker == 0xc9) { check_overflow(pos, 4, data_span.size()); uint32_t l; std::memcpy(&l, &data_span[pos], 4); len = ntohl(l); pos += 4; }
+    else { throw BtoonException("Not a tabular payload"); }
+
+    check_overflow(pos, 1, data_span.size());
+    int8_t ext_type = static_cast<int8_t>(data_span[pos++]);
+    if (ext_type != -10) {
+        throw BtoonException("Not a tabular payload");
+    }
+    check_overflow(pos, len, data_span.size());
+    std::span<const uint8_t> ext = data_span.subspan(pos, len);
+
+    // --- Header ---
+    size_t p = 0;
+    auto read_u32 = [&](const char* what) -> uint32_t {
+        if (p + 4 > ext.size()) {
+            throw BtoonException(std::string("Decoder overflow in tabular ") + what);
+        }
+        uint32_t v = (static_cast<uint32_t>(ext[p]) << 24) |
+                     (static_cast<uint32_t>(ext[p + 1]) << 16) |
+                     (static_cast<uint32_t>(ext[p + 2]) << 8) |
+                     (static_cast<uint32_t>(ext[p + 3]));
+        p += 4;
+        return v;
+    };
+
+    uint32_t version = read_u32("version");
+    if (version < 1 || version > 5) {
+        throw BtoonException("Unsupported tabular version");
+    }
+    uint32_t num_columns = read_u32("num_columns");
+    uint32_t num_rows = read_u32("num_rows");
+
+    std::vector<std::string> column_names;
+    column_names.reserve(num_columns);
+    for (uint32_t i = 0; i < num_columns; ++i) {
+        uint32_t name_len = read_u32("column name length");
+        if (name_len > ext.size() || p > ext.size() - name_len) {
+            throw BtoonException("Decoder overflow in tabular column name data");
+        }
+        column_names.emplace_back(reinterpret_cast<const char*>(&ext[p]), name_len);
+        p += name_len;
+    }
+    if (p + num_columns > ext.size()) {
+        throw BtoonException("Decoder overflow in tabular column type");
+    }
+    p += num_columns; // column types are not needed for projection
+
+    // Mark which columns the caller asked for, validating they exist.
+    std::vector<bool> wanted(num_columns, false);
+    for (const auto& name : columns) {
+        auto it = std::find(column_names.begin(), column_names.end(), name);
+        if (it == column_names.end()) {
+            throw BtoonException("Unknown tabular column: " + name);
+        }
+        wanted[static_cast<size_t>(it - column_names.begin())] = true;
+    }
+
+    Array arr(num_rows);
+    for (uint32_t i = 0; i < num_rows; ++i) {
+        arr[i] = Map{};
+    }
+
+    auto decode_column_into = [&](std::span<const uint8_t> column_buffer,
+                                  uint32_t column, uint32_t row_base, uint32_t rows) {
+        size_t sub_pos = 0;
+        for (uint32_t j = 0; j < rows; ++j) {
+            auto& row_map = std::get<Map>(arr[row_base + j]);
+            row_map[column_names[column]] = decode(column_buffer, sub_pos);
+        }
+        if (sub_pos != column_buffer.size()) {
+            throw BtoonException("Column data size mismatch during decoding");
+        }
+    };
+
+    if (version == 2) {
+        // Chunked layout: skip unrequested column chunks via their stored size.
+        uint32_t group_size = read_u32("row group size");
+        uint32_t num_chunks = read_u32("chunk count");
+        if (group_size == 0) {
+            throw BtoonException("Invalid tabular row group size");
+        }
+        uint32_t row_base = 0;
+        for (uint32_t chunk = 0; chunk < num_chunks; ++chunk) {
+            uint32_t chunk_rows = read_u32("chunk row count");
+            if (chunk_rows > group_size ||
+                static_cast<uint64_t>(row_base) + chunk_rows > num_rows) {
+                throw BtoonException("Invalid tabular chunk row count");
+            }
+            for (uint32_t i = 0; i < num_columns; ++i) {
+                if (p + 1 > ext.size()) {
+                    throw BtoonException("Decoder overflow in tabular chunk algorithm");
+                }
+                auto algo = static_cast<CompressionAlgorithm>(ext[p]);
+                p += 1;
+                uint32_t uncompressed_size = read_u32("chunk uncompressed size");
+                uint32_t stored_size = read_u32("chunk stored size");
+                if (stored_size > ext.size() || p > ext.size() - stored_size) {
+                    throw BtoonException("Decoder overflow in tabular chunk data");
+                }
+                if (wanted[i]) {
+                    std::span<const uint8_t> stored = ext.subspan(p, stored_size);
+                    if (algo != CompressionAlgorithm::NONE) {
+                        std::vector<uint8_t> decompressed = decompress(algo, stored);
+                        if (decompressed.size() != uncompressed_size) {
+                            throw BtoonException("Tabular chunk size mismatch after decompression");
+                        }
+                        decode_column_into(decompressed, i, row_base, chunk_rows);
+                    } else {
+                        if (stored_size != uncompressed_size) {
+                            throw BtoonException("Tabular chunk size mismatch");
+                        }
+                        decode_column_into(stored, i, row_base, chunk_rows);
+                    }
+                }
+                p += stored_size;
+            }
+            row_base += chunk_rows;
+        }
+        return arr;
+    }
+
+    std::vector<uint32_t> offsets;
+    if (version >= 3) {
+        offsets.reserve(num_columns);
+        for (uint32_t i = 0; i < num_columns; ++i) {
+            offsets.push_back(read_u32("column offset"));
+        }
+    }
+    size_t data_section = p;
+
+    for (uint32_t i = 0; i < num_columns; ++i) {
+        if (version >= 3) {
+            if (!wanted[i]) {
+                continue; // direct seek makes skipping free
+            }
+            if (offsets[i] > ext.size() || data_section > ext.size() - offsets[i]) {
+                throw BtoonException("Decoder overflow in tabular column offset");
+            }
+            p = data_section + offsets[i];
+        }
+        uint32_t column_data_size = read_u32("column data size");
+        if (column_data_size > ext.size() || p > ext.size() - column_data_size) {
+            throw BtoonException("Decoder overflow in tabular column data");
+        }
+        if (wanted[i]) {
+            if (version >= 4) {
+                decodeBitmapColumn(ext.subspan(p, column_data_size), column_names[i],
+                                   arr, 0, num_rows);
+            } else {
+                decode_column_into(ext.subspan(p, column_data_size), i, 0, num_rows);
+            }
+        }
+        p += column_data_size;
+    }
+    return arr;
+}
+
 std::span<const uint8_t> Decoder::verifyAndExtractData(std::span<const uint8_t> buffer) const {
-    if (useSecurity_) {
-        throw BtoonException("Security not implemented");
+    if (!useSecurity_ || security_ == nullptr) {
+        return buffer;
+    }
+    // Envelope written by Encoder::addSignatureIfEnabled:
+    // [sig length u8][signature][payload].
+    if (buffer.empty()) {
+        throw BtoonException("Signed buffer is empty");
+    }
+    size_t sig_len = buffer[0];
+    if (buffer.size() < 1 + sig_len) {
+        throw BtoonException("Signed buffer shorter than its signature");
+    }
+    std::vector<uint8_t> signature(buffer.begin() + 1, buffer.begin() + 1 + sig_len);
+    auto payload = buffer.subspan(1 + sig_len);
+    auto verify_start = std::chrono::steady_clock::now();
+    bool verified = security_->verify(payload, signature);
+    if (collectStats_) {
+        stats_.signatures++;
+        stats_.signature_time_ms +=
+            std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - verify_start).count();
+    }
+    if (!verified) {
+        throw BtoonException("Signature verification failed");
     }
-    return buffer;
+    return payload;
 }
 
 } // namespace btoon
\ No newline at end of file
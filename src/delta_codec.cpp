@@ -11,6 +11,120 @@
 
 namespace btoon {
 
+namespace {
+
+// Small positive values decode as Uint; deltas may be either variant.
+int64_t to_int64(const Value& value) {
+    if (std::holds_alternative<Uint>(value)) {
+        return static_cast<int64_t>(std::get<Uint>(value));
+    }
+    return std::get<Int>(value);
+}
+
+uint64_t zigzag_encode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^
+           static_cast<uint64_t>(value >> 63);
+}
+
+int64_t zigzag_decode(uint64_t value) {
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t get_varint(const std::vector<uint8_t>& data, size_t& pos) {
+    uint64_t value = 0;
+    unsigned shift = 0;
+    for (;;) {
+        if (pos >= data.size() || shift >= 64) {
+            throw BtoonException("Truncated varint in delta-of-delta data");
+        }
+        uint8_t byte = data[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+        shift += 7;
+    }
+}
+
+// In-place first-order differences: v[i] becomes v[i] - v[i-1], with
+// v[0] differenced against the seed.
+void difference(std::vector<int64_t>& v, int64_t seed) {
+    size_t i = 0;
+    int64_t last_value = seed;
+#if defined(__AVX2__)
+    for (; i + 3 < v.size(); i += 4) {
+        __m256i current = _mm256_loadu_si256((__m256i*)&v[i]);
+        // Previous element per slot: [last, v0, v1, v2]. permute4x64 moves
+        // values across the 128-bit lanes, which slli_si256 cannot.
+        __m256i prev = _mm256_permute4x64_epi64(current, _MM_SHUFFLE(2, 1, 0, 0));
+        prev = _mm256_blend_epi32(prev, _mm256_set1_epi64x(last_value), 0x03);
+        __m256i deltas = _mm256_sub_epi64(current, prev);
+
+        last_value = v[i + 3];
+        _mm256_storeu_si256((__m256i*)&v[i], deltas);
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 1 < v.size(); i += 2) {
+        int64x2_t current = vld1q_s64(&v[i]);
+        int64x2_t prev = vextq_s64(vdupq_n_s64(last_value), current, 1);
+        int64x2_t deltas = vsubq_s64(current, prev);
+
+        last_value = v[i + 1];
+        vst1q_s64(&v[i], deltas);
+    }
+#endif
+    for (; i < v.size(); ++i) {
+        int64_t value = v[i];
+        v[i] = value - last_value;
+        last_value = value;
+    }
+}
+
+// In-place running sum: v[i] becomes seed + v[0] + ... + v[i]. The prefix
+// sum is built inside the vector registers so reconstruction is not one
+// serial dependency chain per element.
+void running_sum(std::vector<int64_t>& v, int64_t seed) {
+    size_t i = 0;
+    int64_t last_value = seed;
+#if defined(__AVX2__)
+    for (; i + 3 < v.size(); i += 4) {
+        __m256i x = _mm256_loadu_si256((__m256i*)&v[i]);
+        // Inclusive prefix within each 128-bit lane...
+        x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+        // ...then carry the low lane's total into the high lane.
+        __m256i carry = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 1, 1, 1));
+        carry = _mm256_blend_epi32(_mm256_setzero_si256(), carry, 0xF0);
+        x = _mm256_add_epi64(x, carry);
+        x = _mm256_add_epi64(x, _mm256_set1_epi64x(last_value));
+
+        _mm256_storeu_si256((__m256i*)&v[i], x);
+        last_value = v[i + 3];
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 1 < v.size(); i += 2) {
+        int64x2_t x = vld1q_s64(&v[i]);
+        x = vaddq_s64(x, vextq_s64(vdupq_n_s64(0), x, 1));  // [a0, a0+a1]
+        x = vaddq_s64(x, vdupq_n_s64(last_value));
+        vst1q_s64(&v[i], x);
+        last_value = v[i + 1];
+    }
+#endif
+    for (; i < v.size(); ++i) {
+        v[i] += last_value;
+        last_value = v[i];
+    }
+}
+
+} // namespace
+
 std::vector<uint8_t> DeltaCodec::encode(const Array& data) {
     Encoder encoder;
     if (data.empty()) {
@@ -20,45 +134,12 @@ std::vector<uint8_t> DeltaCodec::encode(const Array& data) {
     std::vector<int64_t> values;
     values.reserve(data.size());
     for (const auto& value : data) {
-        values.push_back(std::get<Int>(value));
+        values.push_back(to_int64(value));
     }
 
-    size_t i = 0;
-    Int last_value = 0;
-#if defined(__AVX2__)
-    for (; i + 3 < values.size(); i += 4) {
-        __m256i current_values = _mm256_loadu_si256((__m256i*)&values[i]);
-        __m256i last_values = _mm256_slli_si256(current_values, 8);
-        __m256i prev_val_vec = _mm256_set_epi64x(0, 0, 0, last_value);
-        last_values = _mm256_or_si256(last_values, prev_val_vec);
-        __m256i deltas = _mm256_sub_epi64(current_values, last_values);
-        
-        int64_t temp[4];
-        _mm256_storeu_si256((__m256i*)temp, deltas);
-        
-        for (int j = 0; j < 4; ++j) {
-            encoder.encodeInt(temp[j]);
-        }
-        last_value = values[i + 3];
-    }
-#elif defined(__ARM_NEON)
-    for (; i + 1 < values.size(); i += 2) {
-        int64x2_t current_values = vld1q_s64(&values[i]);
-        int64x2_t last_values = vextq_s64(vdupq_n_s64(last_value), current_values, 1);
-        int64x2_t deltas = vsubq_s64(current_values, last_values);
-        
-        int64_t temp[2];
-        vst1q_s64(temp, deltas);
-        
-        for (int j = 0; j < 2; ++j) {
-            encoder.encodeInt(temp[j]);
-        }
-        last_value = values[i + 1];
-    }
-#endif
-    for (; i < values.size(); ++i) {
-        encoder.encodeInt(values[i] - last_value);
-        last_value = values[i];
+    difference(values, 0);
+    for (int64_t delta : values) {
+        encoder.encodeInt(delta);
     }
 
     auto encoded_data = encoder.getBuffer();
@@ -77,54 +158,68 @@ Array DeltaCodec::decode(const std::vector<uint8_t>& data) {
     while (pos < data.size()) {
         auto [value, bytes_read] = decoder.decode_and_get_pos({data.data() + pos, data.size() - pos});
         pos += bytes_read;
-        deltas.push_back(std::get<Int>(value));
+        deltas.push_back(to_int64(value));
     }
 
-    size_t i = 0;
-    Int last_value = 0;
-#if defined(__AVX2__)
-    for (; i + 3 < deltas.size(); i += 4) {
-        __m256i current_deltas = _mm256_loadu_si256((__m256i*)&deltas[i]);
-        __m256i shifted1 = _mm256_slli_si256(current_deltas, 8);
-        __m256i shifted2 = _mm256_slli_si256(current_deltas, 16);
-        __m256i shifted3 = _mm256_slli_si256(current_deltas, 24);
-        __m256i sum1 = _mm256_add_epi64(current_deltas, shifted1);
-        __m256i sum2 = _mm256_add_epi64(sum1, shifted2);
-        __m256i sum3 = _mm256_add_epi64(sum2, shifted3);
-        __m256i last_value_vec = _mm256_set1_epi64x(last_value);
-        __m256i current_values = _mm256_add_epi64(sum3, last_value_vec);
-        
-        int64_t temp[4];
-        _mm256_storeu_si256((__m256i*)temp, current_values);
-        
-        for (int j = 0; j < 4; ++j) {
-            result.push_back(temp[j]);
-        }
-        last_value = temp[3];
+    running_sum(deltas, 0);
+
+    result.reserve(deltas.size());
+    for (int64_t value : deltas) {
+        result.push_back(Int(value));
     }
-#elif defined(__ARM_NEON)
-    int64x2_t prefix_sum = vdupq_n_s64(0);
-    for (; i + 1 < deltas.size(); i += 2) {
-        int64x2_t current_deltas = vld1q_s64(&deltas[i]);
-        prefix_sum = vaddq_s64(prefix_sum, current_deltas);
-        int64x2_t last_value_vec = vdupq_n_s64(last_value);
-        int64x2_t current_values = vaddq_s64(prefix_sum, last_value_vec);
-        
-        int64_t temp[2];
-        vst1q_s64(temp, current_values);
-        
-        for (int j = 0; j < 2; ++j) {
-            result.push_back(temp[j]);
-        }
-        last_value = temp[1];
+    return result;
+}
+
+std::vector<uint8_t> DeltaCodec::encode_delta_of_delta(const Array& data) {
+    std::vector<uint8_t> out;
+    if (data.empty()) {
+        return out;
     }
-#endif
-    for (; i < deltas.size(); ++i) {
-        Int current_value = deltas[i] + last_value;
-        result.push_back(current_value);
-        last_value = current_value;
+    out.reserve(data.size() + 16);
+
+    int64_t first = to_int64(data[0]);
+    put_varint(out, zigzag_encode(first));
+
+    int64_t prev = first;
+    int64_t prev_delta = 0;
+    for (size_t i = 1; i < data.size(); ++i) {
+        int64_t value = to_int64(data[i]);
+        int64_t delta = value - prev;
+        // The first entry carries the delta itself, the rest only its change.
+        put_varint(out, zigzag_encode(i == 1 ? delta : delta - prev_delta));
+        prev = value;
+        prev_delta = delta;
+    }
+    return out;
+}
+
+Array DeltaCodec::decode_delta_of_delta(const std::vector<uint8_t>& data) {
+    Array result;
+    if (data.empty()) {
+        return result;
     }
 
+    size_t pos = 0;
+    int64_t first = zigzag_decode(get_varint(data, pos));
+    if (pos >= data.size()) {
+        result.push_back(Int(first));
+        return result;
+    }
+
+    // deltas[0] is the first delta, the rest are delta-of-deltas; one
+    // running-sum pass turns them into deltas, a second into values.
+    std::vector<int64_t> deltas;
+    while (pos < data.size()) {
+        deltas.push_back(zigzag_decode(get_varint(data, pos)));
+    }
+    running_sum(deltas, 0);
+    running_sum(deltas, first);
+
+    result.reserve(deltas.size() + 1);
+    result.push_back(Int(first));
+    for (int64_t value : deltas) {
+        result.push_back(Int(value));
+    }
     return result;
 }
 
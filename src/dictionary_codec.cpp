@@ -7,6 +7,42 @@
 
 namespace btoon {
 
+namespace {
+
+// Dictionary indices encode as positive integers and come back as Uint.
+int64_t index_of(const Value& value) {
+    if (std::holds_alternative<Uint>(value)) {
+        return static_cast<int64_t>(std::get<Uint>(value));
+    }
+    return std::get<Int>(value);
+}
+
+void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t get_varint(const std::vector<uint8_t>& data, size_t& pos) {
+    uint64_t value = 0;
+    unsigned shift = 0;
+    for (;;) {
+        if (pos >= data.size() || shift >= 64) {
+            throw BtoonException("Truncated varint in dictionary data");
+        }
+        uint8_t byte = data[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+        shift += 7;
+    }
+}
+
+} // namespace
+
 std::vector<uint8_t> DictionaryCodec::encode(const Array& data) {
     Encoder encoder;
     if (data.empty()) {
@@ -51,11 +87,78 @@ Array DictionaryCodec::decode(const std::vector<uint8_t>& data) {
     while (pos < data.size()) {
         auto [value, bytes_read_val] = decoder.decode_and_get_pos({data.data() + pos, data.size() - pos});
         pos += bytes_read_val;
-        int index = std::get<Int>(value);
-        result.push_back(dictionary_array[index]);
+        int64_t index = index_of(value);
+        result.push_back(dictionary_array[static_cast<size_t>(index)]);
+    }
+
+    return result;
+}
+
+std::vector<uint8_t> StreamingDictionaryCodec::encode(const Array& data) {
+    // First pass: learn this message's new values so the header can say how
+    // many entries the decoder should absorb before reading indices. Each
+    // value is serialized once; the bytes double as the lookup key and as
+    // the wire representation of a new entry.
+    std::vector<uint64_t> message_indices;
+    message_indices.reserve(data.size());
+    std::vector<uint8_t> new_entries;
+    size_t first_new = dictionary_.size();
+    for (const auto& value : data) {
+        Encoder value_encoder;
+        value_encoder.encode(value);
+        auto buffer = value_encoder.getBuffer();
+        std::vector<uint8_t> bytes(buffer.begin(), buffer.end());
+
+        auto [it, inserted] = indices_.try_emplace(std::move(bytes), dictionary_.size());
+        if (inserted) {
+            dictionary_.push_back(value);
+            new_entries.insert(new_entries.end(), it->first.begin(), it->first.end());
+        }
+        message_indices.push_back(it->second);
+    }
+
+    std::vector<uint8_t> out;
+    put_varint(out, dictionary_.size() - first_new);
+    out.insert(out.end(), new_entries.begin(), new_entries.end());
+
+    put_varint(out, message_indices.size());
+    for (uint64_t index : message_indices) {
+        put_varint(out, index);
+    }
+    return out;
+}
+
+Array StreamingDictionaryCodec::decode(const std::vector<uint8_t>& data) {
+    Decoder decoder;
+    size_t pos = 0;
+
+    uint64_t new_entries = get_varint(data, pos);
+    for (uint64_t i = 0; i < new_entries; ++i) {
+        if (pos >= data.size()) {
+            throw BtoonException("Truncated dictionary entry");
+        }
+        auto [value, bytes_read] =
+            decoder.decode_and_get_pos({data.data() + pos, data.size() - pos});
+        pos += bytes_read;
+        dictionary_.push_back(value);
     }
 
+    uint64_t count = get_varint(data, pos);
+    Array result;
+    result.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t index = get_varint(data, pos);
+        if (index >= dictionary_.size()) {
+            throw BtoonException("Dictionary index out of range");
+        }
+        result.push_back(dictionary_[index]);
+    }
     return result;
 }
 
+void StreamingDictionaryCodec::clear() {
+    dictionary_.clear();
+    indices_.clear();
+}
+
 } // namespace btoon
@@ -0,0 +1,348 @@
+#include "btoon/document_cursor.h"
+#include <cstring>
+
+namespace btoon {
+
+namespace {
+
+void check_bounds(size_t pos, size_t count, size_t buffer_size) {
+    if (count > buffer_size || pos > buffer_size - count) {
+        throw BtoonException("DocumentCursor overflow");
+    }
+}
+
+size_t read_be_length(std::span<const uint8_t> buffer, size_t& pos, size_t bytes) {
+    check_bounds(pos, bytes, buffer.size());
+    size_t len = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        len = (len << 8) | buffer[pos + i];
+    }
+    pos += bytes;
+    return len;
+}
+
+// Decode a single value at pos into a ValueView. Unlike ZeroCopyDecoder this
+// covers the full marker set (fixed-width ints, floats, 32-bit lengths and
+// extensions), since a cursor may land on any leaf of the document.
+ValueView decode_view(std::span<const uint8_t> buffer, size_t& pos, size_t depth) {
+    if (depth > 128) {
+        throw BtoonException("Maximum nesting depth exceeded");
+    }
+    check_bounds(pos, 1, buffer.size());
+    uint8_t marker = buffer[pos++];
+
+    if (marker <= 0x7f) return static_cast<Uint>(marker);
+    if (marker >= 0xe0) return static_cast<Int>(static_cast<int8_t>(marker));
+
+    if (marker >= 0xa0 && marker <= 0xbf) {
+        size_t len = marker & 0x1f;
+        check_bounds(pos, len, buffer.size());
+        std::string_view str(reinterpret_cast<const char*>(&buffer[pos]), len);
+        pos += len;
+        return str;
+    }
+    if ((marker >= 0x80 && marker <= 0x8f) || marker == 0xde || marker == 0xdf) {
+        size_t count;
+        if (marker <= 0x8f) count = marker & 0x0f;
+        else count = read_be_length(buffer, pos, marker == 0xde ? 2 : 4);
+        MapView map;
+        for (size_t i = 0; i < count; ++i) {
+            auto key = decode_view(buffer, pos, depth + 1);
+            auto val = decode_view(buffer, pos, depth + 1);
+            auto* str_key = std::get_if<std::string_view>(&key);
+            if (!str_key) {
+                throw BtoonException("Map key must be string");
+            }
+            map.emplace_back(*str_key, std::move(val));
+        }
+        return map;
+    }
+    if ((marker >= 0x90 && marker <= 0x9f) || marker == 0xdc || marker == 0xdd) {
+        size_t count;
+        if (marker <= 0x9f) count = marker & 0x0f;
+        else count = read_be_length(buffer, pos, marker == 0xdc ? 2 : 4);
+        ArrayView arr;
+        arr.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            arr.push_back(decode_view(buffer, pos, depth + 1));
+        }
+        return arr;
+    }
+
+    switch (marker) {
+        case 0xc0: return Nil{};
+        case 0xc2: return Bool(false);
+        case 0xc3: return Bool(true);
+        case 0xcc: return static_cast<Uint>(read_be_length(buffer, pos, 1));
+        case 0xcd: return static_cast<Uint>(read_be_length(buffer, pos, 2));
+        case 0xce: return static_cast<Uint>(read_be_length(buffer, pos, 4));
+        case 0xcf: {
+            check_bounds(pos, 8, buffer.size());
+            uint64_t val = 0;
+            for (size_t i = 0; i < 8; ++i) val = (val << 8) | buffer[pos + i];
+            pos += 8;
+            return static_cast<Uint>(val);
+        }
+        case 0xd0: return static_cast<Int>(static_cast<int8_t>(read_be_length(buffer, pos, 1)));
+        case 0xd1: return static_cast<Int>(static_cast<int16_t>(read_be_length(buffer, pos, 2)));
+        case 0xd2: return static_cast<Int>(static_cast<int32_t>(read_be_length(buffer, pos, 4)));
+        case 0xd3: {
+            check_bounds(pos, 8, buffer.size());
+            uint64_t val = 0;
+            for (size_t i = 0; i < 8; ++i) val = (val << 8) | buffer[pos + i];
+            pos += 8;
+            return static_cast<Int>(val);
+        }
+        case 0xca: {
+            uint32_t bits = static_cast<uint32_t>(read_be_length(buffer, pos, 4));
+            float f;
+            std::memcpy(&f, &bits, 4);
+            return static_cast<Float>(f);
+        }
+        case 0xcb: {
+            check_bounds(pos, 8, buffer.size());
+            uint64_t bits = 0;
+            for (size_t i = 0; i < 8; ++i) bits = (bits << 8) | buffer[pos + i];
+            pos += 8;
+            double d;
+            std::memcpy(&d, &bits, 8);
+            return static_cast<Float>(d);
+        }
+        case 0xd9: case 0xda: case 0xdb: {
+            size_t bytes = marker == 0xd9 ? 1 : marker == 0xda ? 2 : 4;
+            size_t len = read_be_length(buffer, pos, bytes);
+            check_bounds(pos, len, buffer.size());
+            std::string_view str(reinterpret_cast<const char*>(&buffer[pos]), len);
+            pos += len;
+            return str;
+        }
+        case 0xc4: case 0xc5: case 0xc6: {
+            size_t bytes = marker == 0xc4 ? 1 : marker == 0xc5 ? 2 : 4;
+            size_t len = read_be_length(buffer, pos, bytes);
+            check_bounds(pos, len, buffer.size());
+            std::span<const uint8_t> bin(&buffer[pos], len);
+            pos += len;
+            return bin;
+        }
+        case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8:
+        case 0xc7: case 0xc8: case 0xc9: {
+            size_t len;
+            if (marker >= 0xd4) len = size_t{1} << (marker - 0xd4);
+            else len = read_be_length(buffer, pos, marker == 0xc7 ? 1 : marker == 0xc8 ? 2 : 4);
+            check_bounds(pos, len + 1, buffer.size());
+            Extension ext;
+            ext.type = static_cast<int8_t>(buffer[pos++]);
+            ext.data.assign(buffer.begin() + static_cast<std::ptrdiff_t>(pos),
+                            buffer.begin() + static_cast<std::ptrdiff_t>(pos + len));
+            pos += len;
+            return ext;
+        }
+        default: throw BtoonException("Unknown marker");
+    }
+}
+
+} // namespace
+
+DocumentCursor::DocumentCursor(std::span<const uint8_t> buffer)
+    : buffer_(buffer), pos_(0), valid_(true) {
+    if (buffer.empty()) {
+        throw BtoonException("DocumentCursor: empty buffer");
+    }
+}
+
+void DocumentCursor::requireValid() const {
+    if (!valid_) {
+        throw BtoonException("DocumentCursor: cursor is invalid");
+    }
+}
+
+DocumentCursor::Type DocumentCursor::type() const {
+    requireValid();
+    check_bounds(pos_, 1, buffer_.size());
+    uint8_t marker = buffer_[pos_];
+
+    if (marker <= 0x7f) return Type::Uint;
+    if (marker >= 0xe0) return Type::Int;
+    if (marker >= 0x80 && marker <= 0x8f) return Type::Map;
+    if (marker >= 0x90 && marker <= 0x9f) return Type::Array;
+    if (marker >= 0xa0 && marker <= 0xbf) return Type::String;
+
+    switch (marker) {
+        case 0xc0: return Type::Nil;
+        case 0xc2: case 0xc3: return Type::Bool;
+        case 0xc4: case 0xc5: case 0xc6: return Type::Binary;
+        case 0xca: case 0xcb: return Type::Float;
+        case 0xcc: case 0xcd: case 0xce: case 0xcf: return Type::Uint;
+        case 0xd0: case 0xd1: case 0xd2: case 0xd3: return Type::Int;
+        case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8:
+        case 0xc7: case 0xc8: case 0xc9: return Type::Extension;
+        case 0xd9: case 0xda: case 0xdb: return Type::String;
+        case 0xdc: case 0xdd: return Type::Array;
+        case 0xde: case 0xdf: return Type::Map;
+        default: throw BtoonException("Unknown marker");
+    }
+}
+
+size_t DocumentCursor::readContainerHeader(std::span<const uint8_t> buffer,
+                                           size_t& pos, bool& is_map) {
+    check_bounds(pos, 1, buffer.size());
+    uint8_t marker = buffer[pos++];
+
+    if (marker >= 0x80 && marker <= 0x8f) { is_map = true;  return marker & 0x0f; }
+    if (marker >= 0x90 && marker <= 0x9f) { is_map = false; return marker & 0x0f; }
+
+    switch (marker) {
+        case 0xdc: is_map = false; return read_be_length(buffer, pos, 2);
+        case 0xdd: is_map = false; return read_be_length(buffer, pos, 4);
+        case 0xde: is_map = true;  return read_be_length(buffer, pos, 2);
+        case 0xdf: is_map = true;  return read_be_length(buffer, pos, 4);
+        default: throw BtoonException("DocumentCursor: not a container");
+    }
+}
+
+std::string_view DocumentCursor::readStringKey(std::span<const uint8_t> buffer,
+                                               size_t& pos) {
+    check_bounds(pos, 1, buffer.size());
+    uint8_t marker = buffer[pos++];
+    size_t len = 0;
+    if (marker >= 0xa0 && marker <= 0xbf) { len = marker & 0x1f; }
+    else if (marker == 0xd9) { len = read_be_length(buffer, pos, 1); }
+    else if (marker == 0xda) { len = read_be_length(buffer, pos, 2); }
+    else if (marker == 0xdb) { len = read_be_length(buffer, pos, 4); }
+    else { throw BtoonException("DocumentCursor: map key is not a string"); }
+    check_bounds(pos, len, buffer.size());
+    std::string_view key(reinterpret_cast<const char*>(&buffer[pos]), len);
+    pos += len;
+    return key;
+}
+
+size_t DocumentCursor::skipValue(std::span<const uint8_t> buffer, size_t pos) {
+    // Iterative skip: `remaining` counts complete values still to be passed
+    // over. Containers bump the count instead of recursing, so deeply nested
+    // documents cannot exhaust the stack.
+    size_t remaining = 1;
+    while (remaining > 0) {
+        --remaining;
+        check_bounds(pos, 1, buffer.size());
+        uint8_t marker = buffer[pos++];
+
+        if (marker <= 0x7f || marker >= 0xe0) continue;   // fixint
+        if (marker >= 0x80 && marker <= 0x8f) {           // fixmap
+            remaining += 2 * static_cast<size_t>(marker & 0x0f);
+            continue;
+        }
+        if (marker >= 0x90 && marker <= 0x9f) {           // fixarray
+            remaining += marker & 0x0f;
+            continue;
+        }
+        if (marker >= 0xa0 && marker <= 0xbf) {           // fixstr
+            size_t len = marker & 0x1f;
+            check_bounds(pos, len, buffer.size());
+            pos += len;
+            continue;
+        }
+
+        switch (marker) {
+            case 0xc0: case 0xc2: case 0xc3: break;       // nil, bool
+            case 0xca: pos += 4; check_bounds(pos, 0, buffer.size()); break;
+            case 0xcb: pos += 8; check_bounds(pos, 0, buffer.size()); break;
+            case 0xcc: case 0xd0: pos += 1; check_bounds(pos, 0, buffer.size()); break;
+            case 0xcd: case 0xd1: pos += 2; check_bounds(pos, 0, buffer.size()); break;
+            case 0xce: case 0xd2: pos += 4; check_bounds(pos, 0, buffer.size()); break;
+            case 0xcf: case 0xd3: pos += 8; check_bounds(pos, 0, buffer.size()); break;
+            case 0xd9: case 0xc4: {                       // str8 / bin8
+                size_t len = read_be_length(buffer, pos, 1);
+                check_bounds(pos, len, buffer.size());
+                pos += len;
+                break;
+            }
+            case 0xda: case 0xc5: {                       // str16 / bin16
+                size_t len = read_be_length(buffer, pos, 2);
+                check_bounds(pos, len, buffer.size());
+                pos += len;
+                break;
+            }
+            case 0xdb: case 0xc6: {                       // str32 / bin32
+                size_t len = read_be_length(buffer, pos, 4);
+                check_bounds(pos, len, buffer.size());
+                pos += len;
+                break;
+            }
+            case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8: { // fixext
+                size_t len = size_t{1} << (marker - 0xd4);
+                check_bounds(pos, len + 1, buffer.size()); // type byte + payload
+                pos += len + 1;
+                break;
+            }
+            case 0xc7: case 0xc8: case 0xc9: {            // ext8/16/32
+                size_t bytes = marker == 0xc7 ? 1 : marker == 0xc8 ? 2 : 4;
+                size_t len = read_be_length(buffer, pos, bytes);
+                check_bounds(pos, len + 1, buffer.size()); // type byte + payload
+                pos += len + 1;
+                break;
+            }
+            case 0xdc: remaining += read_be_length(buffer, pos, 2); break;
+            case 0xdd: remaining += read_be_length(buffer, pos, 4); break;
+            case 0xde: remaining += 2 * read_be_length(buffer, pos, 2); break;
+            case 0xdf: remaining += 2 * read_be_length(buffer, pos, 4); break;
+            default: throw BtoonException("Unknown marker");
+        }
+    }
+    return pos;
+}
+
+size_t DocumentCursor::size() const {
+    requireValid();
+    size_t pos = pos_;
+    bool is_map = false;
+    return readContainerHeader(buffer_, pos, is_map);
+}
+
+DocumentCursor DocumentCursor::find(std::string_view key) const {
+    requireValid();
+    size_t pos = pos_;
+    bool is_map = false;
+    size_t entries = readContainerHeader(buffer_, pos, is_map);
+    if (!is_map) {
+        throw BtoonException("DocumentCursor: find() requires a map");
+    }
+    for (size_t i = 0; i < entries; ++i) {
+        std::string_view entry_key = readStringKey(buffer_, pos);
+        if (entry_key == key) {
+            return DocumentCursor(buffer_, pos, true);
+        }
+        pos = skipValue(buffer_, pos);
+    }
+    return DocumentCursor(buffer_, pos, false);
+}
+
+DocumentCursor DocumentCursor::at(size_t index) const {
+    requireValid();
+    size_t pos = pos_;
+    bool is_map = false;
+    size_t count = readContainerHeader(buffer_, pos, is_map);
+    if (is_map) {
+        throw BtoonException("DocumentCursor: at() requires an array");
+    }
+    if (index >= count) {
+        throw BtoonException("DocumentCursor: array index out of range");
+    }
+    for (size_t i = 0; i < index; ++i) {
+        pos = skipValue(buffer_, pos);
+    }
+    return DocumentCursor(buffer_, pos, true);
+}
+
+ValueView DocumentCursor::value() const {
+    requireValid();
+    size_t pos = pos_;
+    return decode_view(buffer_, pos, 0);
+}
+
+std::span<const uint8_t> DocumentCursor::raw() const {
+    requireValid();
+    size_t end = skipValue(buffer_, pos_);
+    return buffer_.subspan(pos_, end - pos_);
+}
+
+} // namespace btoon
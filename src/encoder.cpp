@@ -9,7 +9,10 @@
 #endif
 
 #include "btoon/encoder.h"
+#include "btoon/batch_processor.h"
 #include <algorithm>
+#include <chrono>
+#include <numeric>
 #include <stdexcept>
 #include <cstring>
 #include <iostream>
@@ -75,6 +78,20 @@ std::span<const uint8_t> Encoder::getBuffer() {
     return {buffer_, size_};
 }
 
+void Encoder::reset() {
+    size_ = 0;
+}
+
+std::vector<uint8_t> Encoder::takeBuffer() {
+    addSignatureIfEnabled();
+    std::vector<uint8_t> out(size_);
+    if (size_ > 0) {
+        simd_copy(out.data(), buffer_, size_);
+    }
+    reset();
+    return out;
+}
+
 void Encoder::encodeNil() {
     grow_buffer(1);
     buffer_[size_++] = 0xc0;
@@ -156,8 +173,7 @@ void Encoder::encodeFloat(double value) {
     size_ += 8;
 }
 
-void Encoder::encodeString(const std::string& value) {
-    size_t len = value.size();
+void Encoder::encodeStringHeader(size_t len) {
     if (len <= 31) {
         grow_buffer(1 + len);
         buffer_[size_++] = static_cast<uint8_t>(0xa0 | len);
@@ -178,17 +194,9 @@ void Encoder::encodeString(const std::string& value) {
         std::memcpy(buffer_ + size_, &be_len, 4);
         size_ += 4;
     }
-    // Use SIMD copy for strings longer than 32 bytes
-    if (len > 32) {
-        simd_copy(buffer_ + size_, reinterpret_cast<const uint8_t*>(value.data()), len);
-    } else {
-        std::memcpy(buffer_ + size_, value.data(), len);
-    }
-    size_ += len;
 }
 
-void Encoder::encodeBinary(std::span<const uint8_t> value) {
-    size_t len = value.size();
+void Encoder::encodeBinaryHeader(size_t len) {
     if (len <= 255) {
         grow_buffer(2 + len);
         buffer_[size_++] = 0xc4;
@@ -206,6 +214,27 @@ void Encoder::encodeBinary(std::span<const uint8_t> value) {
         std::memcpy(buffer_ + size_, &be_len, 4);
         size_ += 4;
     }
+}
+
+void Encoder::encodeString(const std::string& value) {
+    encodeString(std::string_view(value));
+}
+
+void Encoder::encodeString(std::string_view value) {
+    size_t len = value.size();
+    encodeStringHeader(len);
+    // Use SIMD copy for strings longer than 32 bytes
+    if (len > 32) {
+        simd_copy(buffer_ + size_, reinterpret_cast<const uint8_t*>(value.data()), len);
+    } else {
+        std::memcpy(buffer_ + size_, value.data(), len);
+    }
+    size_ += len;
+}
+
+void Encoder::encodeBinary(std::span<const uint8_t> value) {
+    size_t len = value.size();
+    encodeBinaryHeader(len);
     // Use SIMD copy for binary data longer than 32 bytes
     if (len > 32) {
         simd_copy(buffer_ + size_, value.data(), len);
@@ -215,8 +244,7 @@ void Encoder::encodeBinary(std::span<const uint8_t> value) {
     size_ += len;
 }
 
-void Encoder::encodeArray(const std::vector<std::vector<uint8_t>>& elements) {
-    size_t len = elements.size();
+void Encoder::encodeArrayHeader(size_t len) {
     if (len <= 15) {
         grow_buffer(1);
         buffer_[size_++] = static_cast<uint8_t>(0x90 | len);
@@ -233,15 +261,9 @@ void Encoder::encodeArray(const std::vector<std::vector<uint8_t>>& elements) {
         std::memcpy(buffer_ + size_, &be_len, 4);
         size_ += 4;
     }
-    for (const auto& elem : elements) {
-        grow_buffer(elem.size());
-        std::memcpy(buffer_ + size_, elem.data(), elem.size());
-        size_ += elem.size();
-    }
 }
 
-void Encoder::encodeMap(const std::map<std::string, std::vector<uint8_t>>& pairs) {
-    size_t len = pairs.size();
+void Encoder::encodeMapHeader(size_t len) {
     if (len <= 15) {
         grow_buffer(1);
         buffer_[size_++] = static_cast<uint8_t>(0x80 | len);
@@ -258,6 +280,19 @@ void Encoder::encodeMap(const std::map<std::string, std::vector<uint8_t>>& pairs
         std::memcpy(buffer_ + size_, &be_len, 4);
         size_ += 4;
     }
+}
+
+void Encoder::encodeArray(const std::vector<std::vector<uint8_t>>& elements) {
+    encodeArrayHeader(elements.size());
+    for (const auto& elem : elements) {
+        grow_buffer(elem.size());
+        std::memcpy(buffer_ + size_, elem.data(), elem.size());
+        size_ += elem.size();
+    }
+}
+
+void Encoder::encodeMap(const std::map<std::string, std::vector<uint8_t>>& pairs) {
+    encodeMapHeader(pairs.size());
     for (const auto& pair : pairs) {
         encodeString(pair.first);
         grow_buffer(pair.second.size());
@@ -295,23 +330,25 @@ void Encoder::encodeTimestamp(const Timestamp& timestamp) {
 }
 
 void Encoder::encodeDate(int64_t milliseconds) {
-    encodeExtension(-1, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&milliseconds), 8));
+    uint64_t ms_be = htonll(static_cast<uint64_t>(milliseconds));
+    encodeExtension(-2, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&ms_be), 8));
 }
 
 void Encoder::encodeDateTime(int64_t nanoseconds) {
-    encodeExtension(-2, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&nanoseconds), 8));
+    uint64_t ns_be = htonll(static_cast<uint64_t>(nanoseconds));
+    encodeExtension(-3, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&ns_be), 8));
 }
 
 void Encoder::encodeBigInt(std::span<const uint8_t> bytes) {
-    encodeExtension(0, bytes);
+    encodeExtension(-4, bytes);
 }
 
 void Encoder::encodeVectorFloat(const VectorFloat& value) {
-    encodeExtension(-3, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(value.data.data()), value.data.size() * sizeof(float)));
+    encodeExtension(-5, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(value.data.data()), value.data.size() * sizeof(float)));
 }
 
 void Encoder::encodeVectorDouble(const VectorDouble& value) {
-    encodeExtension(-4, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(value.data.data()), value.data.size() * sizeof(double)));
+    encodeExtension(-6, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(value.data.data()), value.data.size() * sizeof(double)));
 }
 
 void Encoder::encodeExtension(int8_t type, std::span<const uint8_t> data) {
@@ -353,11 +390,146 @@ void Encoder::encodeExtension(int8_t type, std::span<const uint8_t> data) {
     size_ += len;
 }
 
+void Encoder::encodeColumnarChunked(const Array& data) {
+    const auto* first_row = std::get_if<Map>(&data[0]);
+    std::vector<std::string> column_names;
+    for (const auto& [key, _] : *first_row) {
+        column_names.push_back(key);
+    }
+    std::sort(column_names.begin(), column_names.end());
+
+    std::vector<uint8_t> payload;
+    auto append_u32 = [&](uint32_t v) {
+        uint32_t be = htonl(v);
+        payload.insert(payload.end(), reinterpret_cast<uint8_t*>(&be), reinterpret_cast<uint8_t*>(&be) + 4);
+    };
+
+    // --- Header (same shape as v1, version bumped to 2) ---
+    append_u32(2);
+    append_u32(static_cast<uint32_t>(column_names.size()));
+    append_u32(static_cast<uint32_t>(data.size()));
+
+    for (const auto& name : column_names) {
+        append_u32(static_cast<uint32_t>(name.length()));
+        payload.insert(payload.end(), name.begin(), name.end());
+    }
+
+    for (const auto& name : column_names) {
+        const auto& val = (*first_row).at(name);
+        std::visit([&](auto&& arg) {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, Nil>) payload.push_back(0);
+            else if constexpr (std::is_same_v<T, Bool>) payload.push_back(1);
+            else if constexpr (std::is_same_v<T, Int>) payload.push_back(2);
+            else if constexpr (std::is_same_v<T, Uint>) payload.push_back(3);
+            else if constexpr (std::is_same_v<T, Float>) payload.push_back(4);
+            else if constexpr (std::is_same_v<T, String>) payload.push_back(5);
+            else payload.push_back(0); // Default to unknown
+        }, val);
+    }
+
+    // --- Row-group section ---
+    size_t group_size = options_.columnar_row_group_size;
+    size_t num_chunks = (data.size() + group_size - 1) / group_size;
+    append_u32(static_cast<uint32_t>(group_size));
+    append_u32(static_cast<uint32_t>(num_chunks));
+
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        size_t row_begin = chunk * group_size;
+        size_t row_end = std::min(row_begin + group_size, data.size());
+        append_u32(static_cast<uint32_t>(row_end - row_begin));
+
+        // Serialize and compress the chunk of each column; with
+        // columnar_encode_threads != 1 the columns of a row group are
+        // processed concurrently, each task on its own MemoryPool.
+        struct ChunkColumn {
+            CompressionAlgorithm algorithm = CompressionAlgorithm::NONE;
+            uint32_t uncompressed_size = 0;
+            std::vector<uint8_t> stored;
+        };
+
+        auto build_chunk_column = [&](size_t col, MemoryPool* pool) -> ChunkColumn {
+            const auto& name = column_names[col];
+            std::vector<uint8_t> column_data;
+            for (size_t row = row_begin; row < row_end; ++row) {
+                const auto* row_map = std::get_if<Map>(&data[row]);
+                Encoder temp_encoder(pool); // No security
+                temp_encoder.setOptions(options_);
+                temp_encoder.encode((*row_map).at(name));
+                auto buf = temp_encoder.getBuffer();
+                column_data.insert(column_data.end(), buf.begin(), buf.end());
+            }
+
+            // Per-column algorithm override, falling back to the default.
+            CompressionAlgorithm algo = options_.columnar_compression;
+            auto it = options_.columnar_column_compression.find(name);
+            if (it != options_.columnar_column_compression.end()) {
+                algo = it->second;
+            }
+
+            ChunkColumn result;
+            result.uncompressed_size = static_cast<uint32_t>(column_data.size());
+            if (algo != CompressionAlgorithm::NONE) {
+                std::vector<uint8_t> compressed = compress(algo, column_data, options_.compression_level);
+                // Keep the chunk raw when compression does not pay off.
+                if (compressed.size() < column_data.size()) {
+                    result.algorithm = algo;
+                    result.stored = std::move(compressed);
+                    return result;
+                }
+            }
+            result.stored = std::move(column_data);
+            return result;
+        };
+
+        std::vector<ChunkColumn> chunk_columns(column_names.size());
+        if (options_.columnar_encode_threads != 1 && column_names.size() > 1) {
+            batch::BatchOptions batch_options;
+            batch_options.worker_threads = options_.columnar_encode_threads;
+            batch_options.batch_size = 1;
+            batch::ParallelBatchProcessor<size_t, std::pair<size_t, ChunkColumn>> processor(
+                [&](const size_t& col) {
+                    MemoryPool column_pool;
+                    return std::make_pair(col, build_chunk_column(col, &column_pool));
+                },
+                batch_options);
+
+            std::vector<size_t> column_indices(column_names.size());
+            std::iota(column_indices.begin(), column_indices.end(), size_t{0});
+            auto results = processor.process(column_indices);
+            if (results.size() != column_names.size()) {
+                throw BtoonException("Parallel columnar encode failed");
+            }
+            for (auto& [col, chunk_column] : results) {
+                chunk_columns[col] = std::move(chunk_column);
+            }
+        } else {
+            for (size_t col = 0; col < column_names.size(); ++col) {
+                chunk_columns[col] = build_chunk_column(col, pool_);
+            }
+        }
+
+        for (const auto& chunk_column : chunk_columns) {
+            payload.push_back(static_cast<uint8_t>(chunk_column.algorithm));
+            append_u32(chunk_column.uncompressed_size);
+            append_u32(static_cast<uint32_t>(chunk_column.stored.size()));
+            payload.insert(payload.end(), chunk_column.stored.begin(), chunk_column.stored.end());
+        }
+    }
+
+    encodeExtension(-10, payload);
+}
+
 void Encoder::encodeColumnar(const Array& data) {
+    if (options_.columnar_row_group_size > 0 && is_tabular(data)) {
+        encodeColumnarChunked(data);
+        return;
+    }
     if (!is_tabular(data)) {
         std::vector<std::vector<uint8_t>> elements;
         for(const auto& v : data) {
             Encoder temp_encoder;
+            temp_encoder.setOptions(options_);
             temp_encoder.encode(v);
             auto buf = temp_encoder.getBuffer();
             elements.emplace_back(buf.begin(), buf.end());
@@ -375,8 +547,12 @@ void Encoder::encodeColumnar(const Array& data) {
 
     std::vector<uint8_t> schema_bytes;
 
-    // version
-    schema_bytes.push_back(0); schema_bytes.push_back(0); schema_bytes.push_back(0); schema_bytes.push_back(1);
+    // version (3 = monolithic v1 layout plus a column offset table,
+    //          4 = v3 plus per-column validity bitmaps with packed values,
+    //          5 = v4 plus dictionary-encoded string columns; patched in
+    //              below once the columns have been serialized)
+    schema_bytes.push_back(0); schema_bytes.push_back(0); schema_bytes.push_back(0);
+    schema_bytes.push_back(options_.columnar_validity_bitmaps ? 4 : 3);
 
     // num_columns
     uint32_t num_columns_val = htonl(column_names.size());
@@ -406,22 +582,189 @@ void Encoder::encodeColumnar(const Array& data) {
         }, val);
     }
 
-    std::vector<uint8_t> columns_data_bytes;
-    for (const auto& name : column_names) {
+    // Serialize each column's value stream. Columns are independent, so with
+    // EncodeOptions::columnar_encode_threads != 1 they are distributed over
+    // the ParallelBatchProcessor worker pool; each task uses its own
+    // MemoryPool, since pools are not thread-safe.
+    auto serialize_column = [&](size_t col, MemoryPool* pool) -> std::vector<uint8_t> {
+        if (options_.columnar_validity_bitmaps) {
+            // v4 column entry: [flags u8][validity bitmap][packed values].
+            // Bit (row % 8) of bitmap byte (row / 8) is set for non-null
+            // rows; only non-null values are stored, contiguously. All-Float
+            // columns pack as raw big-endian doubles (flag 0x02) so readers
+            // can bulk-copy them without per-value marker dispatch.
+            const auto& name = column_names[col];
+            size_t num_rows = data.size();
+            std::vector<uint8_t> bitmap((num_rows + 7) / 8, 0);
+            bool all_float = true;
+            bool all_string = true;
+            size_t non_null = 0;
+            for (size_t row = 0; row < num_rows; ++row) {
+                const auto& value = std::get_if<Map>(&data[row])->at(name);
+                if (!std::holds_alternative<Nil>(value)) {
+                    bitmap[row / 8] |= static_cast<uint8_t>(1u << (row % 8));
+                    ++non_null;
+                    if (!std::holds_alternative<Float>(value)) {
+                        all_float = false;
+                    }
+                    if (!std::holds_alternative<String>(value)) {
+                        all_string = false;
+                    }
+                }
+            }
+            bool packed_float = all_float && non_null > 0;
+
+            // All-String columns with low observed cardinality are
+            // dictionary-encoded (flag 0x04): the distinct strings are
+            // written once as a dictionary page and each non-null row
+            // stores only a varint index into it. The cutoff — at most
+            // 65535 distinct values, each repeated twice on average —
+            // keeps unique-string columns on the plain path.
+            std::map<std::string, uint64_t> dictionary;
+            if (all_string && non_null > 0) {
+                for (size_t row = 0; row < num_rows; ++row) {
+                    const auto& value = std::get_if<Map>(&data[row])->at(name);
+                    if (!std::holds_alternative<Nil>(value)) {
+                        dictionary.try_emplace(std::get<String>(value), dictionary.size());
+                    }
+                }
+                if (dictionary.size() > 0xFFFF || dictionary.size() * 2 > non_null) {
+                    dictionary.clear();
+                }
+            }
+            bool dictionary_encoded = !dictionary.empty();
+
+            std::vector<uint8_t> column_data;
+            uint8_t flags = 0x01;
+            if (packed_float) flags |= 0x02;
+            if (dictionary_encoded) flags |= 0x04;
+            column_data.push_back(flags);
+            column_data.insert(column_data.end(), bitmap.begin(), bitmap.end());
+
+            auto put_varint = [&](uint64_t v) {
+                while (v >= 0x80) {
+                    column_data.push_back(static_cast<uint8_t>(v) | 0x80);
+                    v >>= 7;
+                }
+                column_data.push_back(static_cast<uint8_t>(v));
+            };
+
+            if (dictionary_encoded) {
+                // Dictionary page: entry count, then each distinct string
+                // encoded once in index order.
+                put_varint(dictionary.size());
+                std::vector<const std::string*> ordered(dictionary.size());
+                for (const auto& [entry, index] : dictionary) {
+                    ordered[index] = &entry;
+                }
+                for (const std::string* entry : ordered) {
+                    Encoder temp_encoder(pool); // No security
+                    temp_encoder.setOptions(options_);
+                    temp_encoder.encodeString(*entry);
+                    auto buf = temp_encoder.getBuffer();
+                    column_data.insert(column_data.end(), buf.begin(), buf.end());
+                }
+                for (size_t row = 0; row < num_rows; ++row) {
+                    const auto& value = std::get_if<Map>(&data[row])->at(name);
+                    if (!std::holds_alternative<Nil>(value)) {
+                        put_varint(dictionary.at(std::get<String>(value)));
+                    }
+                }
+                return column_data;
+            }
+
+            for (size_t row = 0; row < num_rows; ++row) {
+                const auto& value = std::get_if<Map>(&data[row])->at(name);
+                if (std::holds_alternative<Nil>(value)) {
+                    continue;
+                }
+                if (packed_float) {
+                    uint64_t bits;
+                    double d = std::get<Float>(value);
+                    std::memcpy(&bits, &d, 8);
+                    bits = htonll(bits);
+                    const uint8_t* p = reinterpret_cast<const uint8_t*>(&bits);
+                    column_data.insert(column_data.end(), p, p + 8);
+                } else {
+                    Encoder temp_encoder(pool); // No security
+                    temp_encoder.setOptions(options_);
+                    temp_encoder.encode(value);
+                    auto buf = temp_encoder.getBuffer();
+                    column_data.insert(column_data.end(), buf.begin(), buf.end());
+                }
+            }
+            return column_data;
+        }
+
         std::vector<uint8_t> column_data;
         for (const auto& row_value : data) {
             const auto* row = std::get_if<Map>(&row_value);
-            Encoder temp_encoder(pool_); // Uses the main pool, no security
-            temp_encoder.encode((*row).at(name));
+            Encoder temp_encoder(pool); // No security
+            temp_encoder.setOptions(options_);
+            temp_encoder.encode((*row).at(column_names[col]));
             auto buf = temp_encoder.getBuffer();
             column_data.insert(column_data.end(), buf.begin(), buf.end());
         }
+        return column_data;
+    };
 
+    std::vector<std::vector<uint8_t>> encoded_columns(column_names.size());
+    if (options_.columnar_encode_threads != 1 && column_names.size() > 1) {
+        batch::BatchOptions batch_options;
+        batch_options.worker_threads = options_.columnar_encode_threads;
+        batch_options.batch_size = 1;
+        batch::ParallelBatchProcessor<size_t, std::pair<size_t, std::vector<uint8_t>>> processor(
+            [&](const size_t& col) {
+                MemoryPool column_pool;
+                return std::make_pair(col, serialize_column(col, &column_pool));
+            },
+            batch_options);
+
+        std::vector<size_t> column_indices(column_names.size());
+        std::iota(column_indices.begin(), column_indices.end(), size_t{0});
+        auto results = processor.process(column_indices);
+        if (results.size() != column_names.size()) {
+            throw BtoonException("Parallel columnar encode failed");
+        }
+        for (auto& [col, bytes] : results) {
+            encoded_columns[col] = std::move(bytes);
+        }
+    } else {
+        for (size_t col = 0; col < column_names.size(); ++col) {
+            encoded_columns[col] = serialize_column(col, pool_);
+        }
+    }
+
+    // Version 5 is v4 plus dictionary-encoded string columns. It is only
+    // declared when some column actually carries a dictionary page, so
+    // payloads without one stay readable by v4 decoders.
+    if (options_.columnar_validity_bitmaps) {
+        for (const auto& column_data : encoded_columns) {
+            if (!column_data.empty() && (column_data[0] & 0x04)) {
+                schema_bytes[3] = 5;
+                break;
+            }
+        }
+    }
+
+    std::vector<uint8_t> columns_data_bytes;
+    std::vector<uint32_t> column_offsets;
+    column_offsets.reserve(column_names.size());
+    for (const auto& column_data : encoded_columns) {
+        column_offsets.push_back(static_cast<uint32_t>(columns_data_bytes.size()));
         uint32_t column_data_size_val = htonl(column_data.size());
         columns_data_bytes.insert(columns_data_bytes.end(), reinterpret_cast<uint8_t*>(&column_data_size_val), reinterpret_cast<uint8_t*>(&column_data_size_val) + 4);
         columns_data_bytes.insert(columns_data_bytes.end(), column_data.begin(), column_data.end());
     }
-    
+
+    // Column offset table: byte offset of each column's size-prefixed entry
+    // within the data section, so readers can seek straight to the columns a
+    // query projects instead of scanning all of them.
+    for (uint32_t offset : column_offsets) {
+        uint32_t offset_be = htonl(offset);
+        schema_bytes.insert(schema_bytes.end(), reinterpret_cast<uint8_t*>(&offset_be), reinterpret_cast<uint8_t*>(&offset_be) + 4);
+    }
+
     std::vector<uint8_t> combined_bytes;
     combined_bytes.insert(combined_bytes.end(), schema_bytes.begin(), schema_bytes.end());
     combined_bytes.insert(combined_bytes.end(), columns_data_bytes.begin(), columns_data_bytes.end());
@@ -429,7 +772,36 @@ void Encoder::encodeColumnar(const Array& data) {
     encodeExtension(-10, combined_bytes);
 }
 
+Encoder::StatsFrame::StatsFrame(Encoder& encoder, const Value& value)
+    : encoder_(encoder) {
+    if (!encoder_.collectStats_) return;
+    top_ = encoder_.encodeDepth_++ == 0;
+    if (top_) {
+        start_size_ = encoder_.size_;
+        encoder_.stats_.messages++;
+        encoder_.stats_.count_value(value);
+    }
+}
+
+Encoder::StatsFrame::~StatsFrame() {
+    if (!encoder_.collectStats_) return;
+    --encoder_.encodeDepth_;
+    if (top_) {
+        encoder_.stats_.bytes_processed += encoder_.size_ - start_size_;
+    }
+}
+
+CodecStats Encoder::statistics() const {
+    CodecStats snapshot = stats_;
+    for (const auto& size_class : pool_->size_class_stats()) {
+        snapshot.pool_reuses += size_class.reuses;
+        snapshot.pool_free_bytes += size_class.free_bytes;
+    }
+    return snapshot;
+}
+
 void Encoder::encode(const Value& value) {
+    StatsFrame stats_frame(*this, value);
     std::visit([this](auto&& arg) {
         using T = std::decay_t<decltype(arg)>;
         if constexpr (std::is_same_v<T, Nil>) encodeNil();
@@ -446,6 +818,7 @@ void Encoder::encode(const Value& value) {
                 std::vector<std::vector<uint8_t>> elements;
                 for (const auto& v : arg) {
                     Encoder temp_encoder;
+                    temp_encoder.setOptions(options_);
                     temp_encoder.encode(v);
                     auto buf = temp_encoder.getBuffer();
                     elements.emplace_back(buf.begin(), buf.end());
@@ -457,12 +830,22 @@ void Encoder::encode(const Value& value) {
             std::map<std::string, std::vector<uint8_t>> pairs;
             for (const auto& [key, val] : arg) {
                 Encoder temp_encoder;
+                temp_encoder.setOptions(options_);
                 temp_encoder.encode(val);
                 auto buf = temp_encoder.getBuffer();
                 pairs[key] = std::vector<uint8_t>(buf.begin(), buf.end());
             }
             encodeMap(pairs);
         }
+        else if constexpr (std::is_same_v<T, FlatMap>) {
+            // Entries are already key-sorted, so the output is byte-identical
+            // to the std::map representation of the same contents.
+            encodeMapHeader(arg.size());
+            for (const auto& [key, val] : arg) {
+                encodeString(key);
+                encode(val);
+            }
+        }
         else if constexpr (std::is_same_v<T, Extension>) encodeExtension(arg.type, arg.data);
         else if constexpr (std::is_same_v<T, Timestamp>) encodeTimestamp(arg);
         else if constexpr (std::is_same_v<T, Date>) encodeDate(arg.milliseconds);
@@ -474,9 +857,149 @@ void Encoder::encode(const Value& value) {
     }, value);
 }
 
+void Encoder::encode(Value&& value) {
+    StatsFrame stats_frame(*this, value);
+    std::visit([this](auto&& arg) {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, std::vector<Value>>) {
+            if (options_.auto_tabular && is_tabular(arg)) {
+                encodeColumnar(arg);
+                return;
+            }
+            // Write the header from the known element count and encode the
+            // elements straight into this buffer, skipping the per-element
+            // temporary encoders (and their buffer copies) the lvalue path
+            // goes through.
+            encodeArrayHeader(arg.size());
+            for (auto& v : arg) {
+                encode(std::move(v));
+            }
+        } else if constexpr (std::is_same_v<T, std::map<String, Value>>) {
+            encodeMapHeader(arg.size());
+            for (auto& [key, val] : arg) {
+                encodeString(key);
+                encode(std::move(val));
+            }
+        } else if constexpr (std::is_same_v<T, FlatMap>) {
+            encodeMapHeader(arg.size());
+            for (auto& [key, val] : arg) {
+                encodeString(key);
+                encode(std::move(val));
+            }
+        } else if constexpr (std::is_same_v<T, Nil>) encodeNil();
+        else if constexpr (std::is_same_v<T, Bool>) encodeBool(arg);
+        else if constexpr (std::is_same_v<T, Int>) encodeInt(arg);
+        else if constexpr (std::is_same_v<T, Uint>) encodeUint(arg);
+        else if constexpr (std::is_same_v<T, Float>) encodeFloat(arg);
+        else if constexpr (std::is_same_v<T, String>) encodeString(arg);
+        else if constexpr (std::is_same_v<T, Binary>) encodeBinary(arg);
+        else if constexpr (std::is_same_v<T, Extension>) encodeExtension(arg.type, arg.data);
+        else if constexpr (std::is_same_v<T, Timestamp>) encodeTimestamp(arg);
+        else if constexpr (std::is_same_v<T, Date>) encodeDate(arg.milliseconds);
+        else if constexpr (std::is_same_v<T, DateTime>) encodeDateTime(arg.nanoseconds);
+        else if constexpr (std::is_same_v<T, BigInt>) encodeBigInt(arg.bytes);
+        else if constexpr (std::is_same_v<T, VectorFloat>) encodeVectorFloat(arg);
+        else if constexpr (std::is_same_v<T, VectorDouble>) encodeVectorDouble(arg);
+        else { throw BtoonException("Unsupported type for encoding"); }
+    }, value);
+}
+
+// ===== VectoredEncoder =====
+
+VectoredEncoder::VectoredEncoder(const EncodeOptions& options) {
+    framing_.setOptions(options);
+}
+
+std::vector<std::span<const uint8_t>> VectoredEncoder::encode(const Value& value) {
+    segments_.clear();
+    arena_.clear();
+    framing_.reset();
+    encodeValue(value);
+    flushFraming();
+    return segments_;
+}
+
+size_t VectoredEncoder::total_size() const {
+    size_t total = 0;
+    for (const auto& segment : segments_) {
+        total += segment.size();
+    }
+    return total;
+}
+
+// Move the pending framing bytes into stable arena storage and emit them as
+// a segment. The framing encoder's buffer may be reallocated as it grows, so
+// segments must never point into it directly.
+void VectoredEncoder::flushFraming() {
+    auto pending = framing_.getBuffer();
+    if (pending.empty()) {
+        return;
+    }
+    arena_.emplace_back(pending.begin(), pending.end());
+    segments_.emplace_back(arena_.back());
+    framing_.reset();
+}
+
+void VectoredEncoder::encodeValue(const Value& value) {
+    std::visit([this](auto&& arg) {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, String>) {
+            if (arg.size() >= inline_threshold_) {
+                framing_.encodeStringHeader(arg.size());
+                flushFraming();
+                segments_.emplace_back(reinterpret_cast<const uint8_t*>(arg.data()), arg.size());
+            } else {
+                framing_.encodeString(arg);
+            }
+        } else if constexpr (std::is_same_v<T, Binary>) {
+            if (arg.size() >= inline_threshold_) {
+                framing_.encodeBinaryHeader(arg.size());
+                flushFraming();
+                segments_.emplace_back(arg.data(), arg.size());
+            } else {
+                framing_.encodeBinary(arg);
+            }
+        } else if constexpr (std::is_same_v<T, std::vector<Value>>) {
+            if (framing_.options_.auto_tabular && is_tabular(arg)) {
+                // Columnar output interleaves all columns; encode it whole
+                // through the framing encoder.
+                framing_.encodeColumnar(arg);
+            } else {
+                framing_.encodeArrayHeader(arg.size());
+                for (const auto& v : arg) {
+                    encodeValue(v);
+                }
+            }
+        } else if constexpr (std::is_same_v<T, std::map<String, Value>>) {
+            framing_.encodeMapHeader(arg.size());
+            for (const auto& [key, val] : arg) {
+                framing_.encodeString(key);
+                encodeValue(val);
+            }
+        } else if constexpr (std::is_same_v<T, FlatMap>) {
+            framing_.encodeMapHeader(arg.size());
+            for (const auto& [key, val] : arg) {
+                framing_.encodeString(key);
+                encodeValue(val);
+            }
+        } else {
+            // Scalars, extensions and timestamps are a handful of bytes;
+            // they always travel with the framing.
+            framing_.encode(Value(arg));
+        }
+    }, value);
+}
+
 void Encoder::addSignatureIfEnabled() {
     if (useSecurity_ && security_ != nullptr) {
+        auto sign_start = std::chrono::steady_clock::now();
         auto signature = security_->sign({buffer_, size_});
+        if (collectStats_) {
+            stats_.signatures++;
+            stats_.signature_time_ms +=
+                std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - sign_start).count();
+        }
         uint8_t sigLen = static_cast<uint8_t>(signature.size());
         size_t new_size = 1 + sigLen + size_;
         uint8_t* new_buffer = static_cast<uint8_t*>(pool_->allocate(new_size));
@@ -0,0 +1,352 @@
+#include "btoon/graphql_schema.h"
+#include <algorithm>
+#include <sstream>
+
+namespace btoon {
+namespace graphql {
+
+// ============= GraphQLSchema =============
+
+GraphQLSchema::GraphQLSchema() {
+    init_built_in_scalars();
+}
+
+void GraphQLSchema::init_built_in_scalars() {
+    for (const char* name : {"Int", "Float", "String", "Boolean", "ID"}) {
+        types_.emplace(name, GraphQLType(name, GraphQLTypeKind::SCALAR));
+    }
+}
+
+void GraphQLSchema::add_type(const GraphQLType& type) {
+    types_.insert_or_assign(type.name, type);
+}
+
+void GraphQLSchema::add_scalar(const std::string& name, const std::string& description) {
+    GraphQLType scalar(name, GraphQLTypeKind::SCALAR);
+    scalar.description = description;
+    types_.insert_or_assign(name, std::move(scalar));
+}
+
+void GraphQLSchema::set_query_type(const std::string& type_name) { query_type_ = type_name; }
+void GraphQLSchema::set_mutation_type(const std::string& type_name) { mutation_type_ = type_name; }
+void GraphQLSchema::set_subscription_type(const std::string& type_name) {
+    subscription_type_ = type_name;
+}
+
+const GraphQLType* GraphQLSchema::get_type(const std::string& name) const {
+    auto it = types_.find(name);
+    return it != types_.end() ? &it->second : nullptr;
+}
+
+std::vector<GraphQLType> GraphQLSchema::get_all_types() const {
+    std::vector<GraphQLType> all;
+    all.reserve(types_.size());
+    for (const auto& [name, type] : types_) {
+        all.push_back(type);
+    }
+    return all;
+}
+
+// ============= StructCodegen =============
+
+namespace {
+
+// How a GraphQL scalar maps onto a struct member and the Encoder /
+// ValueView primitives used to move it across the wire.
+struct ScalarPlan {
+    const char* cpp_type;
+    const char* encode_fn;
+    const char* decode_fn;  // detail:: helper emitted in the prologue
+};
+
+const ScalarPlan* scalar_plan(const std::string& type) {
+    static const std::unordered_map<std::string, ScalarPlan> kPlans = {
+        {"Int", {"std::int64_t", "encodeInt", "to_int64"}},
+        {"Float", {"double", "encodeFloat", "to_double"}},
+        {"Decimal", {"double", "encodeFloat", "to_double"}},
+        {"String", {"std::string", "encodeString", "to_string"}},
+        {"ID", {"std::string", "encodeString", "to_string"}},
+        {"Boolean", {"bool", "encodeBool", "to_bool"}},
+        {"Timestamp", {"btoon::Timestamp", "encodeTimestamp", "to_timestamp"}},
+        {"Binary", {"std::vector<std::uint8_t>", "encodeBinary", "to_binary"}},
+    };
+    auto it = kPlans.find(type);
+    return it == kPlans.end() ? nullptr : &it->second;
+}
+
+bool is_object_kind(GraphQLTypeKind kind) {
+    return kind == GraphQLTypeKind::OBJECT || kind == GraphQLTypeKind::INPUT_OBJECT;
+}
+
+// Coercion-tolerant extraction helpers shared by all generated structs.
+// Emitted once per generated header.
+const char* kDetailHelpers = R"(namespace detail {
+
+inline std::int64_t to_int64(const btoon::ValueView& v) {
+    // Non-negative integers decode as Uint regardless of how they were
+    // declared, so accept both representations.
+    if (const btoon::Uint* u = std::get_if<btoon::Uint>(&v)) {
+        return static_cast<std::int64_t>(*u);
+    }
+    return std::get<btoon::Int>(v);
+}
+
+inline double to_double(const btoon::ValueView& v) {
+    if (const btoon::Float* f = std::get_if<btoon::Float>(&v)) {
+        return *f;
+    }
+    return static_cast<double>(to_int64(v));
+}
+
+inline bool to_bool(const btoon::ValueView& v) {
+    return std::get<btoon::Bool>(v);
+}
+
+inline std::string to_string(const btoon::ValueView& v) {
+    return std::string(std::get<std::string_view>(v));
+}
+
+inline btoon::Timestamp to_timestamp(const btoon::ValueView& v) {
+    return std::get<btoon::Timestamp>(v);
+}
+
+inline std::vector<std::uint8_t> to_binary(const btoon::ValueView& v) {
+    auto bytes = std::get<std::span<const std::uint8_t>>(v);
+    return std::vector<std::uint8_t>(bytes.begin(), bytes.end());
+}
+
+}  // namespace detail
+)";
+
+class Generator {
+public:
+    Generator(const GraphQLSchema& schema, const StructCodegen::Options& options)
+        : schema_(schema), options_(options) {}
+
+    std::string run() {
+        std::ostringstream out;
+        out << "// Generated by btoon StructCodegen - do not edit.\n"
+            << "#pragma once\n\n"
+            << "#include \"btoon/btoon.h\"\n"
+            << "#include \"btoon/encoder.h\"\n"
+            << "#include \"btoon/document_cursor.h\"\n"
+            << "#include <cstdint>\n"
+            << "#include <optional>\n"
+            << "#include <span>\n"
+            << "#include <string>\n"
+            << "#include <string_view>\n"
+            << "#include <vector>\n\n"
+            << "namespace " << options_.namespace_name << " {\n\n";
+        if (options_.generate_decode) {
+            out << kDetailHelpers << "\n";
+        }
+
+        for (const GraphQLType& type : schema_.get_all_types()) {
+            if (type.kind == GraphQLTypeKind::ENUM) {
+                emit_enum(out, type);
+            }
+        }
+        // Objects are emitted in dependency order so by-value members of
+        // nested object types are complete where they are used.
+        for (const GraphQLType& type : schema_.get_all_types()) {
+            if (is_object_kind(type.kind)) {
+                emit_object_recursive(out, type.name);
+            }
+        }
+
+        out << "}  // namespace " << options_.namespace_name << "\n";
+        return out.str();
+    }
+
+private:
+    enum class VisitState { UNVISITED, IN_PROGRESS, DONE };
+
+    void emit_object_recursive(std::ostringstream& out, const std::string& name) {
+        VisitState& state = visit_state_[name];
+        if (state == VisitState::DONE) return;
+        if (state == VisitState::IN_PROGRESS) {
+            throw BtoonException("Cyclic object composition has no by-value layout: " + name);
+        }
+        state = VisitState::IN_PROGRESS;
+
+        const GraphQLType* type = schema_.get_type(name);
+        if (!type) {
+            throw BtoonException("Unknown GraphQL type: " + name);
+        }
+        for (const GraphQLField& field : type->fields) {
+            const GraphQLType* field_type = schema_.get_type(field.type);
+            if (field_type && is_object_kind(field_type->kind)) {
+                emit_object_recursive(out, field_type->name);
+            }
+        }
+        emit_object(out, *type);
+        visit_state_[name] = VisitState::DONE;
+    }
+
+    void emit_enum(std::ostringstream& out, const GraphQLType& type) {
+        out << "enum class " << type.name << " : std::int64_t {\n";
+        for (size_t i = 0; i < type.enum_values.size(); ++i) {
+            out << "    " << type.enum_values[i] << " = " << i << ",\n";
+        }
+        out << "};\n\n";
+    }
+
+    // What a field's declared GraphQL type means for generated code.
+    struct FieldPlan {
+        std::string base_type;    // C++ type of one element
+        const ScalarPlan* scalar = nullptr;
+        bool is_enum = false;
+        bool is_object = false;
+    };
+
+    FieldPlan plan_field(const GraphQLField& field) const {
+        FieldPlan plan;
+        if (const ScalarPlan* scalar = scalar_plan(field.type)) {
+            plan.base_type = scalar->cpp_type;
+            plan.scalar = scalar;
+            return plan;
+        }
+        const GraphQLType* type = schema_.get_type(field.type);
+        if (!type) {
+            throw BtoonException("Unknown GraphQL type: " + field.type);
+        }
+        if (type->kind == GraphQLTypeKind::ENUM) {
+            plan.base_type = type->name;
+            plan.is_enum = true;
+            return plan;
+        }
+        if (is_object_kind(type->kind)) {
+            plan.base_type = type->name;
+            plan.is_object = true;
+            return plan;
+        }
+        throw BtoonException("GraphQL type not representable as a struct field: " + field.type);
+    }
+
+    std::string member_type(const GraphQLField& field, const FieldPlan& plan) const {
+        if (field.is_list) return "std::vector<" + plan.base_type + ">";
+        if (!field.is_required) return "std::optional<" + plan.base_type + ">";
+        return plan.base_type;
+    }
+
+    std::string encode_element(const FieldPlan& plan, const std::string& expr) const {
+        if (plan.is_object) {
+            return expr + ".encodeTo(encoder);";
+        }
+        if (plan.is_enum) {
+            return "encoder.encodeInt(static_cast<std::int64_t>(" + expr + "));";
+        }
+        if (std::string(plan.scalar->encode_fn) == "encodeString") {
+            return "encoder.encodeString(std::string_view(" + expr + "));";
+        }
+        return "encoder." + std::string(plan.scalar->encode_fn) + "(" + expr + ");";
+    }
+
+    std::string decode_element(const FieldPlan& plan, const std::string& cursor) const {
+        if (plan.is_object) {
+            return plan.base_type + "::decodeFrom(" + cursor + ".raw())";
+        }
+        if (plan.is_enum) {
+            return "static_cast<" + plan.base_type + ">(detail::to_int64(" + cursor +
+                   ".value()))";
+        }
+        return "detail::" + std::string(plan.scalar->decode_fn) + "(" + cursor + ".value())";
+    }
+
+    void emit_object(std::ostringstream& out, const GraphQLType& type) {
+        if (!type.description.empty()) {
+            out << "// " << type.description << "\n";
+        }
+        out << "struct " << type.name << " {\n";
+        std::vector<FieldPlan> plans;
+        plans.reserve(type.fields.size());
+        for (const GraphQLField& field : type.fields) {
+            plans.push_back(plan_field(field));
+            out << "    " << member_type(field, plans.back()) << " " << field.name << "{};\n";
+        }
+
+        // encodeTo: fixed field order, keys as string_view literals.
+        out << "\n    void encodeTo(btoon::Encoder& encoder) const {\n"
+            << "        encoder.encodeMapHeader(" << type.fields.size() << ");\n";
+        for (size_t i = 0; i < type.fields.size(); ++i) {
+            const GraphQLField& field = type.fields[i];
+            out << "        encoder.encodeString(std::string_view{\"" << field.name << "\"});\n";
+            if (field.is_list) {
+                out << "        encoder.encodeArrayHeader(" << field.name << ".size());\n"
+                    << "        for (const auto& item : " << field.name << ") {\n"
+                    << "            " << encode_element(plans[i], "item") << "\n"
+                    << "        }\n";
+            } else if (!field.is_required) {
+                out << "        if (" << field.name << ".has_value()) {\n"
+                    << "            " << encode_element(plans[i], "*" + field.name) << "\n"
+                    << "        } else {\n"
+                    << "            encoder.encodeNil();\n"
+                    << "        }\n";
+            } else {
+                out << "        " << encode_element(plans[i], field.name) << "\n";
+            }
+        }
+        out << "    }\n";
+
+        if (options_.generate_decode) {
+            out << "\n    static " << type.name
+                << " decodeFrom(std::span<const std::uint8_t> buffer) {\n"
+                << "        btoon::DocumentCursor doc(buffer);\n"
+                << "        " << type.name << " out;\n";
+            for (size_t i = 0; i < type.fields.size(); ++i) {
+                emit_decode_field(out, type.fields[i], plans[i]);
+            }
+            out << "        return out;\n"
+                << "    }\n";
+        }
+        out << "};\n\n";
+    }
+
+    void emit_decode_field(std::ostringstream& out, const GraphQLField& field,
+                           const FieldPlan& plan) {
+        out << "        {\n"
+            << "            auto cursor = doc.find(\"" << field.name << "\");\n";
+        if (field.is_list) {
+            out << "            if (cursor.valid() && cursor.type() == "
+                   "btoon::DocumentCursor::Type::Array) {\n"
+                << "                const size_t count = cursor.size();\n"
+                << "                out." << field.name << ".reserve(count);\n"
+                << "                for (size_t i = 0; i < count; ++i) {\n"
+                << "                    auto element = cursor.at(i);\n"
+                << "                    out." << field.name << ".push_back("
+                << decode_element(plan, "element") << ");\n"
+                << "                }\n"
+                << "            }\n";
+        } else if (!field.is_required) {
+            out << "            if (cursor.valid() && cursor.type() != "
+                   "btoon::DocumentCursor::Type::Nil) {\n"
+                << "                out." << field.name << " = " << decode_element(plan, "cursor")
+                << ";\n"
+                << "            }\n";
+        } else {
+            out << "            if (!cursor.valid()) {\n"
+                << "                throw btoon::BtoonException(\"Missing required field: "
+                << field.name << "\");\n"
+                << "            }\n"
+                << "            out." << field.name << " = " << decode_element(plan, "cursor")
+                << ";\n";
+        }
+        out << "        }\n";
+    }
+
+    const GraphQLSchema& schema_;
+    const StructCodegen::Options& options_;
+    std::unordered_map<std::string, VisitState> visit_state_;
+};
+
+}  // namespace
+
+StructCodegen::StructCodegen() : options_() {}
+StructCodegen::StructCodegen(const Options& options) : options_(options) {}
+
+std::string StructCodegen::generate(const GraphQLSchema& schema) const {
+    return Generator(schema, options_).run();
+}
+
+} // namespace graphql
+} // namespace btoon
@@ -0,0 +1,612 @@
+#include "btoon/json_schema.h"
+#include <algorithm>
+#include <regex>
+#include <sstream>
+
+namespace btoon {
+namespace json_schema {
+
+// ============= JsonSchema =============
+
+JsonSchema::JsonSchema(JsonSchemaDraft draft) : draft_(draft) {}
+
+void JsonSchema::set_id(const std::string& id) { id_ = id; }
+void JsonSchema::set_title(const std::string& title) { title_ = title; }
+void JsonSchema::set_description(const std::string& description) { description_ = description; }
+void JsonSchema::set_version(const std::string& version) { version_ = version; }
+
+void JsonSchema::set_root_schema(const JsonSchemaProperty& schema) {
+    root_schema_ = schema;
+}
+
+const JsonSchemaProperty& JsonSchema::get_root_schema() const {
+    return root_schema_;
+}
+
+void JsonSchema::add_definition(const std::string& name, const JsonSchemaProperty& schema) {
+    definitions_[name] = schema;
+}
+
+const JsonSchemaProperty* JsonSchema::get_definition(const std::string& name) const {
+    auto it = definitions_.find(name);
+    return it != definitions_.end() ? &it->second : nullptr;
+}
+
+bool JsonSchema::validate(const Value& data, std::vector<std::string>& errors) const {
+    return JsonSchemaValidator(*this).validate(data, errors);
+}
+
+// ============= Format checkers =============
+
+namespace {
+
+// Format regexes are compiled once per process, not per validation.
+bool check_date(const std::string& s) {
+    static const std::regex re(R"(\d{4}-\d{2}-\d{2})");
+    return std::regex_match(s, re);
+}
+
+bool check_time(const std::string& s) {
+    static const std::regex re(R"(\d{2}:\d{2}:\d{2}(\.\d+)?([Zz]|[+-]\d{2}:\d{2})?)");
+    return std::regex_match(s, re);
+}
+
+bool check_date_time(const std::string& s) {
+    static const std::regex re(
+        R"(\d{4}-\d{2}-\d{2}[Tt]\d{2}:\d{2}:\d{2}(\.\d+)?([Zz]|[+-]\d{2}:\d{2}))");
+    return std::regex_match(s, re);
+}
+
+bool check_email(const std::string& s) {
+    static const std::regex re(R"([^@\s]+@[^@\s]+\.[^@\s]+)");
+    return std::regex_match(s, re);
+}
+
+bool check_hostname(const std::string& s) {
+    static const std::regex re(
+        R"(([A-Za-z0-9]([A-Za-z0-9-]{0,61}[A-Za-z0-9])?\.)*[A-Za-z0-9]([A-Za-z0-9-]{0,61}[A-Za-z0-9])?)");
+    return !s.empty() && s.size() <= 253 && std::regex_match(s, re);
+}
+
+bool check_ipv4(const std::string& s) {
+    static const std::regex re(
+        R"(((25[0-5]|2[0-4]\d|1\d{2}|[1-9]?\d)\.){3}(25[0-5]|2[0-4]\d|1\d{2}|[1-9]?\d))");
+    return std::regex_match(s, re);
+}
+
+bool check_ipv6(const std::string& s) {
+    static const std::regex re(R"(([0-9A-Fa-f]{0,4}:){2,7}[0-9A-Fa-f]{0,4})");
+    return std::regex_match(s, re);
+}
+
+bool check_uuid(const std::string& s) {
+    static const std::regex re(
+        R"([0-9A-Fa-f]{8}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{12})");
+    return std::regex_match(s, re);
+}
+
+bool check_uri(const std::string& s) {
+    static const std::regex re(R"([A-Za-z][A-Za-z0-9+.-]*:\S*)");
+    return std::regex_match(s, re);
+}
+
+bool check_regex(const std::string& s) {
+    try {
+        std::regex probe(s);
+        return true;
+    } catch (const std::regex_error&) {
+        return false;
+    }
+}
+
+using FormatChecker = bool (*)(const std::string&);
+
+FormatChecker format_checker_for(JsonSchemaFormat format) {
+    switch (format) {
+        case JsonSchemaFormat::DATE: return &check_date;
+        case JsonSchemaFormat::TIME: return &check_time;
+        case JsonSchemaFormat::DATE_TIME: return &check_date_time;
+        case JsonSchemaFormat::EMAIL:
+        case JsonSchemaFormat::IDN_EMAIL: return &check_email;
+        case JsonSchemaFormat::HOSTNAME:
+        case JsonSchemaFormat::IDN_HOSTNAME: return &check_hostname;
+        case JsonSchemaFormat::IPV4: return &check_ipv4;
+        case JsonSchemaFormat::IPV6: return &check_ipv6;
+        case JsonSchemaFormat::UUID: return &check_uuid;
+        case JsonSchemaFormat::URI:
+        case JsonSchemaFormat::URI_REFERENCE:
+        case JsonSchemaFormat::IRI:
+        case JsonSchemaFormat::IRI_REFERENCE: return &check_uri;
+        case JsonSchemaFormat::REGEX: return &check_regex;
+        // Number formats and BTOON extensions are annotations here.
+        default: return nullptr;
+    }
+}
+
+bool matches_type(const Value& value, JsonSchemaType type) {
+    switch (type) {
+        case JsonSchemaType::NULL_TYPE: return std::holds_alternative<Nil>(value);
+        case JsonSchemaType::BOOLEAN: return std::holds_alternative<Bool>(value);
+        case JsonSchemaType::OBJECT:
+            return std::holds_alternative<Map>(value) || std::holds_alternative<FlatMap>(value);
+        case JsonSchemaType::ARRAY: return std::holds_alternative<Array>(value);
+        case JsonSchemaType::STRING: return std::holds_alternative<String>(value);
+        case JsonSchemaType::INTEGER:
+            return std::holds_alternative<Int>(value) || std::holds_alternative<Uint>(value);
+        case JsonSchemaType::NUMBER:
+            return std::holds_alternative<Int>(value) || std::holds_alternative<Uint>(value) ||
+                   std::holds_alternative<Float>(value);
+    }
+    return false;
+}
+
+const char* type_name(JsonSchemaType type) {
+    switch (type) {
+        case JsonSchemaType::NULL_TYPE: return "null";
+        case JsonSchemaType::BOOLEAN: return "boolean";
+        case JsonSchemaType::OBJECT: return "object";
+        case JsonSchemaType::ARRAY: return "array";
+        case JsonSchemaType::NUMBER: return "number";
+        case JsonSchemaType::STRING: return "string";
+        case JsonSchemaType::INTEGER: return "integer";
+    }
+    return "unknown";
+}
+
+std::optional<double> as_number(const Value& value) {
+    if (const Int* i = std::get_if<Int>(&value)) return static_cast<double>(*i);
+    if (const Uint* u = std::get_if<Uint>(&value)) return static_cast<double>(*u);
+    if (const Float* f = std::get_if<Float>(&value)) return *f;
+    return std::nullopt;
+}
+
+}  // namespace
+
+// ============= JsonSchemaValidator =============
+
+class JsonSchemaValidator::ValidatorImpl {
+public:
+    static constexpr size_t kNoNode = static_cast<size_t>(-1);
+
+    explicit ValidatorImpl(const JsonSchema& schema) : schema_(&schema) {
+        root_ = compile(schema.get_root_schema(), "#");
+        schema_ = nullptr;  // Compiled program no longer references the tree.
+    }
+
+    bool validate(const Value& value, std::vector<ValidationError>& errors) const {
+        return check(root_, value, "$", errors);
+    }
+
+private:
+    // One flattened schema node. Constraints are stored pre-resolved so
+    // evaluation is a straight walk with no tree interpretation.
+    struct Node {
+        std::string schema_path;
+        std::vector<JsonSchemaType> types;
+        std::optional<Value> const_value;
+        std::vector<Value> enum_values;
+
+        std::optional<size_t> min_length;
+        std::optional<size_t> max_length;
+        std::optional<std::regex> pattern;
+        std::string pattern_source;
+        FormatChecker format_checker = nullptr;
+        const char* format_name = "";
+
+        std::optional<double> minimum;
+        std::optional<double> maximum;
+        bool exclusive_minimum = false;
+        bool exclusive_maximum = false;
+        std::optional<double> multiple_of;
+
+        std::optional<size_t> min_items;
+        std::optional<size_t> max_items;
+        bool unique_items = false;
+        size_t items = kNoNode;
+
+        std::vector<std::pair<std::string, size_t>> properties;
+        std::vector<std::string> required;  // sorted
+        std::optional<size_t> min_properties;
+        std::optional<size_t> max_properties;
+        size_t additional_properties = kNoNode;
+        std::vector<std::tuple<std::regex, std::string, size_t>> pattern_properties;
+
+        std::vector<size_t> all_of;
+        std::vector<size_t> any_of;
+        std::vector<size_t> one_of;
+        size_t not_schema = kNoNode;
+        size_t if_schema = kNoNode;
+        size_t then_schema = kNoNode;
+        size_t else_schema = kNoNode;
+    };
+
+    size_t compile(const JsonSchemaProperty& prop, const std::string& schema_path) {
+        if (prop.ref.has_value()) {
+            return compile_ref(prop.ref.value());
+        }
+
+        size_t index = nodes_.size();
+        nodes_.emplace_back();
+
+        Node node;
+        node.schema_path = schema_path;
+        node.types = prop.type;
+        node.const_value = prop.const_value;
+        node.enum_values = prop.enum_values;
+
+        node.min_length = prop.min_length;
+        node.max_length = prop.max_length;
+        if (prop.pattern.has_value()) {
+            node.pattern.emplace(prop.pattern.value());
+            node.pattern_source = prop.pattern.value();
+        }
+        if (prop.format.has_value()) {
+            node.format_checker = format_checker_for(prop.format.value());
+            node.format_name = "format";
+        }
+
+        node.minimum = prop.minimum;
+        node.maximum = prop.maximum;
+        node.exclusive_minimum = prop.exclusive_minimum.value_or(false);
+        node.exclusive_maximum = prop.exclusive_maximum.value_or(false);
+        node.multiple_of = prop.multiple_of;
+
+        node.min_items = prop.min_items;
+        node.max_items = prop.max_items;
+        node.unique_items = prop.unique_items.value_or(false);
+        if (prop.items) {
+            node.items = compile(*prop.items, schema_path + "/items");
+        }
+
+        node.properties.reserve(prop.properties.size());
+        for (const auto& [name, child] : prop.properties) {
+            node.properties.emplace_back(
+                name, compile(child, schema_path + "/properties/" + name));
+        }
+        std::sort(node.properties.begin(), node.properties.end());
+        node.required = prop.required;
+        std::sort(node.required.begin(), node.required.end());
+        node.min_properties = prop.min_properties;
+        node.max_properties = prop.max_properties;
+        if (prop.additional_properties) {
+            node.additional_properties =
+                compile(*prop.additional_properties, schema_path + "/additionalProperties");
+        }
+        for (const auto& [source, child] : prop.pattern_properties) {
+            node.pattern_properties.emplace_back(
+                std::regex(source), source,
+                compile(child, schema_path + "/patternProperties/" + source));
+        }
+
+        for (size_t i = 0; i < prop.all_of.size(); ++i) {
+            node.all_of.push_back(
+                compile(prop.all_of[i], schema_path + "/allOf/" + std::to_string(i)));
+        }
+        for (size_t i = 0; i < prop.any_of.size(); ++i) {
+            node.any_of.push_back(
+                compile(prop.any_of[i], schema_path + "/anyOf/" + std::to_string(i)));
+        }
+        for (size_t i = 0; i < prop.one_of.size(); ++i) {
+            node.one_of.push_back(
+                compile(prop.one_of[i], schema_path + "/oneOf/" + std::to_string(i)));
+        }
+        if (prop.not_schema) {
+            node.not_schema = compile(*prop.not_schema, schema_path + "/not");
+        }
+        if (prop.if_schema) {
+            node.if_schema = compile(*prop.if_schema, schema_path + "/if");
+        }
+        if (prop.then_schema) {
+            node.then_schema = compile(*prop.then_schema, schema_path + "/then");
+        }
+        if (prop.else_schema) {
+            node.else_schema = compile(*prop.else_schema, schema_path + "/else");
+        }
+
+        nodes_[index] = std::move(node);
+        return index;
+    }
+
+    // $refs are resolved at compile time against the document's
+    // definitions. Each definition is compiled once and shared; a slot is
+    // reserved before the body is compiled so self-references terminate.
+    size_t compile_ref(const std::string& ref) {
+        std::string name = ref;
+        size_t slash = name.find_last_of('/');
+        if (slash != std::string::npos) {
+            name = name.substr(slash + 1);
+        }
+
+        auto it = ref_slots_.find(name);
+        if (it != ref_slots_.end()) {
+            return it->second;
+        }
+
+        const JsonSchemaProperty* definition = schema_->get_definition(name);
+        if (!definition) {
+            throw BtoonException("Unresolved $ref: " + ref);
+        }
+
+        size_t slot = nodes_.size();
+        nodes_.emplace_back();
+        ref_slots_.emplace(name, slot);
+
+        size_t compiled = compile(*definition, "#/$defs/" + name);
+        nodes_[slot] = nodes_[compiled];
+        return slot;
+    }
+
+    void report(const Node& node, const Value& value, const std::string& path,
+                std::string message, std::vector<ValidationError>& errors) const {
+        errors.push_back(ValidationError{path, std::move(message), node.schema_path, value});
+    }
+
+    bool check(size_t index, const Value& value, const std::string& path,
+               std::vector<ValidationError>& errors) const {
+        const Node& node = nodes_[index];
+        bool ok = true;
+
+        if (!node.types.empty()) {
+            bool matched = false;
+            for (JsonSchemaType t : node.types) {
+                if (matches_type(value, t)) {
+                    matched = true;
+                    break;
+                }
+            }
+            if (!matched) {
+                std::ostringstream msg;
+                msg << "Expected type";
+                for (size_t i = 0; i < node.types.size(); ++i) {
+                    msg << (i == 0 ? " " : " or ") << type_name(node.types[i]);
+                }
+                report(node, value, path, msg.str(), errors);
+                return false;  // Remaining constraints assume the type matched.
+            }
+        }
+
+        if (node.const_value.has_value() && !(value == node.const_value.value())) {
+            report(node, value, path, "Value does not match const", errors);
+            ok = false;
+        }
+        if (!node.enum_values.empty()) {
+            bool found = false;
+            for (const Value& candidate : node.enum_values) {
+                if (value == candidate) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                report(node, value, path, "Value is not one of the enumerated values", errors);
+                ok = false;
+            }
+        }
+
+        if (const String* s = std::get_if<String>(&value)) {
+            ok &= check_string(node, *s, value, path, errors);
+        } else if (auto number = as_number(value)) {
+            ok &= check_number(node, *number, value, path, errors);
+        } else if (const Array* array = std::get_if<Array>(&value)) {
+            ok &= check_array(node, *array, value, path, errors);
+        }
+        if (const Map* map = std::get_if<Map>(&value)) {
+            ok &= check_object(node, *map, value, path, errors);
+        }
+
+        ok &= check_composition(node, value, path, errors);
+        return ok;
+    }
+
+    bool check_string(const Node& node, const String& s, const Value& value,
+                      const std::string& path, std::vector<ValidationError>& errors) const {
+        bool ok = true;
+        if (node.min_length.has_value() && s.size() < node.min_length.value()) {
+            report(node, value, path,
+                   "String is shorter than minLength " + std::to_string(node.min_length.value()),
+                   errors);
+            ok = false;
+        }
+        if (node.max_length.has_value() && s.size() > node.max_length.value()) {
+            report(node, value, path,
+                   "String is longer than maxLength " + std::to_string(node.max_length.value()),
+                   errors);
+            ok = false;
+        }
+        if (node.pattern.has_value() && !std::regex_search(s, node.pattern.value())) {
+            report(node, value, path, "String does not match pattern " + node.pattern_source,
+                   errors);
+            ok = false;
+        }
+        if (node.format_checker && !node.format_checker(s)) {
+            report(node, value, path, "String does not match format", errors);
+            ok = false;
+        }
+        return ok;
+    }
+
+    bool check_number(const Node& node, double number, const Value& value,
+                      const std::string& path, std::vector<ValidationError>& errors) const {
+        bool ok = true;
+        if (node.minimum.has_value()) {
+            bool violated = node.exclusive_minimum ? number <= node.minimum.value()
+                                                   : number < node.minimum.value();
+            if (violated) {
+                report(node, value, path, "Number is below minimum", errors);
+                ok = false;
+            }
+        }
+        if (node.maximum.has_value()) {
+            bool violated = node.exclusive_maximum ? number >= node.maximum.value()
+                                                   : number > node.maximum.value();
+            if (violated) {
+                report(node, value, path, "Number is above maximum", errors);
+                ok = false;
+            }
+        }
+        if (node.multiple_of.has_value() && node.multiple_of.value() != 0.0) {
+            double quotient = number / node.multiple_of.value();
+            if (quotient != static_cast<double>(static_cast<long long>(quotient))) {
+                report(node, value, path, "Number is not a multiple of multipleOf", errors);
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+    bool check_array(const Node& node, const Array& array, const Value& value,
+                     const std::string& path, std::vector<ValidationError>& errors) const {
+        bool ok = true;
+        if (node.min_items.has_value() && array.size() < node.min_items.value()) {
+            report(node, value, path, "Array has fewer than minItems elements", errors);
+            ok = false;
+        }
+        if (node.max_items.has_value() && array.size() > node.max_items.value()) {
+            report(node, value, path, "Array has more than maxItems elements", errors);
+            ok = false;
+        }
+        if (node.unique_items) {
+            for (size_t i = 0; ok && i < array.size(); ++i) {
+                for (size_t j = i + 1; j < array.size(); ++j) {
+                    if (array[i] == array[j]) {
+                        report(node, value, path, "Array elements are not unique", errors);
+                        ok = false;
+                        break;
+                    }
+                }
+            }
+        }
+        if (node.items != kNoNode) {
+            for (size_t i = 0; i < array.size(); ++i) {
+                ok &= check(node.items, array[i], path + "[" + std::to_string(i) + "]", errors);
+            }
+        }
+        return ok;
+    }
+
+    bool check_object(const Node& node, const Map& map, const Value& value,
+                      const std::string& path, std::vector<ValidationError>& errors) const {
+        bool ok = true;
+        if (node.min_properties.has_value() && map.size() < node.min_properties.value()) {
+            report(node, value, path, "Object has fewer than minProperties members", errors);
+            ok = false;
+        }
+        if (node.max_properties.has_value() && map.size() > node.max_properties.value()) {
+            report(node, value, path, "Object has more than maxProperties members", errors);
+            ok = false;
+        }
+        for (const std::string& name : node.required) {
+            if (map.find(name) == map.end()) {
+                report(node, value, path, "Missing required property: " + name, errors);
+                ok = false;
+            }
+        }
+        for (const auto& [name, member] : map) {
+            bool claimed = false;
+            auto it = std::lower_bound(
+                node.properties.begin(), node.properties.end(), name,
+                [](const auto& entry, const std::string& key) { return entry.first < key; });
+            std::string member_path = path + "." + name;
+            if (it != node.properties.end() && it->first == name) {
+                ok &= check(it->second, member, member_path, errors);
+                claimed = true;
+            }
+            for (const auto& [regex, source, child] : node.pattern_properties) {
+                if (std::regex_search(name, regex)) {
+                    ok &= check(child, member, member_path, errors);
+                    claimed = true;
+                }
+            }
+            if (!claimed && node.additional_properties != kNoNode) {
+                ok &= check(node.additional_properties, member, member_path, errors);
+            }
+        }
+        return ok;
+    }
+
+    bool check_composition(const Node& node, const Value& value, const std::string& path,
+                           std::vector<ValidationError>& errors) const {
+        bool ok = true;
+        for (size_t child : node.all_of) {
+            ok &= check(child, value, path, errors);
+        }
+        if (!node.any_of.empty()) {
+            bool any = false;
+            std::vector<ValidationError> scratch;
+            for (size_t child : node.any_of) {
+                scratch.clear();
+                if (check(child, value, path, scratch)) {
+                    any = true;
+                    break;
+                }
+            }
+            if (!any) {
+                report(node, value, path, "Value does not match any schema in anyOf", errors);
+                ok = false;
+            }
+        }
+        if (!node.one_of.empty()) {
+            size_t matches = 0;
+            std::vector<ValidationError> scratch;
+            for (size_t child : node.one_of) {
+                scratch.clear();
+                if (check(child, value, path, scratch)) {
+                    matches++;
+                }
+            }
+            if (matches != 1) {
+                report(node, value, path,
+                       "Value matches " + std::to_string(matches) + " schemas in oneOf", errors);
+                ok = false;
+            }
+        }
+        if (node.not_schema != kNoNode) {
+            std::vector<ValidationError> scratch;
+            if (check(node.not_schema, value, path, scratch)) {
+                report(node, value, path, "Value matches schema in not", errors);
+                ok = false;
+            }
+        }
+        if (node.if_schema != kNoNode) {
+            std::vector<ValidationError> scratch;
+            if (check(node.if_schema, value, path, scratch)) {
+                if (node.then_schema != kNoNode) {
+                    ok &= check(node.then_schema, value, path, errors);
+                }
+            } else if (node.else_schema != kNoNode) {
+                ok &= check(node.else_schema, value, path, errors);
+            }
+        }
+        return ok;
+    }
+
+    const JsonSchema* schema_;  // Only valid during compilation.
+    std::vector<Node> nodes_;
+    std::unordered_map<std::string, size_t> ref_slots_;
+    size_t root_ = 0;
+};
+
+JsonSchemaValidator::JsonSchemaValidator(const JsonSchema& schema)
+    : pimpl_(std::make_unique<ValidatorImpl>(schema)) {}
+
+JsonSchemaValidator::~JsonSchemaValidator() = default;
+JsonSchemaValidator::JsonSchemaValidator(JsonSchemaValidator&&) noexcept = default;
+JsonSchemaValidator& JsonSchemaValidator::operator=(JsonSchemaValidator&&) noexcept = default;
+
+bool JsonSchemaValidator::validate(const Value& value, std::vector<std::string>& errors) const {
+    std::vector<ValidationError> detailed;
+    bool ok = pimpl_->validate(value, detailed);
+    errors.reserve(errors.size() + detailed.size());
+    for (const ValidationError& error : detailed) {
+        errors.push_back(error.path + ": " + error.message);
+    }
+    return ok;
+}
+
+bool JsonSchemaValidator::validate_detailed(const Value& value,
+                                            std::vector<ValidationError>& errors) const {
+    return pimpl_->validate(value, errors);
+}
+
+} // namespace json_schema
+} // namespace btoon
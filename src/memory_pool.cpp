@@ -1,7 +1,8 @@
 #include "btoon/memory_pool.h"
+#include <algorithm>
+#include <bit>
 #include <cstdlib>
 #include <cstring>
-#include <algorithm>
 
 namespace btoon {
 
@@ -51,12 +52,13 @@ MemoryPool::Block::Block(size_t sz)
     }
 }
 
-MemoryPool::MemoryPool(size_t initial_size)
+MemoryPool::MemoryPool(size_t initial_size, bool prefault)
     : current_pos_(nullptr),
       remaining_(0),
       block_size_(initial_size),
       total_allocated_(0),
-      current_usage_(0) {
+      current_usage_(0),
+      prefault_(prefault) {
     new_block(initial_size);
 }
 
@@ -64,27 +66,66 @@ MemoryPool::~MemoryPool() {
     // Blocks are automatically freed by unique_ptr
 }
 
-void* MemoryPool::allocate(size_t size) {
-    // Try to reuse from free list first
-    if (!free_list_.empty()) {
-        auto it = free_list_.top();
-        if (it.size >= size) {
-            free_list_.pop();
-            current_usage_ += size;
-            
-            // If the chunk is significantly larger, split it
-            if (it.size > size + 64) {
-                void* remaining_ptr = static_cast<uint8_t*>(it.ptr) + size;
-                free_list_.push(FreeChunk(remaining_ptr, it.size - size));
+size_t MemoryPool::floor_class(size_t size) {
+    size_t shift = static_cast<size_t>(std::bit_width(size)) - 1;  // floor(log2)
+    shift = std::clamp(shift, kMinClassShift, kMaxClassShift);
+    return shift - kMinClassShift;
+}
+
+void MemoryPool::bin_chunk(void* ptr, size_t size) {
+    bins_[floor_class(size)].emplace_back(ptr, size);
+}
+
+void* MemoryPool::take_from_bins(size_t aligned_size) {
+    // First fit within the request's own class — chunks there share its
+    // power of two but may still be smaller — then O(1) pops from higher
+    // classes, whose chunks are always large enough.
+    size_t first = floor_class(aligned_size);
+    for (size_t cls = first; cls < kNumClasses; ++cls) {
+        auto& bin = bins_[cls];
+        size_t pick = bin.size();
+        if (cls == first) {
+            for (size_t i = 0; i < bin.size(); ++i) {
+                if (bin[i].size >= aligned_size) {
+                    pick = i;
+                    break;
+                }
             }
-            
-            return it.ptr;
+        } else if (!bin.empty()) {
+            pick = bin.size() - 1;
         }
+        if (pick == bin.size()) {
+            continue;
+        }
+
+        FreeChunk chunk = bin[pick];
+        bin[pick] = bin.back();
+        bin.pop_back();
+        bin_reuses_[cls]++;
+
+        // Re-bin a significantly larger chunk's tail instead of wasting it.
+        if (chunk.size >= aligned_size + kSplitThreshold) {
+            bin_chunk(static_cast<uint8_t*>(chunk.ptr) + aligned_size,
+                      chunk.size - aligned_size);
+        }
+        return chunk.ptr;
     }
-    
+    return nullptr;
+}
+
+void* MemoryPool::allocate(size_t size) {
     // Align size to maintain alignment for subsequent allocations
     size_t aligned_size = (size + SIMD_ALIGNMENT - 1) & ~(SIMD_ALIGNMENT - 1);
-    
+    if (aligned_size == 0) {
+        aligned_size = SIMD_ALIGNMENT;
+    }
+
+    // Try to reuse from the segregated free lists first
+    if (void* reused = take_from_bins(aligned_size)) {
+        current_usage_ += size;
+        return reused;
+    }
+
     // Allocate from current block
     if (aligned_size > remaining_) {
         // If requested size is very large, allocate a dedicated block
@@ -105,12 +146,37 @@ void* MemoryPool::allocate(size_t size) {
 
 void MemoryPool::deallocate(void* ptr, size_t size) {
     if (!ptr) return;
-    
-    // Add to free list for reuse
-    free_list_.push(FreeChunk(ptr, size));
+
+    // Bin by size class for reuse; allocate() rounded the chunk up to the
+    // alignment, so bin the usable size rather than the requested one.
+    size_t aligned_size = (size + SIMD_ALIGNMENT - 1) & ~(SIMD_ALIGNMENT - 1);
+    if (aligned_size == 0) {
+        // Mirror allocate(): a size-0 request still got an aligned chunk,
+        // and binning a zero-size chunk would let take_from_bins() hand it
+        // out for a real request later.
+        aligned_size = SIMD_ALIGNMENT;
+    }
+    bin_chunk(ptr, aligned_size);
     current_usage_ -= size;
 }
 
+std::vector<MemoryPool::SizeClassStats> MemoryPool::size_class_stats() const {
+    std::vector<SizeClassStats> stats(kNumClasses);
+    for (size_t cls = 0; cls < kNumClasses; ++cls) {
+        auto& entry = stats[cls];
+        entry.min_size = size_t(1) << (cls + kMinClassShift);
+        entry.max_size = cls + 1 == kNumClasses
+                             ? SIZE_MAX
+                             : (size_t(1) << (cls + kMinClassShift + 1)) - 1;
+        entry.free_chunks = bins_[cls].size();
+        for (const auto& chunk : bins_[cls]) {
+            entry.free_bytes += chunk.size;
+        }
+        entry.reuses = bin_reuses_[cls];
+    }
+    return stats;
+}
+
 void MemoryPool::new_block(size_t min_size) {
     size_t size = std::max(min_size, block_size_);
     
@@ -123,14 +189,26 @@ void MemoryPool::new_block(size_t min_size) {
     current_pos_ = blocks_.back().data.get();
     remaining_ = size;
     total_allocated_ += size;
+
+    if (prefault_) {
+        // Write one byte per page so the calling thread faults the whole
+        // block in now; on NUMA hosts first-touch binds the pages to this
+        // thread's node.
+        constexpr size_t kPageSize = 4096;
+        uint8_t* base = blocks_.back().data.get();
+        for (size_t offset = 0; offset < size; offset += kPageSize) {
+            base[offset] = 0;
+        }
+    }
 }
 
 void MemoryPool::reset() {
-    // Clear free list
-    while (!free_list_.empty()) {
-        free_list_.pop();
+    // Clear free lists
+    for (auto& bin : bins_) {
+        bin.clear();
     }
-    
+    bin_reuses_.fill(0);
+
     // Reset to first block if available
     if (!blocks_.empty()) {
         current_pos_ = blocks_[0].data.get();
@@ -152,4 +230,115 @@ void* MemoryPool::align_ptr(void* ptr, size_t alignment) {
     return reinterpret_cast<void*>(aligned);
 }
 
+// ============= SharedMemoryPool =============
+
+SharedMemoryPool::SharedMemoryPool(size_t initial_size, bool prefault)
+    : id_([] {
+          static std::atomic<uint64_t> next_id{1};
+          return next_id.fetch_add(1, std::memory_order_relaxed);
+      }()),
+      arena_(initial_size, prefault) {}
+
+SharedMemoryPool::~SharedMemoryPool() = default;
+
+SharedMemoryPool::ThreadCache& SharedMemoryPool::local_cache() {
+    // Each thread remembers the caches it has opened, keyed by the pool's
+    // unique id. Ids are never reused, so a slot left behind by a destroyed
+    // pool can never match a live one and is simply skipped.
+    struct Slot {
+        uint64_t pool_id;
+        ThreadCache* cache;
+    };
+    static thread_local std::vector<Slot> slots;
+
+    for (const auto& slot : slots) {
+        if (slot.pool_id == id_) {
+            return *slot.cache;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    caches_.push_back(std::make_unique<ThreadCache>());
+    ThreadCache* cache = caches_.back().get();
+    cache->magazine.reserve(kMagazineCapacity);
+    slots.push_back({id_, cache});
+    return *cache;
+}
+
+void* SharedMemoryPool::allocate(size_t size) {
+    size_t aligned_size =
+        (size + MemoryPool::SIMD_ALIGNMENT - 1) & ~(MemoryPool::SIMD_ALIGNMENT - 1);
+    if (aligned_size == 0) {
+        // A zero-size request must still get a distinct chunk; without the
+        // round-up it would return the bump pointer unadvanced (nullptr on
+        // a fresh cache, or aliasing the next real allocation).
+        aligned_size = MemoryPool::SIMD_ALIGNMENT;
+    }
+
+    // Oversized requests bypass the cache: a slab could not hold them and
+    // they are rare enough that the lock does not matter.
+    if (aligned_size > kSlabSize / 2) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_usage_.fetch_add(size, std::memory_order_relaxed);
+        return arena_.allocate(aligned_size);
+    }
+
+    ThreadCache& cache = local_cache();
+
+    // Reuse a freed chunk from this thread's magazine (first fit; the
+    // magazine is small, so the scan is a handful of compares).
+    for (size_t i = 0; i < cache.magazine.size(); ++i) {
+        if (cache.magazine[i].size >= aligned_size) {
+            void* ptr = cache.magazine[i].ptr;
+            cache.magazine[i] = cache.magazine.back();
+            cache.magazine.pop_back();
+            current_usage_.fetch_add(size, std::memory_order_relaxed);
+            return ptr;
+        }
+    }
+
+    // Bump from the private slab, refilling it from the shared arena. The
+    // tail of the old slab goes into the magazine rather than stranding.
+    if (aligned_size > cache.slab_remaining) {
+        if (cache.slab_remaining >= MemoryPool::SIMD_ALIGNMENT) {
+            cache.magazine.push_back({cache.slab_pos, cache.slab_remaining});
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache.slab_pos = static_cast<uint8_t*>(arena_.allocate(kSlabSize));
+        cache.slab_remaining = kSlabSize;
+    }
+    void* ptr = cache.slab_pos;
+    cache.slab_pos += aligned_size;
+    cache.slab_remaining -= aligned_size;
+    current_usage_.fetch_add(size, std::memory_order_relaxed);
+    return ptr;
+}
+
+void SharedMemoryPool::deallocate(void* ptr, size_t size) {
+    if (!ptr) return;
+
+    size_t aligned_size =
+        (size + MemoryPool::SIMD_ALIGNMENT - 1) & ~(MemoryPool::SIMD_ALIGNMENT - 1);
+    current_usage_.fetch_sub(size, std::memory_order_relaxed);
+
+    ThreadCache& cache = local_cache();
+    cache.magazine.push_back({ptr, aligned_size});
+
+    // Spill half of a full magazine back to the shared free list so space
+    // freed here can be reused by other threads.
+    if (cache.magazine.size() >= kMagazineCapacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t keep = kMagazineCapacity / 2;
+        for (size_t i = keep; i < cache.magazine.size(); ++i) {
+            arena_.deallocate(cache.magazine[i].ptr, cache.magazine[i].size);
+        }
+        cache.magazine.resize(keep);
+    }
+}
+
+size_t SharedMemoryPool::total_allocated() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return arena_.total_allocated();
+}
+
 } // namespace btoon
\ No newline at end of file
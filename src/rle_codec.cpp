@@ -3,8 +3,100 @@
 #include "btoon/decoder.h"
 #include "btoon/btoon.h"
 
+#include <bit>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace btoon {
 
+namespace {
+
+// Run lengths encode as positive integers and come back as Uint.
+int64_t run_length_of(const Value& value) {
+    if (std::holds_alternative<Uint>(value)) {
+        return static_cast<int64_t>(std::get<Uint>(value));
+    }
+    return std::get<Int>(value);
+}
+
+void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t get_varint(const std::vector<uint8_t>& data, size_t& pos) {
+    uint64_t value = 0;
+    unsigned shift = 0;
+    for (;;) {
+        if (pos >= data.size() || shift >= 64) {
+            throw BtoonException("Truncated varint in RLE data");
+        }
+        uint8_t byte = data[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+        shift += 7;
+    }
+}
+
+// First index >= start whose byte differs from data[start], found by
+// comparing whole vector blocks against the run byte.
+size_t find_run_end(std::span<const uint8_t> data, size_t start) {
+    const uint8_t byte = data[start];
+    size_t i = start + 1;
+#if defined(__AVX2__)
+    const __m256i splat = _mm256_set1_epi8(static_cast<char>(byte));
+    for (; i + 32 <= data.size(); i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)&data[i]);
+        uint32_t mask = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, splat)));
+        if (mask != 0xFFFFFFFFu) {
+            return i + std::countr_one(mask);
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i splat = _mm_set1_epi8(static_cast<char>(byte));
+    for (; i + 16 <= data.size(); i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)&data[i]);
+        uint32_t mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(block, splat)));
+        if (mask != 0xFFFFu) {
+            return i + std::countr_one(mask);
+        }
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t splat = vdupq_n_u8(byte);
+    for (; i + 16 <= data.size(); i += 16) {
+        uint8x16_t equal = vceqq_u8(vld1q_u8(&data[i]), splat);
+        if (vminvq_u8(equal) != 0xFF) {
+            uint8_t lanes[16];
+            vst1q_u8(lanes, equal);
+            for (size_t j = 0; j < 16; ++j) {
+                if (lanes[j] != 0xFF) {
+                    return i + j;
+                }
+            }
+        }
+    }
+#endif
+    for (; i < data.size(); ++i) {
+        if (data[i] != byte) {
+            return i;
+        }
+    }
+    return data.size();
+}
+
+} // namespace
+
 std::vector<uint8_t> RleCodec::encode(const Array& data) {
     Encoder encoder;
     if (data.empty()) {
@@ -12,7 +104,7 @@ std::vector<uint8_t> RleCodec::encode(const Array& data) {
     }
 
     Value last_value = data[0];
-    int run_length = 1;
+    int64_t run_length = 1;
     for (size_t i = 1; i < data.size(); ++i) {
         if (data[i] == last_value) {
             run_length++;
@@ -39,11 +131,36 @@ Array RleCodec::decode(const std::vector<uint8_t>& data) {
         pos += bytes_read_val;
         auto [run_length_value, bytes_read_len] = decoder.decode_and_get_pos({data.data() + pos, data.size() - pos});
         pos += bytes_read_len;
-        int run_length = std::get<Int>(run_length_value);
+        int64_t run_length = run_length_of(run_length_value);
         result.insert(result.end(), run_length, value);
     }
 
     return result;
 }
 
-} // namespace btoon
\ No newline at end of file
+std::vector<uint8_t> RleCodec::encode_bytes(std::span<const uint8_t> data) {
+    std::vector<uint8_t> out;
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t end = find_run_end(data, pos);
+        put_varint(out, end - pos);
+        out.push_back(data[pos]);
+        pos = end;
+    }
+    return out;
+}
+
+std::vector<uint8_t> RleCodec::decode_bytes(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> out;
+    size_t pos = 0;
+    while (pos < data.size()) {
+        uint64_t run_length = get_varint(data, pos);
+        if (pos >= data.size()) {
+            throw BtoonException("Truncated run in RLE data");
+        }
+        out.insert(out.end(), run_length, data[pos++]);
+    }
+    return out;
+}
+
+} // namespace btoon
@@ -1,7 +1,10 @@
 #include "btoon/schema.h"
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <regex>
+#include <random>
 #include <fstream>
 #include <set>
 #include <limits>
@@ -29,6 +32,219 @@ SchemaVersion SchemaVersion::fromString(const std::string& str) {
     throw BtoonException("Invalid version string: " + str);
 }
 
+// ===== CompiledSchema Implementation =====
+
+/**
+ * The flat validation program. One Instruction per field, in declaration
+ * order; everything a check needs — numeric type tag, bounds, compiled
+ * pattern, enum list — is resolved at compile time so execution never
+ * touches the constraint Value tree or a type string.
+ */
+class CompiledSchema::Program {
+public:
+    enum class TypeTag : uint8_t {
+        STRING, INT, UINT, FLOAT, BOOL, BINARY, ARRAY, MAP, NIL, ANY, UNKNOWN
+    };
+
+    struct Constraint {
+        std::optional<int64_t> min_int;
+        std::optional<int64_t> max_int;
+        std::optional<double> min_float;
+        std::optional<double> max_float;
+        std::optional<std::regex> pattern;
+        std::optional<Array> enum_values;
+    };
+
+    struct Instruction {
+        std::string name;
+        std::string type_name;  // for error messages only
+        TypeTag type;
+        bool required;
+        std::optional<Constraint> constraint;
+    };
+
+    std::vector<Instruction> instructions;
+    std::vector<std::string> known_names;  // sorted; only filled when strict
+    bool strict = false;
+
+    static TypeTag tagFor(const std::string& type) {
+        if (type == "string") return TypeTag::STRING;
+        if (type == "int") return TypeTag::INT;
+        if (type == "uint") return TypeTag::UINT;
+        if (type == "float") return TypeTag::FLOAT;
+        if (type == "bool") return TypeTag::BOOL;
+        if (type == "binary") return TypeTag::BINARY;
+        if (type == "array") return TypeTag::ARRAY;
+        if (type == "map") return TypeTag::MAP;
+        if (type == "nil") return TypeTag::NIL;
+        if (type == "any") return TypeTag::ANY;
+        return TypeTag::UNKNOWN;
+    }
+
+    static std::optional<Constraint> compileConstraint(const Value& constraints) {
+        const Map* constraint_map = std::get_if<Map>(&constraints);
+        if (!constraint_map) {
+            return std::nullopt;
+        }
+        Constraint compiled;
+        if (constraint_map->count("min")) {
+            if (const Int* v = std::get_if<Int>(&constraint_map->at("min"))) {
+                compiled.min_int = *v;
+            }
+            if (const Float* v = std::get_if<Float>(&constraint_map->at("min"))) {
+                compiled.min_float = *v;
+            }
+        }
+        if (constraint_map->count("max")) {
+            if (const Int* v = std::get_if<Int>(&constraint_map->at("max"))) {
+                compiled.max_int = *v;
+            }
+            if (const Float* v = std::get_if<Float>(&constraint_map->at("max"))) {
+                compiled.max_float = *v;
+            }
+        }
+        if (constraint_map->count("pattern")) {
+            if (const String* p = std::get_if<String>(&constraint_map->at("pattern"))) {
+                compiled.pattern = std::regex(*p);
+            }
+        }
+        if (constraint_map->count("enum")) {
+            if (const Array* e = std::get_if<Array>(&constraint_map->at("enum"))) {
+                compiled.enum_values = *e;
+            }
+        }
+        return compiled;
+    }
+
+    static bool checkType(const Value& value, TypeTag tag) {
+        switch (tag) {
+            case TypeTag::STRING: return std::holds_alternative<String>(value);
+            case TypeTag::INT: return std::holds_alternative<Int>(value);
+            case TypeTag::UINT: return std::holds_alternative<Uint>(value);
+            case TypeTag::FLOAT: return std::holds_alternative<Float>(value);
+            case TypeTag::BOOL: return std::holds_alternative<Bool>(value);
+            case TypeTag::BINARY: return std::holds_alternative<Binary>(value);
+            case TypeTag::ARRAY: return std::holds_alternative<Array>(value);
+            case TypeTag::MAP: return std::holds_alternative<Map>(value);
+            case TypeTag::NIL: return std::holds_alternative<Nil>(value);
+            case TypeTag::ANY: return true;
+            case TypeTag::UNKNOWN: return false;
+        }
+        return false;
+    }
+
+    static bool checkConstraint(const Value& value, const Constraint& constraint) {
+        if (const Int* int_val = std::get_if<Int>(&value)) {
+            if (constraint.min_int && *int_val < *constraint.min_int) return false;
+            if (constraint.max_int && *int_val > *constraint.max_int) return false;
+        }
+        if (const Float* float_val = std::get_if<Float>(&value)) {
+            if (constraint.min_float && *float_val < *constraint.min_float) return false;
+            if (constraint.max_float && *float_val > *constraint.max_float) return false;
+        }
+        if (constraint.pattern) {
+            if (const String* str_val = std::get_if<String>(&value)) {
+                if (!std::regex_match(*str_val, *constraint.pattern)) return false;
+            }
+        }
+        if (constraint.enum_values) {
+            bool found = false;
+            for (const auto& enum_val : *constraint.enum_values) {
+                if (value == enum_val) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) return false;
+        }
+        return true;
+    }
+
+    /// Boolean fast path: short-circuits on the first violation and never
+    /// formats an error string.
+    bool check(const Value& value) const {
+        const Map* value_map = std::get_if<Map>(&value);
+        if (!value_map) {
+            return false;
+        }
+        for (const auto& inst : instructions) {
+            if (!inst.required) {
+                continue;
+            }
+            auto it = value_map->find(inst.name);
+            if (it == value_map->end()) {
+                return false;
+            }
+            if (!checkType(it->second, inst.type)) {
+                return false;
+            }
+            if (inst.constraint && !checkConstraint(it->second, *inst.constraint)) {
+                return false;
+            }
+        }
+        if (strict) {
+            for (const auto& [key, unused] : *value_map) {
+                (void)unused;
+                if (!std::binary_search(known_names.begin(), known_names.end(), key)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /// Diagnostic path; message text matches the interpreted validator.
+    std::vector<std::string> run(const Value& value) const {
+        std::vector<std::string> errors;
+        const Map* value_map = std::get_if<Map>(&value);
+        if (!value_map) {
+            errors.push_back("Value must be a map");
+            return errors;
+        }
+        for (const auto& inst : instructions) {
+            if (!inst.required) {
+                continue;
+            }
+            auto it = value_map->find(inst.name);
+            if (it == value_map->end()) {
+                errors.push_back("Missing required field: " + inst.name);
+                continue;
+            }
+            if (!checkType(it->second, inst.type)) {
+                errors.push_back("Invalid type for field '" + inst.name +
+                                 "': expected " + inst.type_name);
+            }
+            if (inst.constraint && !checkConstraint(it->second, *inst.constraint)) {
+                errors.push_back("Constraint violation for field: " + inst.name);
+            }
+        }
+        if (strict) {
+            for (const auto& [key, unused] : *value_map) {
+                (void)unused;
+                if (!std::binary_search(known_names.begin(), known_names.end(), key)) {
+                    errors.push_back("Unknown field: " + key);
+                }
+            }
+        }
+        return errors;
+    }
+};
+
+CompiledSchema::CompiledSchema(std::unique_ptr<Program> program)
+    : program_(std::move(program)) {}
+
+CompiledSchema::~CompiledSchema() = default;
+CompiledSchema::CompiledSchema(CompiledSchema&&) noexcept = default;
+CompiledSchema& CompiledSchema::operator=(CompiledSchema&&) noexcept = default;
+
+bool CompiledSchema::validate(const Value& value) const {
+    return program_->check(value);
+}
+
+std::vector<std::string> CompiledSchema::validateWithErrors(const Value& value) const {
+    return program_->run(value);
+}
+
 // ===== SchemaImpl Implementation =====
 
 class SchemaImpl {
@@ -44,64 +260,55 @@ public:
         : name_(name), version_(version), fields_(fields),
           evolution_strategy_(EvolutionStrategy::BACKWARD_COMPATIBLE) {}
 
-    // Validation
+    // Validation: both paths execute the compiled program.
     bool validate(const Value& value) const {
-        auto errors = validateWithErrors(value);
-        return errors.empty();
+        return compile()->validate(value);
     }
-    
+
     std::vector<std::string> validateWithErrors(const Value& value) const {
-        std::vector<std::string> errors;
-        
-        const Map* value_map = std::get_if<Map>(&value);
-        if (!value_map) {
-            errors.push_back("Value must be a map");
-            return errors;
+        return compile()->validateWithErrors(value);
+    }
+
+    std::shared_ptr<const CompiledSchema> compile() const {
+        auto cached = compiled_.load(std::memory_order_acquire);
+        if (cached) {
+            return cached;
         }
-        
-        // Check required fields
+        auto program = std::make_unique<CompiledSchema::Program>();
+        program->strict = evolution_strategy_ == EvolutionStrategy::STRICT;
+        program->instructions.reserve(fields_.size());
         for (const auto& field : fields_) {
-            if (field.required) {
-                auto it = value_map->find(field.name);
-                if (it == value_map->end()) {
-                    errors.push_back("Missing required field: " + field.name);
-                    continue;
-                }
-                
-                // Type validation
-                if (!validateType(it->second, field.type)) {
-                    errors.push_back("Invalid type for field '" + field.name + 
-                                    "': expected " + field.type);
-                }
-                
-                // Constraint validation
-                if (field.constraints.has_value()) {
-                    if (!validateConstraints(it->second, field.constraints.value())) {
-                        errors.push_back("Constraint violation for field: " + field.name);
-                    }
-                }
+            CompiledSchema::Program::Instruction inst;
+            inst.name = field.name;
+            inst.type_name = field.type;
+            inst.type = CompiledSchema::Program::tagFor(field.type);
+            inst.required = field.required;
+            if (field.constraints.has_value()) {
+                inst.constraint =
+                    CompiledSchema::Program::compileConstraint(field.constraints.value());
             }
+            program->instructions.push_back(std::move(inst));
         }
-        
-        // Check for unknown fields if strategy is strict
-        if (evolution_strategy_ == EvolutionStrategy::STRICT) {
-            for (const auto& [key, _] : *value_map) {
-                bool found = false;
-                for (const auto& field : fields_) {
-                    if (field.name == key) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    errors.push_back("Unknown field: " + key);
-                }
+        if (program->strict) {
+            program->known_names.reserve(fields_.size());
+            for (const auto& field : fields_) {
+                program->known_names.push_back(field.name);
             }
+            std::sort(program->known_names.begin(), program->known_names.end());
         }
-        
-        return errors;
+        std::shared_ptr<const CompiledSchema> built(
+            new CompiledSchema(std::move(program)));
+        // Concurrent validators may compile in parallel; the first publish
+        // wins and the losers use it — a duplicate compile is harmless.
+        std::shared_ptr<const CompiledSchema> expected;
+        if (compiled_.compare_exchange_strong(expected, built,
+                                              std::memory_order_release,
+                                              std::memory_order_acquire)) {
+            return built;
+        }
+        return expected;
     }
-    
+
     // Version management
     SchemaVersion getVersion() const { return version_; }
     void setVersion(const SchemaVersion& version) { version_ = version; }
@@ -110,14 +317,16 @@ public:
     // Field management
     void addField(const SchemaField& field) {
         fields_.push_back(field);
+        compiled_.store(nullptr, std::memory_order_release);
     }
-    
+
     void removeField(const std::string& field_name) {
         fields_.erase(
             std::remove_if(fields_.begin(), fields_.end(),
                 [&](const SchemaField& f) { return f.name == field_name; }),
             fields_.end()
         );
+        compiled_.store(nullptr, std::memory_order_release);
     }
     
     std::optional<SchemaField> getField(const std::string& field_name) const {
@@ -174,6 +383,7 @@ public:
     
     void setEvolutionStrategy(EvolutionStrategy strategy) {
         evolution_strategy_ = strategy;
+        compiled_.store(nullptr, std::memory_order_release);
     }
     
     EvolutionStrategy getEvolutionStrategy() const {
@@ -436,102 +646,13 @@ private:
         }
     };
     std::unordered_map<MigrationKey, MigrationFunction, MigrationKeyHash> migrations_;
-    
-    bool validateType(const Value& value, const std::string& expected_type) const {
-        if (expected_type == "string") {
-            return std::holds_alternative<String>(value);
-        } else if (expected_type == "int") {
-            return std::holds_alternative<Int>(value);
-        } else if (expected_type == "uint") {
-            return std::holds_alternative<Uint>(value);
-        } else if (expected_type == "float") {
-            return std::holds_alternative<Float>(value);
-        } else if (expected_type == "bool") {
-            return std::holds_alternative<Bool>(value);
-        } else if (expected_type == "binary") {
-            return std::holds_alternative<Binary>(value);
-        } else if (expected_type == "array") {
-            return std::holds_alternative<Array>(value);
-        } else if (expected_type == "map") {
-            return std::holds_alternative<Map>(value);
-        } else if (expected_type == "nil") {
-            return std::holds_alternative<Nil>(value);
-        } else if (expected_type == "any") {
-            return true;  // Any type is valid
-        }
-        return false;
-    }
-    
-    bool validateConstraints(const Value& value, const Value& constraints) const {
-        const Map* constraint_map = std::get_if<Map>(&constraints);
-        if (!constraint_map) {
-            return true;  // No constraints
-        }
-        
-        // Check min/max for numeric types
-        if (constraint_map->count("min")) {
-            if (const Int* int_val = std::get_if<Int>(&value)) {
-                const Int* min_val = std::get_if<Int>(&constraint_map->at("min"));
-                if (min_val && *int_val < *min_val) {
-                    return false;
-                }
-            }
-            if (const Float* float_val = std::get_if<Float>(&value)) {
-                const Float* min_val = std::get_if<Float>(&constraint_map->at("min"));
-                if (min_val && *float_val < *min_val) {
-                    return false;
-                }
-            }
-        }
-        
-        if (constraint_map->count("max")) {
-            if (const Int* int_val = std::get_if<Int>(&value)) {
-                const Int* max_val = std::get_if<Int>(&constraint_map->at("max"));
-                if (max_val && *int_val > *max_val) {
-                    return false;
-                }
-            }
-            if (const Float* float_val = std::get_if<Float>(&value)) {
-                const Float* max_val = std::get_if<Float>(&constraint_map->at("max"));
-                if (max_val && *float_val > *max_val) {
-                    return false;
-                }
-            }
-        }
-        
-        // Check pattern for strings
-        if (constraint_map->count("pattern")) {
-            if (const String* str_val = std::get_if<String>(&value)) {
-                const String* pattern = std::get_if<String>(&constraint_map->at("pattern"));
-                if (pattern) {
-                    std::regex re(*pattern);
-                    if (!std::regex_match(*str_val, re)) {
-                        return false;
-                    }
-                }
-            }
-        }
-        
-        // Check enum values
-        if (constraint_map->count("enum")) {
-            const Array* enum_values = std::get_if<Array>(&constraint_map->at("enum"));
-            if (enum_values) {
-                bool found = false;
-                for (const auto& enum_val : *enum_values) {
-                    if (value == enum_val) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    return false;
-                }
-            }
-        }
-        
-        return true;
-    }
-    
+
+    // Lazily built validation program; reset whenever the fields or the
+    // evolution strategy change. Atomic because validate() is const and
+    // runs concurrently through shared Schema instances (the registry
+    // hands the same shared_ptr to every lookup).
+    mutable std::atomic<std::shared_ptr<const CompiledSchema>> compiled_;
+
     static std::string evolutionStrategyToString(EvolutionStrategy strategy) {
         switch (strategy) {
             case EvolutionStrategy::STRICT: return "strict";
@@ -574,6 +695,10 @@ std::vector<std::string> Schema::validateWithErrors(const Value& value) const {
     return pimpl_->validateWithErrors(value);
 }
 
+std::shared_ptr<const CompiledSchema> Schema::compile() const {
+    return pimpl_->compile();
+}
+
 SchemaVersion Schema::getVersion() const {
     return pimpl_->getVersion();
 }
@@ -658,24 +783,40 @@ std::optional<Value> Schema::getMetadata(const std::string& key) const {
 
 // ===== SchemaRegistry Implementation =====
 
+/**
+ * Read-optimized registry: the schema table is an immutable snapshot
+ * published through an atomic shared_ptr. Lookups load the current
+ * snapshot and read it without any lock, so decoder threads never
+ * serialize on the registry; registration copies the table, applies the
+ * change, and publishes the new snapshot under a writer mutex
+ * (rare-and-slow by design). Readers that loaded the old snapshot keep
+ * a valid reference until they drop it.
+ */
 class SchemaRegistry::RegistryImpl {
 public:
+    RegistryImpl() { snapshot_.store(std::make_shared<const Snapshot>()); }
+
     void registerSchema(const std::string& name, std::shared_ptr<Schema> schema) {
-        schemas_[name][schema->getVersion()] = schema;
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto next = std::make_shared<Snapshot>(*snapshot_.load(std::memory_order_acquire));
+        next->schemas[name][schema->getVersion()] = schema;
+        snapshot_.store(std::move(next), std::memory_order_release);
     }
-    
+
     std::shared_ptr<Schema> getSchema(const std::string& name) const {
-        auto it = schemas_.find(name);
-        if (it != schemas_.end() && !it->second.empty()) {
+        auto snap = snapshot_.load(std::memory_order_acquire);
+        auto it = snap->schemas.find(name);
+        if (it != snap->schemas.end() && !it->second.empty()) {
             // Return latest version
             return it->second.rbegin()->second;
         }
         return nullptr;
     }
-    
+
     std::shared_ptr<Schema> getSchema(const std::string& name, const SchemaVersion& version) const {
-        auto it = schemas_.find(name);
-        if (it != schemas_.end()) {
+        auto snap = snapshot_.load(std::memory_order_acquire);
+        auto it = snap->schemas.find(name);
+        if (it != snap->schemas.end()) {
             auto ver_it = it->second.find(version);
             if (ver_it != it->second.end()) {
                 return ver_it->second;
@@ -683,86 +824,97 @@ public:
         }
         return nullptr;
     }
-    
+
     std::vector<SchemaVersion> getVersions(const std::string& name) const {
         std::vector<SchemaVersion> versions;
-        auto it = schemas_.find(name);
-        if (it != schemas_.end()) {
+        auto snap = snapshot_.load(std::memory_order_acquire);
+        auto it = snap->schemas.find(name);
+        if (it != snap->schemas.end()) {
             for (const auto& [version, _] : it->second) {
                 versions.push_back(version);
             }
         }
         return versions;
     }
-    
+
     std::shared_ptr<Schema> getLatestSchema(const std::string& name) const {
         return getSchema(name);
     }
-    
+
     bool validate(const Value& value) const {
+        auto snap = snapshot_.load(std::memory_order_acquire);
+
         // Try to auto-detect schema
         const Map* value_map = std::get_if<Map>(&value);
         if (value_map && value_map->count("$schema")) {
             const String* schema_name = std::get_if<String>(&value_map->at("$schema"));
             if (schema_name) {
-                auto schema = getSchema(*schema_name);
-                if (schema) {
-                    return schema->validate(value);
+                auto it = snap->schemas.find(*schema_name);
+                if (it != snap->schemas.end() && !it->second.empty()) {
+                    return it->second.rbegin()->second->validate(value);
                 }
             }
         }
-        
+
         // Try all schemas
-        for (const auto& [name, versions] : schemas_) {
+        for (const auto& [name, versions] : snap->schemas) {
             for (const auto& [version, schema] : versions) {
                 if (schema->validate(value)) {
                     return true;
                 }
             }
         }
-        
+
         return false;
     }
-    
+
     void removeSchema(const std::string& name) {
-        schemas_.erase(name);
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto next = std::make_shared<Snapshot>(*snapshot_.load(std::memory_order_acquire));
+        next->schemas.erase(name);
+        snapshot_.store(std::move(next), std::memory_order_release);
     }
-    
+
     void removeSchema(const std::string& name, const SchemaVersion& version) {
-        auto it = schemas_.find(name);
-        if (it != schemas_.end()) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto next = std::make_shared<Snapshot>(*snapshot_.load(std::memory_order_acquire));
+        auto it = next->schemas.find(name);
+        if (it != next->schemas.end()) {
             it->second.erase(version);
             if (it->second.empty()) {
-                schemas_.erase(it);
+                next->schemas.erase(it);
             }
         }
+        snapshot_.store(std::move(next), std::memory_order_release);
     }
-    
+
     void clear() {
-        schemas_.clear();
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        snapshot_.store(std::make_shared<const Snapshot>(), std::memory_order_release);
     }
-    
+
     Value toValue() const {
         Map registry_map;
         registry_map["$type"] = String("schema_registry");
-        
+
         Array schemas_array;
-        for (const auto& [name, versions] : schemas_) {
+        auto snap = snapshot_.load(std::memory_order_acquire);
+        for (const auto& [name, versions] : snap->schemas) {
             for (const auto& [version, schema] : versions) {
                 schemas_array.push_back(schema->toValue());
             }
         }
         registry_map["schemas"] = schemas_array;
-        
+
         return registry_map;
     }
-    
+
     void parseFromValue(const Value& value) {
         const Map* registry_map = std::get_if<Map>(&value);
         if (!registry_map) {
             throw BtoonException("Registry must be a map");
         }
-        
+
         if (registry_map->count("schemas")) {
             const Array* schemas_array = std::get_if<Array>(&registry_map->at("schemas"));
             if (schemas_array) {
@@ -775,8 +927,13 @@ public:
     }
 
 private:
-    // name -> (version -> schema)
-    std::unordered_map<std::string, std::map<SchemaVersion, std::shared_ptr<Schema>>> schemas_;
+    // name -> (version -> schema); immutable once published.
+    struct Snapshot {
+        std::unordered_map<std::string, std::map<SchemaVersion, std::shared_ptr<Schema>>> schemas;
+    };
+
+    std::atomic<std::shared_ptr<const Snapshot>> snapshot_;
+    std::mutex write_mutex_;  // serializes publishers only
 };
 
 SchemaRegistry::SchemaRegistry() : pimpl_(std::make_unique<RegistryImpl>()) {}
@@ -804,6 +961,18 @@ std::vector<SchemaVersion> SchemaRegistry::getVersions(const std::string& name)
     return pimpl_->getVersions(name);
 }
 
+std::shared_ptr<const CompiledSchema> SchemaRegistry::getCompiledSchema(
+    const std::string& name) const {
+    auto schema = pimpl_->getSchema(name);
+    return schema ? schema->compile() : nullptr;
+}
+
+std::shared_ptr<const CompiledSchema> SchemaRegistry::getCompiledSchema(
+    const std::string& name, const SchemaVersion& version) const {
+    auto schema = pimpl_->getSchema(name, version);
+    return schema ? schema->compile() : nullptr;
+}
+
 std::shared_ptr<Schema> SchemaRegistry::getLatestSchema(const std::string& name) const {
     return pimpl_->getLatestSchema(name);
 }
@@ -968,8 +1137,10 @@ public:
     InferenceOptions options;
     SchemaInferrer::Statistics stats;
     
-    SchemaInferrerImpl(const InferenceOptions& opts) : options(opts), stats{} {}
-    
+    SchemaInferrerImpl(const InferenceOptions& opts)
+        : options(opts), stats{},
+          rng_(opts.sampling_seed != 0 ? opts.sampling_seed : std::random_device{}()) {}
+
     std::string inferType(const Value& value) const {
         return std::visit([this](auto&& arg) -> std::string {
             using T = std::decay_t<decltype(arg)>;
@@ -982,6 +1153,7 @@ public:
             else if constexpr (std::is_same_v<T, Binary>) return "binary";
             else if constexpr (std::is_same_v<T, Array>) return "array";
             else if constexpr (std::is_same_v<T, Map>) return "map";
+            else if constexpr (std::is_same_v<T, FlatMap>) return "map";
             else if constexpr (std::is_same_v<T, Extension>) return "extension";
             else if constexpr (std::is_same_v<T, Timestamp>) return "timestamp";
             else if constexpr (std::is_same_v<T, Date>) return "date";
@@ -1097,11 +1269,102 @@ public:
         return std::move(*builder.build());
     }
     
+    // Merge a newly observed type into an existing one, mirroring the
+    // conflict handling in aggregateSamples.
+    std::string mergeFieldType(const std::string& existing, const std::string& incoming) const {
+        if (existing == incoming) return existing;
+        auto numeric = [](const std::string& t) {
+            return t == "int" || t == "uint" || t == "float" || t == "number";
+        };
+        if (options.merge_numeric_types && numeric(existing) && numeric(incoming)) {
+            return "number";
+        }
+        if (!options.strict_types) return "any";
+        return existing;
+    }
+
+    bool stable() const {
+        return options.stability_window > 0 && stable_run_ >= options.stability_window;
+    }
+
+    void observe(const Map& record) {
+        if (stable()) {
+            // Caller kept feeding past the stability window; note the
+            // records we are skipping so sampling_fraction stays honest.
+            terminated_early_ = true;
+            return;
+        }
+        records_seen_++;
+
+        // Stability tracking runs over every record, not just sampled
+        // ones: it only needs per-field types, which are cheap to keep.
+        bool novel = false;
+        for (const auto& [key, value] : record) {
+            std::string type = inferType(value);
+            auto it = observed_types_.find(key);
+            if (it == observed_types_.end()) {
+                observed_types_.emplace(key, std::move(type));
+                novel = true;
+            } else if (it->second != type) {
+                std::string merged = mergeFieldType(it->second, type);
+                if (merged != it->second) {
+                    it->second = std::move(merged);
+                    novel = true;
+                }
+            }
+        }
+        stable_run_ = novel ? 0 : stable_run_ + 1;
+
+        if (reservoir_.size() < options.sample_size) {
+            reservoir_.push_back(record);
+        } else if (options.reservoir_sampling) {
+            // Algorithm R: keep each of the records_seen_ records with
+            // equal probability sample_size / records_seen_.
+            std::uniform_int_distribution<size_t> pick(0, records_seen_ - 1);
+            size_t slot = pick(rng_);
+            if (slot < reservoir_.size()) {
+                reservoir_[slot] = record;
+            }
+        }
+    }
+
+    Schema finishStreaming(const std::string& name) {
+        Array sampled;
+        sampled.reserve(reservoir_.size());
+        for (auto& record : reservoir_) {
+            sampled.emplace_back(std::move(record));
+        }
+        Schema schema = aggregateSamples(sampled, name);
+        stats.records_seen = records_seen_;
+        stats.sampling_fraction = records_seen_ > 0
+            ? static_cast<double>(stats.samples_analyzed) / static_cast<double>(records_seen_)
+            : 0.0;
+        stats.terminated_early = terminated_early_;
+        reservoir_.clear();
+        return schema;
+    }
+
     Schema inferFromArrayOfMaps(const Array& array, const std::string& name) {
+        if (options.reservoir_sampling || options.stability_window > 0) {
+            for (const auto& item : array) {
+                if (stable()) {
+                    terminated_early_ = true;
+                    break;
+                }
+                if (const Map* map = std::get_if<Map>(&item)) {
+                    observe(*map);
+                }
+            }
+            return finishStreaming(name);
+        }
+        return aggregateSamples(array, name);
+    }
+
+    Schema aggregateSamples(const Array& array, const std::string& name) {
         if (array.empty()) {
             return Schema(name, SchemaVersion{1, 0, 0}, {});
         }
-        
+
         // Collect field information
         std::unordered_map<std::string, std::vector<Value>> field_values;
         std::unordered_map<std::string, size_t> field_occurrence;
@@ -1170,9 +1433,22 @@ public:
         
         stats.samples_analyzed = sample_count;
         stats.fields_discovered = field_values.size();
-        
+        if (stats.records_seen == 0) {
+            stats.records_seen = sample_count;
+            stats.sampling_fraction = 1.0;
+        }
+
         return std::move(*builder.build());
     }
+
+private:
+    // Streaming/sampling state for observe()/finishStreaming().
+    std::vector<Map> reservoir_;
+    std::unordered_map<std::string, std::string> observed_types_;
+    size_t records_seen_ = 0;
+    size_t stable_run_ = 0;
+    bool terminated_early_ = false;
+    std::mt19937_64 rng_;
 };
 
 SchemaInferrer::SchemaInferrer(const InferenceOptions& options)
@@ -1244,6 +1520,20 @@ Schema SchemaInferrer::inferFromArray(const Array& array, const std::string& nam
     }
 }
 
+void SchemaInferrer::observe(const Value& record) {
+    if (const Map* map = std::get_if<Map>(&record)) {
+        pimpl_->observe(*map);
+    }
+}
+
+bool SchemaInferrer::stable() const {
+    return pimpl_->stable();
+}
+
+Schema SchemaInferrer::finish(const std::string& name) {
+    return pimpl_->finishStreaming(name);
+}
+
 Schema SchemaInferrer::merge(std::vector<Schema>&& schemas, const std::string& name) {
     if (schemas.empty()) {
         return Schema(name, SchemaVersion{1, 0, 0}, {});
@@ -1,23 +1,112 @@
 #include "btoon/security.h"
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
 #include <openssl/hmac.h>
+#include <openssl/params.h>
 #include <openssl/sha.h>
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
 
 namespace btoon {
 
+namespace {
+
+#if !defined(__SSE4_2__) && !defined(__ARM_FEATURE_CRC32)
+// Byte-wise table fallback for targets without CRC instructions.
+const std::array<uint32_t, 256>& crc32c_table() {
+    static const std::array<uint32_t, 256> table = [] {
+        constexpr uint32_t poly = 0x82F63B78u;  // CRC32C, reflected
+        std::array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? (poly ^ (c >> 1)) : (c >> 1);
+            }
+            t[n] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+#endif
+
+/// CRC32C (Castagnoli) over the buffer, using the CPU's CRC instructions
+/// when the build targets them — the same compile-time dispatch as the
+/// encoder's simd_copy.
+uint32_t crc32c(std::span<const uint8_t> data) {
+    uint32_t crc = 0xFFFFFFFFu;
+    size_t i = 0;
+
+#if defined(__SSE4_2__)
+    uint64_t crc64 = crc;
+    for (; i + 8 <= data.size(); i += 8) {
+        uint64_t chunk;
+        std::memcpy(&chunk, &data[i], 8);
+        crc64 = _mm_crc32_u64(crc64, chunk);
+    }
+    crc = static_cast<uint32_t>(crc64);
+    for (; i < data.size(); ++i) {
+        crc = _mm_crc32_u8(crc, data[i]);
+    }
+#elif defined(__ARM_FEATURE_CRC32)
+    for (; i + 8 <= data.size(); i += 8) {
+        uint64_t chunk;
+        std::memcpy(&chunk, &data[i], 8);
+        crc = __crc32cd(crc, chunk);
+    }
+    for (; i < data.size(); ++i) {
+        crc = __crc32cb(crc, data[i]);
+    }
+#else
+    const auto& table = crc32c_table();
+    for (; i < data.size(); ++i) {
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+#endif
+
+    return crc ^ 0xFFFFFFFFu;
+}
+
+} // namespace
+
 void Security::setSecretKey(const std::string& key) {
     secretKey_ = key;
 }
 
+void Security::setIntegrityMode(IntegrityMode mode) {
+    integrityMode_ = mode;
+}
+
+IntegrityMode Security::integrityMode() const {
+    return integrityMode_;
+}
+
 std::vector<uint8_t> Security::sign(std::span<const uint8_t> data) const {
+    if (integrityMode_ == IntegrityMode::CRC32C) {
+        // Big-endian, like every other multi-byte field on the wire.
+        uint32_t crc = crc32c(data);
+        return {static_cast<uint8_t>(crc >> 24), static_cast<uint8_t>(crc >> 16),
+                static_cast<uint8_t>(crc >> 8), static_cast<uint8_t>(crc)};
+    }
     unsigned char md[EVP_MAX_MD_SIZE];
     unsigned int md_len;
-    HMAC(EVP_sha256(), secretKey_.data(), secretKey_.size(),
+    HMAC(EVP_sha256(), secretKey_.data(), static_cast<int>(secretKey_.size()),
          data.data(), data.size(), md, &md_len);
     return {md, md + md_len};
 }
 
 bool Security::verify(const std::vector<uint8_t>& data, const std::vector<uint8_t>& signature) const {
-    if (secretKey_.empty()) {
+    return verify(std::span<const uint8_t>(data), signature);
+}
+
+bool Security::verify(std::span<const uint8_t> data, const std::vector<uint8_t>& signature) const {
+    if (integrityMode_ == IntegrityMode::HMAC_SHA256 && secretKey_.empty()) {
         throw BtoonException("No secret key set for HMAC verification");
     }
     auto computed = sign(data);
@@ -30,6 +119,113 @@ bool Security::verify(const std::vector<uint8_t>& data, const std::vector<uint8_
     return diff == 0;
 }
 
+HmacSigner Security::createSigner() const {
+    if (integrityMode_ != IntegrityMode::HMAC_SHA256) {
+        throw BtoonException("Incremental signing is only available in HMAC mode");
+    }
+    if (secretKey_.empty()) {
+        throw BtoonException("No secret key set for HMAC signing");
+    }
+    return HmacSigner(secretKey_);
+}
+
+// ===== HmacSigner Implementation =====
+
+class HmacSigner::HmacSignerImpl {
+public:
+    explicit HmacSignerImpl(const std::string& key)
+        : key_(key),
+          mac_(EVP_MAC_fetch(nullptr, "HMAC", nullptr)),
+          ctx_(mac_ ? EVP_MAC_CTX_new(mac_) : nullptr) {
+        if (!ctx_) {
+            EVP_MAC_free(mac_);
+            throw BtoonException("Failed to allocate HMAC context");
+        }
+        init();
+    }
+
+    ~HmacSignerImpl() {
+        EVP_MAC_CTX_free(ctx_);
+        EVP_MAC_free(mac_);
+    }
+
+    void init() {
+        // OpenSSL picks the SHA implementation at runtime, using SHA-NI or
+        // the ARMv8 crypto extensions where the CPU provides them.
+        char digest[] = "SHA256";
+        OSSL_PARAM params[] = {
+            OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+            OSSL_PARAM_construct_end()
+        };
+        if (EVP_MAC_init(ctx_,
+                         reinterpret_cast<const unsigned char*>(key_.data()),
+                         key_.size(), params) != 1) {
+            throw BtoonException("Failed to initialize HMAC context");
+        }
+        finalized_ = false;
+    }
+
+    void update(std::span<const uint8_t> data) {
+        requireActive();
+        if (EVP_MAC_update(ctx_, data.data(), data.size()) != 1) {
+            throw BtoonException("Failed to update HMAC context");
+        }
+    }
+
+    std::vector<uint8_t> finalize() {
+        requireActive();
+        unsigned char md[EVP_MAX_MD_SIZE];
+        size_t md_len = 0;
+        if (EVP_MAC_final(ctx_, md, &md_len, sizeof(md)) != 1) {
+            throw BtoonException("Failed to finalize HMAC context");
+        }
+        finalized_ = true;
+        return {md, md + md_len};
+    }
+
+private:
+    void requireActive() const {
+        if (finalized_) {
+            throw BtoonException("HMAC signer already finalized; call reset() to reuse");
+        }
+    }
+
+    std::string key_;
+    EVP_MAC* mac_;
+    EVP_MAC_CTX* ctx_;
+    bool finalized_ = false;
+};
+
+HmacSigner::HmacSigner(const std::string& key)
+    : pimpl_(std::make_unique<HmacSignerImpl>(key)) {}
+
+HmacSigner::~HmacSigner() = default;
+HmacSigner::HmacSigner(HmacSigner&&) noexcept = default;
+HmacSigner& HmacSigner::operator=(HmacSigner&&) noexcept = default;
+
+void HmacSigner::update(std::span<const uint8_t> data) {
+    pimpl_->update(data);
+}
+
+std::vector<uint8_t> HmacSigner::finalize() {
+    return pimpl_->finalize();
+}
+
+bool HmacSigner::finalizeAndVerify(const std::vector<uint8_t>& signature) {
+    auto computed = pimpl_->finalize();
+    if (computed.size() != signature.size()) return false;
+    // Constant-time comparison, matching Security::verify.
+    int diff = 0;
+    for (size_t i = 0; i < computed.size(); ++i) {
+        diff |= computed[i] ^ signature[i];
+    }
+    return diff == 0;
+}
+
+void HmacSigner::reset() {
+    pimpl_->init();
+}
+
 void Security::setAllowedTypes(const std::set<size_t>& types) {
     allowedTypes_ = types;
     restrictTypes_ = !types.empty();
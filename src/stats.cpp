@@ -0,0 +1,81 @@
+#include "btoon/stats.h"
+#include "btoon/btoon.h"
+
+namespace btoon {
+
+double CodecStats::compression_ratio() const {
+    if (bytes_after_compression == 0) {
+        return 1.0;
+    }
+    return static_cast<double>(bytes_before_compression) /
+           static_cast<double>(bytes_after_compression);
+}
+
+void CodecStats::merge(const CodecStats& other) {
+    messages += other.messages;
+    bytes_processed += other.bytes_processed;
+    nils += other.nils;
+    bools += other.bools;
+    ints += other.ints;
+    uints += other.uints;
+    floats += other.floats;
+    strings += other.strings;
+    binaries += other.binaries;
+    arrays += other.arrays;
+    maps += other.maps;
+    extensions += other.extensions;
+    timestamps += other.timestamps;
+    dates += other.dates;
+    datetimes += other.datetimes;
+    bigints += other.bigints;
+    vector_floats += other.vector_floats;
+    vector_doubles += other.vector_doubles;
+    bytes_before_compression += other.bytes_before_compression;
+    bytes_after_compression += other.bytes_after_compression;
+    pool_reuses += other.pool_reuses;
+    pool_free_bytes += other.pool_free_bytes;
+    signatures += other.signatures;
+    signature_time_ms += other.signature_time_ms;
+}
+
+void CodecStats::count_value(const Value& value) {
+    std::visit([this](auto&& arg) {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, Nil>) nils++;
+        else if constexpr (std::is_same_v<T, Bool>) bools++;
+        else if constexpr (std::is_same_v<T, Int>) ints++;
+        else if constexpr (std::is_same_v<T, Uint>) uints++;
+        else if constexpr (std::is_same_v<T, Float>) floats++;
+        else if constexpr (std::is_same_v<T, String>) strings++;
+        else if constexpr (std::is_same_v<T, Binary>) binaries++;
+        else if constexpr (std::is_same_v<T, Array>) {
+            arrays++;
+            for (const auto& item : arg) {
+                count_value(item);
+            }
+        }
+        else if constexpr (std::is_same_v<T, Map>) {
+            maps++;
+            for (const auto& [key, val] : arg) {
+                strings++;  // Map keys serialize as strings
+                count_value(val);
+            }
+        }
+        else if constexpr (std::is_same_v<T, FlatMap>) {
+            maps++;
+            for (const auto& [key, val] : arg) {
+                strings++;
+                count_value(val);
+            }
+        }
+        else if constexpr (std::is_same_v<T, Extension>) extensions++;
+        else if constexpr (std::is_same_v<T, Timestamp>) timestamps++;
+        else if constexpr (std::is_same_v<T, Date>) dates++;
+        else if constexpr (std::is_same_v<T, DateTime>) datetimes++;
+        else if constexpr (std::is_same_v<T, BigInt>) bigints++;
+        else if constexpr (std::is_same_v<T, VectorFloat>) vector_floats++;
+        else if constexpr (std::is_same_v<T, VectorDouble>) vector_doubles++;
+    }, value);
+}
+
+} // namespace btoon
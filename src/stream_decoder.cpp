@@ -1,35 +1,481 @@
 #include "btoon/stream_decoder.h"
 #include "btoon/decoder.h"
+#include "btoon/compression.h"
+#include <zlib.h>  // crc32 for frame checksums
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace btoon {
 
+namespace {
+
+uint32_t frame_read_be32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+uint64_t frame_read_be64(const uint8_t* p) {
+    return (static_cast<uint64_t>(frame_read_be32(p)) << 32) | frame_read_be32(p + 4);
+}
+
+} // namespace
+
 class StreamDecoderImpl {
 public:
     StreamDecoderImpl(std::istream& stream, const DecodeOptions& options)
         : stream_(stream), options_(options) {}
 
+    ~StreamDecoderImpl() {
+        shutDownThreads();
+    }
+
     std::optional<Value> read() {
-        // This is a simplified implementation. A real implementation would
-        // read from the stream incrementally and parse the data without
-        // loading the entire object into memory first.
-        std::vector<char> buffer(std::istreambuf_iterator<char>(stream_), {});
-        if (buffer.empty()) {
+        if (!probed_) {
+            probe();
+        }
+        if (parallel()) {
+            if (!ensureBatch()) {
+                return std::nullopt;
+            }
+            return std::move(current_batch_[batch_pos_++]);
+        }
+        if (framed_) {
+            if (!ensureFrameData()) {
+                return std::nullopt;
+            }
+            return decodeOne(frame_, pos_);
+        }
+        ensureLegacyLoaded();
+        if (legacy_pos_ >= legacy_end_) {
             return std::nullopt;
         }
-        
-        Decoder decoder;
-        return decoder.decode({reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size()});
+        return decodeOne(legacy_buffer_, legacy_pos_);
+    }
+
+    std::vector<Value> read_batch(size_t max_records) {
+        std::vector<Value> batch;
+        if (!probed_) {
+            probe();
+        }
+        if (parallel()) {
+            while (batch.size() < max_records && ensureBatch()) {
+                while (batch.size() < max_records && batch_pos_ < current_batch_.size()) {
+                    batch.push_back(std::move(current_batch_[batch_pos_++]));
+                }
+            }
+            return batch;
+        }
+        if (framed_) {
+            // Drain whole frames: the frame is decompressed once and every
+            // record in it is decoded back to back.
+            while (batch.size() < max_records && ensureFrameData()) {
+                while (batch.size() < max_records && pos_ < frame_.size()) {
+                    batch.push_back(decodeOne(frame_, pos_));
+                }
+            }
+            return batch;
+        }
+        ensureLegacyLoaded();
+        while (batch.size() < max_records && legacy_pos_ < legacy_end_) {
+            batch.push_back(decodeOne(legacy_buffer_, legacy_pos_));
+        }
+        return batch;
     }
 
     bool has_next() {
-        return stream_.peek() != EOF;
+        if (!probed_) {
+            probe();
+        }
+        if (parallel()) {
+            return ensureBatch();
+        }
+        if (framed_) {
+            return ensureFrameData();
+        }
+        ensureLegacyLoaded();
+        return legacy_pos_ < legacy_end_;
     }
 
 private:
+    // A frame as stored on the wire, before decompression.
+    struct RawFrame {
+        CompressionAlgorithm algo;
+        uint32_t uncompressed_size;
+        uint32_t checksum;
+        std::vector<uint8_t> stored;
+    };
+
+    bool parallel() const { return !workers_.empty(); }
+
+    static Value decodeOne(const std::vector<uint8_t>& buffer, size_t& pos) {
+        auto remaining = std::span<const uint8_t>(buffer).subspan(pos);
+        Decoder decoder;
+        auto [value, consumed] = decoder.decode_and_get_pos(remaining);
+        pos += consumed;
+        return value;
+    }
+
+    static std::vector<Value> decodeAll(const std::vector<uint8_t>& buffer) {
+        std::vector<Value> records;
+        size_t pos = 0;
+        while (pos < buffer.size()) {
+            records.push_back(decodeOne(buffer, pos));
+        }
+        return records;
+    }
+
+    // Peek at the stream head: framed streams open with a "BTFM" frame
+    // header, anything else takes the unframed path. The probed bytes are
+    // kept aside rather than pushed back, since putback of multiple
+    // characters is not guaranteed for file streams.
+    void probe() {
+        probed_ = true;
+        char head[4];
+        stream_.read(head, 4);
+        std::streamsize got = stream_.gcount();
+        if (got == 4 && std::memcmp(head, "BTFM", 4) == 0) {
+            framed_ = true;
+            header_consumed_ = true;
+            if (options_.stream_decode_threads != 1) {
+                startParallel();
+            } else if (options_.stream_read_ahead) {
+                prefetch_ = std::thread([this] { prefetchLoop(); });
+            }
+            return;
+        }
+        stream_.clear();
+        legacy_prefix_.assign(head, head + got);
+    }
+
+    // Unframed input: load the remaining stream once, then decode records
+    // sequentially from the buffer. A trailing seek index footer is excluded
+    // from the record region so decoding stops at the last record.
+    void ensureLegacyLoaded() {
+        if (legacy_loaded_) {
+            return;
+        }
+        legacy_loaded_ = true;
+        legacy_buffer_.assign(legacy_prefix_.begin(), legacy_prefix_.end());
+        legacy_prefix_.clear();
+        legacy_buffer_.insert(legacy_buffer_.end(),
+                              std::istreambuf_iterator<char>(stream_), {});
+        legacy_end_ = legacy_buffer_.size();
+
+        if (legacy_end_ >= 16 &&
+            std::memcmp(&legacy_buffer_[legacy_end_ - 8], "BTONIDX1", 8) == 0) {
+            uint64_t count = frame_read_be64(&legacy_buffer_[legacy_end_ - 16]);
+            if (count <= (legacy_end_ - 16) / 8) {
+                legacy_end_ = legacy_end_ - 16 - static_cast<size_t>(count) * 8;
+            }
+        }
+    }
+
+    bool ensureFrameData() {
+        while (pos_ >= frame_.size()) {
+            if (!loadNextFrame()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool loadNextFrame() {
+        if (prefetch_.joinable()) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] {
+                return !ready_.empty() || done_ || pipeline_error_;
+            });
+            if (!ready_.empty()) {
+                frame_ = std::move(ready_.front());
+                ready_.pop_front();
+                pos_ = 0;
+                lock.unlock();
+                cv_.notify_all();  // the prefetcher may be waiting for space
+                return true;
+            }
+            if (pipeline_error_) {
+                std::rethrow_exception(pipeline_error_);
+            }
+            return false;
+        }
+
+        auto raw = readRawFrame();
+        if (!raw) {
+            return false;
+        }
+        frame_ = inflateFrame(*raw);
+        pos_ = 0;
+        return true;
+    }
+
+    // Reads the next stored frame from the stream without decompressing it;
+    // nullopt at the frame directory footer or end of stream.
+    std::optional<RawFrame> readRawFrame() {
+        if (!header_consumed_) {
+            char head[4];
+            stream_.read(head, 4);
+            if (stream_.gcount() != 4 || std::memcmp(head, "BTFM", 4) != 0) {
+                return std::nullopt;
+            }
+        }
+        header_consumed_ = false;
+
+        uint8_t header[20];
+        stream_.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (stream_.gcount() != sizeof(header)) {
+            throw BtoonException("Truncated stream frame header");
+        }
+        if (header[0] != 1) {
+            throw BtoonException("Unsupported stream frame version");
+        }
+        RawFrame raw;
+        raw.algo = static_cast<CompressionAlgorithm>(header[1]);
+        uint32_t compressed_size = frame_read_be32(&header[4]);
+        raw.uncompressed_size = frame_read_be32(&header[8]);
+        raw.checksum = frame_read_be32(&header[12]);
+
+        raw.stored.resize(compressed_size);
+        stream_.read(reinterpret_cast<char*>(raw.stored.data()),
+                     static_cast<std::streamsize>(raw.stored.size()));
+        if (static_cast<uint32_t>(stream_.gcount()) != compressed_size) {
+            throw BtoonException("Truncated stream frame payload");
+        }
+        return raw;
+    }
+
+    // Verifies the checksum and decompresses a stored frame.
+    static std::vector<uint8_t> inflateFrame(const RawFrame& raw) {
+        uint32_t actual = static_cast<uint32_t>(
+            ::crc32(::crc32(0L, Z_NULL, 0), raw.stored.data(),
+                    static_cast<uInt>(raw.stored.size())));
+        if (actual != raw.checksum) {
+            throw BtoonException("Stream frame checksum mismatch");
+        }
+
+        std::vector<uint8_t> payload;
+        if (raw.algo == CompressionAlgorithm::NONE) {
+            payload = raw.stored;
+        } else {
+            payload = decompress(raw.algo, raw.stored);
+        }
+        if (payload.size() != raw.uncompressed_size) {
+            throw BtoonException("Stream frame size mismatch");
+        }
+        return payload;
+    }
+
+    // At most this many decompressed frames wait for the consumer: one being
+    // drained plus one ready behind it.
+    static constexpr size_t kMaxReadyFrames = 2;
+
+    void prefetchLoop() {
+        for (;;) {
+            std::optional<std::vector<uint8_t>> payload;
+            try {
+                auto raw = readRawFrame();
+                if (raw) {
+                    payload = inflateFrame(*raw);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                pipeline_error_ = std::current_exception();
+                done_ = true;
+                cv_.notify_all();
+                return;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!payload) {
+                done_ = true;
+                cv_.notify_all();
+                return;
+            }
+            cv_.wait(lock, [this] {
+                return ready_.size() < kMaxReadyFrames || stop_;
+            });
+            if (stop_) {
+                return;
+            }
+            ready_.push_back(std::move(*payload));
+            cv_.notify_all();
+        }
+    }
+
+    // --- Parallel frame decode ---
+    //
+    // One reader thread pulls raw frames off the stream and fans them out to
+    // a worker pool; workers decompress, verify and decode whole frames
+    // concurrently. Results carry sequence numbers and the consumer waits
+    // for the next one in order, so delivery order matches stream order
+    // regardless of which worker finishes first. The reader stays at most
+    // window_ frames ahead of the consumer, bounding memory.
+
+    void startParallel() {
+        size_t count = options_.stream_decode_threads;
+        if (count == 0) {
+            count = std::thread::hardware_concurrency();
+            if (count == 0) {
+                count = 1;
+            }
+        }
+        window_ = count * 2;
+        workers_.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            workers_.emplace_back([this] { workerLoop(); });
+        }
+        reader_ = std::thread([this] { readerLoop(); });
+    }
+
+    void shutDownThreads() {
+        if (!prefetch_.joinable() && workers_.empty()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        if (prefetch_.joinable()) {
+            prefetch_.join();
+        }
+        if (reader_.joinable()) {
+            reader_.join();
+        }
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        workers_.clear();
+    }
+
+    void readerLoop() {
+        for (uint64_t seq = 0;; ++seq) {
+            std::optional<RawFrame> raw;
+            try {
+                raw = readRawFrame();
+            } catch (...) {
+                failPipeline(std::current_exception());
+                return;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!raw) {
+                total_frames_ = seq;
+                done_ = true;
+                cv_.notify_all();
+                return;
+            }
+            cv_.wait(lock, [this, seq] {
+                return seq < consume_seq_ + window_ || stop_ || pipeline_error_;
+            });
+            if (stop_ || pipeline_error_) {
+                return;
+            }
+            work_.emplace_back(seq, std::move(*raw));
+            cv_.notify_all();
+        }
+    }
+
+    void workerLoop() {
+        for (;;) {
+            uint64_t seq;
+            RawFrame raw;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] {
+                    return !work_.empty() || (done_ && work_.empty()) || stop_ ||
+                           pipeline_error_;
+                });
+                if (work_.empty() || stop_ || pipeline_error_) {
+                    return;
+                }
+                seq = work_.front().first;
+                raw = std::move(work_.front().second);
+                work_.pop_front();
+            }
+            try {
+                std::vector<Value> records = decodeAll(inflateFrame(raw));
+                std::lock_guard<std::mutex> lock(mutex_);
+                results_.emplace(seq, std::move(records));
+                cv_.notify_all();
+            } catch (...) {
+                failPipeline(std::current_exception());
+                return;
+            }
+        }
+    }
+
+    void failPipeline(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!pipeline_error_) {
+            pipeline_error_ = error;
+        }
+        done_ = true;
+        cv_.notify_all();
+    }
+
+    // Makes current_batch_ hold undelivered records, pulling the next frame's
+    // results in sequence order; false when the stream is exhausted.
+    bool ensureBatch() {
+        while (batch_pos_ >= current_batch_.size()) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] {
+                return results_.count(consume_seq_) != 0 || pipeline_error_ ||
+                       (done_ && consume_seq_ >= total_frames_);
+            });
+            auto it = results_.find(consume_seq_);
+            if (it != results_.end()) {
+                current_batch_ = std::move(it->second);
+                results_.erase(it);
+                consume_seq_++;
+                batch_pos_ = 0;
+                lock.unlock();
+                cv_.notify_all();  // the reader may be waiting on the window
+                continue;
+            }
+            if (pipeline_error_) {
+                std::rethrow_exception(pipeline_error_);
+            }
+            return false;
+        }
+        return true;
+    }
+
     std::istream& stream_;
     DecodeOptions options_;
+    bool probed_ = false;
+    bool framed_ = false;
+    bool header_consumed_ = false;  // "BTFM" of the next frame already read
+    std::vector<char> legacy_prefix_;
+    bool legacy_loaded_ = false;
+    std::vector<uint8_t> legacy_buffer_;
+    size_t legacy_end_ = 0;  // record bytes end here (footer excluded)
+    size_t legacy_pos_ = 0;
+    std::vector<uint8_t> frame_;  // decompressed payload of the current frame
+    size_t pos_ = 0;
+
+    // Threaded-mode state; mutex_ guards everything below.
+    std::thread prefetch_;
+    std::thread reader_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::vector<uint8_t>> ready_;              // read-ahead mode
+    std::deque<std::pair<uint64_t, RawFrame>> work_;      // parallel mode
+    std::map<uint64_t, std::vector<Value>> results_;      // parallel mode
+    uint64_t consume_seq_ = 0;
+    uint64_t total_frames_ = 0;  // valid once done_ is set by the reader
+    size_t window_ = 0;          // max frames in flight past the consumer
+    bool done_ = false;
+    bool stop_ = false;
+    std::exception_ptr pipeline_error_;
+
+    std::vector<Value> current_batch_;  // parallel mode delivery buffer
+    size_t batch_pos_ = 0;
 };
 
 StreamDecoder::StreamDecoder(std::istream& stream, const DecodeOptions& options)
@@ -41,6 +487,10 @@ std::optional<Value> StreamDecoder::read() {
     return pimpl_->read();
 }
 
+std::vector<Value> StreamDecoder::read_batch(size_t max_records) {
+    return pimpl_->read_batch(max_records);
+}
+
 bool StreamDecoder::has_next() {
     return pimpl_->has_next();
 }
@@ -1,15 +1,64 @@
 #include "btoon/stream_encoder.h"
 #include "btoon/encoder.h"
+#include "btoon/compression.h"
+#include <zlib.h>  // crc32 for frame checksums
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 namespace btoon {
 
 class StreamEncoderImpl {
 public:
     StreamEncoderImpl(std::ostream& stream, const EncodeOptions& options)
-        : stream_(stream), options_(options) {}
+        : stream_(stream), options_(options) {
+        if (options_.stream_frame_size != 0 && options_.stream_seek_index) {
+            throw BtoonException(
+                "stream_seek_index is not supported on framed streams; "
+                "the frame directory already provides random access");
+        }
+        if (options_.stream_background_compression) {
+            if (options_.stream_frame_size == 0) {
+                throw BtoonException(
+                    "stream_background_compression requires stream_frame_size");
+            }
+            worker_ = std::thread([this] { workerLoop(); });
+        }
+    }
+
+    ~StreamEncoderImpl() {
+        // Abandon queued frames if the stream was never closed; close() is
+        // the only place the frame directory is written, matching the seek
+        // index contract.
+        if (worker_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            worker_.join();
+        }
+    }
 
     void write(const Value& value) {
+        if (options_.stream_frame_size != 0) {
+            Encoder encoder;
+            encoder.setOptions(options_);
+            encoder.encode(value);
+            auto encoded = encoder.getBuffer();
+            pending_.insert(pending_.end(), encoded.begin(), encoded.end());
+            pending_records_++;
+            if (pending_.size() >= options_.stream_frame_size) {
+                dispatchFrame();
+            }
+            return;
+        }
+        if (options_.stream_seek_index) {
+            record_offsets_.push_back(static_cast<uint64_t>(stream_.tellp()));
+        }
         Encoder encoder;
         encoder.setOptions(options_);
         encoder.encode(value);
@@ -19,12 +68,212 @@ public:
     }
 
     void close() {
+        if (!closed_) {
+            if (options_.stream_frame_size != 0) {
+                dispatchFrame();
+                if (worker_.joinable()) {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stop_ = true;
+                    }
+                    cv_.notify_all();
+                    worker_.join();
+                    if (worker_error_) {
+                        std::rethrow_exception(worker_error_);
+                    }
+                }
+                writeFrameDirectory();
+            } else if (options_.stream_seek_index) {
+                writeSeekIndex();
+            }
+        }
+        closed_ = true;
         stream_.flush();
     }
 
 private:
+    struct FrameEntry {
+        uint64_t offset;            // file offset of the frame header
+        uint32_t compressed_size;   // stored payload bytes
+        uint32_t uncompressed_size; // payload bytes after decompression
+        uint32_t checksum;          // crc32 of the stored payload
+        uint32_t record_count;      // records encoded into the frame
+    };
+
+    struct PendingFrame {
+        std::vector<uint8_t> payload;
+        uint32_t record_count;
+    };
+
+    // At most this many frames wait for the worker: the one it is
+    // compressing plus one ready behind it. A deeper queue only adds memory,
+    // not throughput, since the worker is the bottleneck it exists to hide.
+    static constexpr size_t kMaxQueuedFrames = 2;
+
+    void writeBe(uint64_t v, int n) {
+        uint8_t bytes[8];
+        for (int i = n - 1; i >= 0; --i) {
+            bytes[i] = static_cast<uint8_t>(v & 0xff);
+            v >>= 8;
+        }
+        stream_.write(reinterpret_cast<const char*>(bytes), n);
+    }
+
+    // Hands the accumulated frame to the worker thread, or compresses and
+    // writes it inline when pipelining is off.
+    void dispatchFrame() {
+        if (pending_.empty()) {
+            rethrowWorkerError();
+            return;
+        }
+        PendingFrame frame{std::move(pending_), pending_records_};
+        pending_ = {};
+        pending_records_ = 0;
+
+        if (!worker_.joinable()) {
+            writeFrame(std::move(frame));
+            return;
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] {
+                return queue_.size() < kMaxQueuedFrames || worker_error_;
+            });
+            if (!worker_error_) {
+                queue_.push_back(std::move(frame));
+            }
+        }
+        cv_.notify_all();
+        rethrowWorkerError();
+    }
+
+    void rethrowWorkerError() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (worker_error_) {
+            std::rethrow_exception(worker_error_);
+        }
+    }
+
+    void workerLoop() {
+        for (;;) {
+            PendingFrame frame;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return !queue_.empty() || stop_; });
+                if (queue_.empty()) {
+                    break;  // stop requested and nothing left to write
+                }
+                frame = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            try {
+                writeFrame(std::move(frame));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                worker_error_ = std::current_exception();
+                queue_.clear();
+                cv_.notify_all();
+                return;
+            }
+            cv_.notify_all();  // a producer may be waiting for queue space
+        }
+    }
+
+    // Frame layout (all integers big-endian):
+    //   "BTFM" | version u8 | algorithm u8 | reserved u16
+    //   | compressed_size u32 | uncompressed_size u32 | crc32 u32
+    //   | record_count u32 | stored payload
+    // The checksum covers the stored bytes, so corruption is caught before
+    // any decompression work. Frames that do not shrink are stored raw with
+    // the algorithm byte set to NONE. In pipelined mode only the worker
+    // thread touches the stream between construction and close().
+    void writeFrame(PendingFrame frame) {
+        CompressionAlgorithm algo = CompressionAlgorithm::NONE;
+        std::vector<uint8_t> stored;
+        if (options_.compress &&
+            options_.compression_algorithm != CompressionAlgorithm::NONE) {
+            int level = options_.compression_level;
+            if (level == 0 && options_.compression_preset != CompressionLevel::CUSTOM) {
+                level = get_numeric_level(options_.compression_algorithm,
+                                          options_.compression_preset);
+            }
+            stored = compress(options_.compression_algorithm, frame.payload, level);
+            algo = options_.compression_algorithm;
+            if (stored.size() >= frame.payload.size()) {
+                stored = frame.payload;
+                algo = CompressionAlgorithm::NONE;
+            }
+        } else {
+            stored = frame.payload;
+        }
+
+        uint32_t checksum = static_cast<uint32_t>(
+            ::crc32(::crc32(0L, Z_NULL, 0), stored.data(),
+                    static_cast<uInt>(stored.size())));
+
+        frames_.push_back(FrameEntry{
+            static_cast<uint64_t>(stream_.tellp()),
+            static_cast<uint32_t>(stored.size()),
+            static_cast<uint32_t>(frame.payload.size()),
+            checksum,
+            frame.record_count});
+
+        stream_.write("BTFM", 4);
+        writeBe(1, 1);  // version
+        writeBe(static_cast<uint8_t>(algo), 1);
+        writeBe(0, 2);  // reserved
+        writeBe(stored.size(), 4);
+        writeBe(frame.payload.size(), 4);
+        writeBe(checksum, 4);
+        writeBe(frame.record_count, 4);
+        stream_.write(reinterpret_cast<const char*>(stored.data()),
+                      static_cast<std::streamsize>(stored.size()));
+    }
+
+    // Directory footer, appended after the last frame:
+    //   [offset u64 | compressed u32 | uncompressed u32 | crc32 u32
+    //    | record_count u32] * N  [frame count u64]  "BTONFRM1"
+    // The fixed-size trailer mirrors the seek index footer: a reader finds
+    // the directory from the end of the file without out-of-band framing.
+    void writeFrameDirectory() {
+        for (const FrameEntry& frame : frames_) {
+            writeBe(frame.offset, 8);
+            writeBe(frame.compressed_size, 4);
+            writeBe(frame.uncompressed_size, 4);
+            writeBe(frame.checksum, 4);
+            writeBe(frame.record_count, 4);
+        }
+        writeBe(frames_.size(), 8);
+        stream_.write("BTONFRM1", 8);
+    }
+
+    // Footer layout, appended after the last record:
+    //   [record offset u64 BE] * N  [record count u64 BE]  "BTONIDX1"
+    // The fixed-size trailer lets a reader recognize and locate the index
+    // from the end of the file without any out-of-band framing.
+    void writeSeekIndex() {
+        for (uint64_t offset : record_offsets_) {
+            writeBe(offset, 8);
+        }
+        writeBe(record_offsets_.size(), 8);
+        stream_.write("BTONIDX1", 8);
+    }
+
     std::ostream& stream_;
     EncodeOptions options_;
+    std::vector<uint64_t> record_offsets_;
+    std::vector<uint8_t> pending_;
+    uint32_t pending_records_ = 0;
+    std::vector<FrameEntry> frames_;
+    bool closed_ = false;
+
+    // Pipelined mode state; mutex_ guards queue_, stop_ and worker_error_.
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<PendingFrame> queue_;
+    bool stop_ = false;
+    std::exception_ptr worker_error_;
 };
 
 StreamEncoder::StreamEncoder(std::ostream& stream, const EncodeOptions& options)
@@ -11,9 +11,16 @@
 #include "btoon/validator.h"
 #include "btoon/decoder.h"
 #include <cmath>
+#include <cstring>
 #include <stack>
 #include <unordered_set>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace btoon {
 
 // ===== BoundsChecker Implementation =====
@@ -48,6 +55,175 @@ bool BoundsChecker::inBounds(size_t position) const {
 
 // ===== UTF8Validator Implementation =====
 
+namespace {
+
+/**
+ * @brief Length of the leading run of ASCII bytes in a buffer.
+ *
+ * Scans a SIMD block at a time where available by testing the high bit of
+ * every byte, falling back to a byte loop for the remainder. An ASCII run
+ * always ends on a UTF-8 sequence boundary, so validation can resume
+ * directly after it.
+ */
+size_t ascii_run(const uint8_t* data, size_t len) {
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for (; i + 32 <= len; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        if (_mm256_movemask_epi8(block) != 0) break;
+    }
+#elif defined(__SSE2__)
+    for (; i + 16 <= len; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(block) != 0) break;
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 16 <= len; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(data + i)) >= 0x80) break;
+    }
+#endif
+
+    while (i < len && data[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+#if defined(__AVX2__)
+
+// Error classes for the three-table classification of adjacent byte pairs,
+// after Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction
+// Per Byte". Each bit marks one way a (previous byte, current byte) pair
+// can be malformed; a pair is an error when the same bit survives the AND
+// of all three lookups.
+constexpr uint8_t UTF8_TOO_SHORT = 1 << 0;       // Lead byte not followed by a continuation
+constexpr uint8_t UTF8_TOO_LONG = 1 << 1;        // Continuation after the end of a sequence
+constexpr uint8_t UTF8_OVERLONG_3 = 1 << 2;      // E0 with a sub-0xA0 continuation
+constexpr uint8_t UTF8_TOO_LARGE = 1 << 3;       // Above U+10FFFF
+constexpr uint8_t UTF8_SURROGATE = 1 << 4;       // ED with a 0xA0+ continuation
+constexpr uint8_t UTF8_OVERLONG_2 = 1 << 5;      // C0/C1 lead
+constexpr uint8_t UTF8_TOO_LARGE_1000 = 1 << 6;  // F4 with a 0x90+ continuation
+constexpr uint8_t UTF8_OVERLONG_4 = 1 << 6;      // F0 with a sub-0x90 continuation
+constexpr uint8_t UTF8_TWO_CONTS = 1 << 7;       // Two consecutive continuations
+constexpr uint8_t UTF8_CARRY = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS;
+
+// Indexed by the high nibble of the previous byte.
+alignas(32) constexpr uint8_t kUtf8Byte1High[16] = {
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+    UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+};
+
+// Indexed by the low nibble of the previous byte.
+alignas(32) constexpr uint8_t kUtf8Byte1Low[16] = {
+    UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+    UTF8_CARRY | UTF8_OVERLONG_2,
+    UTF8_CARRY,
+    UTF8_CARRY,
+    UTF8_CARRY | UTF8_TOO_LARGE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+};
+
+// Indexed by the high nibble of the current byte.
+alignas(32) constexpr uint8_t kUtf8Byte2High[16] = {
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 |
+        UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+};
+
+/// Broadcast a 16-byte lookup table into both lanes of a 256-bit register.
+inline __m256i utf8_table(const uint8_t (&table)[16]) {
+    return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table)));
+}
+
+/// Each lane sees the byte N positions before it, crossing the boundary
+/// into the previous block.
+template <int N>
+inline __m256i utf8_prev(__m256i input, __m256i prev) {
+    __m256i joined = _mm256_permute2x128_si256(prev, input, 0x21);
+    return _mm256_alignr_epi8(input, joined, 16 - N);
+}
+
+/**
+ * @brief Table-driven UTF-8 validation, 32 bytes per step.
+ *
+ * Classifies every adjacent byte pair through three nibble lookups and
+ * cross-checks expected continuation positions against bytes two and
+ * three back. The trailing partial block is processed zero-padded, which
+ * also flags sequences left incomplete at the end of the input.
+ */
+bool validate_utf8_blocks(const uint8_t* data, size_t len) {
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+    const __m256i byte_1_high = utf8_table(kUtf8Byte1High);
+    const __m256i byte_1_low = utf8_table(kUtf8Byte1Low);
+    const __m256i byte_2_high = utf8_table(kUtf8Byte2High);
+
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i error = _mm256_setzero_si256();
+
+    auto check_block = [&](__m256i input) {
+        __m256i prev1 = utf8_prev<1>(input, prev_input);
+        __m256i nib_1_high = _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibbles);
+        __m256i nib_1_low = _mm256_and_si256(prev1, low_nibbles);
+        __m256i nib_2_high = _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibbles);
+        __m256i special = _mm256_and_si256(
+            _mm256_and_si256(_mm256_shuffle_epi8(byte_1_high, nib_1_high),
+                             _mm256_shuffle_epi8(byte_1_low, nib_1_low)),
+            _mm256_shuffle_epi8(byte_2_high, nib_2_high));
+
+        // Lanes whose byte two (resp. three) back is a 3-byte (4-byte) lead
+        // must be continuations; UTF8_TWO_CONTS marks the lanes that are.
+        // Any mismatch in bit 7 is an error.
+        __m256i prev2 = utf8_prev<2>(input, prev_input);
+        __m256i prev3 = utf8_prev<3>(input, prev_input);
+        __m256i must23 = _mm256_or_si256(
+            _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80))),
+            _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80))));
+        __m256i must23_80 = _mm256_and_si256(must23, _mm256_set1_epi8(static_cast<char>(0x80)));
+        error = _mm256_or_si256(error, _mm256_xor_si256(must23_80, special));
+        prev_input = input;
+    };
+
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        check_block(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+    }
+
+    // Always run one zero-padded tail block (possibly all padding) so a
+    // multi-byte sequence truncated at the end of the input is rejected.
+    alignas(32) uint8_t tail[32] = {0};
+    if (i < len) {
+        std::memcpy(tail, data + i, len - i);
+    }
+    check_block(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+
+    return _mm256_testz_si256(error, error) != 0;
+}
+
+#endif // defined(__AVX2__)
+
+} // namespace
+
 bool UTF8Validator::isValidCodePoint(uint32_t cp) {
     // Check for valid Unicode ranges
     if (cp > 0x10FFFF) return false;  // Beyond Unicode range
@@ -64,9 +240,25 @@ int UTF8Validator::getUTF8SequenceLength(uint8_t lead) {
 }
 
 bool UTF8Validator::isValid(std::string_view str) {
-    size_t i = 0;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(str.data());
+
+    // Pure-ASCII strings (keys, identifiers, most log payloads) are accepted
+    // after a single vectorized scan of the high bits.
+    size_t i = ascii_run(data, str.length());
+    if (i == str.length()) return true;
+
+#if defined(__AVX2__)
+    // The ASCII prefix ends on a sequence boundary, so the block validator
+    // can pick up from there.
+    return validate_utf8_blocks(data + i, str.length() - i);
+#else
     while (i < str.length()) {
         uint8_t lead = static_cast<uint8_t>(str[i]);
+        if (lead < 0x80) {
+            // Skip interior ASCII runs a block at a time as well.
+            i += ascii_run(data + i, str.length() - i);
+            continue;
+        }
         int len = getUTF8SequenceLength(lead);
         
         if (len == 0) return false;
@@ -95,11 +287,12 @@ bool UTF8Validator::isValid(std::string_view str) {
         }
         
         if (!isValidCodePoint(cp)) return false;
-        
+
         i += static_cast<size_t>(len);
     }
-    
+
     return true;
+#endif
 }
 
 std::string UTF8Validator::sanitize(std::string_view str) {
@@ -316,53 +509,62 @@ public:
     
     explicit ValidatorImpl(const ValidationOptions& opts) : options(opts) {}
     
-    ValidationResult validateData(std::span<const uint8_t> data) const {
-        ValidationResult result;
-        
-        if (options.collect_stats) {
-            result.stats = ValidationResult::Stats{};
-        }
-        
+    // Upfront whole-buffer checks shared by validateData and
+    // decodeValidatedData: total size, emptiness, and the compression
+    // envelope including the zip-bomb ratio. Returns false when decoding
+    // should not be attempted.
+    bool checkEnvelope(std::span<const uint8_t> data, ValidationResult& result) const {
         // Check total size
         if (data.size() > options.max_total_size) {
             result.addError("Data exceeds maximum allowed size");
-            return result;
+            return false;
         }
-        
+
         // Quick format check
         if (data.empty()) {
             result.addError("Empty data");
-            return result;
+            return false;
         }
-        
+
         // Check for compression header
-        [[maybe_unused]] bool isCompressed = false;
         if (data.size() >= 16) {
             uint32_t magic = ntohl(*reinterpret_cast<const uint32_t*>(data.data()));
             if (magic == 0x42544F4E) {  // "BTON"
-                isCompressed = true;
-                
                 // Validate compression header
                 uint32_t compressed_size = ntohl(*reinterpret_cast<const uint32_t*>(data.data() + 8));
                 uint32_t uncompressed_size = ntohl(*reinterpret_cast<const uint32_t*>(data.data() + 12));
-                
+
                 if (compressed_size + 16 != data.size()) {
                     result.addError("Compression header size mismatch");
-                    return result;
+                    return false;
                 }
-                
+
                 if (uncompressed_size > options.max_total_size) {
                     result.addError("Uncompressed size exceeds limit");
-                    return result;
+                    return false;
                 }
-                
+
                 // Check compression ratio for zip bomb
                 if (compressed_size > 0 && uncompressed_size / compressed_size > 1000) {
                     result.addWarning("Extremely high compression ratio detected");
                 }
             }
         }
-        
+
+        return true;
+    }
+
+    ValidationResult validateData(std::span<const uint8_t> data) const {
+        ValidationResult result;
+
+        if (options.collect_stats) {
+            result.stats = ValidationResult::Stats{};
+        }
+
+        if (!checkEnvelope(data, result)) {
+            return result;
+        }
+
         // Security checks
         if (!options.fast_mode) {
             auto security_issues = SecurityValidator::checkSecurity(data);
@@ -410,7 +612,32 @@ public:
         
         return result;
     }
-    
+
+    std::pair<Value, ValidationResult> decodeValidatedData(std::span<const uint8_t> data) const {
+        ValidationResult result;
+
+        if (options.collect_stats) {
+            result.stats = ValidationResult::Stats{};
+        }
+
+        if (!checkEnvelope(data, result)) {
+            return {Value(Nil{}), std::move(result)};
+        }
+
+        // The SecurityValidator pre-scans are deliberately skipped here:
+        // nesting depth and size claims are enforced inline by the fused
+        // decode, so the buffer is traversed exactly once after the O(1)
+        // envelope checks above.
+        try {
+            Decoder decoder;
+            Value value = decoder.decodeValidated(data, options, result);
+            return {std::move(value), std::move(result)};
+        } catch (const std::exception& e) {
+            result.addError(std::string("Decode error: ") + e.what());
+            return {Value(Nil{}), std::move(result)};
+        }
+    }
+
     // Helper template to validate specific value types (MSVC-compatible)
     template<typename T>
     void validateTypedValue(const T& arg, ValidationResult& result, size_t depth) const {
@@ -574,6 +801,10 @@ ValidationResult Validator::validate(const Value& value) const {
     return pimpl_->validateValue(value, 0);
 }
 
+std::pair<Value, ValidationResult> Validator::decodeValidated(std::span<const uint8_t> data) const {
+    return pimpl_->decodeValidatedData(data);
+}
+
 bool Validator::quickCheck(std::span<const uint8_t> data) const {
     return pimpl_->quickCheckData(data);
 }
@@ -597,4 +828,388 @@ std::vector<uint8_t> Validator::sanitize(std::span<const uint8_t> data) const {
     }
 }
 
+// ===== StreamingValidator Implementation =====
+
+class StreamingValidator::StreamingValidatorImpl {
+public:
+    explicit StreamingValidatorImpl(const ValidationOptions& opts) : options(opts) {
+        resetState();
+    }
+
+    void resetState() {
+        result = ValidationResult{};
+        if (options.collect_stats) {
+            result.stats = ValidationResult::Stats{};
+        }
+        mode = Mode::Marker;
+        stack.clear();
+        total_bytes = 0;
+        accum = 0;
+        need = 0;
+        have = 0;
+        cur_marker = 0;
+        payload_remaining = 0;
+        utf8_remaining = 0;
+        utf8_next_min = 0x80;
+        utf8_next_max = 0xBF;
+        dead = false;
+    }
+
+    bool feed(std::span<const uint8_t> chunk) {
+        if (dead) return false;
+
+        total_bytes += chunk.size();
+        if (total_bytes > options.max_total_size) {
+            fail("Data exceeds maximum allowed size");
+            return false;
+        }
+
+        size_t i = 0;
+        while (i < chunk.size() && !dead) {
+            switch (mode) {
+                case Mode::Marker:
+                    onMarker(chunk[i++]);
+                    break;
+                case Mode::Length:
+                case Mode::Scalar: {
+                    size_t take = std::min(need - have, chunk.size() - i);
+                    for (size_t j = 0; j < take; ++j) {
+                        accum = (accum << 8) | chunk[i + j];
+                    }
+                    have += take;
+                    i += take;
+                    if (have == need) {
+                        mode == Mode::Length ? onLength() : onScalar();
+                    }
+                    break;
+                }
+                case Mode::ExtType:
+                    onExtType(chunk[i++]);
+                    break;
+                case Mode::StringBody: {
+                    size_t take = static_cast<size_t>(
+                        std::min<uint64_t>(payload_remaining, chunk.size() - i));
+                    consumeUtf8(chunk.data() + i, take);
+                    payload_remaining -= take;
+                    i += take;
+                    if (payload_remaining == 0 && !dead) {
+                        if (utf8_remaining != 0) {
+                            fail("Invalid UTF-8 string");
+                            break;
+                        }
+                        valueComplete();
+                    }
+                    break;
+                }
+                case Mode::SkipBody: {
+                    size_t take = static_cast<size_t>(
+                        std::min<uint64_t>(payload_remaining, chunk.size() - i));
+                    payload_remaining -= take;
+                    i += take;
+                    if (payload_remaining == 0) {
+                        valueComplete();
+                    }
+                    break;
+                }
+            }
+        }
+        return !dead;
+    }
+
+    ValidationResult finish() {
+        if (!dead) {
+            if (total_bytes == 0) {
+                fail("Empty data");
+            } else if (mode != Mode::Marker || !stack.empty()) {
+                fail("Truncated data: stream ended mid-value");
+            }
+        }
+        return result;
+    }
+
+    bool ok() const { return !dead; }
+
+    ValidationOptions options;
+    ValidationResult result;
+
+private:
+    // The scanner is a marker-level state machine: headers and numeric
+    // scalars are accumulated byte-wise into `accum`, payloads are only
+    // counted down (strings additionally through the incremental UTF-8
+    // checker), and open containers live on `stack` as a value countdown.
+    enum class Mode { Marker, Length, Scalar, ExtType, StringBody, SkipBody };
+
+    struct Frame {
+        bool is_map;
+        uint64_t remaining;  // Values still expected; map entries count as two.
+    };
+
+    void fail(const std::string& error) {
+        result.addError(error);
+        dead = true;
+    }
+
+    void onMarker(uint8_t m) {
+        if (!stack.empty() && stack.back().is_map && stack.back().remaining % 2 == 0) {
+            bool is_str = (m >= 0xa0 && m <= 0xbf) || m == 0xd9 || m == 0xda || m == 0xdb;
+            if (!is_str) {
+                fail("Map key is not a string");
+                return;
+            }
+        }
+        cur_marker = m;
+
+        if (m <= 0x7f || m >= 0xe0) { valueComplete(); return; }
+        if (m >= 0x80 && m <= 0x8f) { openContainer(true, m & 0x0f); return; }
+        if (m >= 0x90 && m <= 0x9f) { openContainer(false, m & 0x0f); return; }
+        if (m >= 0xa0 && m <= 0xbf) { beginString(m & 0x1f); return; }
+
+        switch (m) {
+            case 0xc0: case 0xc2: case 0xc3: valueComplete(); return;
+            case 0xc4: case 0xc5: case 0xc6: beginLength(size_t{1} << (m - 0xc4)); return;
+            case 0xc7: case 0xc8: case 0xc9: beginLength(size_t{1} << (m - 0xc7)); return;
+            case 0xca: beginScalar(4); return;
+            case 0xcb: beginScalar(8); return;
+            case 0xcc: case 0xcd: case 0xce: case 0xcf: beginScalar(size_t{1} << (m - 0xcc)); return;
+            case 0xd0: case 0xd1: case 0xd2: case 0xd3: beginScalar(size_t{1} << (m - 0xd0)); return;
+            case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8:
+                payload_remaining = uint64_t{1} << (m - 0xd4);
+                mode = Mode::ExtType;
+                return;
+            case 0xd9: case 0xda: case 0xdb: beginLength(size_t{1} << (m - 0xd9)); return;
+            case 0xdc: beginLength(2); return;
+            case 0xdd: beginLength(4); return;
+            case 0xde: beginLength(2); return;
+            case 0xdf: beginLength(4); return;
+            default: fail("Unknown marker"); return;  // 0xc1
+        }
+    }
+
+    void beginLength(size_t bytes) {
+        accum = 0;
+        need = bytes;
+        have = 0;
+        mode = Mode::Length;
+    }
+
+    void beginScalar(size_t bytes) {
+        accum = 0;
+        need = bytes;
+        have = 0;
+        mode = Mode::Scalar;
+    }
+
+    void beginSkip(uint64_t bytes) {
+        if (bytes == 0) {
+            valueComplete();
+            return;
+        }
+        payload_remaining = bytes;
+        mode = Mode::SkipBody;
+    }
+
+    void beginString(uint64_t len) {
+        if (len > options.max_string_length) {
+            fail("String exceeds maximum length");
+            return;
+        }
+        if (options.collect_stats && result.stats) {
+            result.stats->string_count++;
+            result.stats->largest_string =
+                std::max<size_t>(result.stats->largest_string, len);
+        }
+        if (len == 0) {
+            valueComplete();
+            return;
+        }
+        if (!options.require_utf8_strings) {
+            beginSkip(len);
+            return;
+        }
+        utf8_remaining = 0;
+        utf8_next_min = 0x80;
+        utf8_next_max = 0xBF;
+        payload_remaining = len;
+        mode = Mode::StringBody;
+    }
+
+    void openContainer(bool is_map, uint64_t len) {
+        if (is_map) {
+            if (len > options.max_map_size) {
+                fail("Map exceeds maximum size");
+                return;
+            }
+        } else if (len > options.max_array_size) {
+            fail("Array exceeds maximum size");
+            return;
+        }
+        if (options.collect_stats && result.stats) {
+            if (is_map) {
+                result.stats->map_count++;
+                result.stats->largest_map = std::max<size_t>(result.stats->largest_map, len);
+            } else {
+                result.stats->array_count++;
+                result.stats->largest_array = std::max<size_t>(result.stats->largest_array, len);
+            }
+            result.stats->max_depth_reached =
+                std::max(result.stats->max_depth_reached, stack.size());
+        }
+        if (len > 0 && stack.size() >= options.max_depth) {
+            fail("Maximum nesting depth exceeded");
+            return;
+        }
+        if (len == 0) {
+            valueComplete();
+            return;
+        }
+        stack.push_back({is_map, is_map ? len * 2 : len});
+        mode = Mode::Marker;
+    }
+
+    void onLength() {
+        uint64_t len = accum;
+        switch (cur_marker) {
+            case 0xc4: case 0xc5: case 0xc6:
+                if (len > options.max_binary_length) {
+                    fail("Binary data exceeds maximum length");
+                    return;
+                }
+                if (options.collect_stats && result.stats) {
+                    result.stats->binary_count++;
+                    result.stats->largest_binary =
+                        std::max<size_t>(result.stats->largest_binary, len);
+                }
+                beginSkip(len);
+                return;
+            case 0xc7: case 0xc8: case 0xc9:
+                payload_remaining = len;
+                mode = Mode::ExtType;
+                return;
+            case 0xd9: case 0xda: case 0xdb:
+                beginString(len);
+                return;
+            case 0xdc: case 0xdd:
+                openContainer(false, len);
+                return;
+            case 0xde: case 0xdf:
+                openContainer(true, len);
+                return;
+            default:
+                fail("Unknown marker");
+                return;
+        }
+    }
+
+    void onScalar() {
+        if (cur_marker == 0xca) {
+            uint32_t bits = static_cast<uint32_t>(accum);
+            float f;
+            std::memcpy(&f, &bits, 4);
+            if (!TypeValidator::validateFloat(f, options.allow_nan_float,
+                                              options.allow_inf_float)) {
+                fail("Invalid float value");
+                return;
+            }
+        } else if (cur_marker == 0xcb) {
+            uint64_t bits = accum;
+            double d;
+            std::memcpy(&d, &bits, 8);
+            if (!TypeValidator::validateFloat(d, options.allow_nan_float,
+                                              options.allow_inf_float)) {
+                fail("Invalid float value");
+                return;
+            }
+        }
+        valueComplete();
+    }
+
+    void onExtType(uint8_t type_byte) {
+        if (options.validate_extension_types) {
+            Extension ext;
+            ext.type = static_cast<int8_t>(type_byte);
+            if (!TypeValidator::validateExtension(ext)) {
+                fail("Invalid extension type: " + std::to_string(ext.type));
+                return;
+            }
+        }
+        beginSkip(payload_remaining);
+    }
+
+    /// Incremental UTF-8 check; a sequence may straddle any chunk or
+    /// mode boundary, so only the expected-continuation state is carried.
+    void consumeUtf8(const uint8_t* data, size_t len) {
+        for (size_t j = 0; j < len; ++j) {
+            uint8_t byte = data[j];
+            if (utf8_remaining > 0) {
+                if (byte < utf8_next_min || byte > utf8_next_max) {
+                    fail("Invalid UTF-8 string");
+                    return;
+                }
+                utf8_next_min = 0x80;
+                utf8_next_max = 0xBF;
+                --utf8_remaining;
+                continue;
+            }
+            if (byte < 0x80) continue;
+            if (byte >= 0xC2 && byte <= 0xDF) { utf8_remaining = 1; }
+            else if (byte == 0xE0) { utf8_remaining = 2; utf8_next_min = 0xA0; }
+            else if (byte >= 0xE1 && byte <= 0xEC) { utf8_remaining = 2; }
+            else if (byte == 0xED) { utf8_remaining = 2; utf8_next_max = 0x9F; }
+            else if (byte >= 0xEE && byte <= 0xEF) { utf8_remaining = 2; }
+            else if (byte == 0xF0) { utf8_remaining = 3; utf8_next_min = 0x90; }
+            else if (byte >= 0xF1 && byte <= 0xF3) { utf8_remaining = 3; }
+            else if (byte == 0xF4) { utf8_remaining = 3; utf8_next_max = 0x8F; }
+            else {
+                // C0, C1, F5-FF and bare continuations.
+                fail("Invalid UTF-8 string");
+                return;
+            }
+        }
+    }
+
+    void valueComplete() {
+        mode = Mode::Marker;
+        while (!stack.empty()) {
+            if (--stack.back().remaining > 0) {
+                return;
+            }
+            stack.pop_back();
+        }
+    }
+
+    Mode mode = Mode::Marker;
+    std::vector<Frame> stack;
+    uint64_t total_bytes = 0;
+    uint64_t accum = 0;
+    size_t need = 0;
+    size_t have = 0;
+    uint8_t cur_marker = 0;
+    uint64_t payload_remaining = 0;
+    uint8_t utf8_remaining = 0;
+    uint8_t utf8_next_min = 0x80;
+    uint8_t utf8_next_max = 0xBF;
+    bool dead = false;
+};
+
+StreamingValidator::StreamingValidator(const ValidationOptions& options)
+    : pimpl_(std::make_unique<StreamingValidatorImpl>(options)) {}
+
+StreamingValidator::~StreamingValidator() = default;
+
+bool StreamingValidator::feed(std::span<const uint8_t> chunk) {
+    return pimpl_->feed(chunk);
+}
+
+bool StreamingValidator::ok() const {
+    return pimpl_->ok();
+}
+
+ValidationResult StreamingValidator::finish() {
+    return pimpl_->finish();
+}
+
+void StreamingValidator::reset() {
+    pimpl_->resetState();
+}
+
 } // namespace btoon
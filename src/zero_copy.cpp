@@ -1,7 +1,10 @@
 #include "btoon/zero_copy.h"
 #include "btoon/decoder.h"
 #include "btoon/encoder.h"
+#include "btoon/compression.h"
+#include <zlib.h>  // crc32 for frame checksums
 #include <cstring>
+#include <limits>
 #include <mutex>
 
 #ifdef _WIN32
@@ -22,6 +25,59 @@
 
 namespace btoon {
 
+namespace {
+
+// Big-endian load of n bytes (n <= 8) for the zero-copy decoder.
+uint64_t zc_read_be(const uint8_t* p, size_t n) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; ++i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+}  // namespace
+
+// ===== MapView Implementation =====
+
+// Copies never carry the index over; the copy rebuilds it on first lookup.
+MapView::MapView(const MapView& other) : entries_(other.entries_) {}
+
+MapView& MapView::operator=(const MapView& other) {
+    entries_ = other.entries_;
+    index_.clear();
+    return *this;
+}
+
+const ValueView* MapView::find(std::string_view key) const {
+    if (entries_.size() <= LINEAR_SCAN_MAX) {
+        // Scan backwards so the last occurrence of a duplicate key wins,
+        // like Decoder's map insertion.
+        for (size_t i = entries_.size(); i-- > 0;) {
+            if (entries_[i].first == key) {
+                return &entries_[i].second;
+            }
+        }
+        return nullptr;
+    }
+    if (index_.empty()) {
+        index_.reserve(entries_.size());
+        // Walk forwards so the last occurrence of a duplicate key wins.
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            index_[entries_[i].first] = i;
+        }
+    }
+    auto it = index_.find(key);
+    return it != index_.end() ? &entries_[it->second].second : nullptr;
+}
+
+const ValueView& MapView::at(std::string_view key) const {
+    if (const ValueView* value = find(key)) {
+        return *value;
+    }
+    throw BtoonException("Map key not found: " + std::string(key));
+}
+
 // ===== ZeroCopyDecoder Implementation =====
 
 ValueView ZeroCopyDecoder::decode(const MemoryView& view) {
@@ -61,7 +117,46 @@ ValueView ZeroCopyDecoder::decodeValue(const uint8_t* data, size_t size,
         case 0xc0: return Nil{};
         case 0xc2: return Bool(false);
         case 0xc3: return Bool(true);
-        
+
+        // Fixed-width numerics
+        case 0xcc: case 0xcd: case 0xce: case 0xcf: {  // uint8-64
+            size_t n = size_t{1} << (type - 0xcc);
+            if (pos + n > size) throw BtoonException("Buffer underflow");
+            Uint value = zc_read_be(data + pos, n);
+            pos += n;
+            return value;
+        }
+
+        case 0xd0: case 0xd1: case 0xd2: case 0xd3: {  // int8-64
+            size_t n = size_t{1} << (type - 0xd0);
+            if (pos + n > size) throw BtoonException("Buffer underflow");
+            uint64_t raw = zc_read_be(data + pos, n);
+            pos += n;
+            // Sign-extend from the encoded width
+            if (n < 8 && (raw & (uint64_t{1} << (n * 8 - 1)))) {
+                raw |= ~((uint64_t{1} << (n * 8)) - 1);
+            }
+            return static_cast<Int>(raw);
+        }
+
+        case 0xca: {  // float32
+            if (pos + 4 > size) throw BtoonException("Buffer underflow");
+            uint32_t bits = static_cast<uint32_t>(zc_read_be(data + pos, 4));
+            pos += 4;
+            float value;
+            std::memcpy(&value, &bits, 4);
+            return static_cast<Float>(value);
+        }
+
+        case 0xcb: {  // float64
+            if (pos + 8 > size) throw BtoonException("Buffer underflow");
+            uint64_t bits = zc_read_be(data + pos, 8);
+            pos += 8;
+            Float value;
+            std::memcpy(&value, &bits, 8);
+            return value;
+        }
+
         // Strings - return string_view instead of copying
         default:
             break;
@@ -117,15 +212,45 @@ ValueView ZeroCopyDecoder::decodeValue(const uint8_t* data, size_t size,
             pos += len;
             return bin;
         }
-        
-        // Simplified - full implementation would handle all other types
+
+        case 0xdb: {  // str32
+            if (pos + 4 > size) throw BtoonException("Buffer underflow");
+            size_t len = static_cast<size_t>(zc_read_be(data + pos, 4));
+            pos += 4;
+            if (pos + len > size) throw BtoonException("Buffer underflow");
+            std::string_view str(reinterpret_cast<const char*>(data + pos), len);
+            pos += len;
+            return str;
+        }
+
+        case 0xc6: {  // bin32
+            if (pos + 4 > size) throw BtoonException("Buffer underflow");
+            size_t len = static_cast<size_t>(zc_read_be(data + pos, 4));
+            pos += 4;
+            if (pos + len > size) throw BtoonException("Buffer underflow");
+            std::span<const uint8_t> bin(data + pos, len);
+            pos += len;
+            return bin;
+        }
+
         default:
             break;
     }
     
-    // fixarray (0x90 - 0x9f)
-    if (type >= 0x90 && type <= 0x9f) {
-        size_t count = type & 0x0f;
+    // Arrays: fixarray (0x90 - 0x9f), array16, array32
+    if ((type >= 0x90 && type <= 0x9f) || type == 0xdc || type == 0xdd) {
+        size_t count;
+        if (type == 0xdc) {
+            if (pos + 2 > size) throw BtoonException("Buffer underflow");
+            count = static_cast<size_t>(zc_read_be(data + pos, 2));
+            pos += 2;
+        } else if (type == 0xdd) {
+            if (pos + 4 > size) throw BtoonException("Buffer underflow");
+            count = static_cast<size_t>(zc_read_be(data + pos, 4));
+            pos += 4;
+        } else {
+            count = type & 0x0f;
+        }
         std::vector<ValueView> arr;
         arr.reserve(count);
         for (size_t i = 0; i < count; i++) {
@@ -133,26 +258,661 @@ ValueView ZeroCopyDecoder::decodeValue(const uint8_t* data, size_t size,
         }
         return arr;
     }
-    
-    // fixmap (0x80 - 0x8f)
-    if (type >= 0x80 && type <= 0x8f) {
-        size_t count = type & 0x0f;
-        std::unordered_map<std::string_view, ValueView> map;
+
+    // Maps: fixmap (0x80 - 0x8f), map16, map32
+    if ((type >= 0x80 && type <= 0x8f) || type == 0xde || type == 0xdf) {
+        size_t count;
+        if (type == 0xde) {
+            if (pos + 2 > size) throw BtoonException("Buffer underflow");
+            count = static_cast<size_t>(zc_read_be(data + pos, 2));
+            pos += 2;
+        } else if (type == 0xdf) {
+            if (pos + 4 > size) throw BtoonException("Buffer underflow");
+            count = static_cast<size_t>(zc_read_be(data + pos, 4));
+            pos += 4;
+        } else {
+            count = type & 0x0f;
+        }
+        MapView map;
+        map.reserve(count);
         for (size_t i = 0; i < count; i++) {
             auto key = decodeValue(data, size, pos, depth + 1);
             auto value = decodeValue(data, size, pos, depth + 1);
             if (auto* str_key = std::get_if<std::string_view>(&key)) {
-                map[*str_key] = std::move(value);
+                map.emplace_back(*str_key, std::move(value));
             } else {
                 throw BtoonException("Map key must be string");
             }
         }
         return map;
     }
-    
+
+    // Extensions: fixext1-16 (0xd4 - 0xd8), ext8/16/32. Timestamps map to
+    // the Timestamp alternative; any other type comes back as a generic
+    // Extension (the payload is copied, the one non-view case).
+    if ((type >= 0xd4 && type <= 0xd8) || type == 0xc7 || type == 0xc8 || type == 0xc9) {
+        size_t len;
+        if (type >= 0xd4 && type <= 0xd8) {
+            len = size_t{1} << (type - 0xd4);
+        } else if (type == 0xc7) {
+            if (pos + 1 > size) throw BtoonException("Buffer underflow");
+            len = data[pos++];
+        } else if (type == 0xc8) {
+            if (pos + 2 > size) throw BtoonException("Buffer underflow");
+            len = static_cast<size_t>(zc_read_be(data + pos, 2));
+            pos += 2;
+        } else {
+            if (pos + 4 > size) throw BtoonException("Buffer underflow");
+            len = static_cast<size_t>(zc_read_be(data + pos, 4));
+            pos += 4;
+        }
+        if (pos + 1 > size) throw BtoonException("Buffer underflow");
+        int8_t ext_type = static_cast<int8_t>(data[pos++]);
+        if (pos + len > size) throw BtoonException("Buffer underflow");
+
+        if (ext_type == -1) {  // Timestamp
+            if (len == 4 || len == 8) {
+                int64_t seconds = static_cast<int64_t>(zc_read_be(data + pos, len));
+                pos += len;
+                return Timestamp(seconds);
+            } else if (len == 12 || len == 14) {
+                int64_t seconds = static_cast<int64_t>(zc_read_be(data + pos, 8));
+                uint32_t nanoseconds = static_cast<uint32_t>(zc_read_be(data + pos + 8, 4));
+                if (len == 14) {
+                    int16_t tz = static_cast<int16_t>(zc_read_be(data + pos + 12, 2));
+                    pos += len;
+                    return Timestamp(seconds, nanoseconds, tz);
+                }
+                pos += len;
+                return Timestamp(seconds, nanoseconds);
+            }
+            throw BtoonException("Invalid timestamp length");
+        }
+
+        Extension ext;
+        ext.type = ext_type;
+        ext.data.assign(data + pos, data + pos + len);
+        pos += len;
+        return ext;
+    }
+
     throw BtoonException("Unsupported type in zero-copy decoder");
 }
 
+TabularView ZeroCopyDecoder::decode_tabular(const MemoryView& view) {
+    return TabularView::open(view);
+}
+
+// ===== TabularView Implementation =====
+
+namespace {
+
+// Big-endian load of n bytes (n <= 8).
+uint64_t tabular_read_be(const uint8_t* p, size_t n) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; ++i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+uint32_t tabular_read_u32(std::span<const uint8_t> ext, size_t& p, const char* what) {
+    if (p + 4 > ext.size()) {
+        throw BtoonException(std::string("Buffer underflow in tabular ") + what);
+    }
+    uint32_t v = static_cast<uint32_t>(tabular_read_be(&ext[p], 4));
+    p += 4;
+    return v;
+}
+
+// Locate the extension body of a tabular payload; returns an empty span if
+// the buffer is not a columnar extension at all.
+std::span<const uint8_t> tabular_ext_body(std::span<const uint8_t> buffer) {
+    size_t pos = 0;
+    if (buffer.size() < 2) {
+        return {};
+    }
+    uint8_t marker = buffer[pos++];
+    size_t len = 0;
+    if (marker == 0xc7) {
+        if (pos + 1 > buffer.size()) return {};
+        len = buffer[pos];
+        pos += 1;
+    } else if (marker == 0xc8) {
+        if (pos + 2 > buffer.size()) return {};
+        len = tabular_read_be(&buffer[pos], 2);
+        pos += 2;
+    } else if (marker == 0xc9) {
+        if (pos + 4 > buffer.size()) return {};
+        len = tabular_read_be(&buffer[pos], 4);
+        pos += 4;
+    } else {
+        return {};
+    }
+    if (pos >= buffer.size() || static_cast<int8_t>(buffer[pos]) != -10) {
+        return {};
+    }
+    pos += 1;
+    if (len == 0 || pos + len > buffer.size()) {
+        return {};
+    }
+    return buffer.subspan(pos, len);
+}
+
+} // namespace
+
+bool TabularView::is_tabular(std::span<const uint8_t> buffer) {
+    return !tabular_ext_body(buffer).empty();
+}
+
+TabularView TabularView::open(std::span<const uint8_t> buffer) {
+    std::span<const uint8_t> ext = tabular_ext_body(buffer);
+    if (ext.empty()) {
+        throw BtoonException("Not a tabular payload");
+    }
+
+    size_t p = 0;
+    uint32_t version = tabular_read_u32(ext, p, "version");
+    if (version < 1 || version > 4) {
+        throw BtoonException("Unsupported tabular version");
+    }
+    if (version == 2) {
+        throw BtoonException("Chunked tabular payloads cannot be viewed zero-copy");
+    }
+    uint32_t num_columns = tabular_read_u32(ext, p, "num_columns");
+    uint32_t num_rows = tabular_read_u32(ext, p, "num_rows");
+
+    std::vector<Column> columns(num_columns);
+    for (uint32_t i = 0; i < num_columns; ++i) {
+        uint32_t name_len = tabular_read_u32(ext, p, "column name length");
+        if (name_len > ext.size() || p > ext.size() - name_len) {
+            throw BtoonException("Buffer underflow in tabular column name");
+        }
+        columns[i].name = std::string_view(reinterpret_cast<const char*>(&ext[p]), name_len);
+        p += name_len;
+    }
+    if (p + num_columns > ext.size()) {
+        throw BtoonException("Buffer underflow in tabular column types");
+    }
+    for (uint32_t i = 0; i < num_columns; ++i) {
+        uint8_t type = ext[p + i];
+        if (type > 5) {
+            throw BtoonException("Invalid tabular column type");
+        }
+        columns[i].type = static_cast<ColumnType>(type);
+    }
+    p += num_columns;
+
+    if (version == 3 || version == 4) {
+        // The offset table enables random access, but a full view walks the
+        // size-prefixed entries sequentially anyway.
+        if (p + static_cast<size_t>(num_columns) * 4 > ext.size()) {
+            throw BtoonException("Buffer underflow in tabular offset table");
+        }
+        p += static_cast<size_t>(num_columns) * 4;
+    }
+
+    for (uint32_t i = 0; i < num_columns; ++i) {
+        uint32_t column_size = tabular_read_u32(ext, p, "column data size");
+        if (column_size > ext.size() || p > ext.size() - column_size) {
+            throw BtoonException("Buffer underflow in tabular column data");
+        }
+        std::span<const uint8_t> entry = ext.subspan(p, column_size);
+        if (version == 4) {
+            if (entry.empty() || !(entry[0] & 0x01)) {
+                throw BtoonException("Tabular bitmap column missing validity bitmap");
+            }
+            size_t bitmap_bytes = (num_rows + 7) / 8;
+            if (1 + bitmap_bytes > entry.size()) {
+                throw BtoonException("Buffer underflow in tabular validity bitmap");
+            }
+            columns[i].packed_float = (entry[0] & 0x02) != 0;
+            columns[i].bitmap = entry.subspan(1, bitmap_bytes);
+            columns[i].values = entry.subspan(1 + bitmap_bytes);
+        } else {
+            columns[i].values = entry;
+        }
+        p += column_size;
+    }
+
+    return TabularView(version, num_rows, std::move(columns));
+}
+
+size_t TabularView::column_index(std::string_view name) const {
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        if (columns_[i].name == name) {
+            return i;
+        }
+    }
+    throw BtoonException("Unknown tabular column: " + std::string(name));
+}
+
+bool TabularView::rowValid(const Column& column, size_t row) const {
+    if (column.bitmap.empty()) {
+        return true;
+    }
+    return (column.bitmap[row / 8] >> (row % 8)) & 1u;
+}
+
+std::span<const int64_t> TabularView::int64_column(size_t col, std::vector<int64_t>& storage) const {
+    const Column& column = columns_.at(col);
+    storage.clear();
+    storage.reserve(num_rows_);
+    std::span<const uint8_t> values = column.values;
+    size_t pos = 0;
+    for (size_t row = 0; row < num_rows_; ++row) {
+        if (!rowValid(column, row)) {
+            storage.push_back(0);
+            continue;
+        }
+        if (pos >= values.size()) {
+            throw BtoonException("Buffer underflow in tabular column data");
+        }
+        uint8_t marker = values[pos++];
+        if (marker <= 0x7f) {
+            storage.push_back(static_cast<int64_t>(marker));
+        } else if (marker >= 0xe0) {
+            storage.push_back(static_cast<int8_t>(marker));
+        } else if (marker >= 0xd0 && marker <= 0xd3) {
+            size_t width = size_t{1} << (marker - 0xd0);
+            if (pos + width > values.size()) {
+                throw BtoonException("Buffer underflow in tabular column data");
+            }
+            uint64_t bits = tabular_read_be(&values[pos], width);
+            pos += width;
+            // Sign-extend from the stored width.
+            size_t shift = 64 - width * 8;
+            storage.push_back(static_cast<int64_t>(bits << shift) >> shift);
+        } else if (marker >= 0xcc && marker <= 0xcf) {
+            size_t width = size_t{1} << (marker - 0xcc);
+            if (pos + width > values.size()) {
+                throw BtoonException("Buffer underflow in tabular column data");
+            }
+            storage.push_back(static_cast<int64_t>(tabular_read_be(&values[pos], width)));
+            pos += width;
+        } else {
+            throw BtoonException("Tabular column cell is not integral");
+        }
+    }
+    return storage;
+}
+
+std::span<const uint64_t> TabularView::uint64_column(size_t col, std::vector<uint64_t>& storage) const {
+    const Column& column = columns_.at(col);
+    storage.clear();
+    storage.reserve(num_rows_);
+    std::span<const uint8_t> values = column.values;
+    size_t pos = 0;
+    for (size_t row = 0; row < num_rows_; ++row) {
+        if (!rowValid(column, row)) {
+            storage.push_back(0);
+            continue;
+        }
+        if (pos >= values.size()) {
+            throw BtoonException("Buffer underflow in tabular column data");
+        }
+        uint8_t marker = values[pos++];
+        if (marker <= 0x7f) {
+            storage.push_back(marker);
+        } else if (marker >= 0xcc && marker <= 0xcf) {
+            size_t width = size_t{1} << (marker - 0xcc);
+            if (pos + width > values.size()) {
+                throw BtoonException("Buffer underflow in tabular column data");
+            }
+            storage.push_back(tabular_read_be(&values[pos], width));
+            pos += width;
+        } else {
+            throw BtoonException("Tabular column cell is not an unsigned integer");
+        }
+    }
+    return storage;
+}
+
+std::span<const double> TabularView::float64_column(size_t col, std::vector<double>& storage) const {
+    const Column& column = columns_.at(col);
+    storage.clear();
+    storage.reserve(num_rows_);
+    std::span<const uint8_t> values = column.values;
+    size_t pos = 0;
+    for (size_t row = 0; row < num_rows_; ++row) {
+        if (!rowValid(column, row)) {
+            storage.push_back(std::numeric_limits<double>::quiet_NaN());
+            continue;
+        }
+        if (column.packed_float) {
+            // Packed v4 layout: raw big-endian doubles at a fixed stride.
+            if (pos + 8 > values.size()) {
+                throw BtoonException("Buffer underflow in tabular column data");
+            }
+            uint64_t bits = tabular_read_be(&values[pos], 8);
+            pos += 8;
+            double d;
+            std::memcpy(&d, &bits, 8);
+            storage.push_back(d);
+            continue;
+        }
+        if (pos >= values.size()) {
+            throw BtoonException("Buffer underflow in tabular column data");
+        }
+        uint8_t marker = values[pos++];
+        if (marker == 0xcb) {
+            if (pos + 8 > values.size()) {
+                throw BtoonException("Buffer underflow in tabular column data");
+            }
+            uint64_t bits = tabular_read_be(&values[pos], 8);
+            pos += 8;
+            double d;
+            std::memcpy(&d, &bits, 8);
+            storage.push_back(d);
+        } else if (marker == 0xca) {
+            if (pos + 4 > values.size()) {
+                throw BtoonException("Buffer underflow in tabular column data");
+            }
+            uint32_t bits = static_cast<uint32_t>(tabular_read_be(&values[pos], 4));
+            pos += 4;
+            float f;
+            std::memcpy(&f, &bits, 4);
+            storage.push_back(f);
+        } else {
+            throw BtoonException("Tabular column cell is not a float");
+        }
+    }
+    return storage;
+}
+
+std::vector<std::string_view> TabularView::string_column(size_t col) const {
+    const Column& column = columns_.at(col);
+    std::vector<std::string_view> out;
+    out.reserve(num_rows_);
+    std::span<const uint8_t> values = column.values;
+    size_t pos = 0;
+    for (size_t row = 0; row < num_rows_; ++row) {
+        if (!rowValid(column, row)) {
+            out.emplace_back();
+            continue;
+        }
+        if (pos >= values.size()) {
+            throw BtoonException("Buffer underflow in tabular column data");
+        }
+        uint8_t marker = values[pos++];
+        size_t len = 0;
+        if (marker >= 0xa0 && marker <= 0xbf) {
+            len = marker & 0x1f;
+        } else if (marker == 0xd9) {
+            if (pos + 1 > values.size()) {
+                throw BtoonException("Buffer underflow in tabular column data");
+            }
+            len = values[pos];
+            pos += 1;
+        } else if (marker == 0xda) {
+            if (pos + 2 > values.size()) {
+                throw BtoonException("Buffer underflow in tabular column data");
+            }
+            len = tabular_read_be(&values[pos], 2);
+            pos += 2;
+        } else if (marker == 0xdb) {
+            if (pos + 4 > values.size()) {
+                throw BtoonException("Buffer underflow in tabular column data");
+            }
+            len = tabular_read_be(&values[pos], 4);
+            pos += 4;
+        } else {
+            throw BtoonException("Tabular column cell is not a string");
+        }
+        if (pos + len > values.size()) {
+            throw BtoonException("Buffer underflow in tabular column data");
+        }
+        out.emplace_back(reinterpret_cast<const char*>(&values[pos]), len);
+        pos += len;
+    }
+    return out;
+}
+
+// ===== IndexedRecordReader Implementation =====
+
+namespace {
+
+constexpr char kSeekIndexMagic[8] = {'B', 'T', 'O', 'N', 'I', 'D', 'X', '1'};
+
+uint64_t seek_index_read_u64(const uint8_t* p) {
+    return tabular_read_be(p, 8);
+}
+
+// Numeric keys compare across Int/Uint/Float (small positive ints decode
+// as Uint, so a caller passing Int(5) must still match); string keys
+// compare lexically. Other key types are not orderable here.
+int compare_record_keys(const Value& a, const Value& b) {
+    const auto* sa = std::get_if<String>(&a);
+    const auto* sb = std::get_if<String>(&b);
+    if (sa && sb) {
+        return sa->compare(*sb) < 0 ? -1 : (*sa == *sb ? 0 : 1);
+    }
+    auto numeric = [](const Value& v, long double& out) {
+        if (const auto* i = std::get_if<Int>(&v)) { out = static_cast<long double>(*i); return true; }
+        if (const auto* u = std::get_if<Uint>(&v)) { out = static_cast<long double>(*u); return true; }
+        if (const auto* f = std::get_if<Float>(&v)) { out = static_cast<long double>(*f); return true; }
+        return false;
+    };
+    long double na, nb;
+    if (numeric(a, na) && numeric(b, nb)) {
+        if (na < nb) return -1;
+        if (na > nb) return 1;
+        return 0;
+    }
+    throw BtoonException("Unsupported key type for indexed lookup");
+}
+
+} // namespace
+
+bool IndexedRecordReader::has_index(std::span<const uint8_t> buffer) {
+    if (buffer.size() < 16) {
+        return false;
+    }
+    if (std::memcmp(&buffer[buffer.size() - 8], kSeekIndexMagic, 8) != 0) {
+        return false;
+    }
+    uint64_t count = seek_index_read_u64(&buffer[buffer.size() - 16]);
+    return count <= (buffer.size() - 16) / 8;
+}
+
+IndexedRecordReader IndexedRecordReader::open(std::span<const uint8_t> buffer) {
+    if (!has_index(buffer)) {
+        throw BtoonException("No seek index footer");
+    }
+    uint64_t count = seek_index_read_u64(&buffer[buffer.size() - 16]);
+    size_t table_start = buffer.size() - 16 - static_cast<size_t>(count) * 8;
+
+    std::vector<uint64_t> offsets;
+    offsets.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t offset = seek_index_read_u64(&buffer[table_start + i * 8]);
+        if (offset >= table_start || (!offsets.empty() && offset <= offsets.back())) {
+            throw BtoonException("Corrupt seek index footer");
+        }
+        offsets.push_back(offset);
+    }
+    return IndexedRecordReader(buffer, table_start, std::move(offsets));
+}
+
+std::span<const uint8_t> IndexedRecordReader::record_bytes(size_t n) const {
+    if (n >= offsets_.size()) {
+        throw BtoonException("Record index out of range");
+    }
+    size_t begin = static_cast<size_t>(offsets_[n]);
+    size_t end = (n + 1 < offsets_.size()) ? static_cast<size_t>(offsets_[n + 1]) : data_end_;
+    return buffer_.subspan(begin, end - begin);
+}
+
+Value IndexedRecordReader::record(size_t n) const {
+    Decoder decoder;
+    return decoder.decode(record_bytes(n));
+}
+
+Value IndexedRecordReader::recordKey(size_t n, std::string_view key) const {
+    Value v = record(n);
+    const auto* map = std::get_if<Map>(&v);
+    if (!map) {
+        throw BtoonException("Indexed record is not a map");
+    }
+    auto it = map->find(std::string(key));
+    if (it == map->end()) {
+        throw BtoonException("Indexed record lacks key field: " + std::string(key));
+    }
+    return it->second;
+}
+
+std::optional<size_t> IndexedRecordReader::find(std::string_view key, const Value& target) const {
+    size_t lo = 0;
+    size_t hi = offsets_.size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (compare_record_keys(recordKey(mid, key), target) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < offsets_.size() && compare_record_keys(recordKey(lo, key), target) == 0) {
+        return lo;
+    }
+    return std::nullopt;
+}
+
+// ===== FramedStreamReader Implementation =====
+
+namespace {
+
+constexpr char kFrameDirectoryMagic[8] = {'B', 'T', 'O', 'N', 'F', 'R', 'M', '1'};
+constexpr size_t kFrameHeaderSize = 24;    // "BTFM" + version/algo/reserved + 4 u32s
+constexpr size_t kFrameDirEntrySize = 24;  // offset u64 + 4 u32s
+
+uint32_t frame_read_u32(const uint8_t* p) {
+    return static_cast<uint32_t>(tabular_read_be(p, 4));
+}
+
+} // namespace
+
+bool FramedStreamReader::has_frames(std::span<const uint8_t> buffer) {
+    if (buffer.size() < 16) {
+        return false;
+    }
+    if (std::memcmp(&buffer[buffer.size() - 8], kFrameDirectoryMagic, 8) != 0) {
+        return false;
+    }
+    uint64_t count = seek_index_read_u64(&buffer[buffer.size() - 16]);
+    return count <= (buffer.size() - 16) / kFrameDirEntrySize;
+}
+
+FramedStreamReader FramedStreamReader::open(std::span<const uint8_t> buffer) {
+    if (!has_frames(buffer)) {
+        throw BtoonException("No frame directory footer");
+    }
+    uint64_t count = seek_index_read_u64(&buffer[buffer.size() - 16]);
+    size_t table_start = buffer.size() - 16 - static_cast<size_t>(count) * kFrameDirEntrySize;
+
+    std::vector<FrameEntry> frames;
+    frames.reserve(count);
+    size_t total_records = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        const uint8_t* entry = &buffer[table_start + i * kFrameDirEntrySize];
+        FrameEntry frame;
+        frame.offset = seek_index_read_u64(entry);
+        frame.compressed_size = frame_read_u32(entry + 8);
+        frame.uncompressed_size = frame_read_u32(entry + 12);
+        frame.checksum = frame_read_u32(entry + 16);
+        frame.record_count = frame_read_u32(entry + 20);
+        frame.first_record = total_records;
+        if (frame.offset + kFrameHeaderSize + frame.compressed_size > table_start ||
+            (!frames.empty() && frame.offset <= frames.back().offset)) {
+            throw BtoonException("Corrupt frame directory footer");
+        }
+        total_records += frame.record_count;
+        frames.push_back(frame);
+    }
+    return FramedStreamReader(buffer, std::move(frames), total_records);
+}
+
+std::vector<uint8_t> FramedStreamReader::frame_payload(size_t n) const {
+    if (n >= frames_.size()) {
+        throw BtoonException("Frame index out of range");
+    }
+    const FrameEntry& frame = frames_[n];
+    const uint8_t* header = &buffer_[static_cast<size_t>(frame.offset)];
+    if (std::memcmp(header, "BTFM", 4) != 0 || header[4] != 1) {
+        throw BtoonException("Corrupt stream frame header");
+    }
+    auto algo = static_cast<CompressionAlgorithm>(header[5]);
+
+    auto stored = buffer_.subspan(
+        static_cast<size_t>(frame.offset) + kFrameHeaderSize, frame.compressed_size);
+    uint32_t actual = static_cast<uint32_t>(
+        ::crc32(::crc32(0L, Z_NULL, 0), stored.data(), static_cast<uInt>(stored.size())));
+    if (actual != frame.checksum) {
+        throw BtoonException("Stream frame checksum mismatch");
+    }
+
+    std::vector<uint8_t> payload;
+    if (algo == CompressionAlgorithm::NONE) {
+        payload.assign(stored.begin(), stored.end());
+    } else {
+        payload = decompress(algo, stored);
+    }
+    if (payload.size() != frame.uncompressed_size) {
+        throw BtoonException("Stream frame size mismatch");
+    }
+    return payload;
+}
+
+const std::vector<uint8_t>& FramedStreamReader::framePayloadCached(size_t n) const {
+    if (cached_frame_ != n) {
+        cached_payload_ = frame_payload(n);
+        cached_frame_ = n;
+    }
+    return cached_payload_;
+}
+
+std::vector<Value> FramedStreamReader::frame_records(size_t n) const {
+    const std::vector<uint8_t>& payload = framePayloadCached(n);
+    std::vector<Value> records;
+    records.reserve(frames_[n].record_count);
+    Decoder decoder;
+    size_t pos = 0;
+    while (pos < payload.size()) {
+        auto [value, consumed] =
+            decoder.decode_and_get_pos(std::span<const uint8_t>(payload).subspan(pos));
+        records.push_back(std::move(value));
+        pos += consumed;
+    }
+    return records;
+}
+
+Value FramedStreamReader::record(size_t n) const {
+    if (n >= total_records_) {
+        throw BtoonException("Record index out of range");
+    }
+    // Last frame whose first_record is <= n.
+    auto it = std::upper_bound(frames_.begin(), frames_.end(), n,
+                               [](size_t idx, const FrameEntry& frame) {
+                                   return idx < frame.first_record;
+                               });
+    size_t frame_index = static_cast<size_t>(it - frames_.begin()) - 1;
+
+    const std::vector<uint8_t>& payload = framePayloadCached(frame_index);
+    Decoder decoder;
+    size_t pos = 0;
+    size_t skip = n - frames_[frame_index].first_record;
+    for (size_t i = 0; i < skip; ++i) {
+        auto [value, consumed] =
+            decoder.decode_and_get_pos(std::span<const uint8_t>(payload).subspan(pos));
+        (void)value;
+        pos += consumed;
+    }
+    auto [value, consumed] =
+        decoder.decode_and_get_pos(std::span<const uint8_t>(payload).subspan(pos));
+    (void)consumed;
+    return value;
+}
+
 // ===== MemoryMappedFile Implementation =====
 
 #ifdef _WIN32
@@ -240,6 +1000,285 @@ MemoryMappedFile::~MemoryMappedFile() {
 
 #endif
 
+// ===== MappedFileSink Implementation =====
+
+/**
+ * Streambuf whose put area is the mapped file itself. Every character the
+ * stream writes goes straight into the mapping; overflow grows the file
+ * and remaps, then restores the put position.
+ */
+class MappedFileSink::MappedStreamBuf : public std::streambuf {
+public:
+    MappedStreamBuf(const std::string& path, size_t initial_capacity) {
+        if (initial_capacity == 0) {
+            initial_capacity = 1;
+        }
+        openFile(path);
+        try {
+            mapFile(initial_capacity);
+        } catch (...) {
+            // The destructor of a partially constructed streambuf never
+            // runs, so close the file handle here or it leaks.
+            closeFile();
+            throw;
+        }
+        setPutPos(0);
+    }
+
+    ~MappedStreamBuf() override {
+        try {
+            finish();
+        } catch (...) {
+            // Destructors must not throw; the file keeps its last good state.
+        }
+    }
+
+    void finish() {
+        if (finished_) {
+            return;
+        }
+        final_size_ = written();
+        finished_ = true;
+        unmapAndTrim(final_size_);
+        setp(nullptr, nullptr);
+    }
+
+    size_t bytes_written() const {
+        return finished_ ? final_size_ : written();
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) {
+            return traits_type::not_eof(ch);
+        }
+        grow(capacity_ + 1);
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+        return ch;
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        size_t count = static_cast<size_t>(n);
+        size_t used = written();
+        if (count > capacity_ - used) {
+            grow(used + count);
+        }
+        std::memcpy(static_cast<char*>(map_) + used, s, count);
+        setPutPos(used + count);
+        return n;
+    }
+
+    // Only tellp() is supported; StreamEncoder uses it for seek index
+    // and frame directory offsets.
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which) override {
+        if ((which & std::ios_base::out) && dir == std::ios_base::cur && off == 0) {
+            return pos_type(static_cast<off_type>(written()));
+        }
+        return pos_type(off_type(-1));
+    }
+
+private:
+    size_t written() const {
+        return static_cast<size_t>(pptr() - pbase());
+    }
+
+    // Re-anchor the put area to the mapping with pos bytes already used.
+    void setPutPos(size_t pos) {
+        char* base = static_cast<char*>(map_);
+        setp(base, base + capacity_);
+        while (pos > 0) {
+            constexpr size_t max_step = static_cast<size_t>(std::numeric_limits<int>::max());
+            int step = pos > max_step ? std::numeric_limits<int>::max()
+                                      : static_cast<int>(pos);
+            pbump(step);
+            pos -= static_cast<size_t>(step);
+        }
+    }
+
+    void grow(size_t min_capacity) {
+        size_t used = written();
+        size_t new_capacity = capacity_;
+        while (new_capacity < min_capacity) {
+            new_capacity *= 2;
+        }
+        remapFile(new_capacity);
+        setPutPos(used);
+    }
+
+    void openFile(const std::string& path);
+    void closeFile();                    // closes the handle without trimming
+    void mapFile(size_t capacity);       // (re)creates the mapping at capacity
+    void remapFile(size_t new_capacity); // grows the file and remaps
+    void unmapAndTrim(size_t final_size);
+
+    void* map_ = nullptr;
+    size_t capacity_ = 0;
+    size_t final_size_ = 0;
+    bool finished_ = false;
+
+#ifdef _WIN32
+    void* file_ = nullptr;     // HANDLE
+    void* mapping_ = nullptr;  // HANDLE
+#else
+    int fd_ = -1;
+#endif
+};
+
+#ifdef _WIN32
+
+void MappedFileSink::MappedStreamBuf::openFile(const std::string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0,
+                              nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw BtoonException("Failed to create file for mapped writing: " + path);
+    }
+    file_ = file;
+}
+
+void MappedFileSink::MappedStreamBuf::closeFile() {
+    if (mapping_) {
+        CloseHandle(static_cast<HANDLE>(mapping_));
+        mapping_ = nullptr;
+    }
+    if (file_) {
+        CloseHandle(static_cast<HANDLE>(file_));
+        file_ = nullptr;
+    }
+}
+
+void MappedFileSink::MappedStreamBuf::mapFile(size_t capacity) {
+    LARGE_INTEGER li;
+    li.QuadPart = static_cast<LONGLONG>(capacity);
+    if (!SetFilePointerEx(static_cast<HANDLE>(file_), li, nullptr, FILE_BEGIN) ||
+        !SetEndOfFile(static_cast<HANDLE>(file_))) {
+        throw BtoonException("Failed to extend mapped file");
+    }
+    HANDLE mapping = CreateFileMappingA(static_cast<HANDLE>(file_), nullptr,
+                                        PAGE_READWRITE, li.HighPart, li.LowPart, nullptr);
+    if (mapping == nullptr) {
+        throw BtoonException("Failed to create writable file mapping");
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, capacity);
+    if (data == nullptr) {
+        CloseHandle(mapping);
+        throw BtoonException("Failed to map file for writing");
+    }
+    mapping_ = mapping;
+    map_ = data;
+    capacity_ = capacity;
+}
+
+void MappedFileSink::MappedStreamBuf::remapFile(size_t new_capacity) {
+    UnmapViewOfFile(map_);
+    CloseHandle(static_cast<HANDLE>(mapping_));
+    map_ = nullptr;
+    mapping_ = nullptr;
+    mapFile(new_capacity);
+}
+
+void MappedFileSink::MappedStreamBuf::unmapAndTrim(size_t final_size) {
+    if (map_) {
+        UnmapViewOfFile(map_);
+        map_ = nullptr;
+    }
+    if (mapping_) {
+        CloseHandle(static_cast<HANDLE>(mapping_));
+        mapping_ = nullptr;
+    }
+    if (file_) {
+        LARGE_INTEGER li;
+        li.QuadPart = static_cast<LONGLONG>(final_size);
+        SetFilePointerEx(static_cast<HANDLE>(file_), li, nullptr, FILE_BEGIN);
+        SetEndOfFile(static_cast<HANDLE>(file_));
+        CloseHandle(static_cast<HANDLE>(file_));
+        file_ = nullptr;
+    }
+}
+
+#else  // POSIX
+
+void MappedFileSink::MappedStreamBuf::openFile(const std::string& path) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        throw BtoonException("Failed to create file for mapped writing: " + path);
+    }
+}
+
+void MappedFileSink::MappedStreamBuf::closeFile() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+void MappedFileSink::MappedStreamBuf::mapFile(size_t capacity) {
+    if (ftruncate(fd_, static_cast<off_t>(capacity)) < 0) {
+        throw BtoonException("Failed to extend mapped file");
+    }
+    void* data = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+        throw BtoonException("Failed to map file for writing");
+    }
+    map_ = data;
+    capacity_ = capacity;
+}
+
+void MappedFileSink::MappedStreamBuf::remapFile(size_t new_capacity) {
+    if (ftruncate(fd_, static_cast<off_t>(new_capacity)) < 0) {
+        throw BtoonException("Failed to extend mapped file");
+    }
+#ifdef __linux__
+    void* data = mremap(map_, capacity_, new_capacity, MREMAP_MAYMOVE);
+    if (data == MAP_FAILED) {
+        throw BtoonException("Failed to remap file for writing");
+    }
+#else
+    munmap(map_, capacity_);
+    void* data = mmap(nullptr, new_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+        map_ = nullptr;
+        throw BtoonException("Failed to remap file for writing");
+    }
+#endif
+    map_ = data;
+    capacity_ = new_capacity;
+}
+
+void MappedFileSink::MappedStreamBuf::unmapAndTrim(size_t final_size) {
+    if (map_) {
+        munmap(map_, capacity_);
+        map_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        if (ftruncate(fd_, static_cast<off_t>(final_size)) < 0) {
+            ::close(fd_);
+            fd_ = -1;
+            throw BtoonException("Failed to trim mapped file");
+        }
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+#endif
+
+MappedFileSink::MappedFileSink(const std::string& path, size_t initial_capacity)
+    : buf_(std::make_unique<MappedStreamBuf>(path, initial_capacity)),
+      stream_(buf_.get()) {}
+
+MappedFileSink::~MappedFileSink() = default;
+
+void MappedFileSink::finish() {
+    stream_.flush();
+    buf_->finish();
+}
+
+size_t MappedFileSink::bytes_written() const {
+    return buf_->bytes_written();
+}
+
 // ===== SharedMemoryBuffer Implementation =====
 
 #ifdef _WIN32
@@ -0,0 +1,225 @@
+/**
+ * Comparative serialization benchmarks: the same datasets run through
+ * BTOON (row-wise and columnar), MessagePack, and JSON text, reporting
+ * encode/decode throughput and encoded size side by side. MessagePack
+ * and JSON go through the vendored nlohmann implementation, which keeps
+ * the comparison dependency-free and uses the same document model for
+ * both baselines.
+ */
+#include <benchmark/benchmark.h>
+#include "btoon/btoon.h"
+#include "nlohmann/json.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace btoon;
+using json = nlohmann::json;
+
+namespace {
+
+// --- Datasets ---
+//
+// Built as JSON documents first so every format serializes exactly the
+// same logical content; the BTOON value is converted from the JSON tree.
+
+enum Dataset : int64_t { kRpc = 0, kTabular = 1, kTimeseries = 2 };
+
+// Nested RPC-style batch, the shape of a service request log.
+json make_json_rpc(size_t records) {
+    json batch = json::array();
+    for (size_t i = 0; i < records; ++i) {
+        batch.push_back({
+            {"method", i % 2 == 0 ? "orders.create" : "orders.lookup"},
+            {"id", i},
+            {"auth", {{"token", "tok-" + std::to_string(i * 2654435761u)},
+                      {"scopes", {"read", "write"}}}},
+            {"body", {{"customer", "customer-" + std::to_string(i % 1000)},
+                      {"amount", static_cast<double>(i) * 0.37},
+                      {"urgent", i % 17 == 0}}},
+        });
+    }
+    return {{"version", 2},
+            {"trace_id", "2f5c1b8e-ec01-4a7d-a2f9-3f8f6f1f2f5c"},
+            {"batch", std::move(batch)}};
+}
+
+// Wide tabular data, the shape the columnar path targets.
+json make_json_tabular(size_t rows) {
+    json result = json::array();
+    for (size_t i = 0; i < rows; ++i) {
+        result.push_back({
+            {"id", i},
+            {"sensor", i % 128},
+            {"value", static_cast<double>(i % 1000) * 1.5},
+            {"quality", static_cast<double>(i % 100) / 100.0},
+            {"label", i % 2 == 0 ? "calibrated" : "raw"},
+            {"valid", i % 13 != 0},
+        });
+    }
+    return result;
+}
+
+// Timeseries with bulk numeric samples. JSON and MessagePack carry the
+// samples as a plain array; the BTOON conversion below upgrades it to
+// VectorDouble, which is exactly the difference being measured.
+json make_json_timeseries(size_t points) {
+    json samples = json::array();
+    for (size_t i = 0; i < points; ++i) {
+        samples.push_back(static_cast<double>(i % 3600) * 0.25);
+    }
+    return {{"series", "plant-7/turbine-3/rpm"},
+            {"interval_ms", 250},
+            {"samples", std::move(samples)}};
+}
+
+json make_json_dataset(int64_t dataset) {
+    switch (dataset) {
+        case kRpc: return make_json_rpc(10000);
+        case kTabular: return make_json_tabular(100000);
+        default: return make_json_timeseries(1000000);
+    }
+}
+
+Value json_to_value(const json& j) {
+    if (j.is_null()) return Nil{};
+    if (j.is_boolean()) return Bool(j.get<bool>());
+    if (j.is_number_integer() && !j.is_number_unsigned()) return Int(j.get<int64_t>());
+    if (j.is_number_unsigned()) return Uint(j.get<uint64_t>());
+    if (j.is_number_float()) return Float(j.get<double>());
+    if (j.is_string()) return String(j.get<std::string>());
+    if (j.is_array()) {
+        // A homogeneous double array becomes VectorDouble, the layout the
+        // vector extension exists for.
+        bool all_doubles = !j.empty();
+        for (const auto& item : j) {
+            if (!item.is_number_float()) { all_doubles = false; break; }
+        }
+        if (all_doubles) {
+            VectorDouble vec;
+            vec.data.reserve(j.size());
+            for (const auto& item : j) {
+                vec.data.push_back(item.get<double>());
+            }
+            return vec;
+        }
+        Array arr;
+        arr.reserve(j.size());
+        for (const auto& item : j) {
+            arr.push_back(json_to_value(item));
+        }
+        return arr;
+    }
+    if (j.is_object()) {
+        Map map;
+        for (const auto& [key, val] : j.items()) {
+            map[key] = json_to_value(val);
+        }
+        return map;
+    }
+    return Nil{};
+}
+
+// --- Formats ---
+
+enum Format : int64_t { kBtoonRowWise = 0, kBtoonColumnar = 1, kMsgpack = 2, kJson = 3 };
+
+const char* format_label(int64_t format) {
+    switch (format) {
+        case kBtoonRowWise: return "btoon/row-wise";
+        case kBtoonColumnar: return "btoon/columnar";
+        case kMsgpack: return "msgpack";
+        default: return "json";
+    }
+}
+
+const char* dataset_label(int64_t dataset) {
+    switch (dataset) {
+        case kRpc: return "rpc";
+        case kTabular: return "tabular";
+        default: return "timeseries";
+    }
+}
+
+EncodeOptions btoon_options(int64_t format) {
+    EncodeOptions opts;
+    opts.auto_tabular = (format == kBtoonColumnar);
+    return opts;
+}
+
+void set_comparison_labels(benchmark::State& state, size_t encoded_size) {
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * encoded_size));
+    state.counters["size"] = static_cast<double>(encoded_size);
+    state.SetLabel(std::string(format_label(state.range(0))) + " " +
+                   dataset_label(state.range(1)));
+}
+
+// --- Benchmarks ---
+
+void BM_CompareEncode(benchmark::State& state) {
+    int64_t format = state.range(0);
+    json j = make_json_dataset(state.range(1));
+    size_t encoded_size = 0;
+    if (format == kBtoonRowWise || format == kBtoonColumnar) {
+        Value value = json_to_value(j);
+        EncodeOptions opts = btoon_options(format);
+        encoded_size = encode(value, opts).size();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(encode(value, opts));
+        }
+    } else if (format == kMsgpack) {
+        encoded_size = json::to_msgpack(j).size();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(json::to_msgpack(j));
+        }
+    } else {
+        encoded_size = j.dump().size();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(j.dump());
+        }
+    }
+    set_comparison_labels(state, encoded_size);
+}
+BENCHMARK(BM_CompareEncode)
+    ->Args({kBtoonRowWise, kRpc})->Args({kBtoonColumnar, kRpc})
+    ->Args({kMsgpack, kRpc})->Args({kJson, kRpc})
+    ->Args({kBtoonRowWise, kTabular})->Args({kBtoonColumnar, kTabular})
+    ->Args({kMsgpack, kTabular})->Args({kJson, kTabular})
+    ->Args({kBtoonRowWise, kTimeseries})->Args({kBtoonColumnar, kTimeseries})
+    ->Args({kMsgpack, kTimeseries})->Args({kJson, kTimeseries});
+
+void BM_CompareDecode(benchmark::State& state) {
+    int64_t format = state.range(0);
+    json j = make_json_dataset(state.range(1));
+    size_t encoded_size = 0;
+    if (format == kBtoonRowWise || format == kBtoonColumnar) {
+        auto encoded = encode(json_to_value(j), btoon_options(format));
+        encoded_size = encoded.size();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(decode(encoded));
+        }
+    } else if (format == kMsgpack) {
+        auto encoded = json::to_msgpack(j);
+        encoded_size = encoded.size();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(json::from_msgpack(encoded));
+        }
+    } else {
+        std::string encoded = j.dump();
+        encoded_size = encoded.size();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(json::parse(encoded));
+        }
+    }
+    set_comparison_labels(state, encoded_size);
+}
+BENCHMARK(BM_CompareDecode)
+    ->Args({kBtoonRowWise, kRpc})->Args({kBtoonColumnar, kRpc})
+    ->Args({kMsgpack, kRpc})->Args({kJson, kRpc})
+    ->Args({kBtoonRowWise, kTabular})->Args({kBtoonColumnar, kTabular})
+    ->Args({kMsgpack, kTabular})->Args({kJson, kTabular})
+    ->Args({kBtoonRowWise, kTimeseries})->Args({kBtoonColumnar, kTimeseries})
+    ->Args({kMsgpack, kTimeseries})->Args({kJson, kTimeseries});
+
+}  // namespace
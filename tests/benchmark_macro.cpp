@@ -0,0 +1,324 @@
+/**
+ * Macro benchmarks over realistic multi-MB documents: nested RPC
+ * payloads, wide tabular data, and timeseries. Every benchmark reports
+ * bytes/sec through SetBytesProcessed and heap allocations per
+ * iteration through a counted global operator new, so encode/decode
+ * throughput and allocation behaviour can be compared between releases.
+ */
+#include <benchmark/benchmark.h>
+#include "btoon/encoder.h"
+#include "btoon/decoder.h"
+#include "btoon/btoon.h"
+#include "btoon/stream_encoder.h"
+#include "btoon/stream_decoder.h"
+#include "btoon/zero_copy.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace btoon;
+
+// --- Allocation tracking ---
+
+static std::atomic<size_t> g_alloc_count{0};
+static std::atomic<size_t> g_alloc_bytes{0};
+
+void* operator new(std::size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size)) return ptr;
+    throw std::bad_alloc{};
+}
+
+// GCC cannot pair these frees with the malloc in the replaced operator
+// new above and reports -Wmismatched-new-delete at every inlined delete;
+// the pairing is correct, so silence it for the definitions.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+#pragma GCC diagnostic pop
+
+namespace {
+
+// Snapshot the counters around the timed loop and report per-iteration
+// averages; the benchmark framework's own allocations between
+// iterations are small compared to multi-MB documents.
+class AllocScope {
+public:
+    explicit AllocScope(benchmark::State& state)
+        : state_(state),
+          start_count_(g_alloc_count.load(std::memory_order_relaxed)),
+          start_bytes_(g_alloc_bytes.load(std::memory_order_relaxed)) {}
+
+    ~AllocScope() {
+        auto iterations = static_cast<double>(state_.iterations());
+        if (iterations == 0) return;
+        auto count = g_alloc_count.load(std::memory_order_relaxed) - start_count_;
+        auto bytes = g_alloc_bytes.load(std::memory_order_relaxed) - start_bytes_;
+        state_.counters["allocs/iter"] = static_cast<double>(count) / iterations;
+        state_.counters["alloc_bytes/iter"] = static_cast<double>(bytes) / iterations;
+    }
+
+private:
+    benchmark::State& state_;
+    size_t start_count_;
+    size_t start_bytes_;
+};
+
+// --- Dataset builders ---
+
+// Nested RPC-style payload: an envelope with headers and a batch of
+// request records, each with nested auth/metadata maps and string-heavy
+// bodies. `records` scales the document size.
+Value make_rpc_payload(size_t records) {
+    Array batch;
+    batch.reserve(records);
+    for (size_t i = 0; i < records; ++i) {
+        Map request{
+            {"method", String(i % 2 == 0 ? "orders.create" : "orders.lookup")},
+            {"id", Uint(i)},
+            {"auth", Map{
+                {"token", String("tok-" + std::to_string(i * 2654435761u))},
+                {"scopes", Array{String("read"), String("write")}},
+            }},
+            {"metadata", Map{
+                {"client", String("loader/2.3.1")},
+                {"region", String(i % 3 == 0 ? "eu-west-1" : "us-east-2")},
+                {"retries", Uint(i % 4)},
+            }},
+            {"body", Map{
+                {"customer", String("customer-" + std::to_string(i % 1000))},
+                {"note", String("A moderately sized free-text note that pads "
+                                "the record out to a realistic payload width.")},
+                {"amount", Float(static_cast<double>(i) * 0.37)},
+                {"urgent", Bool(i % 17 == 0)},
+            }},
+        };
+        batch.push_back(std::move(request));
+    }
+    return Map{
+        {"version", Uint(2)},
+        {"trace_id", String("2f5c1b8e-ec01-4a7d-a2f9-3f8f6f1f2f5c")},
+        {"batch", std::move(batch)},
+    };
+}
+
+// Wide tabular data: an array of row maps with homogeneous numeric and
+// string columns, the shape auto_tabular targets.
+Array make_tabular(size_t rows) {
+    Array result;
+    result.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        result.push_back(Map{
+            {"id", Uint(i)},
+            {"sensor", Uint(i % 128)},
+            {"value", Float(static_cast<double>(i % 1000) * 1.5)},
+            {"quality", Float(static_cast<double>(i % 100) / 100.0)},
+            {"label", String(i % 2 == 0 ? "calibrated" : "raw")},
+            {"valid", Bool(i % 13 != 0)},
+        });
+    }
+    return result;
+}
+
+// Timeseries: bulk numeric samples in VectorDouble plus metadata, the
+// layout the vector types exist for.
+Value make_timeseries(size_t points) {
+    VectorDouble samples;
+    samples.data.reserve(points);
+    for (size_t i = 0; i < points; ++i) {
+        samples.data.push_back(static_cast<double>(i % 3600) * 0.25);
+    }
+    return Map{
+        {"series", String("plant-7/turbine-3/rpm")},
+        {"start", Timestamp{1700000000}},
+        {"interval_ms", Uint(250)},
+        {"samples", std::move(samples)},
+    };
+}
+
+size_t encoded_size(const Value& value, const EncodeOptions& opts = {}) {
+    return encode(value, opts).size();
+}
+
+// --- Macro encode/decode ---
+
+void BM_MacroEncodeRpc(benchmark::State& state) {
+    Value payload = make_rpc_payload(static_cast<size_t>(state.range(0)));
+    size_t bytes = encoded_size(payload);
+    AllocScope allocs(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encode(payload));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_MacroEncodeRpc)->Arg(1000)->Arg(10000)->Arg(50000);
+
+void BM_MacroDecodeRpc(benchmark::State& state) {
+    auto encoded = encode(make_rpc_payload(static_cast<size_t>(state.range(0))));
+    AllocScope allocs(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(decode(encoded));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(encoded.size()));
+}
+BENCHMARK(BM_MacroDecodeRpc)->Arg(1000)->Arg(10000)->Arg(50000);
+
+// --- Columnar path ---
+
+void BM_MacroEncodeTabular(benchmark::State& state) {
+    Value table = make_tabular(static_cast<size_t>(state.range(0)));
+    EncodeOptions opts;
+    opts.auto_tabular = state.range(1) != 0;
+    size_t bytes = encoded_size(table, opts);
+    AllocScope allocs(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encode(table, opts));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+    state.SetLabel(opts.auto_tabular ? "columnar" : "row-wise");
+}
+BENCHMARK(BM_MacroEncodeTabular)
+    ->Args({10000, 0})->Args({10000, 1})
+    ->Args({100000, 0})->Args({100000, 1});
+
+void BM_MacroDecodeTabular(benchmark::State& state) {
+    EncodeOptions opts;
+    opts.auto_tabular = state.range(1) != 0;
+    auto encoded = encode(make_tabular(static_cast<size_t>(state.range(0))), opts);
+    AllocScope allocs(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(decode(encoded));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(encoded.size()));
+    state.SetLabel(opts.auto_tabular ? "columnar" : "row-wise");
+}
+BENCHMARK(BM_MacroDecodeTabular)
+    ->Args({10000, 0})->Args({10000, 1})
+    ->Args({100000, 0})->Args({100000, 1});
+
+// --- Timeseries / vector types ---
+
+void BM_MacroRoundTripTimeseries(benchmark::State& state) {
+    Value series = make_timeseries(static_cast<size_t>(state.range(0)));
+    size_t bytes = encoded_size(series);
+    AllocScope allocs(state);
+    for (auto _ : state) {
+        auto encoded = encode(series);
+        benchmark::DoNotOptimize(decode(encoded));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_MacroRoundTripTimeseries)->Arg(100000)->Arg(1000000);
+
+// --- Compression profiles ---
+
+void BM_MacroEncodeCompressed(benchmark::State& state) {
+    Value table = make_tabular(50000);
+    EncodeOptions opts;
+    opts.compress = true;
+    switch (state.range(0)) {
+        case 0: opts.compression_algorithm = CompressionAlgorithm::ZLIB; break;
+        case 1: opts.compression_algorithm = CompressionAlgorithm::LZ4; break;
+        default: opts.compression_algorithm = CompressionAlgorithm::ZSTD; break;
+    }
+    size_t raw_bytes = encoded_size(table);
+    size_t compressed_bytes = 0;
+    try {
+        compressed_bytes = encoded_size(table, opts);
+    } catch (const BtoonException& e) {
+        // Algorithm not compiled into this build.
+        state.SkipWithError(e.what());
+        return;
+    }
+    AllocScope allocs(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encode(table, opts));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(raw_bytes));
+    state.counters["ratio"] =
+        static_cast<double>(raw_bytes) / static_cast<double>(compressed_bytes);
+    switch (state.range(0)) {
+        case 0: state.SetLabel("zlib"); break;
+        case 1: state.SetLabel("lz4"); break;
+        default: state.SetLabel("zstd"); break;
+    }
+}
+BENCHMARK(BM_MacroEncodeCompressed)->Arg(0)->Arg(1)->Arg(2);
+
+// --- Streaming ---
+
+void BM_MacroStreamEncode(benchmark::State& state) {
+    Array records = make_tabular(static_cast<size_t>(state.range(0)));
+    size_t bytes = 0;
+    AllocScope allocs(state);
+    for (auto _ : state) {
+        std::ostringstream out;
+        StreamEncoder encoder(out);
+        for (const auto& record : records) {
+            encoder.write(record);
+        }
+        encoder.close();
+        bytes = out.str().size();
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_MacroStreamEncode)->Arg(10000)->Arg(100000);
+
+void BM_MacroStreamDecode(benchmark::State& state) {
+    Array records = make_tabular(static_cast<size_t>(state.range(0)));
+    std::ostringstream out;
+    {
+        StreamEncoder encoder(out);
+        for (const auto& record : records) {
+            encoder.write(record);
+        }
+        encoder.close();
+    }
+    std::string data = out.str();
+    AllocScope allocs(state);
+    for (auto _ : state) {
+        std::istringstream in(data);
+        StreamDecoder decoder(in);
+        size_t count = 0;
+        while (auto value = decoder.read()) {
+            count++;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+BENCHMARK(BM_MacroStreamDecode)->Arg(10000)->Arg(100000);
+
+// --- Zero-copy decode ---
+
+void BM_MacroZeroCopyDecodeRpc(benchmark::State& state) {
+    // The zero-copy decoder reads plain containers, not the tabular
+    // extension, so keep auto_tabular off for its input.
+    EncodeOptions opts;
+    opts.auto_tabular = false;
+    auto encoded = encode(make_rpc_payload(static_cast<size_t>(state.range(0))), opts);
+    AllocScope allocs(state);
+    for (auto _ : state) {
+        ZeroCopyDecoder decoder;
+        benchmark::DoNotOptimize(decoder.decode(encoded.data(), encoded.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(encoded.size()));
+}
+BENCHMARK(BM_MacroZeroCopyDecodeRpc)->Arg(1000)->Arg(10000)->Arg(50000);
+
+}  // namespace
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "btoon/btoon.h"
+#include "btoon/arena_value.h"
+
+using namespace btoon;
+
+TEST(ArenaValueTest, DecodeScalars) {
+    MemoryPool pool;
+    ArenaDecoder decoder(pool);
+
+    std::vector<uint8_t> data = encode(Value(Uint(42)));
+    ArenaValue v = decoder.decode(data);
+    ASSERT_TRUE(std::holds_alternative<Uint>(v));
+    EXPECT_EQ(std::get<Uint>(v), 42u);
+
+    data = encode(Value(Float(2.5)));
+    v = decoder.decode(data);
+    ASSERT_TRUE(std::holds_alternative<Float>(v));
+    EXPECT_DOUBLE_EQ(std::get<Float>(v), 2.5);
+}
+
+TEST(ArenaValueTest, DecodeContainersIntoPool) {
+    MemoryPool pool;
+    ArenaDecoder decoder(pool);
+
+    Map m;
+    m["name"] = String("a reasonably long string that will not fit in SSO");
+    m["values"] = Array{Uint(1), Uint(2), Uint(3)};
+    auto data = encode(Value(m));
+
+    size_t usage_before = pool.current_usage();
+    ArenaValue v = decoder.decode(data);
+    EXPECT_GT(pool.current_usage(), usage_before);
+
+    auto* map = std::get_if<ArenaMap>(&v);
+    ASSERT_NE(map, nullptr);
+    auto it = map->find("name");
+    ASSERT_NE(it, map->end());
+    auto* str = std::get_if<ArenaString>(&it->second);
+    ASSERT_NE(str, nullptr);
+    EXPECT_EQ(std::string_view(*str),
+              "a reasonably long string that will not fit in SSO");
+
+    auto* arr = std::get_if<ArenaArray>(&map->find("values")->second);
+    ASSERT_NE(arr, nullptr);
+    ASSERT_EQ(arr->size(), 3u);
+    EXPECT_EQ(std::get<Uint>((*arr)[1]), 2u);
+}
+
+TEST(ArenaValueTest, PoolResetReclaimsTree) {
+    MemoryPool pool;
+    ArenaDecoder decoder(pool);
+
+    Map m;
+    for (int i = 0; i < 64; ++i) {
+        m["key_" + std::to_string(i)] = String("value_" + std::to_string(i));
+    }
+    auto data = encode(Value(m));
+
+    {
+        ArenaValue v = decoder.decode(data);
+        EXPECT_GT(pool.current_usage(), 0u);
+        // The tree must be discarded before reset; scope exit does that here.
+    }
+    pool.reset();
+    EXPECT_EQ(pool.current_usage(), 0u);
+}
+
+TEST(ArenaValueTest, RoundTripThroughToValue) {
+    MemoryPool pool;
+    ArenaDecoder decoder(pool);
+
+    Map m;
+    m["nested"] = Map{{"flag", Bool(true)}, {"count", Int(-5)}};
+    m["bin"] = Binary{0x01, 0x02, 0x03};
+    Value original(m);
+    auto data = encode(original);
+
+    ArenaValue arena = decoder.decode(data);
+    Value heap = ArenaDecoder::toValue(arena);
+    EXPECT_EQ(heap, original);
+}
+
+TEST(ArenaValueTest, DecodeTimestampExtension) {
+    MemoryPool pool;
+    ArenaDecoder decoder(pool);
+
+    Timestamp ts(1700000000, 123456789);
+    auto data = encode(Value(ts));
+    ArenaValue v = decoder.decode(data);
+    auto* decoded = std::get_if<Timestamp>(&v);
+    ASSERT_NE(decoded, nullptr);
+    EXPECT_EQ(decoded->seconds, 1700000000);
+    EXPECT_EQ(decoded->nanoseconds, 123456789u);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "btoon/async_stream.h"
+#include "btoon/stream_decoder.h"
+
+#include <sstream>
+
+using namespace btoon;
+
+namespace {
+
+// Sink that completes immediately; collects everything the encoder writes.
+struct CollectingSink {
+    std::vector<uint8_t> bytes;
+
+    std::suspend_never write(std::span<const uint8_t> chunk) {
+        bytes.insert(bytes.end(), chunk.begin(), chunk.end());
+        return {};
+    }
+};
+
+// Sink that feeds an AsyncStreamDecoder directly, encoder to decoder
+// in-process with no stream in between.
+struct PipeSink {
+    AsyncStreamDecoder& decoder;
+
+    std::suspend_never write(std::span<const uint8_t> chunk) {
+        decoder.feed(chunk);
+        return {};
+    }
+};
+
+// Reads records until end of stream, collecting them for the test body.
+CoTask<void> drain(AsyncStreamDecoder& decoder, std::vector<Value>& out) {
+    while (auto record = co_await decoder.read()) {
+        out.push_back(std::move(*record));
+    }
+}
+
+} // namespace
+
+TEST(AsyncStreamTest, ReadCompletesWithoutSuspensionWhenBuffered) {
+    AsyncStreamDecoder decoder;
+    decoder.feed(encode(Value(String("first"))));
+    decoder.feed(encode(Value(Int(-42))));
+    EXPECT_TRUE(decoder.record_ready());
+    decoder.finish();
+
+    std::vector<Value> records;
+    auto task = drain(decoder, records);
+    task.start();
+    // Everything was buffered, so the coroutine never suspended.
+    ASSERT_TRUE(task.done());
+    task.result();
+
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0], Value(String("first")));
+    EXPECT_EQ(records[1], Value(Int(-42)));
+}
+
+TEST(AsyncStreamTest, ReadSuspendsUntilBytesArrive) {
+    AsyncStreamDecoder decoder;
+    std::vector<Value> records;
+    auto task = drain(decoder, records);
+    task.start();
+    EXPECT_FALSE(task.done());
+
+    // Deliver a record one byte at a time, as a slow transport would; the
+    // parked read() resumes only when the record is complete.
+    auto encoded = encode(Value(Map{
+        {"id", Uint(7)},
+        {"payload", String("partial delivery")}
+    }));
+    for (size_t i = 0; i + 1 < encoded.size(); ++i) {
+        decoder.feed(std::span(&encoded[i], 1));
+        EXPECT_TRUE(records.empty());
+    }
+    decoder.feed(std::span(&encoded.back(), 1));
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0], decode(encoded));
+
+    EXPECT_FALSE(task.done());
+    decoder.finish();
+    ASSERT_TRUE(task.done());
+    task.result();
+    EXPECT_EQ(records.size(), 1u);
+}
+
+TEST(AsyncStreamTest, TruncatedStreamSurfacesAsException) {
+    AsyncStreamDecoder decoder;
+    std::vector<Value> records;
+    auto task = drain(decoder, records);
+    task.start();
+
+    auto encoded = encode(Value(String("cut short")));
+    decoder.feed(std::span(encoded.data(), encoded.size() - 1));
+    decoder.finish();
+
+    ASSERT_TRUE(task.done());
+    EXPECT_THROW(task.result(), BtoonException);
+}
+
+TEST(AsyncStreamTest, EncoderOutputReadableBySyncDecoder) {
+    CollectingSink sink;
+    AsyncStreamEncoder encoder(sink);
+
+    std::vector<Value> written = {
+        Value(Array{Uint(1), Uint(2), Uint(3)}),
+        Value(String("via async sink")),
+        Value(Nil{})
+    };
+    for (const auto& value : written) {
+        auto task = encoder.write(value);
+        task.start();
+        ASSERT_TRUE(task.done());
+        task.result();
+    }
+
+    // The plain record stream is the same one StreamDecoder reads.
+    std::stringstream ss(std::string(sink.bytes.begin(), sink.bytes.end()));
+    StreamDecoder decoder(ss);
+    for (const auto& value : written) {
+        auto record = decoder.read();
+        ASSERT_TRUE(record.has_value());
+        EXPECT_EQ(*record, value);
+    }
+    EXPECT_FALSE(decoder.read().has_value());
+}
+
+TEST(AsyncStreamTest, EncoderToDecoderPipe) {
+    AsyncStreamDecoder decoder;
+    std::vector<Value> records;
+    auto reader = drain(decoder, records);
+    reader.start();
+
+    PipeSink sink{decoder};
+    AsyncStreamEncoder encoder(sink);
+    for (int i = 0; i < 5; ++i) {
+        auto task = encoder.write(Map{{"seq", Int(-i)}});
+        task.start();
+        ASSERT_TRUE(task.done());
+        // Each record surfaced on the reader side as soon as it was written.
+        EXPECT_EQ(records.size(), static_cast<size_t>(i) + 1);
+    }
+    decoder.finish();
+    ASSERT_TRUE(reader.done());
+    reader.result();
+
+    ASSERT_EQ(records.size(), 5u);
+    EXPECT_EQ(records[4], Value(Map{{"seq", Int(-4)}}));
+}
+
+TEST(AsyncStreamTest, ArchiveOptionsRejected) {
+    CollectingSink sink;
+    EncodeOptions opts;
+    opts.stream_seek_index = true;
+    EXPECT_THROW(AsyncStreamEncoder<CollectingSink> encoder(sink, opts),
+                 BtoonException);
+}
@@ -0,0 +1,355 @@
+#include <gtest/gtest.h>
+#include "btoon/batch_processor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace btoon;
+using namespace btoon::batch;
+
+TEST(BatchProcessorTest, ProcessPreservesInputOrder) {
+    BatchOptions opts;
+    opts.batch_size = 16;
+    opts.worker_threads = 4;
+
+    ParallelBatchProcessor<int, int> processor(
+        [](const int& v) { return v * 2; }, opts);
+
+    std::vector<int> items(10000);
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i] = static_cast<int>(i);
+    }
+
+    auto results = processor.process(items);
+    ASSERT_EQ(results.size(), items.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results[i], static_cast<int>(i) * 2) << "at index " << i;
+    }
+    EXPECT_EQ(processor.statistics().processed_items, items.size());
+    EXPECT_EQ(processor.statistics().failed_items, 0u);
+}
+
+TEST(BatchProcessorTest, FailedItemsAreCountedAndSkipped) {
+    BatchOptions opts;
+    opts.batch_size = 8;
+    opts.worker_threads = 3;
+
+    ParallelBatchProcessor<int, int> processor(
+        [](const int& v) {
+            if (v % 10 == 0) {
+                throw BtoonException("multiple of ten");
+            }
+            return v;
+        },
+        opts);
+
+    std::atomic<size_t> handled{0};
+    processor.set_error_handler(
+        [&](const int&, const std::exception&) { handled++; });
+
+    std::vector<int> items(100);
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i] = static_cast<int>(i);
+    }
+
+    auto results = processor.process(items);
+    EXPECT_EQ(results.size(), 90u);
+    EXPECT_EQ(processor.statistics().processed_items, 90u);
+    EXPECT_EQ(processor.statistics().failed_items, 10u);
+    EXPECT_EQ(handled.load(), 10u);
+
+    // Surviving items keep their relative order.
+    EXPECT_EQ(results.front(), 1);
+    EXPECT_EQ(results.back(), 99);
+}
+
+TEST(BatchProcessorTest, WorkStealingRebalancesSkewedLoad) {
+    BatchOptions opts;
+    opts.batch_size = 1;
+    opts.worker_threads = 4;
+
+    // The first worker's owned range is artificially slow; the others run
+    // dry immediately and must steal from it to finish the job.
+    ParallelBatchProcessor<int, int> processor(
+        [](const int& v) {
+            if (v < 50) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            return v;
+        },
+        opts);
+
+    std::vector<int> items(200);
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i] = static_cast<int>(i);
+    }
+
+    auto results = processor.process(items);
+    ASSERT_EQ(results.size(), items.size());
+    EXPECT_GT(processor.statistics().work_steals, 0u);
+}
+
+TEST(BatchProcessorTest, MoreWorkersThanBatches) {
+    BatchOptions opts;
+    opts.batch_size = 100;
+    opts.worker_threads = 8;
+
+    ParallelBatchProcessor<int, int> processor(
+        [](const int& v) { return v + 1; }, opts);
+
+    auto results = processor.process({1, 2, 3});
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0], 2);
+    EXPECT_EQ(results[2], 4);
+}
+
+TEST(BatchProcessorTest, NumaTopologyReportsAtLeastOneNode) {
+    const auto& topology = NumaTopology::detect();
+    ASSERT_GE(topology.num_nodes(), 1u);
+    for (const auto& node : topology.nodes) {
+        EXPECT_FALSE(node.cpus.empty());
+    }
+    // Workers spread round-robin and always land on a valid node.
+    EXPECT_EQ(topology.node_for_worker(0), 0u);
+    EXPECT_LT(topology.node_for_worker(7), topology.num_nodes());
+}
+
+TEST(BatchProcessorTest, NumaAwareProcessingPreservesResults) {
+    BatchOptions opts;
+    opts.batch_size = 16;
+    opts.worker_threads = 4;
+    opts.numa_aware = true;
+
+    ParallelBatchProcessor<int, int> processor(
+        [](const int& v) { return v * 3; }, opts);
+
+    std::vector<int> items(5000);
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i] = static_cast<int>(i);
+    }
+
+    auto results = processor.process(items);
+    ASSERT_EQ(results.size(), items.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results[i], static_cast<int>(i) * 3) << "at index " << i;
+    }
+}
+
+namespace {
+
+std::string write_shard_file(const std::string& name, int first, int count) {
+    btoon::Array records;
+    for (int i = 0; i < count; ++i) {
+        records.push_back(btoon::Value(btoon::Uint(first + i)));
+    }
+    auto encoded = btoon::encode(btoon::Value(records));
+
+    auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(encoded.data()),
+               static_cast<std::streamsize>(encoded.size()));
+    return path;
+}
+
+} // namespace
+
+TEST(MapReduceProcessorTest, ProcessFilesAggregatesAcrossShards) {
+    std::vector<std::string> shards = {
+        write_shard_file("btoon_mr_shard0.btoon", 0, 40),
+        write_shard_file("btoon_mr_shard1.btoon", 40, 40),
+        write_shard_file("btoon_mr_shard2.btoon", 80, 20),
+    };
+
+    BatchOptions opts;
+    opts.worker_threads = 3;
+
+    MapReduceProcessor<std::string, int64_t, int64_t> processor(
+        [](const btoon::Value& record) {
+            auto v = static_cast<int64_t>(std::get<btoon::Uint>(record));
+            return std::make_pair(v % 2 == 0 ? std::string("even")
+                                             : std::string("odd"),
+                                  v);
+        },
+        [](const std::string&, const std::vector<int64_t>& values) {
+            int64_t sum = 0;
+            for (int64_t v : values) sum += v;
+            return sum;
+        },
+        opts);
+
+    auto results = processor.process_files(shards);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results["even"], 2450);  // 0 + 2 + ... + 98
+    EXPECT_EQ(results["odd"], 2500);   // 1 + 3 + ... + 99
+
+    for (const auto& path : shards) {
+        std::filesystem::remove(path);
+    }
+}
+
+TEST(BatchProcessorTest, LoadShardValuesThrowsOnMissingFile) {
+    EXPECT_THROW(load_shard_values("/nonexistent/btoon_shard.btoon"),
+                 BtoonException);
+}
+
+TEST(BatchProcessorTest, SplitFileChunksCoversWholeFile) {
+    auto path = write_shard_file("btoon_split_chunks.btoon", 0, 100);
+
+    auto chunks = split_file_chunks(path, 4);
+    ASSERT_EQ(chunks.size(), 4u);
+    size_t expected_offset = 0;
+    size_t total = 0;
+    for (const auto& [offset, length] : chunks) {
+        EXPECT_EQ(offset, expected_offset);
+        expected_offset += length;
+        total += length;
+    }
+    EXPECT_EQ(total, std::filesystem::file_size(path));
+
+    std::filesystem::remove(path);
+}
+
+TEST(BatchProcessorTest, MergeSortedBatchesProducesSortedOutput) {
+    std::vector<std::vector<int>> batches = {
+        {1, 4, 9}, {}, {2, 3, 10}, {5}, {0, 6, 7, 8}};
+
+    auto merged = merge_sorted_batches(batches);
+    ASSERT_EQ(merged.size(), 11u);
+    EXPECT_TRUE(std::is_sorted(merged.begin(), merged.end()));
+    EXPECT_EQ(merged.front(), 0);
+    EXPECT_EQ(merged.back(), 10);
+}
+
+TEST(WindowProcessorTest, SlidingAggregatesMatchNaive) {
+    std::vector<int> items(500);
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i] = static_cast<int>((i * 7919) % 173) - 80;
+    }
+
+    for (size_t slide : {size_t(7), size_t(50), size_t(90)}) {
+        WindowProcessor<int> processor(WindowProcessor<int>::SLIDING, 50, slide);
+
+        std::vector<WindowAggregate<int>> naive;
+        processor.process(items, [&](const std::vector<int>& window, size_t) {
+            WindowAggregate<int> agg;
+            agg.count = window.size();
+            for (int v : window) {
+                agg.sum += v;
+            }
+            agg.min = *std::min_element(window.begin(), window.end());
+            agg.max = *std::max_element(window.begin(), window.end());
+            naive.push_back(agg);
+        });
+
+        size_t seen = 0;
+        processor.process_aggregates(items, [&](const WindowAggregate<int>& agg,
+                                                size_t window_id) {
+            ASSERT_EQ(window_id, seen);
+            ASSERT_LT(seen, naive.size());
+            EXPECT_EQ(agg.count, naive[seen].count) << "slide " << slide;
+            EXPECT_EQ(agg.sum, naive[seen].sum) << "slide " << slide;
+            EXPECT_EQ(agg.min, naive[seen].min) << "slide " << slide;
+            EXPECT_EQ(agg.max, naive[seen].max) << "slide " << slide;
+            seen++;
+        });
+        EXPECT_EQ(seen, naive.size());
+    }
+}
+
+TEST(WindowProcessorTest, TumblingAggregatesIncludePartialTail) {
+    WindowProcessor<int> processor(WindowProcessor<int>::TUMBLING, 4);
+
+    std::vector<WindowAggregate<int>> aggregates;
+    processor.process_aggregates({1, 2, 3, 4, 10, -5},
+                                 [&](const WindowAggregate<int>& agg, size_t) {
+                                     aggregates.push_back(agg);
+                                 });
+
+    ASSERT_EQ(aggregates.size(), 2u);
+    EXPECT_EQ(aggregates[0].count, 4u);
+    EXPECT_EQ(aggregates[0].sum, 10);
+    EXPECT_EQ(aggregates[0].min, 1);
+    EXPECT_EQ(aggregates[0].max, 4);
+    EXPECT_EQ(aggregates[1].count, 2u);
+    EXPECT_EQ(aggregates[1].sum, 5);
+    EXPECT_EQ(aggregates[1].min, -5);
+    EXPECT_EQ(aggregates[1].max, 10);
+}
+
+TEST(ProcessingPipelineTest, ParallelMatchesSequential) {
+    BatchOptions opts;
+    opts.batch_size = 32;
+    opts.worker_threads = 4;
+
+    auto build = [&] {
+        ProcessingPipeline<int> pipeline(opts);
+        pipeline.add_stage("add", [](const int& v) { return v + 1; })
+                .add_stage("double", [](const int& v) { return v * 2; })
+                .add_stage("sub", [](const int& v) { return v - 3; });
+        return pipeline;
+    };
+
+    std::vector<int> items(1000);
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i] = static_cast<int>(i);
+    }
+
+    auto sequential = build().process(items);
+    auto parallel = build().process_parallel(items);
+    EXPECT_EQ(parallel, sequential);
+}
+
+TEST(ProcessingPipelineTest, StageConcurrencyLimitIsRespected) {
+    BatchOptions opts;
+    opts.batch_size = 10;
+    opts.worker_threads = 4;
+    opts.stage_concurrency = {1};  // stage 0 single-file, stage 1 unlimited
+
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+
+    ProcessingPipeline<int> pipeline(opts);
+    pipeline.add_stage("limited", [&](const int& v) {
+        int now = ++running;
+        int prev = peak.load();
+        while (now > prev && !peak.compare_exchange_weak(prev, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        --running;
+        return v;
+    });
+    pipeline.add_stage("free", [](const int& v) { return v + 100; });
+
+    std::vector<int> items(100);
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i] = static_cast<int>(i);
+    }
+
+    auto results = pipeline.process_parallel(items);
+    ASSERT_EQ(results.size(), items.size());
+    EXPECT_EQ(results[0], 100);
+    EXPECT_EQ(peak.load(), 1);
+}
+
+TEST(ProcessingPipelineTest, ParallelPropagatesStageErrors) {
+    BatchOptions opts;
+    opts.batch_size = 4;
+    opts.worker_threads = 2;
+
+    ProcessingPipeline<int> pipeline(opts);
+    pipeline.add_stage("explode", [](const int& v) -> int {
+        if (v == 13) {
+            throw BtoonException("unlucky");
+        }
+        return v;
+    });
+
+    std::vector<int> items(50);
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i] = static_cast<int>(i);
+    }
+    EXPECT_THROW(pipeline.process_parallel(items), BtoonException);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "btoon/capi.h"
+#include <vector>
 
 TEST(CAPITest, Version) {
     const char* version = btoon_version();
@@ -52,3 +53,282 @@ TEST(CAPITest, StringRoundTrip) {
     btoon_value_destroy(decoded);
     btoon_free_result(result);
 }
+
+TEST(CAPITest, ArenaDecodeRoundTrip) {
+    // Build and encode a small document through the regular API.
+    btoon_value_t* name = btoon_value_create_string("ada", 3);
+    btoon_value_t* age = btoon_value_create_uint(36);
+    btoon_string_t keys[] = {{"name", 4}, {"age", 3}};
+    const btoon_value_t* values[] = {name, age};
+    btoon_value_t* original = btoon_value_create_map(keys, values, 2);
+    btoon_encode_options_t options = {false, BTOON_COMPRESSION_ZLIB, 0, false};
+    btoon_result_t result = btoon_encode(original, &options);
+    ASSERT_EQ(result.error, nullptr);
+
+    // Decode into an arena: the whole tree lives in pool memory and is
+    // never individually freed.
+    btoon_arena_t* arena = btoon_arena_create(0);
+    ASSERT_NE(arena, nullptr);
+    const char* error = nullptr;
+    btoon_decode_options_t decode_options = {false, true};
+    btoon_value_t* decoded =
+        btoon_decode_arena(arena, result.data, result.size, &decode_options, &error);
+    ASSERT_EQ(error, nullptr);
+    ASSERT_NE(decoded, nullptr);
+
+    ASSERT_EQ(decoded->type, BTOON_TYPE_MAP);
+    ASSERT_EQ(decoded->as.m.len, 2u);
+    bool saw_name = false;
+    for (size_t i = 0; i < decoded->as.m.len; ++i) {
+        if (strncmp(decoded->as.m.keys[i].ptr, "name", decoded->as.m.keys[i].len) == 0) {
+            saw_name = true;
+            EXPECT_EQ(decoded->as.m.values[i]->type, BTOON_TYPE_STRING);
+            EXPECT_STREQ(decoded->as.m.values[i]->as.s.ptr, "ada");
+        }
+    }
+    EXPECT_TRUE(saw_name);
+    EXPECT_GT(btoon_arena_total_allocated(arena), 0u);
+
+    // One call releases the document; no btoon_value_destroy on arena values.
+    btoon_arena_destroy(arena);
+
+    btoon_value_destroy(original);
+    btoon_value_destroy(name);
+    btoon_value_destroy(age);
+    btoon_free_result(result);
+}
+
+TEST(CAPITest, ArenaDecodeReportsErrorsInArena) {
+    btoon_arena_t* arena = btoon_arena_create(1024);
+    ASSERT_NE(arena, nullptr);
+
+    const uint8_t junk[] = {0xC1, 0xFF, 0xFF};
+    const char* error = nullptr;
+    btoon_value_t* decoded = btoon_decode_arena(arena, junk, sizeof(junk), nullptr, &error);
+    EXPECT_EQ(decoded, nullptr);
+    ASSERT_NE(error, nullptr);
+    EXPECT_GT(strlen(error), 0u);
+
+    // The message is arena-owned; destroying the arena reclaims it too.
+    btoon_arena_destroy(arena);
+    btoon_arena_destroy(nullptr);  // NULL is a no-op
+}
+
+TEST(CAPITest, ViewDecodePointsIntoCallerBuffer) {
+    btoon_value_t* name = btoon_value_create_string("grace", 5);
+    btoon_value_t* age = btoon_value_create_uint(45);
+    btoon_string_t keys[] = {{"name", 4}, {"age", 3}};
+    const btoon_value_t* values[] = {name, age};
+    btoon_value_t* original = btoon_value_create_map(keys, values, 2);
+    btoon_encode_options_t options = {false, BTOON_COMPRESSION_ZLIB, 0, false};
+    btoon_result_t result = btoon_encode(original, &options);
+    ASSERT_EQ(result.error, nullptr);
+
+    btoon_arena_t* arena = btoon_arena_create(0);
+    ASSERT_NE(arena, nullptr);
+    const char* error = nullptr;
+    btoon_value_t* decoded = btoon_decode_view(arena, result.data, result.size, &error);
+    ASSERT_EQ(error, nullptr);
+    ASSERT_NE(decoded, nullptr);
+
+    ASSERT_EQ(decoded->type, BTOON_TYPE_MAP);
+    ASSERT_EQ(decoded->as.m.len, 2u);
+    bool saw_name = false;
+    for (size_t i = 0; i < decoded->as.m.len; ++i) {
+        const btoon_string_t& key = decoded->as.m.keys[i];
+        // Keys and string payloads are views: pointers into the encoded
+        // buffer, not NUL-terminated copies.
+        EXPECT_GE(key.ptr, reinterpret_cast<const char*>(result.data));
+        EXPECT_LE(key.ptr + key.len,
+                  reinterpret_cast<const char*>(result.data) + result.size);
+        if (strncmp(key.ptr, "name", key.len) == 0 && key.len == 4) {
+            saw_name = true;
+            const btoon_value_t* value = decoded->as.m.values[i];
+            ASSERT_EQ(value->type, BTOON_TYPE_STRING);
+            EXPECT_EQ(value->as.s.len, 5u);
+            EXPECT_EQ(strncmp(value->as.s.ptr, "grace", 5), 0);
+            EXPECT_GE(value->as.s.ptr, reinterpret_cast<const char*>(result.data));
+            EXPECT_LE(value->as.s.ptr + value->as.s.len,
+                      reinterpret_cast<const char*>(result.data) + result.size);
+        }
+    }
+    EXPECT_TRUE(saw_name);
+
+    // The buffer must outlive the view tree, so destroy the tree first.
+    btoon_arena_destroy(arena);
+    btoon_value_destroy(original);
+    btoon_value_destroy(name);
+    btoon_value_destroy(age);
+    btoon_free_result(result);
+}
+
+TEST(CAPITest, ViewDecodeReportsErrors) {
+    btoon_arena_t* arena = btoon_arena_create(0);
+    ASSERT_NE(arena, nullptr);
+
+    const uint8_t junk[] = {0xC1, 0xFF};
+    const char* error = nullptr;
+    EXPECT_EQ(btoon_decode_view(arena, junk, sizeof(junk), &error), nullptr);
+    ASSERT_NE(error, nullptr);
+    EXPECT_GT(strlen(error), 0u);
+    btoon_arena_destroy(arena);
+
+    error = nullptr;
+    EXPECT_EQ(btoon_decode_view(nullptr, junk, sizeof(junk), &error), nullptr);
+    ASSERT_NE(error, nullptr);
+}
+
+TEST(CAPITest, MmapHelpersFeedViewDecode) {
+    // Write an encoded document to disk, map it, and decode a view tree
+    // whose payloads point into the mapping.
+    btoon_value_t* original = btoon_value_create_string("mapped payload", 14);
+    btoon_encode_options_t options = {false, BTOON_COMPRESSION_ZLIB, 0, false};
+    btoon_result_t result = btoon_encode(original, &options);
+    ASSERT_EQ(result.error, nullptr);
+
+    const char* path = "test_capi_mmap.btoon";
+    FILE* f = fopen(path, "wb");
+    ASSERT_NE(f, nullptr);
+    ASSERT_EQ(fwrite(result.data, 1, result.size, f), result.size);
+    fclose(f);
+
+    btoon_mmap_t* mapped = btoon_mmap_open(path);
+    ASSERT_NE(mapped, nullptr);
+    ASSERT_NE(btoon_mmap_data(mapped), nullptr);
+    ASSERT_EQ(btoon_mmap_size(mapped), result.size);
+
+    btoon_arena_t* arena = btoon_arena_create(0);
+    const char* error = nullptr;
+    btoon_value_t* decoded = btoon_decode_view(
+        arena, btoon_mmap_data(mapped), btoon_mmap_size(mapped), &error);
+    ASSERT_EQ(error, nullptr);
+    ASSERT_NE(decoded, nullptr);
+    ASSERT_EQ(decoded->type, BTOON_TYPE_STRING);
+    EXPECT_EQ(decoded->as.s.len, 14u);
+    EXPECT_EQ(strncmp(decoded->as.s.ptr, "mapped payload", 14), 0);
+
+    btoon_arena_destroy(arena);
+    btoon_mmap_close(mapped);
+    btoon_mmap_close(nullptr);  // NULL is a no-op
+
+    btoon_value_destroy(original);
+    btoon_free_result(result);
+    remove(path);
+}
+
+TEST(CAPITest, StreamDecoderWalksConcatenatedMessages) {
+    // Concatenate three encoded messages into one buffer.
+    std::vector<uint8_t> buffer;
+    for (uint64_t i = 0; i < 3; ++i) {
+        btoon_value_t* value = btoon_value_create_uint(i);
+        btoon_encode_options_t options = {false, BTOON_COMPRESSION_ZLIB, 0, false};
+        btoon_result_t result = btoon_encode(value, &options);
+        ASSERT_EQ(result.error, nullptr);
+        buffer.insert(buffer.end(), result.data, result.data + result.size);
+        btoon_free_result(result);
+        btoon_value_destroy(value);
+    }
+
+    btoon_stream_decoder_t* decoder =
+        btoon_stream_decoder_create_buffer(buffer.data(), buffer.size(), nullptr);
+    ASSERT_NE(decoder, nullptr);
+    btoon_arena_t* arena = btoon_arena_create(0);
+
+    uint64_t expected = 0;
+    const char* error = nullptr;
+    while (btoon_stream_decoder_has_next(decoder)) {
+        btoon_value_t* value = btoon_stream_decoder_next(decoder, arena, &error);
+        ASSERT_EQ(error, nullptr);
+        ASSERT_NE(value, nullptr);
+        ASSERT_EQ(value->type, BTOON_TYPE_UINT);
+        EXPECT_EQ(value->as.u, expected++);
+    }
+    EXPECT_EQ(expected, 3u);
+
+    // Past the end: NULL with no error set.
+    error = nullptr;
+    EXPECT_EQ(btoon_stream_decoder_next(decoder, arena, &error), nullptr);
+    EXPECT_EQ(error, nullptr);
+
+    btoon_stream_decoder_destroy(decoder);
+    btoon_arena_destroy(arena);
+}
+
+TEST(CAPITest, BatchDecodeFillsPreallocatedArray) {
+    std::vector<uint8_t> buffer;
+    for (uint64_t i = 0; i < 5; ++i) {
+        btoon_value_t* value = btoon_value_create_uint(i * 10);
+        btoon_encode_options_t options = {false, BTOON_COMPRESSION_ZLIB, 0, false};
+        btoon_result_t result = btoon_encode(value, &options);
+        ASSERT_EQ(result.error, nullptr);
+        buffer.insert(buffer.end(), result.data, result.data + result.size);
+        btoon_free_result(result);
+        btoon_value_destroy(value);
+    }
+
+    btoon_stream_decoder_t* decoder =
+        btoon_stream_decoder_create_buffer(buffer.data(), buffer.size(), nullptr);
+    ASSERT_NE(decoder, nullptr);
+    btoon_arena_t* arena = btoon_arena_create(0);
+
+    // One crossing decodes up to the requested count; the short final
+    // batch signals end of stream.
+    btoon_value_t* values[4] = {};
+    const char* error = nullptr;
+    size_t n = btoon_stream_decoder_next_batch(decoder, arena, values, 4, &error);
+    ASSERT_EQ(error, nullptr);
+    ASSERT_EQ(n, 4u);
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(values[i]->type, BTOON_TYPE_UINT);
+        EXPECT_EQ(values[i]->as.u, i * 10);
+    }
+
+    n = btoon_stream_decoder_next_batch(decoder, arena, values, 4, &error);
+    ASSERT_EQ(error, nullptr);
+    ASSERT_EQ(n, 1u);
+    EXPECT_EQ(values[0]->as.u, 40u);
+
+    n = btoon_stream_decoder_next_batch(decoder, arena, values, 4, &error);
+    EXPECT_EQ(n, 0u);
+    EXPECT_EQ(error, nullptr);
+
+    btoon_stream_decoder_destroy(decoder);
+    btoon_arena_destroy(arena);
+}
+
+TEST(CAPITest, StreamDecoderReadsFromFileDescriptor) {
+    btoon_value_t* value = btoon_value_create_string("from fd", 7);
+    btoon_encode_options_t options = {false, BTOON_COMPRESSION_ZLIB, 0, false};
+    btoon_result_t result = btoon_encode(value, &options);
+    ASSERT_EQ(result.error, nullptr);
+
+    const char* path = "test_capi_stream.btoon";
+    FILE* f = fopen(path, "wb");
+    ASSERT_NE(f, nullptr);
+    ASSERT_EQ(fwrite(result.data, 1, result.size, f), result.size);
+    fclose(f);
+
+    f = fopen(path, "rb");
+    ASSERT_NE(f, nullptr);
+    btoon_stream_decoder_t* decoder = btoon_stream_decoder_create_fd(fileno(f), nullptr);
+    ASSERT_NE(decoder, nullptr);
+    btoon_arena_t* arena = btoon_arena_create(0);
+
+    const char* error = nullptr;
+    btoon_value_t* decoded = btoon_stream_decoder_next(decoder, arena, &error);
+    ASSERT_EQ(error, nullptr);
+    ASSERT_NE(decoded, nullptr);
+    ASSERT_EQ(decoded->type, BTOON_TYPE_STRING);
+    EXPECT_EQ(strncmp(decoded->as.s.ptr, "from fd", 7), 0);
+    EXPECT_EQ(btoon_stream_decoder_next(decoder, arena, &error), nullptr);
+
+    btoon_stream_decoder_destroy(decoder);
+    btoon_stream_decoder_destroy(nullptr);  // NULL is a no-op
+    EXPECT_EQ(btoon_stream_decoder_create_fd(-1, nullptr), nullptr);
+    btoon_arena_destroy(arena);
+    fclose(f);
+
+    btoon_value_destroy(value);
+    btoon_free_result(result);
+    remove(path);
+}
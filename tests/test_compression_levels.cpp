@@ -263,3 +263,118 @@ TEST_F(CompressionLevelsTest, ZSTDLevels) {
     }
 }
 #endif
+
+TEST_F(CompressionLevelsTest, DictionaryRegistry) {
+    auto& registry = DictionaryRegistry::instance();
+    registry.clear();
+
+    // ID 0 is reserved for "no dictionary".
+    CompressionDictionary reserved;
+    reserved.id = 0;
+    reserved.data = {1, 2, 3};
+    EXPECT_THROW(registry.registerDictionary(reserved), BtoonException);
+
+    EXPECT_EQ(registry.find(7), nullptr);
+
+    CompressionDictionary dict;
+    dict.id = 7;
+    dict.algorithm = CompressionAlgorithm::ZSTD;
+    dict.data = {1, 2, 3, 4};
+    registry.registerDictionary(dict);
+
+    auto found = registry.find(7);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->data, dict.data);
+
+    // Compressing with an unregistered ID must fail loudly.
+    EXPECT_THROW(compress_with_dictionary(highly_compressible, 99), BtoonException);
+    EXPECT_THROW(decompress_with_dictionary(highly_compressible, 99), BtoonException);
+
+    registry.clear();
+    EXPECT_EQ(registry.find(7), nullptr);
+}
+
+#ifndef BTOON_WITH_ZSTD
+TEST_F(CompressionLevelsTest, DictionaryTrainingRequiresZstd) {
+    std::vector<std::vector<uint8_t>> samples(10, highly_compressible);
+    EXPECT_THROW(train_zstd_dictionary(samples), BtoonException);
+}
+#endif
+
+#ifdef BTOON_WITH_ZSTD
+TEST_F(CompressionLevelsTest, DictionaryTrainingAndRoundTrip) {
+    auto& registry = DictionaryRegistry::instance();
+    registry.clear();
+
+    // Many small, similar messages: the case dictionaries exist for.
+    std::vector<std::vector<uint8_t>> samples;
+    for (int i = 0; i < 200; ++i) {
+        std::string msg = "{\"sensor\":\"node-" + std::to_string(i % 8) +
+                          "\",\"reading\":" + std::to_string(i) +
+                          ",\"unit\":\"celsius\",\"ok\":true}";
+        samples.emplace_back(msg.begin(), msg.end());
+    }
+
+    auto dict = train_zstd_dictionary(samples, 4096, 42);
+    EXPECT_EQ(dict.id, 42);
+    EXPECT_FALSE(dict.data.empty());
+    registry.registerDictionary(dict);
+
+    std::vector<uint8_t> message(samples[0]);
+    auto compressed = compress_with_dictionary(message, 42, 3);
+    auto restored = decompress_with_dictionary(compressed, 42);
+    EXPECT_EQ(restored, message);
+
+    registry.clear();
+}
+
+TEST_F(CompressionLevelsTest, DictionaryEndToEndEncodeDecode) {
+    auto& registry = DictionaryRegistry::instance();
+    registry.clear();
+
+    std::vector<std::vector<uint8_t>> samples;
+    for (int i = 0; i < 200; ++i) {
+        auto encoded = encode(Map{
+            {"id", Int(i)},
+            {"name", String("John Doe")},
+            {"email", String("john.doe@example.com")}
+        });
+        samples.push_back(std::move(encoded));
+    }
+    registry.registerDictionary(train_zstd_dictionary(samples, 4096, 3));
+
+    EncodeOptions options;
+    options.compress = true;
+    options.min_compression_size = 0;
+    options.compression_dictionary_id = 3;
+
+    auto encoded = encode(json_like_data, options);
+    EXPECT_EQ(decode(encoded), json_like_data);
+
+    registry.clear();
+}
+#endif
+
+TEST_F(CompressionLevelsTest, AlgorithmSelectionIsSampled) {
+    // Random bytes must be classified as not worth compressing.
+    EXPECT_EQ(select_best_algorithm(random_data), CompressionAlgorithm::NONE);
+
+    // Repetitive data must select an actual codec.
+    EXPECT_NE(select_best_algorithm(highly_compressible), CompressionAlgorithm::NONE);
+
+    // Selection samples the payload, so a large blob whose head looks random
+    // but whose bulk is repetitive is still recognized as compressible.
+    std::vector<uint8_t> mixed(random_data.begin(), random_data.end());
+    mixed.resize(8 * 1024 * 1024, 'A');
+    auto start = steady_clock::now();
+    EXPECT_NE(select_best_algorithm(mixed), CompressionAlgorithm::NONE);
+    auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start);
+
+    // A bounded probe should not scale with payload size; allow generous
+    // slack for slow CI machines.
+    EXPECT_LT(elapsed.count(), 100);
+
+    // The ratio estimate orders random above repetitive data.
+    EXPECT_GT(estimate_compression_ratio(CompressionAlgorithm::ZLIB, random_data),
+              estimate_compression_ratio(CompressionAlgorithm::ZLIB, highly_compressible));
+}
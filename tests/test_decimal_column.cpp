@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "btoon/btoon.h"
+#include "btoon/decimal.h"
+#include "btoon/decimal_column.h"
+
+using namespace btoon;
+
+// --- Scalar Decimal ---
+
+TEST(DecimalTest, StringRoundTrip) {
+    EXPECT_EQ(Decimal("123.45").to_string(), "123.45");
+    EXPECT_EQ(Decimal("-0.001").to_string(), "-0.001");
+    EXPECT_EQ(Decimal("1000").to_string(), "1000");
+    EXPECT_THROW(Decimal("12.3.4"), BtoonException);
+    EXPECT_THROW(Decimal("abc"), BtoonException);
+}
+
+TEST(DecimalTest, ExactArithmetic) {
+    // The classic float trap: 0.1 + 0.2
+    EXPECT_EQ(Decimal("0.1") + Decimal("0.2"), Decimal("0.3"));
+    EXPECT_EQ(Decimal("1.00") - Decimal("0.99"), Decimal("0.01"));
+    EXPECT_EQ(Decimal("1.5") * Decimal("2.5"), Decimal("3.75"));
+    EXPECT_EQ(Decimal("1") / Decimal("4"), Decimal("0.25"));
+    EXPECT_THROW(Decimal("1") / Decimal("0"), BtoonException);
+}
+
+TEST(DecimalTest, RoundingAndComparison) {
+    EXPECT_EQ(Decimal("2.345").round(2), Decimal("2.35"));
+    EXPECT_EQ(Decimal("-2.345").round(2), Decimal("-2.35"));
+    EXPECT_EQ(Decimal("2.349").truncate(2), Decimal("2.34"));
+    EXPECT_LT(Decimal("1.99"), Decimal("2"));
+    EXPECT_EQ(Decimal("1.50"), Decimal("1.5"));
+    EXPECT_EQ(Decimal::from_cents(123).to_string(), "1.23");
+    EXPECT_EQ(Decimal("1.234").to_cents(), 123);
+}
+
+TEST(DecimalTest, CurrencyFixedPrecision) {
+    Currency price(Decimal("19.999"));
+    EXPECT_EQ(price.to_string(), "20.00");
+    Currency total = price + Currency(static_cast<int64_t>(150));
+    EXPECT_EQ(total.to_string(true), "$21.50");
+    EXPECT_EQ(total.to_cents(), 2150);
+}
+
+// --- DecimalColumn ---
+
+TEST(DecimalColumnTest, PushBackRescalesToSharedScale) {
+    DecimalColumn column(2);
+    column.push_back(Decimal("1.5"));
+    column.push_back(Decimal("2.345"));  // rounds to 2.35 at scale 2
+    column.push_back(Decimal("10"));
+
+    ASSERT_EQ(column.size(), 3u);
+    EXPECT_EQ(column.mantissas()[0], 150);
+    EXPECT_EQ(column.mantissas()[1], 235);
+    EXPECT_EQ(column.mantissas()[2], 1000);
+    EXPECT_EQ(column.at(1), Decimal("2.35"));
+}
+
+TEST(DecimalColumnTest, SumIsExact) {
+    DecimalColumn column(2);
+    // 0.10 a million times: exact in fixed point, drifts in doubles
+    for (int i = 0; i < 1000000; ++i) {
+        column.push_back_mantissa(10);
+    }
+    EXPECT_EQ(column.sum(), Decimal("100000"));
+}
+
+TEST(DecimalColumnTest, RescaleWidensAndNarrows) {
+    DecimalColumn cents = DecimalColumn::from_values(
+        {Decimal("1.23"), Decimal("4.56")}, 2);
+
+    DecimalColumn subunits = cents.rescaled(4);
+    EXPECT_EQ(subunits.mantissas()[0], 12300);
+    EXPECT_EQ(subunits.at(1), Decimal("4.56"));
+
+    DecimalColumn narrowed = subunits.rescaled(1);
+    EXPECT_EQ(narrowed.at(0), Decimal("1.2"));
+    EXPECT_EQ(narrowed.at(1), Decimal("4.6"));  // half away from zero
+}
+
+TEST(DecimalColumnTest, ThresholdComparisons) {
+    DecimalColumn column = DecimalColumn::from_values(
+        {Decimal("1.00"), Decimal("2.50"), Decimal("3.99")}, 2);
+
+    auto below = column.less_than(Decimal("2.5"));
+    EXPECT_EQ(below, (std::vector<uint8_t>{1, 0, 0}));
+    auto above = column.greater_than(Decimal("2.5"));
+    EXPECT_EQ(above, (std::vector<uint8_t>{0, 0, 1}));
+}
+
+TEST(DecimalColumnTest, EncodesAsExtensionAndRoundTrips) {
+    DecimalColumn column = DecimalColumn::from_values(
+        {Decimal("19.99"), Decimal("-0.05"), Decimal("12345.67")}, 2);
+
+    auto encoded = encode(column.to_value());
+    Value decoded = decode(encoded);
+
+    DecimalColumn restored = DecimalColumn::from_value(decoded);
+    EXPECT_EQ(restored.scale(), 2);
+    ASSERT_EQ(restored.size(), 3u);
+    EXPECT_EQ(restored.at(0), Decimal("19.99"));
+    EXPECT_EQ(restored.at(1), Decimal("-0.05"));
+    EXPECT_EQ(restored.at(2), Decimal("12345.67"));
+    EXPECT_EQ(restored.sum(), Decimal("12365.61"));
+
+    EXPECT_THROW(DecimalColumn::from_value(Value(Int(1))), BtoonException);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "btoon/btoon.h"
+#include "btoon/decoder.h"
 
 using namespace btoon;
 
@@ -87,3 +88,164 @@ TEST(DecoderTest, BoundsChecking) {
     std::vector<uint8_t> data = {0xda, 0x00, 0x10, 'h', 'i'}; 
     EXPECT_THROW(decode(data), BtoonException);
 }
+
+TEST(DecoderTest, IterativeMatchesRecursive) {
+    Map m;
+    m["id"] = Uint(7);
+    m["name"] = String("iterative");
+    m["items"] = Array{Uint(1), Int(-2), Float(3.5), String("x"),
+                       Array{Bool(true), Nil{}}, Map{{"k", Uint(9)}}};
+    m["empty_arr"] = Array{};
+    m["empty_map"] = Map{};
+    auto data = encode(Value(m));
+
+    Decoder decoder;
+    Value recursive = decoder.decode(data);
+    Value iterative = decoder.decodeIterative(data);
+    EXPECT_EQ(iterative, recursive);
+}
+
+TEST(DecoderTest, IterativeHandlesDeepNesting) {
+    // Nested single-element arrays: [[[...nil...]]]. decodeIterative
+    // parses with a bounded stack at any depth, but the returned Value
+    // still destructs recursively, so the depth here is capped at what
+    // ~Value survives (with sanitizer-inflated frames) rather than what
+    // the parser can handle.
+    constexpr size_t kDepth = 5000;
+    std::vector<uint8_t> data(kDepth + 1, 0x91);
+    data[kDepth] = 0xc0;
+
+    Decoder decoder;
+    Value v = decoder.decodeIterative(data);
+    size_t depth = 0;
+    const Value* cur = &v;
+    while (auto* arr = std::get_if<Array>(cur)) {
+        ASSERT_EQ(arr->size(), 1u);
+        cur = &(*arr)[0];
+        ++depth;
+    }
+    EXPECT_EQ(depth, kDepth);
+    EXPECT_TRUE(std::holds_alternative<Nil>(*cur));
+}
+
+TEST(DecoderTest, FixintRunFastPath) {
+    // Large array of fixints exercises the SIMD run-scanning fast path,
+    // including runs broken up by wider integers.
+    Array arr;
+    for (int i = 0; i < 1000; ++i) {
+        arr.push_back(Uint(static_cast<uint64_t>(i % 128)));
+        arr.push_back(Int(-(i % 32) - 1));
+        if (i % 100 == 0) {
+            arr.push_back(Uint(100000));  // forces a uint32 marker mid-run
+        }
+    }
+    auto data = encode(Value(arr));
+
+    Value decoded = decode(data);
+    auto* out = std::get_if<Array>(&decoded);
+    ASSERT_NE(out, nullptr);
+    ASSERT_EQ(out->size(), arr.size());
+    for (size_t i = 0; i < arr.size(); ++i) {
+        EXPECT_EQ((*out)[i], arr[i]) << "mismatch at index " << i;
+    }
+}
+
+TEST(DecoderTest, FlatMapDecodeRoundTrip) {
+    Value doc = Map{
+        {"alpha", Int(-3)},
+        {"beta", String("hello")},
+        {"gamma", Map{{"inner", Bool(true)}}}
+    };
+    auto encoded = encode(doc);
+
+    Decoder decoder;
+    decoder.setFlatMaps(true);
+    Value decoded = decoder.decode(encoded);
+
+    auto* flat = std::get_if<FlatMap>(&decoded);
+    ASSERT_NE(flat, nullptr);
+    EXPECT_EQ(flat->size(), 3u);
+    EXPECT_EQ(flat->at("beta"), Value(String("hello")));
+    auto* inner = std::get_if<FlatMap>(&flat->at("gamma"));
+    ASSERT_NE(inner, nullptr);
+    EXPECT_EQ(inner->at("inner"), Value(Bool(true)));
+    EXPECT_FALSE(flat->contains("missing"));
+    EXPECT_THROW(flat->at("missing"), std::out_of_range);
+
+    // Re-encoding the flat representation yields the original bytes.
+    auto re_encoded = encode(decoded);
+    EXPECT_EQ(re_encoded, encoded);
+}
+
+TEST(DecoderTest, FlatMapIterativeMatchesRecursive) {
+    Value doc = Map{
+        {"k1", Array{Int(1), Map{{"deep", String("v")}}}},
+        {"k2", Nil{}}
+    };
+    auto encoded = encode(doc);
+
+    Decoder decoder;
+    decoder.setFlatMaps(true);
+    Value recursive = decoder.decode(encoded);
+    Value iterative = decoder.decodeIterative(encoded);
+    EXPECT_EQ(recursive, iterative);
+    EXPECT_TRUE(std::holds_alternative<FlatMap>(iterative));
+}
+
+TEST(DecoderTest, FlatMapKeepsSortedInvariant) {
+    FlatMap map;
+    map.insert_or_assign("zebra", Value(Int(1)));
+    map.insert_or_assign("apple", Value(Int(2)));
+    map.insert_or_assign("mango", Value(Int(3)));
+    map.insert_or_assign("apple", Value(Int(4)));  // overwrite
+
+    ASSERT_EQ(map.size(), 3u);
+    EXPECT_EQ(map.entries[0].first, "apple");
+    EXPECT_EQ(map.entries[2].first, "zebra");
+    EXPECT_EQ(map.at("apple"), Value(Int(4)));
+    map["new_key"] = Value(Bool(true));
+    EXPECT_EQ(map.entries[1].first, "mango");
+
+    // Encoding a FlatMap matches the std::map encoding of the same contents.
+    Value as_flat = map;
+    Value as_tree = Map{
+        {"apple", Int(4)}, {"mango", Int(3)}, {"new_key", Bool(true)}, {"zebra", Int(1)}
+    };
+    std::get<Map>(as_tree)["new_key"] = Value(Bool(true));
+    EXPECT_EQ(encode(as_flat), encode(as_tree));
+}
+
+TEST(DecoderTest, SmallTelemetryRecordRoundTrip) {
+    // Representative small-object-heavy record: short strings sit in the
+    // string's inline storage after decode, so no per-field heap traffic.
+    Value record = Map{
+        {"dev", String("edge-07")},
+        {"seq", Uint(4711)},
+        {"ok", Bool(true)},
+        {"tag", Binary{0xde, 0xad}},
+        {"vals", Array{Int(-1), Int(0), Int(1)}}
+    };
+    auto encoded = encode(record);
+
+    Decoder decoder;
+    Value decoded = decoder.decode(encoded);
+    auto* map = std::get_if<Map>(&decoded);
+    ASSERT_NE(map, nullptr);
+    EXPECT_EQ((*map)["dev"], Value(String("edge-07")));
+    EXPECT_EQ((*map)["tag"], Value(Binary{0xde, 0xad}));
+    EXPECT_EQ(encode(decoded), encoded);
+}
+
+TEST(DecoderTest, DuplicateMapKeysLastWins) {
+    // Hand-built fixmap {"a": 1, "a": 2}: both decode paths must keep the
+    // last occurrence, matching the historical operator[] behavior.
+    std::vector<uint8_t> payload = {0x82, 0xa1, 'a', 0x01, 0xa1, 'a', 0x02};
+    Decoder decoder;
+    Value recursive = decoder.decode(payload);
+    Value iterative = decoder.decodeIterative(payload);
+    auto* map = std::get_if<Map>(&recursive);
+    ASSERT_NE(map, nullptr);
+    ASSERT_EQ(map->size(), 1u);
+    EXPECT_EQ((*map)["a"], Value(Uint(2)));
+    EXPECT_EQ(recursive, iterative);
+}
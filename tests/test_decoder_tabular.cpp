@@ -1,6 +1,7 @@
 
 #include <gtest/gtest.h>
 #include "btoon/btoon.h"
+#include "btoon/decoder.h"
 
 using namespace btoon;
 
@@ -58,3 +59,148 @@ TEST(DecoderTest, DecodeTabular) {
         ADD_FAILURE() << "Unexpected type for column 'b' in row 2";
     }
 }
+
+TEST(DecoderTest, DecodeColumnsProjectsRequestedColumns) {
+    Array rows;
+    for (int i = 0; i < 10; ++i) {
+        rows.push_back(Map{
+            {"a", Int(i)},
+            {"b", String("b_" + std::to_string(i))},
+            {"c", Float(i * 1.5)}
+        });
+    }
+    auto encoded = encode(Value(rows));
+
+    Decoder decoder;
+    Array projected = decoder.decodeColumns(encoded, {"a", "c"});
+    ASSERT_EQ(projected.size(), rows.size());
+    for (size_t i = 0; i < projected.size(); ++i) {
+        auto* row = std::get_if<Map>(&projected[i]);
+        ASSERT_NE(row, nullptr);
+        EXPECT_EQ(row->size(), 2u);
+        EXPECT_EQ(row->count("b"), 0u);
+        EXPECT_EQ((*row)["c"], Value(Float(static_cast<double>(i) * 1.5)));
+    }
+}
+
+TEST(DecoderTest, DecodeColumnsUnknownColumnThrows) {
+    Array rows = {
+        Map{{"a", Int(1)}, {"b", Int(2)}},
+        Map{{"a", Int(3)}, {"b", Int(4)}}
+    };
+    auto encoded = encode(Value(rows));
+
+    Decoder decoder;
+    EXPECT_THROW(decoder.decodeColumns(encoded, {"missing"}), BtoonException);
+}
+
+TEST(DecoderTest, DecodeColumnsFromChunkedPayload) {
+    Array rows;
+    for (int i = 0; i < 120; ++i) {
+        rows.push_back(Map{
+            {"id", Int(i)},
+            {"payload", String(std::string(64, static_cast<char>('a' + i % 26)))}
+        });
+    }
+    EncodeOptions opts;
+    opts.columnar_row_group_size = 50;
+    opts.columnar_column_compression["payload"] = CompressionAlgorithm::ZLIB;
+    auto encoded = encode(Value(rows), opts);
+
+    Decoder decoder;
+    Array projected = decoder.decodeColumns(encoded, {"id"});
+    ASSERT_EQ(projected.size(), rows.size());
+    auto* row = std::get_if<Map>(&projected[119]);
+    ASSERT_NE(row, nullptr);
+    EXPECT_EQ(row->size(), 1u);
+    // Small positive ints round-trip as Uint (positive fixint encoding).
+    EXPECT_EQ((*row)["id"], Value(Uint(119)));
+}
+
+TEST(DecoderTest, DecodeColumnsFromValidityBitmapPayload) {
+    Array rows;
+    for (int i = 0; i < 30; ++i) {
+        rows.push_back(Map{
+            {"v", (i % 6 == 0) ? Value(Nil{}) : Value(Float(i * 2.5))},
+            {"label", Value(String("label_" + std::to_string(i)))}
+        });
+    }
+    EncodeOptions opts;
+    opts.columnar_validity_bitmaps = true;
+    auto encoded = encode(Value(rows), opts);
+
+    Decoder decoder;
+    Array projected = decoder.decodeColumns(encoded, {"v"});
+    ASSERT_EQ(projected.size(), rows.size());
+    for (int i = 0; i < 30; ++i) {
+        auto* row = std::get_if<Map>(&projected[i]);
+        ASSERT_NE(row, nullptr);
+        EXPECT_EQ(row->size(), 1u);
+        if (i % 6 == 0) {
+            EXPECT_TRUE(std::holds_alternative<Nil>((*row)["v"]));
+        } else {
+            EXPECT_EQ((*row)["v"], Value(Float(i * 2.5)));
+        }
+    }
+}
+
+TEST(DecoderTest, DictionaryColumnExposesIndicesWhenRequested) {
+    Array rows;
+    const char* labels[] = {"red", "green", "blue"};
+    for (int i = 0; i < 30; ++i) {
+        rows.push_back(Map{
+            {"color", (i % 10 == 9) ? Value(Nil{}) : Value(String(labels[i % 3]))}
+        });
+    }
+    EncodeOptions opts;
+    opts.columnar_validity_bitmaps = true;
+    auto encoded = encode(Value(rows), opts);
+
+    Decoder decoder;
+    decoder.setDictionaryIndices(true);
+    Value decoded = decoder.decode(encoded);
+    auto* out = std::get_if<Array>(&decoded);
+    ASSERT_NE(out, nullptr);
+    ASSERT_EQ(out->size(), rows.size());
+
+    // Equal strings must map to equal indices, distinct ones to distinct
+    // indices, and every index must be in range of the 3-entry dictionary.
+    std::map<std::string, Uint> seen;
+    for (int i = 0; i < 30; ++i) {
+        auto* row = std::get_if<Map>(&(*out)[i]);
+        ASSERT_NE(row, nullptr);
+        if (i % 10 == 9) {
+            EXPECT_TRUE(std::holds_alternative<Nil>((*row)["color"]));
+            continue;
+        }
+        auto* index = std::get_if<Uint>(&(*row)["color"]);
+        ASSERT_NE(index, nullptr);
+        EXPECT_LT(*index, 3u);
+        auto [it, inserted] = seen.emplace(labels[i % 3], *index);
+        EXPECT_EQ(it->second, *index);
+    }
+    EXPECT_EQ(seen.size(), 3u);
+}
+
+TEST(DecoderTest, DecodeColumnsProjectsDictionaryColumn) {
+    Array rows;
+    for (int i = 0; i < 50; ++i) {
+        rows.push_back(Map{
+            {"kind", String(i % 2 == 0 ? "sensor" : "actuator")},
+            {"reading", Float(i * 0.5)}
+        });
+    }
+    EncodeOptions opts;
+    opts.columnar_validity_bitmaps = true;
+    auto encoded = encode(Value(rows), opts);
+
+    Decoder decoder;
+    Array projected = decoder.decodeColumns(encoded, {"kind"});
+    ASSERT_EQ(projected.size(), rows.size());
+    for (int i = 0; i < 50; ++i) {
+        auto* row = std::get_if<Map>(&projected[i]);
+        ASSERT_NE(row, nullptr);
+        EXPECT_EQ(row->size(), 1u);
+        EXPECT_EQ((*row)["kind"], Value(String(i % 2 == 0 ? "sensor" : "actuator")));
+    }
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "btoon/delta_codec.h"
+
+using namespace btoon;
+
+namespace {
+
+Array int_array(std::initializer_list<int64_t> values) {
+    Array data;
+    for (int64_t v : values) {
+        data.push_back(Value(Int(v)));
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(DeltaCodecTest, PlainDeltaRoundTrip) {
+    auto data = int_array({100, 105, 110, 108, 200, -5, 0, 7});
+    auto encoded = DeltaCodec::encode(data);
+    auto decoded = DeltaCodec::decode(encoded);
+    ASSERT_EQ(decoded.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(std::get<Int>(decoded[i]), std::get<Int>(data[i]));
+    }
+}
+
+TEST(DeltaCodecTest, DeltaOfDeltaRoundTrip) {
+    auto data = int_array({1000, 1010, 1020, 1030, 1041, 1050, 1060, 1069,
+                           1080, 1090, 1100, 1110, 1500, 1400, -20});
+    auto encoded = DeltaCodec::encode_delta_of_delta(data);
+    auto decoded = DeltaCodec::decode_delta_of_delta(encoded);
+    ASSERT_EQ(decoded.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(std::get<Int>(decoded[i]), std::get<Int>(data[i])) << "at " << i;
+    }
+}
+
+TEST(DeltaCodecTest, DeltaOfDeltaEdgeSizes) {
+    EXPECT_TRUE(DeltaCodec::decode_delta_of_delta(
+                    DeltaCodec::encode_delta_of_delta({}))
+                    .empty());
+
+    auto one = int_array({-42});
+    auto decoded_one =
+        DeltaCodec::decode_delta_of_delta(DeltaCodec::encode_delta_of_delta(one));
+    ASSERT_EQ(decoded_one.size(), 1u);
+    EXPECT_EQ(std::get<Int>(decoded_one[0]), -42);
+
+    auto two = int_array({5, -1000000});
+    auto decoded_two =
+        DeltaCodec::decode_delta_of_delta(DeltaCodec::encode_delta_of_delta(two));
+    ASSERT_EQ(decoded_two.size(), 2u);
+    EXPECT_EQ(std::get<Int>(decoded_two[1]), -1000000);
+}
+
+TEST(DeltaCodecTest, DeltaOfDeltaIsCompactForRegularTimestamps) {
+    // 1kHz timestamps with occasional 1ms jitter: delta-of-deltas are almost
+    // all zero, so each should cost about one byte.
+    Array timestamps;
+    int64_t ts = 1700000000000;
+    for (int i = 0; i < 1000; ++i) {
+        ts += 1000 + (i % 97 == 0 ? 1 : 0);
+        timestamps.push_back(Value(Int(ts)));
+    }
+
+    auto dod = DeltaCodec::encode_delta_of_delta(timestamps);
+    auto plain = DeltaCodec::encode(timestamps);
+    EXPECT_LT(dod.size(), plain.size());
+    EXPECT_LE(dod.size(), timestamps.size() + 16);
+
+    auto decoded = DeltaCodec::decode_delta_of_delta(dod);
+    ASSERT_EQ(decoded.size(), timestamps.size());
+    EXPECT_EQ(std::get<Int>(decoded.back()), std::get<Int>(timestamps.back()));
+}
+
+TEST(DeltaCodecTest, DeltaOfDeltaRejectsTruncatedInput) {
+    auto data = int_array({1, 1000000, 2000000});
+    auto encoded = DeltaCodec::encode_delta_of_delta(data);
+    encoded.resize(2);  // cut into the middle of the multi-byte first delta
+    EXPECT_THROW(DeltaCodec::decode_delta_of_delta(encoded), BtoonException);
+}
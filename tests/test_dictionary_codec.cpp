@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "btoon/dictionary_codec.h"
+
+using namespace btoon;
+
+namespace {
+
+Array string_array(std::initializer_list<const char*> values) {
+    Array data;
+    for (const char* v : values) {
+        data.push_back(Value(String(v)));
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(DictionaryCodecTest, StaticRoundTrip) {
+    auto data = string_array({"alpha", "beta", "alpha", "gamma", "beta", "alpha"});
+    auto decoded = DictionaryCodec::decode(DictionaryCodec::encode(data));
+    ASSERT_EQ(decoded.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(std::get<String>(decoded[i]), std::get<String>(data[i]));
+    }
+}
+
+TEST(StreamingDictionaryCodecTest, DictionaryPersistsAcrossMessages) {
+    StreamingDictionaryCodec encoder;
+    StreamingDictionaryCodec decoder;
+
+    auto first = string_array({"user_id", "timestamp", "status", "user_id"});
+    auto second = string_array({"status", "timestamp", "user_id", "status"});
+
+    auto msg1 = encoder.encode(first);
+    auto msg2 = encoder.encode(second);
+    EXPECT_EQ(encoder.dictionary_size(), 3u);
+
+    // The second message repeats only known values, so it carries no
+    // entries — just one-byte indices.
+    EXPECT_LT(msg2.size(), msg1.size());
+    EXPECT_LE(msg2.size(), 2u + second.size());
+
+    auto out1 = decoder.decode(msg1);
+    auto out2 = decoder.decode(msg2);
+    EXPECT_EQ(decoder.dictionary_size(), 3u);
+    ASSERT_EQ(out1.size(), first.size());
+    ASSERT_EQ(out2.size(), second.size());
+    for (size_t i = 0; i < second.size(); ++i) {
+        EXPECT_EQ(std::get<String>(out2[i]), std::get<String>(second[i]));
+    }
+}
+
+TEST(StreamingDictionaryCodecTest, RepeatedKeysAmortizeToOneByte) {
+    StreamingDictionaryCodec encoder;
+
+    Array keys = string_array({"field_one", "field_two", "field_three"});
+    encoder.encode(keys);  // learn
+
+    // A thousand repetitions of the learned keys: ~1 byte per reference.
+    Array repeated;
+    for (int i = 0; i < 1000; ++i) {
+        for (const auto& key : keys) {
+            repeated.push_back(key);
+        }
+    }
+    auto msg = encoder.encode(repeated);
+    EXPECT_LE(msg.size(), repeated.size() + 4);
+}
+
+TEST(StreamingDictionaryCodecTest, RejectsUnknownIndex) {
+    StreamingDictionaryCodec encoder;
+    auto msg = encoder.encode(string_array({"a", "b"}));
+
+    // A fresh decoder that missed the first message must refuse indices
+    // pointing past its dictionary.
+    StreamingDictionaryCodec decoder;
+    decoder.decode(msg);
+    auto msg2 = encoder.encode(string_array({"a", "b", "a"}));
+    StreamingDictionaryCodec stale;
+    EXPECT_THROW(stale.decode(msg2), BtoonException);
+}
+
+TEST(StreamingDictionaryCodecTest, ClearForgetsTheDictionary) {
+    StreamingDictionaryCodec codec;
+    codec.encode(string_array({"x", "y"}));
+    EXPECT_EQ(codec.dictionary_size(), 2u);
+    codec.clear();
+    EXPECT_EQ(codec.dictionary_size(), 0u);
+
+    auto msg = codec.encode(string_array({"x"}));
+    StreamingDictionaryCodec decoder;
+    auto out = decoder.decode(msg);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(std::get<String>(out[0]), "x");
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "btoon/btoon.h"
+#include "btoon/document_cursor.h"
+
+using namespace btoon;
+
+namespace {
+
+std::vector<uint8_t> encode_sample_map() {
+    Map m;
+    m["id"] = Uint(42);
+    m["name"] = String("btoon");
+    m["score"] = Float(2.5);
+    m["tags"] = Array{String("a"), String("b"), String("c")};
+    m["nested"] = Map{{"inner", Uint(7)}};
+    return encode(Value(m));
+}
+
+} // namespace
+
+TEST(DocumentCursorTest, TypeOfRoot) {
+    auto data = encode_sample_map();
+    DocumentCursor cursor(data);
+    EXPECT_EQ(cursor.type(), DocumentCursor::Type::Map);
+    EXPECT_EQ(cursor.size(), 5u);
+}
+
+TEST(DocumentCursorTest, FindDecodesOnlyRequestedField) {
+    auto data = encode_sample_map();
+    DocumentCursor cursor(data);
+
+    auto name = cursor.find("name");
+    ASSERT_TRUE(name.valid());
+    EXPECT_EQ(name.type(), DocumentCursor::Type::String);
+    auto view = name.value();
+    ASSERT_TRUE(std::holds_alternative<std::string_view>(view));
+    EXPECT_EQ(std::get<std::string_view>(view), "btoon");
+}
+
+TEST(DocumentCursorTest, FindMissingKeyReturnsInvalidCursor) {
+    auto data = encode_sample_map();
+    DocumentCursor cursor(data);
+
+    auto missing = cursor.find("absent");
+    EXPECT_FALSE(missing.valid());
+    EXPECT_THROW(missing.value(), BtoonException);
+}
+
+TEST(DocumentCursorTest, NestedNavigation) {
+    auto data = encode_sample_map();
+    DocumentCursor cursor(data);
+
+    auto inner = cursor.find("nested").find("inner");
+    ASSERT_TRUE(inner.valid());
+    auto view = inner.value();
+    ASSERT_TRUE(std::holds_alternative<Uint>(view));
+    EXPECT_EQ(std::get<Uint>(view), 7u);
+}
+
+TEST(DocumentCursorTest, ArrayIndexing) {
+    auto data = encode_sample_map();
+    DocumentCursor cursor(data);
+
+    auto tags = cursor.find("tags");
+    ASSERT_TRUE(tags.valid());
+    EXPECT_EQ(tags.type(), DocumentCursor::Type::Array);
+    EXPECT_EQ(tags.size(), 3u);
+
+    auto second = tags.at(1);
+    auto view = second.value();
+    ASSERT_TRUE(std::holds_alternative<std::string_view>(view));
+    EXPECT_EQ(std::get<std::string_view>(view), "b");
+
+    EXPECT_THROW(tags.at(3), BtoonException);
+}
+
+TEST(DocumentCursorTest, RawReturnsEncodedSubtree) {
+    auto data = encode_sample_map();
+    DocumentCursor cursor(data);
+
+    auto tags = cursor.find("tags");
+    auto raw = tags.raw();
+    ASSERT_FALSE(raw.empty());
+
+    // Re-decoding the raw bytes yields the original subtree.
+    Value roundtrip = decode(raw);
+    auto* arr = std::get_if<Array>(&roundtrip);
+    ASSERT_NE(arr, nullptr);
+    ASSERT_EQ(arr->size(), 3u);
+    EXPECT_EQ(std::get<String>((*arr)[0]), "a");
+}
+
+TEST(DocumentCursorTest, ScalarLeaves) {
+    auto data = encode_sample_map();
+    DocumentCursor cursor(data);
+
+    auto id = cursor.find("id").value();
+    ASSERT_TRUE(std::holds_alternative<Uint>(id));
+    EXPECT_EQ(std::get<Uint>(id), 42u);
+
+    auto score = cursor.find("score").value();
+    ASSERT_TRUE(std::holds_alternative<Float>(score));
+    EXPECT_DOUBLE_EQ(std::get<Float>(score), 2.5);
+}
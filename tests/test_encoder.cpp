@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "btoon/btoon.h"
+#include "btoon/encoder.h"
+#include "btoon/decoder.h"
 
 using namespace btoon;
 
@@ -114,3 +116,135 @@ TEST(EncoderTest, RoundTrip) {
     ASSERT_NE(str, nullptr);
     EXPECT_EQ(*str, "x");
 }
+
+TEST(EncoderTest, ResetReusesEncoder) {
+    Encoder encoder;
+    encoder.encode(Value(String("first message")));
+    auto first = encoder.takeBuffer();
+
+    encoder.encode(Value(String("second message")));
+    auto second = encoder.takeBuffer();
+
+    Encoder fresh;
+    fresh.encode(Value(String("second message")));
+    auto reference = fresh.getBuffer();
+    ASSERT_EQ(second.size(), reference.size());
+    EXPECT_TRUE(std::equal(second.begin(), second.end(), reference.begin()));
+    EXPECT_NE(first, second);
+}
+
+TEST(EncoderTest, TakeBufferReturnsOwnedMessage) {
+    Encoder encoder;
+    encoder.encode(Value(Int(-1234567)));
+    auto taken = encoder.takeBuffer();
+    // The encoder is reset: the next message starts from scratch.
+    EXPECT_TRUE(encoder.getBuffer().empty());
+
+    Decoder decoder;
+    EXPECT_EQ(decoder.decode(taken), Value(Int(-1234567)));
+}
+
+TEST(EncoderTest, ResetWithSharedMemoryPool) {
+    MemoryPool pool;
+    Encoder encoder(&pool);
+    for (int i = 0; i < 100; ++i) {
+        encoder.encode(Value(Array{Int(i), String("msg_" + std::to_string(i))}));
+        auto message = encoder.takeBuffer();
+        Decoder decoder;
+        Value decoded = decoder.decode(message);
+        auto* arr = std::get_if<Array>(&decoded);
+        ASSERT_NE(arr, nullptr);
+        EXPECT_EQ((*arr)[1], Value(String("msg_" + std::to_string(i))));
+    }
+}
+
+TEST(EncoderTest, ConsumingEncodeMatchesCopyingEncode) {
+    auto make_doc = [] {
+        return Value(Map{
+            {"meta", Map{{"id", Int(7)}, {"ok", Bool(true)}}},
+            {"blob", Binary(1024, 0xab)},
+            {"tags", Array{String("x"), String("y"), Nil{}}},
+            {"title", String(std::string(300, 'q'))}
+        });
+    };
+
+    Encoder copying;
+    Value doc = make_doc();
+    copying.encode(doc);
+    auto reference = copying.getBuffer();
+
+    Encoder consuming;
+    consuming.encode(make_doc());
+    auto moved = consuming.getBuffer();
+
+    ASSERT_EQ(moved.size(), reference.size());
+    EXPECT_TRUE(std::equal(moved.begin(), moved.end(), reference.begin()));
+}
+
+TEST(EncoderTest, ConsumingEncodeRoundTrip) {
+    Value doc = Array{
+        Map{{"a", Int(1)}, {"b", String("x")}},
+        Map{{"a", Int(2)}, {"b", String("y")}}
+    };
+    Value copy = doc;
+
+    Encoder encoder;
+    encoder.encode(std::move(copy));
+    Decoder decoder;
+    Value decoded = decoder.decode(encoder.getBuffer());
+    auto* arr = std::get_if<Array>(&decoded);
+    ASSERT_NE(arr, nullptr);
+    ASSERT_EQ(arr->size(), 2u);
+    auto* row = std::get_if<Map>(&(*arr)[1]);
+    ASSERT_NE(row, nullptr);
+    EXPECT_EQ((*row)["b"], Value(String("y")));
+}
+
+TEST(EncoderTest, VectoredEncodeMatchesContiguous) {
+    Value doc = Map{
+        {"blob", Binary(4096, 0x5a)},
+        {"id", Int(99)},
+        {"note", String(std::string(1000, 'n'))},
+        {"small", String("tiny")}
+    };
+
+    Encoder contiguous;
+    contiguous.encode(doc);
+    auto reference = contiguous.getBuffer();
+
+    VectoredEncoder vectored;
+    auto segments = vectored.encode(doc);
+    ASSERT_EQ(vectored.total_size(), reference.size());
+
+    std::vector<uint8_t> joined;
+    for (const auto& segment : segments) {
+        joined.insert(joined.end(), segment.begin(), segment.end());
+    }
+    ASSERT_EQ(joined.size(), reference.size());
+    EXPECT_TRUE(std::equal(joined.begin(), joined.end(), reference.begin()));
+}
+
+TEST(EncoderTest, VectoredEncodeReferencesBlobsInPlace) {
+    Value doc = Map{{"payload", Binary(1 << 20, 0xcd)}};
+    const Binary& stored = std::get<Binary>(std::get<Map>(doc).at("payload"));
+    const uint8_t* blob_data = stored.data();
+
+    VectoredEncoder vectored;
+    auto segments = vectored.encode(doc);
+
+    // One of the segments must alias the blob's own storage — no copy.
+    bool referenced = false;
+    for (const auto& segment : segments) {
+        if (segment.data() == blob_data && segment.size() == stored.size()) {
+            referenced = true;
+        }
+    }
+    EXPECT_TRUE(referenced);
+}
+
+TEST(EncoderTest, VectoredEncodeSmallValuesSingleSegment) {
+    Value doc = Map{{"a", Int(1)}, {"b", String("xy")}};
+    VectoredEncoder vectored;
+    auto segments = vectored.encode(doc);
+    EXPECT_EQ(segments.size(), 1u);
+}
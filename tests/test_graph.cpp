@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "btoon/graph.h"
+#include "btoon/encoder.h"
+#include "btoon/decoder.h"
+
+using namespace btoon;
+using namespace btoon::graph;
+
+namespace {
+
+std::string temp_graph_file(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}  // namespace
+
+TEST(GraphTest, FreezeBuildsSortedCsrAdjacency) {
+    Graph<std::string> g;
+    g.add_edge("b", "a");
+    g.add_edge("b", "c");
+    g.add_edge("a", "c");
+    g.add_edge("c", "a");
+
+    auto csr = g.freeze();
+    ASSERT_EQ(csr.node_count(), 3u);
+    EXPECT_EQ(csr.edge_count(), 4u);
+
+    // Ids are sorted, so the layout is deterministic: a=0, b=1, c=2.
+    EXPECT_EQ(csr.id_of(0), "a");
+    EXPECT_EQ(csr.index_of("c"), 2u);
+    EXPECT_EQ(csr.index_of("missing"), (CsrGraph<std::string>::kNoNode));
+
+    auto b_neighbors = csr.neighbors(1);
+    ASSERT_EQ(b_neighbors.size(), 2u);
+    EXPECT_EQ(b_neighbors[0], 0u);  // a
+    EXPECT_EQ(b_neighbors[1], 2u);  // c
+    EXPECT_TRUE(csr.neighbors(0).size() == 1 && csr.neighbors(0)[0] == 2u);
+}
+
+TEST(GraphTest, UndirectedEdgesAppearBothWays) {
+    Graph<std::string> g(GraphType::UNDIRECTED);
+    g.add_edge("x", "y", 2.5);
+
+    EXPECT_TRUE(g.has_edge("x", "y"));
+    EXPECT_TRUE(g.has_edge("y", "x"));
+    EXPECT_EQ(g.edge_count(), 1u);
+    EXPECT_EQ(g.get_edge_weight("y", "x"), 2.5);
+
+    auto csr = g.freeze();
+    EXPECT_EQ(csr.edge_count(), 2u);  // stored once per direction
+    EXPECT_EQ(csr.weights(0)[0], 2.5);
+}
+
+TEST(GraphTest, BfsParentsOverCsr) {
+    // 0-1-2-3 path plus an isolated node 4.
+    Graph<size_t> g;
+    g.add_edge(0, 1);
+    g.add_edge(1, 2);
+    g.add_edge(2, 3);
+    g.add_node(4);
+
+    auto csr = g.freeze();
+    auto parents = csr.bfs_parents(0);
+    ASSERT_EQ(parents.size(), 5u);
+    EXPECT_EQ(parents[0], 0u);
+    EXPECT_EQ(parents[1], 0u);
+    EXPECT_EQ(parents[2], 1u);
+    EXPECT_EQ(parents[3], 2u);
+    EXPECT_EQ(parents[4], (CsrGraph<size_t>::kNoNode));
+
+    auto parent_map = g.bfs(0);
+    EXPECT_EQ(parent_map.size(), 4u);  // node 4 unreached
+    EXPECT_EQ(parent_map.at(3), 2u);
+}
+
+TEST(GraphTest, DijkstraOverCsrPrefersLighterPath) {
+    Graph<std::string> g;
+    g.add_edge("s", "a", 1.0);
+    g.add_edge("a", "t", 1.0);
+    g.add_edge("s", "t", 5.0);
+
+    auto distances = g.dijkstra("s");
+    ASSERT_EQ(distances.size(), 3u);
+    EXPECT_EQ(distances.at("t"), 2.0);
+    EXPECT_EQ(distances.at("a"), 1.0);
+}
+
+TEST(GraphMetricsTest, PagerankRanksHubHighest) {
+    // Every node links to "hub"; hub links back to one node.
+    Graph<std::string> g;
+    for (const char* name : {"a", "b", "c", "d"}) {
+        g.add_edge(name, "hub");
+    }
+    g.add_edge("hub", "a");
+
+    auto ranks = GraphMetrics::pagerank(g);
+    ASSERT_EQ(ranks.size(), 5u);
+    double sum = 0.0;
+    for (const auto& [id, rank] : ranks) {
+        sum += rank;
+        if (id != "hub") {
+            EXPECT_LT(rank, ranks.at("hub"));
+        }
+    }
+    EXPECT_NEAR(sum, 1.0, 1e-9);
+}
+
+TEST(CsrFileTest, MmapRoundTripRunsAlgorithmsOverMappedArrays) {
+    Graph<std::string> g;
+    g.add_edge("s", "a", 1.0);
+    g.add_edge("a", "t", 1.0);
+    g.add_edge("s", "t", 5.0);
+    g.add_node("lonely");
+    auto csr = g.freeze();
+
+    auto path = temp_graph_file("btoon_csr_graph.bin");
+    csr_file::write(csr, path);
+
+    auto file = MemoryMappedFile::open(path);
+    ASSERT_NE(file, nullptr);
+    ASSERT_TRUE(csr_file::MappedCsrGraph::is_csr_file(file->view().span()));
+    auto mapped = csr_file::MappedCsrGraph::open(*file);
+
+    ASSERT_EQ(mapped.node_count(), csr.node_count());
+    ASSERT_EQ(mapped.edge_count(), csr.edge_count());
+    for (uint32_t v = 0; v < mapped.node_count(); ++v) {
+        EXPECT_EQ(mapped.id_of(v), csr.id_of(v));
+        ASSERT_EQ(mapped.neighbors(v).size(), csr.neighbors(v).size());
+        for (size_t i = 0; i < mapped.neighbors(v).size(); ++i) {
+            EXPECT_EQ(mapped.neighbors(v)[i], csr.neighbors(v)[i]);
+            EXPECT_EQ(mapped.weights(v)[i], csr.weights(v)[i]);
+        }
+    }
+    EXPECT_EQ(mapped.index_of("t"), csr.index_of("t"));
+    EXPECT_EQ(mapped.index_of("zzz"), csr_file::MappedCsrGraph::kNoNode);
+
+    uint32_t src = mapped.index_of("s");
+    EXPECT_EQ(mapped.bfs_parents(src), csr.bfs_parents(src));
+    auto distances = mapped.dijkstra(src);
+    EXPECT_EQ(distances[mapped.index_of("t")], 2.0);
+
+    std::filesystem::remove(path);
+}
+
+TEST(CsrFileTest, PropertyBlobsDecodeOnDemand) {
+    Graph<std::string> g;
+    g.add_edge("a", "b", 1.0);
+    auto csr = g.freeze();
+
+    Encoder encoder;
+    Map props;
+    props.emplace("kind", Value(String("test")));
+    encoder.encode(Value(props));
+    auto node_blob = encoder.takeBuffer();
+
+    auto bytes = csr_file::encode(csr, node_blob);
+    auto mapped = csr_file::MappedCsrGraph::open(bytes);
+    ASSERT_EQ(mapped.node_properties().size(), node_blob.size());
+    EXPECT_TRUE(mapped.edge_properties().empty());
+
+    Decoder decoder;
+    auto decoded = decoder.decode(std::vector<uint8_t>(
+        mapped.node_properties().begin(), mapped.node_properties().end()));
+    const auto& map = std::get<Map>(decoded);
+    EXPECT_EQ(std::get<String>(map.at("kind")), "test");
+}
+
+TEST(CsrFileTest, RejectsForeignAndTruncatedBuffers) {
+    std::vector<uint8_t> junk(128, 0x42);
+    EXPECT_FALSE(csr_file::MappedCsrGraph::is_csr_file(junk));
+    EXPECT_THROW(csr_file::MappedCsrGraph::open(junk), BtoonException);
+
+    Graph<std::string> g;
+    g.add_edge("a", "b", 1.0);
+    auto bytes = csr_file::encode(g.freeze());
+    bytes.resize(bytes.size() / 2);
+    EXPECT_THROW(csr_file::MappedCsrGraph::open(bytes), BtoonException);
+
+    // A node count whose (n + 1) * 8 section size wraps to a tiny value
+    // must fail the bounds checks, not slip past them.
+    auto wrapped = csr_file::encode(g.freeze());
+    uint64_t huge_n = uint64_t{1} << 61;
+    std::memcpy(wrapped.data() + 16, &huge_n, 8);
+    EXPECT_THROW(csr_file::MappedCsrGraph::open(wrapped), BtoonException);
+}
+
+namespace {
+
+PropertyGraph make_entity_graph() {
+    PropertyGraph g;
+    g.add_node({"p1", "person", {{"name", Value(String("ada"))}, {"age", Value(Uint(36))}}});
+    g.add_node({"p2", "person", {{"name", Value(String("grace"))}, {"age", Value(Uint(36))}}});
+    g.add_node({"c1", "company", {{"name", Value(String("acme"))}}});
+    g.add_edge({"e1", "p1", "c1", "works_at", {{"since", Value(Uint(2019))}}});
+    g.add_edge({"e2", "p2", "c1", "works_at", {{"since", Value(Uint(2021))}}});
+    return g;
+}
+
+}  // namespace
+
+TEST(PropertyGraphTest, PropertyIndexBacksQueryNodes) {
+    auto g = make_entity_graph();
+    g.create_node_property_index("name");
+
+    auto hits = g.query_nodes({{"name", Value(String("grace"))}});
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0].id, "p2");
+
+    // Indexed key with no bucket short-circuits to no matches.
+    EXPECT_TRUE(g.query_nodes({{"name", Value(String("nobody"))}}).empty());
+
+    // The index follows mutations.
+    g.update_node_property("p2", "name", Value(String("hopper")));
+    EXPECT_TRUE(g.query_nodes({{"name", Value(String("grace"))}}).empty());
+    ASSERT_EQ(g.query_nodes({{"name", Value(String("hopper"))}}).size(), 1u);
+}
+
+TEST(PropertyGraphTest, IndexLookupCoercesIntAndUint) {
+    auto g = make_entity_graph();
+    g.create_node_property_index("age");
+
+    // Stored as Uint (the decoder's choice for non-negative ints) but
+    // queried as Int: the canonical index key unifies the two.
+    auto hits = g.query_nodes({{"age", Value(Int(36))}});
+    EXPECT_EQ(hits.size(), 2u);
+}
+
+TEST(PropertyGraphTest, PatternMatcherAnchorsOnMostSelectiveConstraint) {
+    auto g = make_entity_graph();
+    g.create_node_property_index("name");
+
+    PropertyGraph::Pattern person;
+    person.node_label = "person";
+    person.properties.emplace("name", Value(String("ada")));
+    PropertyGraph::Pattern works_at;
+    works_at.edge_type = "works_at";
+    PropertyGraph::Pattern company;
+    company.node_label = "company";
+
+    auto matches = g.match_pattern({person, works_at, company});
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(std::get<String>(matches[0].at("node0")), "p1");
+    EXPECT_EQ(std::get<String>(matches[0].at("edge0")), "e1");
+    EXPECT_EQ(std::get<String>(matches[0].at("node1")), "c1");
+
+    // Unconstrained person end: both employees match.
+    PropertyGraph::Pattern any_person;
+    any_person.node_label = "person";
+    EXPECT_EQ(g.match_pattern({any_person, works_at, company}).size(), 2u);
+
+    // Single-node patterns work through the label index alone.
+    EXPECT_EQ(g.match_pattern({company}).size(), 1u);
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "btoon/json_schema.h"
+
+using namespace btoon;
+using namespace btoon::json_schema;
+
+namespace {
+
+JsonSchema make_user_schema() {
+    JsonSchemaProperty name;
+    name.type = {JsonSchemaType::STRING};
+    name.min_length = 1;
+    name.max_length = 64;
+
+    JsonSchemaProperty email;
+    email.type = {JsonSchemaType::STRING};
+    email.format = JsonSchemaFormat::EMAIL;
+
+    JsonSchemaProperty age;
+    age.type = {JsonSchemaType::INTEGER};
+    age.minimum = 0.0;
+    age.maximum = 150.0;
+
+    JsonSchemaProperty tag;
+    tag.type = {JsonSchemaType::STRING};
+    tag.pattern = "^[a-z]+$";
+
+    JsonSchemaProperty tags;
+    tags.type = {JsonSchemaType::ARRAY};
+    tags.items = std::make_shared<JsonSchemaProperty>(tag);
+    tags.unique_items = true;
+
+    JsonSchemaProperty root;
+    root.type = {JsonSchemaType::OBJECT};
+    root.properties = {{"name", name}, {"email", email}, {"age", age}, {"tags", tags}};
+    root.required = {"name", "email"};
+
+    JsonSchema schema;
+    schema.set_root_schema(root);
+    return schema;
+}
+
+}  // namespace
+
+TEST(JsonSchemaValidatorTest, CompiledValidatorChecksConstraintsInDocumentOrder) {
+    JsonSchemaValidator validator(make_user_schema());
+
+    std::vector<std::string> errors;
+    Value valid = Map{{"name", String("ada")},
+                      {"email", String("ada@example.com")},
+                      {"age", Uint(36)},
+                      {"tags", Array{String("math"), String("engines")}}};
+    EXPECT_TRUE(validator.validate(valid, errors));
+    EXPECT_TRUE(errors.empty());
+
+    Value invalid = Map{{"name", String("")},
+                        {"email", String("not-an-email")},
+                        {"age", Int(200)},
+                        {"tags", Array{String("ok"), String("ok")}}};
+    EXPECT_FALSE(validator.validate(invalid, errors));
+    EXPECT_EQ(errors.size(), 4u);
+
+    // The same instance is reusable; nothing is recompiled per document.
+    errors.clear();
+    EXPECT_TRUE(validator.validate(valid, errors));
+}
+
+TEST(JsonSchemaValidatorTest, DetailedErrorsCarryPaths) {
+    JsonSchemaValidator validator(make_user_schema());
+
+    Value missing = Map{{"email", String("ada@example.com")}};
+    std::vector<JsonSchemaValidator::ValidationError> errors;
+    EXPECT_FALSE(validator.validate_detailed(missing, errors));
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(errors[0].path, "$");
+    EXPECT_EQ(errors[0].message, "Missing required property: name");
+    EXPECT_EQ(errors[0].schema_path, "#");
+
+    Value bad_tag = Map{{"name", String("ada")},
+                        {"email", String("ada@example.com")},
+                        {"tags", Array{String("UPPER")}}};
+    errors.clear();
+    EXPECT_FALSE(validator.validate_detailed(bad_tag, errors));
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(errors[0].path, "$.tags[0]");
+    EXPECT_EQ(errors[0].schema_path, "#/properties/tags/items");
+}
+
+TEST(JsonSchemaValidatorTest, RefsResolveOnceIncludingSelfReference) {
+    // A recursive tree: {value: integer, children: [tree, ...]}.
+    JsonSchemaProperty value_prop;
+    value_prop.type = {JsonSchemaType::INTEGER};
+
+    JsonSchemaProperty child_ref;
+    child_ref.ref = "#/$defs/tree";
+
+    JsonSchemaProperty children;
+    children.type = {JsonSchemaType::ARRAY};
+    children.items = std::make_shared<JsonSchemaProperty>(child_ref);
+
+    JsonSchemaProperty tree;
+    tree.type = {JsonSchemaType::OBJECT};
+    tree.properties = {{"value", value_prop}, {"children", children}};
+    tree.required = {"value"};
+
+    JsonSchema schema;
+    schema.add_definition("tree", tree);
+    JsonSchemaProperty root;
+    root.ref = "#/$defs/tree";
+    schema.set_root_schema(root);
+
+    JsonSchemaValidator validator(schema);
+    Value nested = Map{
+        {"value", Int(1)},
+        {"children", Array{Map{{"value", Int(2)}},
+                           Map{{"value", Int(3)},
+                               {"children", Array{Map{{"value", String("oops")}}}}}}}};
+    std::vector<JsonSchemaValidator::ValidationError> errors;
+    EXPECT_FALSE(validator.validate_detailed(nested, errors));
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(errors[0].path, "$.children[1].children[0].value");
+
+    // Unknown references are a compile-time error, not a per-document one.
+    JsonSchema broken;
+    JsonSchemaProperty dangling;
+    dangling.ref = "#/$defs/missing";
+    broken.set_root_schema(dangling);
+    EXPECT_THROW(JsonSchemaValidator{broken}, BtoonException);
+}
+
+TEST(JsonSchemaValidatorTest, CompositionAndConditionals) {
+    JsonSchemaProperty str;
+    str.type = {JsonSchemaType::STRING};
+    JsonSchemaProperty num;
+    num.type = {JsonSchemaType::NUMBER};
+    num.minimum = 0.0;
+
+    JsonSchemaProperty root;
+    root.any_of = {str, num};
+
+    JsonSchema schema;
+    schema.set_root_schema(root);
+    JsonSchemaValidator validator(schema);
+
+    std::vector<std::string> errors;
+    EXPECT_TRUE(validator.validate(Value(String("hi")), errors));
+    EXPECT_TRUE(validator.validate(Value(Uint(4)), errors));
+    EXPECT_FALSE(validator.validate(Value(Float(-1.0)), errors));
+    EXPECT_FALSE(validator.validate(Value(Bool(true)), errors));
+}
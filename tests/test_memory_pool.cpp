@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include "btoon/memory_pool.h"
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace btoon;
+
+TEST(MemoryPoolTest, FreedChunksAreReusedAcrossSizeClasses) {
+    MemoryPool pool;
+
+    void* small = pool.allocate(64);
+    void* large = pool.allocate(512);
+    pool.deallocate(small, 64);
+    pool.deallocate(large, 512);
+
+    // A 512-byte request must find the 512-byte chunk even though the
+    // 64-byte chunk was freed after it.
+    EXPECT_EQ(pool.allocate(512), large);
+    EXPECT_EQ(pool.allocate(64), small);
+}
+
+TEST(MemoryPoolTest, ReusedChunkTailIsReBinned) {
+    MemoryPool pool;
+
+    void* big = pool.allocate(1024);
+    pool.deallocate(big, 1024);
+
+    // Reusing the 1KB chunk for 100 bytes should split it and keep the
+    // tail available, rather than wasting ~900 bytes.
+    void* head = pool.allocate(100);
+    EXPECT_EQ(head, big);
+
+    size_t free_bytes = 0;
+    for (const auto& entry : pool.size_class_stats()) {
+        free_bytes += entry.free_bytes;
+    }
+    EXPECT_GE(free_bytes, 1024u - 128u);
+}
+
+TEST(MemoryPoolTest, SizeClassStatsTrackBinsAndReuses) {
+    MemoryPool pool;
+
+    auto stats = pool.size_class_stats();
+    ASSERT_FALSE(stats.empty());
+    EXPECT_EQ(stats.front().min_size, 32u);
+    EXPECT_EQ(stats.back().max_size, SIZE_MAX);
+    for (const auto& entry : stats) {
+        EXPECT_EQ(entry.free_chunks, 0u);
+        EXPECT_EQ(entry.reuses, 0u);
+    }
+
+    void* chunk = pool.allocate(200);  // rounds to 224, class [128, 256)
+    pool.deallocate(chunk, 200);
+
+    stats = pool.size_class_stats();
+    size_t cls = 0;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        if (stats[i].free_chunks > 0) {
+            cls = i;
+        }
+    }
+    EXPECT_LE(stats[cls].min_size, 224u);
+    EXPECT_GE(stats[cls].max_size, 224u);
+    EXPECT_EQ(stats[cls].free_bytes, 224u);
+
+    EXPECT_EQ(pool.allocate(200), chunk);
+    EXPECT_EQ(pool.size_class_stats()[cls].reuses, 1u);
+
+    pool.reset();
+    for (const auto& entry : pool.size_class_stats()) {
+        EXPECT_EQ(entry.free_chunks, 0u);
+        EXPECT_EQ(entry.reuses, 0u);
+    }
+}
+
+TEST(SharedMemoryPoolTest, AllocationsAreAlignedAndUsable) {
+    SharedMemoryPool pool;
+
+    void* a = pool.allocate(100);
+    void* b = pool.allocate(1);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % MemoryPool::SIMD_ALIGNMENT, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % MemoryPool::SIMD_ALIGNMENT, 0u);
+
+    std::memset(a, 0xAB, 100);
+    std::memset(b, 0xCD, 1);
+    EXPECT_EQ(static_cast<uint8_t*>(a)[99], 0xAB);
+    EXPECT_EQ(static_cast<uint8_t*>(b)[0], 0xCD);
+    EXPECT_EQ(pool.current_usage(), 101u);
+
+    pool.deallocate(a, 100);
+    pool.deallocate(b, 1);
+    EXPECT_EQ(pool.current_usage(), 0u);
+}
+
+TEST(SharedMemoryPoolTest, FreedChunksAreReusedByTheSameThread) {
+    SharedMemoryPool pool;
+
+    void* first = pool.allocate(256);
+    pool.deallocate(first, 256);
+    void* second = pool.allocate(256);
+    EXPECT_EQ(second, first);
+}
+
+TEST(SharedMemoryPoolTest, OversizedAllocationsBypassTheCache) {
+    SharedMemoryPool pool;
+
+    void* big = pool.allocate(512 * 1024);
+    ASSERT_NE(big, nullptr);
+    std::memset(big, 0, 512 * 1024);
+    pool.deallocate(big, 512 * 1024);
+    EXPECT_EQ(pool.current_usage(), 0u);
+}
+
+TEST(SharedMemoryPoolTest, ConcurrentAllocationsDoNotOverlap) {
+    SharedMemoryPool pool;
+    constexpr size_t kThreads = 8;
+    constexpr size_t kRounds = 2000;
+
+    std::vector<std::thread> threads;
+    std::vector<bool> ok(kThreads, false);
+    for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            bool valid = true;
+            std::vector<std::pair<uint8_t*, size_t>> live;
+            for (size_t round = 0; round < kRounds; ++round) {
+                size_t size = 16 + (round * 37 + t * 11) % 200;
+                auto* ptr = static_cast<uint8_t*>(pool.allocate(size));
+                std::memset(ptr, static_cast<int>(t), size);
+                live.emplace_back(ptr, size);
+                if (live.size() >= 16) {
+                    // Verify our pattern survived concurrent neighbors, then
+                    // release the oldest half.
+                    for (size_t i = 0; i < 8; ++i) {
+                        auto [p, sz] = live[i];
+                        for (size_t j = 0; j < sz; ++j) {
+                            valid = valid && p[j] == static_cast<uint8_t>(t);
+                        }
+                        pool.deallocate(p, sz);
+                    }
+                    live.erase(live.begin(), live.begin() + 8);
+                }
+            }
+            for (auto [p, sz] : live) {
+                pool.deallocate(p, sz);
+            }
+            ok[t] = valid;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 0; t < kThreads; ++t) {
+        EXPECT_TRUE(ok[t]) << "thread " << t << " saw corrupted memory";
+    }
+    EXPECT_EQ(pool.current_usage(), 0u);
+}
+
+TEST(SharedMemoryPoolTest, CrossThreadDeallocateIsSupported) {
+    SharedMemoryPool pool;
+
+    std::vector<std::pair<void*, size_t>> handoff;
+    std::thread producer([&] {
+        for (size_t i = 0; i < 100; ++i) {
+            size_t size = 64 + i;
+            handoff.emplace_back(pool.allocate(size), size);
+        }
+    });
+    producer.join();
+
+    std::thread consumer([&] {
+        for (auto [ptr, size] : handoff) {
+            pool.deallocate(ptr, size);
+        }
+    });
+    consumer.join();
+
+    EXPECT_EQ(pool.current_usage(), 0u);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "btoon/rle_codec.h"
+
+using namespace btoon;
+
+TEST(RleCodecTest, ValueRoundTrip) {
+    Array data;
+    for (int i = 0; i < 50; ++i) data.push_back(Value(String("on")));
+    for (int i = 0; i < 3; ++i) data.push_back(Value(String("off")));
+    data.push_back(Value(String("on")));
+
+    auto decoded = RleCodec::decode(RleCodec::encode(data));
+    ASSERT_EQ(decoded.size(), data.size());
+    EXPECT_EQ(std::get<String>(decoded[0]), "on");
+    EXPECT_EQ(std::get<String>(decoded[51]), "off");
+    EXPECT_EQ(std::get<String>(decoded.back()), "on");
+}
+
+TEST(RleCodecTest, ByteRoundTripMixedRuns) {
+    std::vector<uint8_t> data;
+    for (int i = 0; i < 100; ++i) data.push_back(0);
+    for (int i = 0; i < 7; ++i) data.push_back(1);
+    data.push_back(0);
+    for (int i = 0; i < 300; ++i) data.push_back(0xFF);
+    for (int i = 0; i < 64; ++i) data.push_back(static_cast<uint8_t>(i));  // no runs
+
+    auto encoded = RleCodec::encode_bytes(data);
+    EXPECT_EQ(RleCodec::decode_bytes(encoded), data);
+}
+
+TEST(RleCodecTest, MegabyteRunEncodesInAFewBytes) {
+    std::vector<uint8_t> zeros(4 * 1024 * 1024, 0);
+    auto encoded = RleCodec::encode_bytes(zeros);
+    EXPECT_LE(encoded.size(), 8u);  // one varint length plus the byte
+    EXPECT_EQ(RleCodec::decode_bytes(encoded), zeros);
+}
+
+TEST(RleCodecTest, ByteRoundTripEdgeCases) {
+    EXPECT_TRUE(RleCodec::encode_bytes({}).empty());
+    EXPECT_TRUE(RleCodec::decode_bytes({}).empty());
+
+    std::vector<uint8_t> one = {0x42};
+    EXPECT_EQ(RleCodec::decode_bytes(RleCodec::encode_bytes(one)), one);
+
+    // Run boundary straddling the vector block width
+    std::vector<uint8_t> data(33, 7);
+    data.push_back(8);
+    EXPECT_EQ(RleCodec::decode_bytes(RleCodec::encode_bytes(data)), data);
+}
+
+TEST(RleCodecTest, DecodeBytesRejectsTruncatedInput) {
+    std::vector<uint8_t> data(100, 5);
+    auto encoded = RleCodec::encode_bytes(data);
+    encoded.pop_back();  // drop the run byte, leaving a dangling length
+    EXPECT_THROW(RleCodec::decode_bytes(encoded), BtoonException);
+}
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
 #include "btoon/schema.h"
 
 using namespace btoon;
@@ -47,3 +49,106 @@ TEST(SchemaTest, BasicValidation) {
     };
     EXPECT_FALSE(schema.validate(missing_key));
 }
+
+TEST(SchemaTest, CompiledProgramMatchesInterpretedMessages) {
+    SchemaField name_field{"name", "string", true, std::nullopt, std::nullopt, std::nullopt};
+    SchemaField age_field{"age", "int", true, std::nullopt, std::nullopt,
+                          Value(Map{{"min", Int(0)}, {"max", Int(150)}})};
+    SchemaField tier_field{"tier", "string", true, std::nullopt, std::nullopt,
+                           Value(Map{{"enum", Array{String("free"), String("pro")}}})};
+    Schema schema("user", SchemaVersion(1, 0, 0), {name_field, age_field, tier_field});
+    auto compiled = schema.compile();
+
+    Value valid = Map{{"name", String("Alice")}, {"age", Int(30)}, {"tier", String("pro")}};
+    EXPECT_TRUE(compiled->validate(valid));
+    EXPECT_TRUE(compiled->validateWithErrors(valid).empty());
+
+    Value invalid = Map{{"age", Int(200)}, {"tier", String("gold")}};
+    EXPECT_FALSE(compiled->validate(invalid));
+    auto errors = compiled->validateWithErrors(invalid);
+    ASSERT_EQ(errors.size(), 3u);
+    EXPECT_EQ(errors[0], "Missing required field: name");
+    EXPECT_EQ(errors[1], "Constraint violation for field: age");
+    EXPECT_EQ(errors[2], "Constraint violation for field: tier");
+
+    EXPECT_FALSE(compiled->validate(Value(Int(1))));
+}
+
+TEST(SchemaTest, CompiledProgramCachedUntilMutation) {
+    Schema schema("point", SchemaVersion(1, 0, 0),
+                  {SchemaField{"x", "float", true, std::nullopt, std::nullopt, std::nullopt}});
+    auto first = schema.compile();
+    EXPECT_EQ(first, schema.compile());
+
+    schema.addField(SchemaField{"y", "float", true, std::nullopt, std::nullopt, std::nullopt});
+    auto second = schema.compile();
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(second->validate(Value(Map{{"x", Float(1.0)}})));
+    EXPECT_TRUE(second->validate(Value(Map{{"x", Float(1.0)}, {"y", Float(2.0)}})));
+}
+
+TEST(SchemaTest, RegistryHandsOutCachedCompiledPrograms) {
+    SchemaRegistry registry;
+    auto schema = std::make_shared<Schema>(
+        "event", SchemaVersion(2, 0, 0),
+        std::vector<SchemaField>{
+            SchemaField{"id", "uint", true, std::nullopt, std::nullopt, std::nullopt}});
+    registry.registerSchema(schema);
+
+    auto compiled = registry.getCompiledSchema("event");
+    ASSERT_NE(compiled, nullptr);
+    EXPECT_EQ(compiled, registry.getCompiledSchema("event", SchemaVersion(2, 0, 0)));
+    EXPECT_TRUE(compiled->validate(Value(Map{{"id", Uint(7)}})));
+    EXPECT_EQ(registry.getCompiledSchema("missing"), nullptr);
+}
+
+TEST(SchemaRegistryTest, LookupsRunConcurrentlyWithRegistration) {
+    SchemaRegistry registry;
+    auto make_schema = [](const std::string& name, uint32_t minor) {
+        return std::make_shared<Schema>(
+            name, SchemaVersion(1, minor, 0),
+            std::vector<SchemaField>{
+                SchemaField{"id", "uint", true, std::nullopt, std::nullopt, std::nullopt}});
+    };
+    registry.registerSchema(make_schema("event", 0));
+
+    std::atomic<size_t> failures{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            Value message = Map{{"id", Uint(7)}};
+            for (int i = 0; i < 500; ++i) {
+                auto schema = registry.getLatestSchema("event");
+                if (!schema || !schema->validate(message)) {
+                    failures.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (uint32_t minor = 1; minor <= 50; ++minor) {
+        registry.registerSchema(make_schema("event", minor));
+        registry.registerSchema(make_schema("other_" + std::to_string(minor), 0));
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(failures.load(), 0u);
+    EXPECT_EQ(registry.getVersions("event").size(), 51u);
+}
+
+TEST(SchemaRegistryTest, SnapshotSurvivesRemoval) {
+    SchemaRegistry registry;
+    auto schema = std::make_shared<Schema>(
+        "doc", SchemaVersion(1, 0, 0),
+        std::vector<SchemaField>{
+            SchemaField{"body", "string", true, std::nullopt, std::nullopt, std::nullopt}});
+    registry.registerSchema(schema);
+
+    auto held = registry.getSchema("doc");
+    ASSERT_NE(held, nullptr);
+    registry.removeSchema("doc");
+    EXPECT_EQ(registry.getSchema("doc"), nullptr);
+
+    // A reference obtained before removal stays usable.
+    EXPECT_TRUE(held->validate(Value(Map{{"body", String("hi")}})));
+}
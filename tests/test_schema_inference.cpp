@@ -340,3 +340,70 @@ TEST_F(SchemaInferenceTest, ValidationAfterInference) {
     Value wrong_type = Map{{"id", String("not_an_int")}, {"name", String("Test")}, {"age", Int(25)}};
     EXPECT_FALSE(schema.validate(wrong_type));
 }
+
+TEST_F(SchemaInferenceTest, ReservoirSamplingBoundsResidentRecords) {
+    InferenceOptions opts;
+    opts.reservoir_sampling = true;
+    opts.sample_size = 32;
+    opts.sampling_seed = 42;
+    
+    SchemaInferrer inferrer(opts);
+    for (uint64_t i = 0; i < 1000; ++i) {
+        inferrer.observe(Value(Map{{"id", Uint(i)}, {"kind", String("row")}}));
+    }
+    Schema schema = inferrer.finish("sampled");
+    
+    auto stats = inferrer.getStatistics();
+    EXPECT_EQ(stats.records_seen, 1000u);
+    EXPECT_EQ(stats.samples_analyzed, 32u);
+    EXPECT_NEAR(stats.sampling_fraction, 0.032, 1e-9);
+    EXPECT_FALSE(stats.terminated_early);
+    
+    auto id_field = schema.getField("id");
+    ASSERT_TRUE(id_field.has_value());
+    EXPECT_EQ(id_field->type, "number");
+    EXPECT_TRUE(id_field->required);
+}
+
+TEST_F(SchemaInferenceTest, StabilityWindowStopsEarly) {
+    InferenceOptions opts;
+    opts.stability_window = 20;
+    
+    Array rows;
+    for (uint64_t i = 0; i < 500; ++i) {
+        rows.push_back(Map{{"id", Uint(i)}, {"name", String("row")}});
+    }
+    
+    SchemaInferrer inferrer(opts);
+    Schema schema = inferrer.inferFromArray(rows, "stable");
+    
+    auto stats = inferrer.getStatistics();
+    EXPECT_TRUE(stats.terminated_early);
+    EXPECT_GE(stats.records_seen, 20u);
+    EXPECT_LT(stats.records_seen, 500u);
+    EXPECT_EQ(schema.getFields().size(), 2u);
+}
+
+TEST_F(SchemaInferenceTest, TypeChangeResetsStabilityWindow) {
+    InferenceOptions opts;
+    opts.stability_window = 10;
+    
+    SchemaInferrer inferrer(opts);
+    for (uint64_t i = 0; i < 9; ++i) {
+        inferrer.observe(Value(Map{{"v", Uint(i)}}));
+    }
+    EXPECT_FALSE(inferrer.stable());
+    
+    // A new type for "v" resets the run of uneventful records.
+    inferrer.observe(Value(Map{{"v", String("mixed")}}));
+    EXPECT_FALSE(inferrer.stable());
+    for (uint64_t i = 0; i < 10; ++i) {
+        inferrer.observe(Value(Map{{"v", Uint(i)}}));
+    }
+    EXPECT_TRUE(inferrer.stable());
+    
+    Schema schema = inferrer.finish("mixed");
+    auto field = schema.getField("v");
+    ASSERT_TRUE(field.has_value());
+    EXPECT_EQ(field->type, "any");
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "btoon/btoon.h"
 #include "btoon/security.h"
+#include "btoon/encoder.h"
+#include "btoon/decoder.h"
 
 // Note: The underlying security features (HMAC signing) are not fully
 // integrated into the high-level API yet. These tests are placeholders
@@ -63,6 +65,92 @@ TEST_F(SecurityTest, VerificationFailureOnWrongKey) {
     EXPECT_FALSE(verified);
 }
 
+TEST_F(SecurityTest, IncrementalSignerMatchesOneShot) {
+    Security sec;
+    sec.setSecretKey("a-very-secret-key");
+
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    auto one_shot = sec.sign(data);
+
+    // Feed the same message in uneven chunks.
+    auto signer = sec.createSigner();
+    std::span<const uint8_t> span(data);
+    signer.update(span.subspan(0, 1));
+    signer.update(span.subspan(1, 499));
+    signer.update(span.subspan(500));
+    EXPECT_EQ(signer.finalize(), one_shot);
+}
+
+TEST_F(SecurityTest, IncrementalSignerVerifiesAndResets) {
+    Security sec;
+    sec.setSecretKey("a-very-secret-key");
+
+    std::vector<uint8_t> data = {1, 2, 3, 4, 5};
+    auto signature = sec.sign(data);
+
+    auto signer = sec.createSigner();
+    signer.update(data);
+    EXPECT_TRUE(signer.finalizeAndVerify(signature));
+
+    // Finalized signers must be reset before reuse.
+    EXPECT_THROW(signer.update(data), BtoonException);
+    signer.reset();
+    signer.update(data);
+    auto tampered = signature;
+    tampered[0] ^= 0xff;
+    EXPECT_FALSE(signer.finalizeAndVerify(tampered));
+}
+
+TEST_F(SecurityTest, SignerRequiresSecretKey) {
+    Security sec;
+    EXPECT_THROW(sec.createSigner(), BtoonException);
+}
+
+TEST_F(SecurityTest, Crc32cChecksumMode) {
+    Security sec;
+    sec.setIntegrityMode(IntegrityMode::CRC32C);
+
+    // No secret key needed in checksum mode.
+    std::vector<uint8_t> data = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    auto checksum = sec.sign(data);
+    ASSERT_EQ(checksum.size(), 4u);
+
+    // Known CRC32C of "123456789" is 0xE3069283.
+    EXPECT_EQ(checksum[0], 0xE3);
+    EXPECT_EQ(checksum[1], 0x06);
+    EXPECT_EQ(checksum[2], 0x92);
+    EXPECT_EQ(checksum[3], 0x83);
+
+    EXPECT_TRUE(sec.verify(data, checksum));
+    data[4] ^= 0xff;
+    EXPECT_FALSE(sec.verify(data, checksum));
+
+    // The incremental signer remains HMAC-only.
+    EXPECT_THROW(sec.createSigner(), BtoonException);
+}
+
+TEST_F(SecurityTest, Crc32cEndToEndThroughCodec) {
+    Security sec;
+    sec.setIntegrityMode(IntegrityMode::CRC32C);
+
+    Value doc = Map{{"seq", Uint(7)}, {"payload", String("internal traffic")}};
+    Encoder encoder(sec);
+    encoder.encode(doc);
+    auto signed_span = encoder.getBuffer();
+    std::vector<uint8_t> buffer(signed_span.begin(), signed_span.end());
+
+    Decoder decoder(sec);
+    EXPECT_EQ(decoder.decode(buffer), doc);
+
+    // Flip a payload bit: the checksum must reject the frame.
+    auto corrupted = buffer;
+    corrupted[corrupted.size() / 2] ^= 0x01;
+    EXPECT_THROW(decoder.decode(corrupted), BtoonException);
+}
+
 TEST_F(SecurityTest, TypeRestriction) {
     Security sec;
     // Allow only String (index 5) and Int (index 2)
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "btoon/btoon.h"
+#include "btoon/encoder.h"
+#include "btoon/decoder.h"
+#include "btoon/security.h"
+#include "btoon/stats.h"
+
+using namespace btoon;
+
+namespace {
+
+Value make_sample() {
+    return Map{
+        {"name", String("sensor-1")},
+        {"readings", Array{Float(1.5), Float(2.5), Float(3.5)}},
+        {"online", Bool(true)},
+        {"count", Uint(42)},
+    };
+}
+
+}  // namespace
+
+TEST(CodecStatsTest, DisabledByDefault) {
+    Encoder encoder;
+    encoder.encode(make_sample());
+    auto stats = encoder.statistics();
+    EXPECT_EQ(stats.messages, 0u);
+    EXPECT_EQ(stats.bytes_processed, 0u);
+}
+
+TEST(CodecStatsTest, EncoderCountsMessagesTypesAndBytes) {
+    Encoder encoder;
+    encoder.setStatsEnabled(true);
+    encoder.encode(make_sample());
+    encoder.encode(make_sample());
+
+    auto stats = encoder.statistics();
+    EXPECT_EQ(stats.messages, 2u);
+    EXPECT_EQ(stats.maps, 2u);
+    EXPECT_EQ(stats.arrays, 2u);
+    EXPECT_EQ(stats.floats, 6u);
+    EXPECT_EQ(stats.bools, 2u);
+    EXPECT_EQ(stats.uints, 2u);
+    // "sensor-1" plus the four map keys, per message
+    EXPECT_EQ(stats.strings, 10u);
+    EXPECT_GT(stats.bytes_processed, 0u);
+
+    encoder.resetStatistics();
+    EXPECT_EQ(encoder.statistics().messages, 0u);
+}
+
+TEST(CodecStatsTest, DecoderCountsMirrorTheEncoder) {
+    auto encoded = encode(make_sample());
+
+    Decoder decoder;
+    decoder.setStatsEnabled(true);
+    decoder.decode(encoded);
+
+    auto stats = decoder.statistics();
+    EXPECT_EQ(stats.messages, 1u);
+    EXPECT_EQ(stats.bytes_processed, encoded.size());
+    EXPECT_EQ(stats.maps, 1u);
+    EXPECT_EQ(stats.arrays, 1u);
+    EXPECT_EQ(stats.floats, 3u);
+}
+
+TEST(CodecStatsTest, MergeAggregatesAcrossInstances) {
+    Encoder first;
+    first.setStatsEnabled(true);
+    first.encode(make_sample());
+
+    Encoder second;
+    second.setStatsEnabled(true);
+    second.encode(make_sample());
+
+    CodecStats total;
+    total.merge(first.statistics());
+    total.merge(second.statistics());
+    EXPECT_EQ(total.messages, 2u);
+    EXPECT_EQ(total.maps, 2u);
+    EXPECT_EQ(total.bytes_processed,
+              first.statistics().bytes_processed +
+                  second.statistics().bytes_processed);
+}
+
+TEST(CodecStatsTest, FreeFunctionsReportCompressionRatio) {
+    // Repetitive payload large enough to clear min_compression_size
+    Array rows;
+    for (int i = 0; i < 200; ++i) {
+        rows.push_back(String("the same compressible text, over and over"));
+    }
+
+    EncodeOptions opts;
+    opts.compress = true;
+    opts.compression_algorithm = CompressionAlgorithm::ZLIB;
+    opts.auto_tabular = false;
+
+    CodecStats encode_stats;
+    auto encoded = encode(Value(rows), opts, encode_stats);
+    EXPECT_EQ(encode_stats.messages, 1u);
+    EXPECT_GT(encode_stats.bytes_before_compression,
+              encode_stats.bytes_after_compression);
+    EXPECT_GT(encode_stats.compression_ratio(), 1.0);
+
+    CodecStats decode_stats;
+    Value decoded = decode(encoded, {}, decode_stats);
+    EXPECT_EQ(decode_stats.messages, 1u);
+    EXPECT_EQ(decode_stats.strings, 200u);
+    EXPECT_GT(decode_stats.compression_ratio(), 1.0);
+    EXPECT_EQ(std::get<Array>(decoded).size(), 200u);
+}
+
+TEST(CodecStatsTest, SignatureTimeIsRecordedWithSecurity) {
+    Security security;
+    security.setSecretKey("stats-test-key");
+
+    Encoder encoder(security);
+    encoder.setStatsEnabled(true);
+    encoder.encode(make_sample());
+    auto signed_buffer = encoder.takeBuffer();
+
+    auto encode_stats = encoder.statistics();
+    EXPECT_EQ(encode_stats.signatures, 1u);
+    EXPECT_GE(encode_stats.signature_time_ms, 0.0);
+
+    Decoder decoder(security);
+    decoder.setStatsEnabled(true);
+    decoder.decode(signed_buffer);
+
+    auto decode_stats = decoder.statistics();
+    EXPECT_EQ(decode_stats.signatures, 1u);
+    EXPECT_GE(decode_stats.signature_time_ms, 0.0);
+    EXPECT_EQ(decode_stats.messages, 1u);
+}
@@ -0,0 +1,370 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include "btoon/timeseries.h"
+
+using namespace btoon;
+using namespace btoon::timeseries;
+
+namespace {
+
+// 1kHz samples with slight timestamp jitter and a slowly drifting value,
+// the shape Gorilla is built for.
+void make_samples(size_t n, std::vector<int64_t>& timestamps, std::vector<double>& values) {
+    int64_t ts = 1700000000000000;
+    double v = 20.0;
+    for (size_t i = 0; i < n; ++i) {
+        ts += 1000 + (i % 53 == 0 ? 3 : 0);
+        v += (i % 7 == 0) ? 0.25 : 0.0;
+        timestamps.push_back(ts);
+        values.push_back(v);
+    }
+}
+
+} // namespace
+
+TEST(GorillaTest, ChunkedRoundTrip) {
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    make_samples(10000, timestamps, values);
+
+    gorilla::ChunkedOptions opts;
+    opts.block_size = 1024;  // ten blocks, one partial
+    auto compressed = gorilla::compress_chunked(timestamps, values, opts);
+
+    auto [out_ts, out_vals] = gorilla::decompress_chunked(compressed);
+    ASSERT_EQ(out_ts.size(), timestamps.size());
+    ASSERT_EQ(out_vals.size(), values.size());
+    EXPECT_EQ(out_ts, timestamps);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(out_vals[i], values[i]) << "at " << i;
+    }
+}
+
+TEST(GorillaTest, CompressesStableSeriesWellBelowRawSize) {
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    make_samples(8192, timestamps, values);
+
+    auto compressed = gorilla::compress_chunked(timestamps, values);
+    // Raw storage is 16 bytes per point; repeated values and regular
+    // timestamps should compress far below that.
+    EXPECT_LT(compressed.size(), timestamps.size() * 4);
+}
+
+TEST(GorillaTest, ParallelCompressionMatchesSerial) {
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    make_samples(20000, timestamps, values);
+
+    gorilla::ChunkedOptions serial_opts;
+    serial_opts.block_size = 2048;
+    auto serial = gorilla::compress_chunked(timestamps, values, serial_opts);
+
+    gorilla::ChunkedOptions parallel_opts;
+    parallel_opts.block_size = 2048;
+    parallel_opts.threads = 4;
+    auto parallel = gorilla::compress_chunked(timestamps, values, parallel_opts);
+
+    // Blocks are stitched in order, so the bytes must match exactly.
+    EXPECT_EQ(parallel, serial);
+
+    auto [out_ts, out_vals] = gorilla::decompress_chunked(parallel, 4);
+    EXPECT_EQ(out_ts, timestamps);
+    EXPECT_EQ(out_vals, values);
+}
+
+TEST(GorillaTest, RangeReadReturnsOnlyRequestedWindow) {
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    make_samples(5000, timestamps, values);
+
+    gorilla::ChunkedOptions opts;
+    opts.block_size = 500;
+    auto compressed = gorilla::compress_chunked(timestamps, values, opts);
+
+    int64_t start = timestamps[1200];
+    int64_t end = timestamps[1799];
+    auto [out_ts, out_vals] = gorilla::decompress_range(compressed, start, end);
+    ASSERT_EQ(out_ts.size(), 600u);
+    EXPECT_EQ(out_ts.front(), timestamps[1200]);
+    EXPECT_EQ(out_ts.back(), timestamps[1799]);
+    EXPECT_EQ(out_vals.front(), values[1200]);
+    EXPECT_EQ(out_vals.back(), values[1799]);
+}
+
+TEST(GorillaTest, SpecialFloatsAndEdgeSizesRoundTrip) {
+    auto empty = gorilla::compress_chunked({}, {});
+    EXPECT_TRUE(gorilla::decompress_chunked(empty).first.empty());
+
+    std::vector<int64_t> timestamps = {10, 20, 30, 45, 60};
+    std::vector<double> values = {0.0, -0.0,
+                                  std::numeric_limits<double>::infinity(),
+                                  std::numeric_limits<double>::max(),
+                                  5e-324};
+    auto compressed = gorilla::compress_chunked(timestamps, values);
+    auto [out_ts, out_vals] = gorilla::decompress_chunked(compressed);
+    EXPECT_EQ(out_ts, timestamps);
+    EXPECT_EQ(out_vals, values);
+    EXPECT_TRUE(std::signbit(out_vals[1]));
+}
+
+TEST(GorillaTest, TruncatedContainerThrows) {
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    make_samples(100, timestamps, values);
+    auto compressed = gorilla::compress_chunked(timestamps, values);
+
+    compressed.resize(compressed.size() / 2);
+    EXPECT_THROW(gorilla::decompress_chunked(compressed), BtoonException);
+}
+
+TEST(TimeSeriesTest, GorillaCompressRoundTrip) {
+    TimeSeries<double> series;
+    for (int i = 0; i < 3000; ++i) {
+        series.append(Timestamp::from_microseconds(1700000000000000 + i * 1000),
+                      100.0 + (i % 10) * 0.5);
+    }
+
+    auto compressed = series.compress(TimeSeriesCompression::GORILLA);
+    auto restored = TimeSeries<double>::decompress(compressed, TimeSeriesCompression::GORILLA);
+    ASSERT_EQ(restored.size(), series.size());
+    for (size_t i = 0; i < series.size(); ++i) {
+        EXPECT_EQ(restored[i].timestamp.to_microseconds(),
+                  series[i].timestamp.to_microseconds());
+        EXPECT_EQ(restored[i].value, series[i].value);
+    }
+}
+
+TEST(TimeSeriesTest, RangeAndAtTimeUseTimeOrder) {
+    TimeSeries<double> series;
+    for (int i = 0; i < 1000; ++i) {
+        series.append(Timestamp::from_microseconds(1000000 + i * 500), i * 1.0);
+    }
+
+    auto window = series.range(Timestamp::from_microseconds(1000000 + 100 * 500),
+                               Timestamp::from_microseconds(1000000 + 149 * 500));
+    ASSERT_EQ(window.size(), 50u);
+    EXPECT_EQ(window.front().value, 100.0);
+    EXPECT_EQ(window.back().value, 149.0);
+
+    auto hit = series.at_time(Timestamp::from_microseconds(1000000 + 77 * 500));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->value, 77.0);
+    EXPECT_FALSE(series.at_time(Timestamp::from_microseconds(1000000 + 77 * 500 + 1)).has_value());
+}
+
+namespace {
+
+std::string temp_segment_file(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+TEST(SegmentStoreTest, MmapRangeQueryAcrossSegments) {
+    std::string filename = temp_segment_file("btoon_segments_range.bts");
+    {
+        segments::SegmentWriter writer(filename);
+        for (int segment = 0; segment < 4; ++segment) {
+            std::vector<int64_t> timestamps;
+            std::vector<double> values;
+            for (int i = 0; i < 2000; ++i) {
+                int64_t row = segment * 2000 + i;
+                timestamps.push_back(1700000000000000 + row * 1000);
+                values.push_back(row * 0.5);
+            }
+            writer.append(timestamps, values);
+        }
+        writer.close();
+    }
+
+    auto file = MemoryMappedFile::open(filename);
+    ASSERT_NE(file, nullptr);
+    auto store = segments::SegmentStore::open(*file);
+    EXPECT_EQ(store.num_segments(), 4u);
+    EXPECT_EQ(store.num_points(), 8000u);
+
+    // Window straddling the boundary between segments 0 and 1.
+    int64_t start = 1700000000000000 + 1900 * 1000;
+    int64_t end = 1700000000000000 + 2099 * 1000;
+    auto [ts, vals] = store.query_range(start, end);
+    ASSERT_EQ(ts.size(), 200u);
+    EXPECT_EQ(ts.front(), start);
+    EXPECT_EQ(ts.back(), end);
+    EXPECT_EQ(vals.front(), 1900 * 0.5);
+    EXPECT_EQ(vals.back(), 2099 * 0.5);
+
+    auto hit = store.at_time(1700000000000000 + 6500 * 1000);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(*hit, 6500 * 0.5);
+    EXPECT_FALSE(store.at_time(42).has_value());
+
+    std::filesystem::remove(filename);
+}
+
+TEST(SegmentStoreTest, RejectsOutOfOrderSegmentsAndMissingFooter) {
+    std::string filename = temp_segment_file("btoon_segments_order.bts");
+    segments::SegmentWriter writer(filename);
+    writer.append({100, 200}, {1.0, 2.0});
+    EXPECT_THROW(writer.append({150, 250}, {3.0, 4.0}), BtoonException);
+    writer.close();
+    std::filesystem::remove(filename);
+
+    std::vector<uint8_t> garbage(64, 0xAB);
+    EXPECT_FALSE(segments::SegmentStore::has_segments(garbage));
+    EXPECT_THROW(segments::SegmentStore::open(garbage), BtoonException);
+}
+
+TEST(TimeSeriesTest, AggregateFunctionsOverSeriesAndRange) {
+    TimeSeries<double> series;
+    for (int i = 1; i <= 9; ++i) {
+        series.append(Timestamp::from_microseconds(i * 1000), static_cast<double>(i));
+    }
+
+    EXPECT_EQ(series.aggregate(AggregationFunction::SUM), 45.0);
+    EXPECT_EQ(series.aggregate(AggregationFunction::MEAN), 5.0);
+    EXPECT_EQ(series.aggregate(AggregationFunction::MIN), 1.0);
+    EXPECT_EQ(series.aggregate(AggregationFunction::MAX), 9.0);
+    EXPECT_EQ(series.aggregate(AggregationFunction::COUNT), 9.0);
+    EXPECT_EQ(series.aggregate(AggregationFunction::MEDIAN), 5.0);
+    EXPECT_EQ(series.aggregate(AggregationFunction::FIRST), 1.0);
+    EXPECT_EQ(series.aggregate(AggregationFunction::LAST), 9.0);
+    EXPECT_NEAR(series.aggregate(AggregationFunction::VARIANCE), 20.0 / 3.0, 1e-12);
+
+    // Range [3ms, 5ms] covers values 3, 4, 5.
+    EXPECT_EQ(series.aggregate(AggregationFunction::SUM,
+                               Timestamp::from_microseconds(3000),
+                               Timestamp::from_microseconds(5000)),
+              12.0);
+}
+
+TEST(TimeSeriesTest, ResampleMeanOverSmallSeries) {
+    TimeSeries<double> series;
+    // Two points per 10ms bucket across 3 buckets.
+    for (int i = 0; i < 6; ++i) {
+        series.append(Timestamp::from_microseconds(i * 5000), static_cast<double>(i));
+    }
+
+    auto resampled = series.resample(std::chrono::milliseconds(10), AggregationFunction::MEAN);
+    ASSERT_EQ(resampled.size(), 3u);
+    EXPECT_EQ(resampled[0].value, 0.5);
+    EXPECT_EQ(resampled[1].value, 2.5);
+    EXPECT_EQ(resampled[2].value, 4.5);
+    EXPECT_EQ(resampled[0].timestamp.to_microseconds(), 0);
+    EXPECT_EQ(resampled[1].timestamp.to_microseconds(), 10000);
+}
+
+TEST(TimeSeriesTest, ParallelResampleMatchesPerBucketAggregates) {
+    TimeSeries<double> series;
+    // 100k points in 1000 buckets: well past the parallel threshold.
+    for (int i = 0; i < 100000; ++i) {
+        series.append(Timestamp::from_microseconds(static_cast<int64_t>(i) * 100),
+                      static_cast<double>(i % 97));
+    }
+
+    auto resampled = series.resample(std::chrono::milliseconds(10), AggregationFunction::SUM);
+    ASSERT_EQ(resampled.size(), 1000u);
+    for (size_t b : {size_t{0}, size_t{499}, size_t{999}}) {
+        double expected = 0.0;
+        for (size_t i = b * 100; i < (b + 1) * 100; ++i) {
+            expected += static_cast<double>(i % 97);
+        }
+        EXPECT_EQ(resampled[b].value, expected) << "bucket " << b;
+        EXPECT_EQ(resampled[b].timestamp.to_microseconds(),
+                  static_cast<int64_t>(b) * 10000);
+    }
+}
+
+TEST(TimeSeriesTest, ResampleSkipsEmptyBuckets) {
+    TimeSeries<double> series;
+    series.append(Timestamp::from_microseconds(1000), 1.0);
+    series.append(Timestamp::from_microseconds(2000), 2.0);
+    series.append(Timestamp::from_microseconds(95000), 9.0);
+
+    auto resampled = series.resample(std::chrono::milliseconds(10), AggregationFunction::MAX);
+    ASSERT_EQ(resampled.size(), 2u);
+    EXPECT_EQ(resampled[0].value, 2.0);
+    EXPECT_EQ(resampled[1].value, 9.0);
+    EXPECT_EQ(resampled[1].timestamp.to_microseconds(), 90000);
+}
+
+TEST(SimdReductionTest, MatchesScalarOnAwkwardLengths) {
+    for (size_t n : {1u, 2u, 3u, 4u, 5u, 7u, 8u, 31u, 1000u}) {
+        std::vector<double> values;
+        for (size_t i = 0; i < n; ++i) {
+            values.push_back(static_cast<double>((i * 37) % 101) - 50.0);
+        }
+        double expected_sum = 0.0;
+        double expected_min = values[0];
+        double expected_max = values[0];
+        for (double v : values) {
+            expected_sum += v;
+            expected_min = std::min(expected_min, v);
+            expected_max = std::max(expected_max, v);
+        }
+        EXPECT_DOUBLE_EQ(simd::sum(values), expected_sum) << "n=" << n;
+        EXPECT_EQ(simd::min(values), expected_min) << "n=" << n;
+        EXPECT_EQ(simd::max(values), expected_max) << "n=" << n;
+    }
+}
+
+TEST(OutlierDetectionTest, ZscoreFindsInjectedSpikes) {
+    TimeSeries<double> series;
+    for (int i = 0; i < 500; ++i) {
+        double v = 50.0 + ((i * 13) % 7) * 0.1;  // tight band around 50
+        if (i == 123) v = 500.0;
+        if (i == 321) v = -400.0;
+        series.append(Timestamp::from_microseconds(i * 1000), v);
+    }
+
+    auto outliers = series.detect_outliers_zscore(3.0);
+    ASSERT_EQ(outliers.size(), 2u);
+    EXPECT_EQ(outliers[0], 123u);
+    EXPECT_EQ(outliers[1], 321u);
+
+    // Constant series has zero stddev: nothing is an outlier.
+    TimeSeries<double> flat;
+    for (int i = 0; i < 16; ++i) {
+        flat.append(Timestamp::from_microseconds(i), 7.0);
+    }
+    EXPECT_TRUE(flat.detect_outliers_zscore().empty());
+}
+
+TEST(OutlierDetectionTest, IqrFindsTailPoints) {
+    TimeSeries<double> series;
+    for (int i = 0; i < 200; ++i) {
+        series.append(Timestamp::from_microseconds(i * 1000),
+                      static_cast<double>(i % 20));
+    }
+    series.append(Timestamp::from_microseconds(200 * 1000), 1000.0);
+    series.append(Timestamp::from_microseconds(201 * 1000), -1000.0);
+
+    auto outliers = series.detect_outliers_iqr(1.5);
+    ASSERT_EQ(outliers.size(), 2u);
+    EXPECT_EQ(outliers[0], 200u);
+    EXPECT_EQ(outliers[1], 201u);
+}
+
+TEST(OutlierDetectionTest, BatchedDetectionMatchesPerSeries) {
+    std::vector<TimeSeries<double>> batch;
+    for (int s = 0; s < 12; ++s) {
+        TimeSeries<double> series;
+        for (int i = 0; i < 300; ++i) {
+            double v = 10.0 * s + ((i * 7) % 5) * 0.01;
+            if (i == 42 + s) v += 1000.0;
+            series.append(Timestamp::from_microseconds(i * 1000), v);
+        }
+        batch.push_back(std::move(series));
+    }
+
+    auto zscore_results = detect_outliers_zscore_batch(batch, 3.0);
+    auto iqr_results = detect_outliers_iqr_batch(batch, 1.5);
+    ASSERT_EQ(zscore_results.size(), batch.size());
+    ASSERT_EQ(iqr_results.size(), batch.size());
+    for (size_t s = 0; s < batch.size(); ++s) {
+        EXPECT_EQ(zscore_results[s], batch[s].detect_outliers_zscore(3.0)) << "series " << s;
+        EXPECT_EQ(iqr_results[s], batch[s].detect_outliers_iqr(1.5)) << "series " << s;
+    }
+}
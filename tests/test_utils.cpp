@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "btoon/utils.h"
+
+using namespace btoon;
+using namespace btoon::utils;
+
+TEST(BufferReaderTest, CheckedReadsThrowOnOverflow) {
+    std::vector<uint8_t> bytes = {0x01, 0x02, 0x03};
+    BufferReader reader(bytes);
+
+    EXPECT_EQ(reader.readUint8(), 0x01);
+    EXPECT_EQ(reader.readUint16(), 0x0203);
+    EXPECT_TRUE(reader.eof());
+    EXPECT_THROW(reader.readUint8(), BtoonException);
+    EXPECT_THROW(reader.readUint32(), BtoonException);
+}
+
+TEST(BufferReaderTest, UncheckedTierValidatesTheFrameOnce) {
+    // Big-endian: u16, u32, f64(1.5), then one trailing byte outside the frame.
+    std::vector<uint8_t> bytes = {0x12, 0x34,
+                                  0xDE, 0xAD, 0xBE, 0xEF,
+                                  0x3F, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                  0x99};
+    BufferReader reader(bytes);
+    auto frame = reader.unchecked(14);
+
+    EXPECT_EQ(frame.readUint16(), 0x1234u);
+    EXPECT_EQ(frame.readUint32(), 0xDEADBEEFu);
+    EXPECT_EQ(frame.readFloat64(), 1.5);
+    EXPECT_TRUE(frame.eof());
+    EXPECT_EQ(frame.remaining(), 0u);
+
+    // The checked reader advanced past the frame it handed out.
+    EXPECT_EQ(reader.position(), 14u);
+    EXPECT_EQ(reader.readUint8(), 0x99);
+
+    // Requesting a frame larger than what remains is caught up front.
+    EXPECT_THROW(reader.unchecked(2), BtoonException);
+}
+
+TEST(BufferReaderTest, UncheckedBytesAndSkipStayInAgreement) {
+    std::vector<uint8_t> bytes = {'h', 'i', 0x00, 0x2A};
+    UncheckedBufferReader reader(bytes);
+
+    auto tag = reader.readBytes(2);
+    EXPECT_EQ(std::string(tag.begin(), tag.end()), "hi");
+    reader.skip(1);
+    EXPECT_EQ(reader.readUint8(), 0x2A);
+    EXPECT_EQ(reader.position(), 4u);
+}
@@ -164,6 +164,172 @@ TEST_F(ValidatorTest, UTF8Validation) {
     EXPECT_NE(sanitized.find("World"), std::string::npos);
 }
 
+TEST_F(ValidatorTest, UTF8ValidationLongBuffers) {
+    // Long pure-ASCII buffers exercise the block-at-a-time fast path.
+    std::string ascii(1000, 'a');
+    EXPECT_TRUE(UTF8Validator::isValid(ascii));
+
+    // A multi-byte sequence straddling a 32-byte block boundary.
+    std::string straddle(31, 'x');
+    straddle += "\xE4\xB8\x96";  // 世 at offsets 31..33
+    straddle += std::string(40, 'y');
+    EXPECT_TRUE(UTF8Validator::isValid(straddle));
+
+    // An invalid byte deep inside an otherwise ASCII buffer.
+    std::string bad_interior(100, 'a');
+    bad_interior[70] = '\xFF';
+    EXPECT_FALSE(UTF8Validator::isValid(bad_interior));
+
+    // A sequence truncated at the very end of the buffer, including at an
+    // exact block-size length.
+    std::string truncated(64, 'a');
+    truncated += "\xF0\x9F\x98";  // 😀 missing its last byte
+    EXPECT_FALSE(UTF8Validator::isValid(truncated));
+
+    std::string block_sized(63, 'a');
+    block_sized += '\xC2';  // lead byte as byte 64, nothing after it
+    ASSERT_EQ(block_sized.size() % 32, 0u);
+    EXPECT_FALSE(UTF8Validator::isValid(block_sized));
+
+    // Surrogates and overlong encodings past the ASCII prefix.
+    std::string surrogate(40, 'a');
+    surrogate += "\xED\xA0\x80";
+    EXPECT_FALSE(UTF8Validator::isValid(surrogate));
+
+    std::string overlong(40, 'a');
+    overlong += "\xE0\x80\x80";
+    EXPECT_FALSE(UTF8Validator::isValid(overlong));
+}
+
+TEST_F(ValidatorTest, FusedDecodeValidatesCleanDocument) {
+    Validator validator;
+    auto [value, result] = validator.decodeValidated(valid_map);
+
+    EXPECT_TRUE(result.valid);
+    EXPECT_TRUE(result.errors.empty());
+
+    Decoder decoder;
+    EXPECT_EQ(value, decoder.decode(valid_map));
+}
+
+TEST_F(ValidatorTest, FusedDecodeReportsInlineViolations) {
+    // Invalid UTF-8 inside a decodable document.
+    Validator validator;
+    auto [value, result] = validator.decodeValidated(invalid_utf8);
+    EXPECT_FALSE(result.valid);
+    ASSERT_FALSE(result.errors.empty());
+    EXPECT_NE(result.errors[0].find("UTF-8"), std::string::npos);
+
+    // NaN float with the default (disallowing) options.
+    auto nan_data = encode(Float(std::numeric_limits<double>::quiet_NaN()));
+    auto [nan_value, nan_result] = validator.decodeValidated(nan_data);
+    EXPECT_FALSE(nan_result.valid);
+
+    // Depth limit enforced during the walk.
+    ValidationOptions shallow;
+    shallow.max_depth = 4;
+    Validator shallow_validator(shallow);
+    auto nested = createDeeplyNested(10);
+    auto [nested_value, nested_result] = shallow_validator.decodeValidated(nested);
+    EXPECT_FALSE(nested_result.valid);
+
+    // Duplicate map keys in hand-built bytes.
+    std::vector<uint8_t> dup_keys = {0x82, 0xa1, 'a', 0x01, 0xa1, 'a', 0x02};
+    auto [dup_value, dup_result] = validator.decodeValidated(dup_keys);
+    EXPECT_FALSE(dup_result.valid);
+    ASSERT_FALSE(dup_result.errors.empty());
+    EXPECT_NE(dup_result.errors[0].find("Duplicate map key"), std::string::npos);
+
+    // Unparseable input surfaces as a decode error, not an exception.
+    auto [bad_value, bad_result] = validator.decodeValidated(truncated_data);
+    EXPECT_FALSE(bad_result.valid);
+    EXPECT_TRUE(std::holds_alternative<Nil>(bad_value));
+}
+
+TEST_F(ValidatorTest, FusedDecodeCollectsStats) {
+    ValidationOptions opts;
+    opts.collect_stats = true;
+    Validator validator(opts);
+
+    auto data = encode(Map{{"name", String("btoon")},
+                           {"tags", Array{String("fast"), String("compact")}}});
+    auto [value, result] = validator.decodeValidated(data);
+
+    EXPECT_TRUE(result.valid);
+    ASSERT_TRUE(result.stats.has_value());
+    EXPECT_EQ(result.stats->map_count, 1u);
+    EXPECT_EQ(result.stats->array_count, 1u);
+    // Two string values plus the map keys pass through the string decoder.
+    EXPECT_GE(result.stats->string_count, 3u);
+}
+
+TEST_F(ValidatorTest, StreamingValidatorAcceptsChunkedInput) {
+    StreamingValidator validator;
+
+    // Feed a record stream one byte at a time, splitting every value.
+    std::vector<uint8_t> stream;
+    for (int i = 0; i < 3; ++i) {
+        auto record = encode(Map{{"id", Int(i)}, {"name", String("record-日本")}});
+        stream.insert(stream.end(), record.begin(), record.end());
+    }
+    for (uint8_t byte : stream) {
+        EXPECT_TRUE(validator.feed(std::span<const uint8_t>(&byte, 1)));
+    }
+
+    auto result = validator.finish();
+    EXPECT_TRUE(result.valid);
+    EXPECT_TRUE(result.errors.empty());
+}
+
+TEST_F(ValidatorTest, StreamingValidatorRejectsAtFirstBadChunk) {
+    // Invalid UTF-8 split across two chunks.
+    StreamingValidator validator;
+    std::vector<uint8_t> first = {0xa4, 'a', 'b'};
+    std::vector<uint8_t> second = {0xFF, 'c'};
+    EXPECT_TRUE(validator.feed(first));
+    EXPECT_FALSE(validator.feed(second));
+    EXPECT_FALSE(validator.ok());
+    EXPECT_FALSE(validator.finish().valid);
+
+    // An oversized string claim is rejected from its header alone,
+    // before any payload arrives.
+    ValidationOptions opts;
+    opts.max_string_length = 16;
+    StreamingValidator bounded(opts);
+    std::vector<uint8_t> huge_header = {0xdb, 0x00, 0x10, 0x00, 0x00};  // str32, 1MB
+    EXPECT_FALSE(bounded.feed(huge_header));
+
+    // A nesting-depth attack is cut off as soon as the limit is crossed.
+    ValidationOptions shallow;
+    shallow.max_depth = 8;
+    StreamingValidator nested(shallow);
+    std::vector<uint8_t> open_arrays(32, 0x91);
+    EXPECT_FALSE(nested.feed(open_arrays));
+
+    // Total size is bounded even for structurally valid input.
+    ValidationOptions small;
+    small.max_total_size = 8;
+    StreamingValidator tiny(small);
+    auto big = encode(String("this is more than eight bytes"));
+    EXPECT_FALSE(tiny.feed(big));
+}
+
+TEST_F(ValidatorTest, StreamingValidatorFlagsTruncationAndSupportsReset) {
+    StreamingValidator validator;
+    std::vector<uint8_t> partial = {0x92, 0x01};  // Array of two, one element fed.
+    EXPECT_TRUE(validator.feed(partial));
+
+    auto result = validator.finish();
+    EXPECT_FALSE(result.valid);
+    ASSERT_FALSE(result.errors.empty());
+    EXPECT_NE(result.errors[0].find("Truncated"), std::string::npos);
+
+    validator.reset();
+    auto complete = encode(Array{Int(1), Int(2)});
+    EXPECT_TRUE(validator.feed(complete));
+    EXPECT_TRUE(validator.finish().valid);
+}
+
 TEST_F(ValidatorTest, TypeValidation) {
     // Integer validation
     EXPECT_TRUE(TypeValidator::validateInt(100, 0, 200));
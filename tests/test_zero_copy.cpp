@@ -0,0 +1,313 @@
+#include <gtest/gtest.h>
+#include "btoon/btoon.h"
+#include "btoon/zero_copy.h"
+
+#include <cmath>
+
+using namespace btoon;
+
+namespace {
+
+std::vector<uint8_t> encode_table(size_t rows, const EncodeOptions& opts = {}) {
+    Array data;
+    for (size_t i = 0; i < rows; ++i) {
+        data.push_back(Map{
+            {"id", Int(static_cast<int64_t>(i) - 5)},
+            {"count", Uint(i * 10)},
+            {"score", Float(i * 0.5)},
+            {"name", String("row_" + std::to_string(i))}
+        });
+    }
+    return encode(Value(data), opts);
+}
+
+} // namespace
+
+TEST(TabularViewTest, OpenExposesSchema) {
+    auto encoded = encode_table(8);
+    ASSERT_TRUE(TabularView::is_tabular(encoded));
+
+    TabularView view = TabularView::open(encoded);
+    EXPECT_EQ(view.num_rows(), 8u);
+    EXPECT_EQ(view.num_columns(), 4u);
+    // Columns are written in sorted name order.
+    EXPECT_EQ(view.column_name(view.column_index("count")), "count");
+    EXPECT_EQ(view.column_type(view.column_index("score")), TabularView::ColumnType::Float);
+    EXPECT_EQ(view.column_type(view.column_index("name")), TabularView::ColumnType::String);
+    EXPECT_THROW(view.column_index("missing"), BtoonException);
+}
+
+TEST(TabularViewTest, TypedColumnsRoundTrip) {
+    auto encoded = encode_table(20);
+    TabularView view = TabularView::open(encoded);
+
+    std::vector<int64_t> ids;
+    auto id_span = view.int64_column(view.column_index("id"), ids);
+    ASSERT_EQ(id_span.size(), 20u);
+    for (size_t i = 0; i < 20; ++i) {
+        EXPECT_EQ(id_span[i], static_cast<int64_t>(i) - 5);
+    }
+
+    std::vector<uint64_t> counts;
+    auto count_span = view.uint64_column(view.column_index("count"), counts);
+    ASSERT_EQ(count_span.size(), 20u);
+    EXPECT_EQ(count_span[19], 190u);
+
+    std::vector<double> scores;
+    auto score_span = view.float64_column(view.column_index("score"), scores);
+    ASSERT_EQ(score_span.size(), 20u);
+    EXPECT_DOUBLE_EQ(score_span[7], 3.5);
+}
+
+TEST(TabularViewTest, StringColumnViewsPointIntoBuffer) {
+    auto encoded = encode_table(6);
+    TabularView view = TabularView::open(encoded);
+
+    auto names = view.string_column(view.column_index("name"));
+    ASSERT_EQ(names.size(), 6u);
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(names[i], "row_" + std::to_string(i));
+        // Genuinely zero-copy: the view must alias the encoded buffer.
+        const char* base = reinterpret_cast<const char*>(encoded.data());
+        EXPECT_GE(names[i].data(), base);
+        EXPECT_LT(names[i].data(), base + encoded.size());
+    }
+}
+
+TEST(TabularViewTest, ValidityBitmapColumns) {
+    Array data;
+    for (size_t i = 0; i < 12; ++i) {
+        data.push_back(Map{
+            {"v", (i % 3 == 0) ? Value(Nil{}) : Value(Float(i * 1.5))},
+            {"tag", Value(String("t" + std::to_string(i)))}
+        });
+    }
+    EncodeOptions opts;
+    opts.columnar_validity_bitmaps = true;
+    auto encoded = encode(Value(data), opts);
+
+    TabularView view = TabularView::open(encoded);
+    size_t v_col = view.column_index("v");
+    auto bitmap = view.validity_bitmap(v_col);
+    ASSERT_FALSE(bitmap.empty());
+
+    std::vector<double> values;
+    auto span = view.float64_column(v_col, values);
+    ASSERT_EQ(span.size(), 12u);
+    for (size_t i = 0; i < 12; ++i) {
+        bool valid = (bitmap[i / 8] >> (i % 8)) & 1u;
+        EXPECT_EQ(valid, i % 3 != 0);
+        if (valid) {
+            EXPECT_DOUBLE_EQ(span[i], i * 1.5);
+        } else {
+            EXPECT_TRUE(std::isnan(span[i]));
+        }
+    }
+}
+
+TEST(TabularViewTest, ChunkedPayloadRejected) {
+    EncodeOptions opts;
+    opts.columnar_row_group_size = 4;
+    auto encoded = encode_table(10, opts);
+    EXPECT_THROW(TabularView::open(encoded), BtoonException);
+}
+
+TEST(TabularViewTest, NonTabularBufferRejected) {
+    auto encoded = encode(Value(String("just a string")));
+    EXPECT_FALSE(TabularView::is_tabular(encoded));
+    EXPECT_THROW(TabularView::open(encoded), BtoonException);
+}
+
+TEST(MapViewTest, SmallMapLookupAndDecodeOrderIteration) {
+    EncodeOptions opts;
+    opts.auto_tabular = false;
+    auto encoded = encode(Value(Map{
+        {"id", Int(-7)},
+        {"name", String("sensor")},
+        {"score", Float(1.5)}
+    }), opts);
+
+    ZeroCopyDecoder decoder;
+    ValueView view = decoder.decode(encoded.data(), encoded.size());
+    const auto& map = std::get<MapView>(view);
+
+    ASSERT_EQ(map.size(), 3u);
+    EXPECT_EQ(std::get<Int>(map.at("id")), -7);
+    EXPECT_EQ(std::get<std::string_view>(map.at("name")), "sensor");
+    EXPECT_TRUE(map.contains("score"));
+    EXPECT_EQ(map.find("missing"), nullptr);
+    EXPECT_THROW(map.at("missing"), BtoonException);
+
+    // Entries come back in wire order (Map encodes keys sorted).
+    std::vector<std::string_view> keys;
+    for (const auto& [key, value] : map) {
+        keys.push_back(key);
+    }
+    EXPECT_EQ(keys, (std::vector<std::string_view>{"id", "name", "score"}));
+}
+
+TEST(MapViewTest, DuplicateKeysLastWins) {
+    // Hand-built fixmap {"a": 1, "a": 2}: the last occurrence answers
+    // lookups, matching Decoder, while iteration still sees both entries.
+    std::vector<uint8_t> payload = {0x82, 0xa1, 'a', 0x01, 0xa1, 'a', 0x02};
+    ZeroCopyDecoder decoder;
+    ValueView view = decoder.decode(payload.data(), payload.size());
+    const auto& map = std::get<MapView>(view);
+    ASSERT_EQ(map.size(), 2u);
+    EXPECT_EQ(std::get<Uint>(map.at("a")), 2u);
+
+    // Same payload shape above the linear-scan limit: the hash index must
+    // resolve duplicates the same way.
+    std::vector<uint8_t> large = {0xde, 0x00, 0x12};
+    for (uint8_t i = 0; i < 17; ++i) {
+        large.insert(large.end(), {0xa2, 'k', static_cast<uint8_t>('a' + i), i});
+    }
+    large.insert(large.end(), {0xa2, 'k', 'a', 0x63});
+    ValueView large_view = decoder.decode(large.data(), large.size());
+    const auto& large_map = std::get<MapView>(large_view);
+    ASSERT_GT(large_map.size(), MapView::LINEAR_SCAN_MAX);
+    EXPECT_EQ(std::get<Uint>(large_map.at("ka")), 99u);
+    EXPECT_EQ(std::get<Uint>(large_map.at("kb")), 1u);
+}
+
+TEST(MapViewTest, LargeMapIndexedLookup) {
+    Map large;
+    for (int i = 0; i < 100; ++i) {
+        large["key_" + std::to_string(i)] = Int(i);
+    }
+    EncodeOptions opts;
+    opts.auto_tabular = false;
+    auto encoded = encode(Value(large), opts);
+
+    ZeroCopyDecoder decoder;
+    ValueView view = decoder.decode(encoded.data(), encoded.size());
+    const auto& map = std::get<MapView>(view);
+
+    ASSERT_GT(map.size(), MapView::LINEAR_SCAN_MAX);
+    // First lookup builds the index; later ones reuse it.
+    EXPECT_EQ(std::get<Uint>(map.at("key_0")), 0u);
+    EXPECT_EQ(std::get<Uint>(map.at("key_99")), 99u);
+    EXPECT_EQ(map.find("key_100"), nullptr);
+
+    // A copy must answer the same lookups with its own index.
+    MapView copy = map;
+    EXPECT_EQ(std::get<Uint>(copy.at("key_42")), 42u);
+}
+
+namespace {
+
+ValueView zc_decode(ZeroCopyDecoder& decoder, const std::vector<uint8_t>& data) {
+    return decoder.decode(data.data(), data.size());
+}
+
+} // namespace
+
+TEST(ZeroCopyDecoderTest, FixedWidthIntegers) {
+    ZeroCopyDecoder decoder;
+    EXPECT_EQ(std::get<Uint>(zc_decode(decoder, {0xcc, 0xff})), 255u);
+    EXPECT_EQ(std::get<Uint>(zc_decode(decoder, {0xcd, 0x12, 0x34})), 0x1234u);
+    EXPECT_EQ(std::get<Uint>(zc_decode(decoder, {0xce, 0x00, 0x01, 0x00, 0x00})), 65536u);
+    EXPECT_EQ(std::get<Uint>(zc_decode(decoder, {0xcf, 0xff, 0xff, 0xff, 0xff,
+                                                 0xff, 0xff, 0xff, 0xff})),
+              UINT64_MAX);
+
+    // Signed widths must sign-extend from the encoded width.
+    EXPECT_EQ(std::get<Int>(zc_decode(decoder, {0xd0, 0x80})), -128);
+    EXPECT_EQ(std::get<Int>(zc_decode(decoder, {0xd1, 0xff, 0x00})), -256);
+    EXPECT_EQ(std::get<Int>(zc_decode(decoder, {0xd2, 0xff, 0xff, 0xff, 0xfe})), -2);
+    EXPECT_EQ(std::get<Int>(zc_decode(decoder, {0xd3, 0xff, 0xff, 0xff, 0xff,
+                                                0xff, 0xff, 0xff, 0xff})),
+              -1);
+    EXPECT_EQ(std::get<Int>(zc_decode(decoder, {0xd1, 0x01, 0x00})), 256);
+
+    // Truncated payloads must throw rather than read past the buffer.
+    EXPECT_THROW(zc_decode(decoder, {0xcd, 0x12}), BtoonException);
+    EXPECT_THROW(zc_decode(decoder, {0xd3, 0xff, 0xff}), BtoonException);
+}
+
+TEST(ZeroCopyDecoderTest, Floats) {
+    ZeroCopyDecoder decoder;
+    // 1.5f = 0x3fc00000, -2.25 = 0xc002000000000000
+    EXPECT_DOUBLE_EQ(std::get<Float>(zc_decode(decoder, {0xca, 0x3f, 0xc0, 0x00, 0x00})),
+                     1.5);
+    EXPECT_DOUBLE_EQ(std::get<Float>(zc_decode(decoder, {0xcb, 0xc0, 0x02, 0x00, 0x00,
+                                                         0x00, 0x00, 0x00, 0x00})),
+                     -2.25);
+    EXPECT_THROW(zc_decode(decoder, {0xca, 0x3f, 0xc0}), BtoonException);
+}
+
+TEST(ZeroCopyDecoderTest, WideStringAndBinaryLengths) {
+    // str32 and bin32 carry 4-byte lengths; the views must alias the
+    // input buffer, not copy it.
+    std::vector<uint8_t> data = {0xdb, 0x00, 0x00, 0x00, 0x05, 'h', 'e', 'l', 'l', 'o'};
+    ZeroCopyDecoder decoder;
+    ValueView view = decoder.decode(data.data(), data.size());
+    auto str = std::get<std::string_view>(view);
+    EXPECT_EQ(str, "hello");
+    EXPECT_EQ(reinterpret_cast<const uint8_t*>(str.data()), data.data() + 5);
+
+    std::vector<uint8_t> bin_data = {0xc6, 0x00, 0x00, 0x00, 0x03, 0xde, 0xad, 0xbf};
+    ValueView bin_view = decoder.decode(bin_data.data(), bin_data.size());
+    auto bin = std::get<std::span<const uint8_t>>(bin_view);
+    ASSERT_EQ(bin.size(), 3u);
+    EXPECT_EQ(bin.data(), bin_data.data() + 5);
+
+    // A length that runs past the buffer is rejected.
+    std::vector<uint8_t> truncated = {0xdb, 0x00, 0x00, 0x00, 0x10, 'h', 'i'};
+    EXPECT_THROW(decoder.decode(truncated.data(), truncated.size()), BtoonException);
+}
+
+TEST(ZeroCopyDecoderTest, WideContainerCounts) {
+    // array16 of 20 fixints, then map16 with 17 entries — both past the
+    // fixarray/fixmap range, so the 2-byte counts are actually exercised.
+    std::vector<uint8_t> arr_data = {0xdc, 0x00, 0x14};
+    for (uint8_t i = 0; i < 20; ++i) {
+        arr_data.push_back(i);
+    }
+    ZeroCopyDecoder decoder;
+    ValueView arr_view = decoder.decode(arr_data.data(), arr_data.size());
+    const auto& arr = std::get<ArrayView>(arr_view);
+    ASSERT_EQ(arr.size(), 20u);
+    EXPECT_EQ(std::get<Uint>(arr[19]), 19u);
+
+    std::vector<uint8_t> map_data = {0xde, 0x00, 0x11};
+    for (uint8_t i = 0; i < 17; ++i) {
+        map_data.insert(map_data.end(), {0xa2, 'k', static_cast<uint8_t>('a' + i), i});
+    }
+    ValueView map_view = decoder.decode(map_data.data(), map_data.size());
+    const auto& map = std::get<MapView>(map_view);
+    ASSERT_EQ(map.size(), 17u);
+    EXPECT_EQ(std::get<Uint>(map.at("kq")), 16u);
+
+    // A declared count the buffer cannot hold must throw, not loop.
+    std::vector<uint8_t> truncated = {0xdd, 0x00, 0x01, 0x00, 0x00, 0x01};
+    EXPECT_THROW(decoder.decode(truncated.data(), truncated.size()), BtoonException);
+
+    // Non-string map keys are rejected.
+    std::vector<uint8_t> bad_key = {0x81, 0x01, 0x02};
+    EXPECT_THROW(decoder.decode(bad_key.data(), bad_key.size()), BtoonException);
+}
+
+TEST(ZeroCopyDecoderTest, TimestampsAndExtensions) {
+    ZeroCopyDecoder decoder;
+    // fixext4, type -1: 32-bit seconds.
+    auto ts4 = std::get<Timestamp>(zc_decode(decoder, {0xd6, 0xff, 0x00, 0x00, 0x00, 0x2a}));
+    EXPECT_EQ(ts4.seconds, 42);
+    EXPECT_EQ(ts4.nanoseconds, 0u);
+
+    // ext8 length 12, type -1: 64-bit seconds + 32-bit nanoseconds.
+    auto ts12 = std::get<Timestamp>(zc_decode(
+        decoder, {0xc7, 0x0c, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07,
+                  0x00, 0x00, 0x01, 0xf4}));
+    EXPECT_EQ(ts12.seconds, 7);
+    EXPECT_EQ(ts12.nanoseconds, 500u);
+
+    // A type other than -1 comes back as a generic Extension with the
+    // payload copied out of the buffer.
+    auto ext = std::get<Extension>(zc_decode(decoder, {0xd5, 0x07, 0xab, 0xcd}));
+    EXPECT_EQ(ext.type, 7);
+    EXPECT_EQ(ext.data, (std::vector<uint8_t>{0xab, 0xcd}));
+
+    // A timestamp payload of any other length is malformed.
+    EXPECT_THROW(zc_decode(decoder, {0xd4, 0xff, 0x00}), BtoonException);
+}
@@ -21,6 +21,8 @@
 #include "btoon/encoder.h"
 #include "btoon/decoder.h"
 #include "btoon/schema.h"
+#include "btoon/stream_encoder.h"
+#include "btoon/stream_decoder.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -296,7 +298,7 @@ void print_usage(const std::string& program_name) {
     std::cout << "  -s, --schema <file>        Validate with schema" << std::endl;
     std::cout << "  -c, --compress             Compress output (BTOON only)" << std::endl;
     std::cout << "  --compression-algo <algo>  Compression algorithm (zlib, lz4, zstd)" << std::endl;
-    std::cout << "  --streaming                Enable streaming mode for large files" << std::endl;
+    std::cout << "  --streaming                Stream JSON/JSONL <-> BTOON record-by-record (constant memory)" << std::endl;
     std::cout << "  --batch                    Batch conversion mode" << std::endl;
     std::cout << "  --batch-size <n>           Batch size for streaming (default: 100)" << std::endl;
     std::cout << "  -v, --verbose              Verbose output" << std::endl;
@@ -907,17 +909,226 @@ void convert_batch(const std::vector<std::string>& input_files,
     std::cout << "  Failed: " << failed << " files" << std::endl;
 }
 
-void convert_streaming(const std::string& input_file, 
+/**
+ * SAX handler that builds btoon::Values directly from JSON parse events,
+ * without materializing an nlohmann::json tree. Completed records are
+ * handed to the sink: for a document whose top level is an array (with
+ * split_top_level_array) each element is emitted as soon as it closes,
+ * so only one record is resident at a time regardless of input size.
+ */
+class SaxToBtoon : public json::json_sax_t {
+public:
+    using RecordSink = std::function<void(Value&&)>;
+
+    SaxToBtoon(RecordSink sink, bool split_top_level_array)
+        : sink_(std::move(sink)), split_(split_top_level_array) {}
+
+    size_t records_emitted() const { return records_; }
+
+    bool null() override { return emit(Nil{}); }
+    bool boolean(bool val) override { return emit(Bool(val)); }
+    bool number_integer(number_integer_t val) override {
+        // Match json_to_value: non-negative integers decode as Uint.
+        if (val < 0) return emit(Int(val));
+        return emit(Uint(static_cast<uint64_t>(val)));
+    }
+    bool number_unsigned(number_unsigned_t val) override { return emit(Uint(val)); }
+    bool number_float(number_float_t val, const string_t&) override {
+        return emit(Float(val));
+    }
+    bool string(string_t& val) override { return emit(String(std::move(val))); }
+    bool binary(binary_t& val) override {
+        return emit(Binary(val.begin(), val.end()));
+    }
+
+    bool start_object(std::size_t) override {
+        stack_.push_back(Frame{Frame::Kind::MAP});
+        return true;
+    }
+    bool key(string_t& val) override {
+        stack_.back().pending_key = std::move(val);
+        return true;
+    }
+    bool end_object() override {
+        Frame frame = std::move(stack_.back());
+        stack_.pop_back();
+        return emit(std::move(frame.map));
+    }
+
+    bool start_array(std::size_t) override {
+        // The root array is not collected when splitting: its elements
+        // go straight to the sink as they complete.
+        if (stack_.empty() && split_) {
+            stack_.push_back(Frame{Frame::Kind::ROOT_STREAM});
+        } else {
+            stack_.push_back(Frame{Frame::Kind::ARRAY});
+        }
+        return true;
+    }
+    bool end_array() override {
+        Frame frame = std::move(stack_.back());
+        stack_.pop_back();
+        if (frame.kind == Frame::Kind::ROOT_STREAM) {
+            return true;
+        }
+        return emit(std::move(frame.arr));
+    }
+
+    bool parse_error(std::size_t position, const std::string&,
+                     const nlohmann::detail::exception& ex) override {
+        throw std::runtime_error("JSON parse error at byte " +
+                                 std::to_string(position) + ": " + ex.what());
+    }
+
+private:
+    struct Frame {
+        enum class Kind { ARRAY, MAP, ROOT_STREAM };
+        Kind kind;
+        Array arr;
+        Map map;
+        std::string pending_key;
+    };
+
+    bool emit(Value&& value) {
+        if (stack_.empty()) {
+            sink_(std::move(value));
+            records_++;
+            return true;
+        }
+        Frame& top = stack_.back();
+        switch (top.kind) {
+            case Frame::Kind::ROOT_STREAM:
+                sink_(std::move(value));
+                records_++;
+                break;
+            case Frame::Kind::MAP:
+                top.map[std::move(top.pending_key)] = std::move(value);
+                break;
+            case Frame::Kind::ARRAY:
+                top.arr.push_back(std::move(value));
+                break;
+        }
+        return true;
+    }
+
+    RecordSink sink_;
+    bool split_;
+    std::vector<Frame> stack_;
+    size_t records_ = 0;
+};
+
+static bool is_jsonl_file(const std::string& filename) {
+    std::string ext = fs::path(filename).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ".jsonl" || ext == ".ndjson";
+}
+
+static void stream_json_to_btoon(const std::string& input_file,
+                                 const std::string& output_file,
+                                 const ConvertOptions& opts) {
+    std::ifstream input(input_file);
+    if (!input) {
+        throw std::runtime_error("Cannot open file: " + input_file);
+    }
+    std::ofstream output(output_file, std::ios::binary);
+    if (!output) {
+        throw std::runtime_error("Cannot create file: " + output_file);
+    }
+
+    EncodeOptions encode_opts;
+    encode_opts.compress = opts.compress;
+    encode_opts.compression_algorithm = opts.compression_algo;
+    StreamEncoder encoder(output, encode_opts);
+
+    size_t records = 0;
+    auto sink = [&](Value&& value) {
+        encoder.write(value);
+        records++;
+    };
+
+    if (is_jsonl_file(input_file)) {
+        // One document per line; each line is its own record, so arrays
+        // on a line are not split.
+        std::string line;
+        while (std::getline(input, line)) {
+            if (line.empty()) continue;
+            SaxToBtoon handler(sink, false);
+            json::sax_parse(line, &handler);
+        }
+    } else {
+        // Whole-file JSON: a top-level array streams element by element.
+        SaxToBtoon handler(sink, true);
+        json::sax_parse(input, &handler);
+    }
+
+    encoder.close();
+    if (opts.verbose) {
+        std::cout << "Streamed " << records << " record(s)" << std::endl;
+    }
+}
+
+static void stream_btoon_to_json(const std::string& input_file,
+                                 const std::string& output_file,
+                                 const ConvertOptions& opts) {
+    std::ifstream input(input_file, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("Cannot open file: " + input_file);
+    }
+    std::ofstream output(output_file);
+    if (!output) {
+        throw std::runtime_error("Cannot create file: " + output_file);
+    }
+
+    DecodeOptions decode_opts;
+    decode_opts.auto_decompress = true;
+    StreamDecoder decoder(input, decode_opts);
+
+    // One JSON document per line (JSONL); each record is converted and
+    // released before the next is read.
+    size_t records = 0;
+    while (auto value = decoder.read()) {
+        json j = value_to_json(*value);
+        output << (opts.pretty ? j.dump(2) : j.dump()) << "\n";
+        records++;
+    }
+
+    if (opts.verbose) {
+        std::cout << "Streamed " << records << " record(s)" << std::endl;
+    }
+}
+
+void convert_streaming(const std::string& input_file,
                       const std::string& output_file,
                       const ConvertOptions& opts) {
-    // Simplified streaming implementation
-    // In production, this would process data in chunks
-    std::cout << "Streaming conversion not fully implemented yet" << std::endl;
-    std::cout << "Falling back to regular conversion" << std::endl;
-    
-    ConvertOptions non_streaming_opts = opts;
-    non_streaming_opts.streaming = false;
-    
-    Value data = read_input(input_file, non_streaming_opts.input_format, non_streaming_opts);
-    write_output(output_file, data, non_streaming_opts.output_format, non_streaming_opts);
+    ConvertOptions stream_opts = opts;
+    if (stream_opts.input_format == Format::AUTO) {
+        stream_opts.input_format =
+            is_jsonl_file(input_file) ? Format::JSON : detect_format(input_file);
+    }
+
+    std::string resolved_output = output_file;
+    if (resolved_output.empty()) {
+        std::string base = fs::path(input_file).stem().string();
+        resolved_output = base +
+            (stream_opts.output_format == Format::BTOON ? ".btoon" : ".jsonl");
+    }
+
+    if (stream_opts.input_format == Format::JSON &&
+        stream_opts.output_format == Format::BTOON) {
+        stream_json_to_btoon(input_file, resolved_output, stream_opts);
+        return;
+    }
+    if (stream_opts.input_format == Format::BTOON &&
+        stream_opts.output_format == Format::JSON) {
+        stream_btoon_to_json(input_file, resolved_output, stream_opts);
+        return;
+    }
+
+    // Other format pairs have no streaming path; convert in memory.
+    std::cerr << "Warning: no streaming path for "
+              << format_to_string(stream_opts.input_format) << " -> "
+              << format_to_string(stream_opts.output_format)
+              << ", converting in memory" << std::endl;
+    Value data = read_input(input_file, stream_opts.input_format, stream_opts);
+    write_output(resolved_output, data, stream_opts.output_format, stream_opts);
 }
@@ -15,6 +15,7 @@
 #include "btoon/schema.h"
 #include "btoon/encoder.h"
 #include "btoon/decoder.h"
+#include "btoon/stream_decoder.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -99,6 +100,8 @@ void print_usage(const std::string& program_name) {
     std::cout << "  -o, --output <file>  Output file (default: stdout)" << std::endl;
     std::cout << "  -l, --language <lang> Target language (cpp, python, go, rust, typescript)" << std::endl;
     std::cout << "  -f, --format <fmt>   Output format (json, yaml, binary, markdown)" << std::endl;
+    std::cout << "  -s, --sample <n>     Infer from a uniform sample of n records (infer)" << std::endl;
+    std::cout << "  --stable-after <n>   Stop once n consecutive records add nothing new (infer)" << std::endl;
     std::cout << "  -v, --verbose        Verbose output" << std::endl;
     std::cout << "  -h, --help           Show this help message" << std::endl;
 }
@@ -477,37 +480,75 @@ int cmd_infer(int argc, char* argv[]) {
     std::string data_file = argv[1];
     std::string output_file;
     bool verbose = false;
-    
+    size_t sample_size = 0;
+    size_t stable_after = 0;
+
     // Parse options
     for (int i = 2; i < argc; i++) {
         if (std::string(argv[i]) == "-o" || std::string(argv[i]) == "--output") {
             if (i + 1 < argc) {
                 output_file = argv[++i];
             }
+        } else if (std::string(argv[i]) == "-s" || std::string(argv[i]) == "--sample") {
+            if (i + 1 < argc) {
+                sample_size = std::stoul(argv[++i]);
+            }
+        } else if (std::string(argv[i]) == "--stable-after") {
+            if (i + 1 < argc) {
+                stable_after = std::stoul(argv[++i]);
+            }
         } else if (std::string(argv[i]) == "-v" || std::string(argv[i]) == "--verbose") {
             verbose = true;
         }
     }
-    
-    // Load and analyze data
-    Value data = load_data_file(data_file);
-    
+
     // Configure inference options
     InferenceOptions opts;
     opts.infer_constraints = true;
     opts.infer_patterns = true;
     opts.max_enum_values = 10;
-    
+    if (sample_size > 0) {
+        opts.sample_size = sample_size;
+        opts.reservoir_sampling = true;
+    }
+    opts.stability_window = stable_after;
+
     // Infer schema
     SchemaInferrer inferrer(opts);
-    Schema schema = inferrer.infer(data, fs::path(data_file).stem().string());
-    
+    std::string schema_name = fs::path(data_file).stem().string();
+    Schema schema = [&]() -> Schema {
+        if (fs::path(data_file).extension().string() == ".json") {
+            // JSON has to be parsed in full anyway.
+            return inferrer.infer(load_data_file(data_file), schema_name);
+        }
+        // Stream binary input record by record so large files are never
+        // fully resident. A file holding one top-level array is a single
+        // in-memory dataset; anything else is treated as a record stream.
+        std::ifstream file(data_file, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Cannot open file: " + data_file);
+        }
+        StreamDecoder stream(file);
+        auto record = stream.read();
+        if (record.has_value() && !stream.has_next()) {
+            return inferrer.infer(record.value(), schema_name);
+        }
+        while (record.has_value() && !inferrer.stable()) {
+            inferrer.observe(record.value());
+            record = stream.read();
+        }
+        return inferrer.finish(schema_name);
+    }();
+
     // Get statistics
     auto stats = inferrer.getStatistics();
-    
+
     if (verbose) {
         std::cout << "Inference Statistics:" << std::endl;
+        std::cout << "  Records seen: " << stats.records_seen << std::endl;
         std::cout << "  Samples analyzed: " << stats.samples_analyzed << std::endl;
+        std::cout << "  Sampling fraction: " << stats.sampling_fraction << std::endl;
+        std::cout << "  Stopped early: " << (stats.terminated_early ? "yes" : "no") << std::endl;
         std::cout << "  Fields discovered: " << stats.fields_discovered << std::endl;
         std::cout << "  Optional fields: " << stats.optional_fields << std::endl;
         std::cout << "  Enum fields: " << stats.enum_fields << std::endl;
@@ -1,10 +1,17 @@
 #include "btoon/btoon.h"
+#include "btoon/batch_processor.h"
+#include "btoon/zero_copy.h"
 #include "nlohmann/json.hpp"
 #include <iostream>
 #include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <vector>
 #include <string>
 
+namespace fs = std::filesystem;
 using namespace btoon;
 using json = nlohmann::basic_json<std::map>;
 
@@ -69,15 +76,140 @@ json btoon_to_json(const Value& v) {
     }, v);
 }
 
+// --- Batch Processing ---
+
+struct BatchJobOptions {
+    bool encode = false;
+    bool compress = false;
+    size_t jobs = 0;    // 0 = auto-detect
+    size_t shards = 0;  // 0 = no sharding
+};
+
+struct FileOutcome {
+    bool ok = false;
+    size_t bytes_in = 0;
+    std::string file;
+    std::string error;
+};
+
+// Worker body for one file: memory-map the input, convert it, and write
+// the result under the output directory (into a shard subdirectory when
+// sharding is enabled).
+static FileOutcome process_one_file(const std::string& input_file,
+                                    const fs::path& output_dir,
+                                    const BatchJobOptions& opts) {
+    FileOutcome outcome;
+    outcome.file = input_file;
+    try {
+        auto mapped = MemoryMappedFile::open(input_file);
+        if (!mapped) {
+            throw BtoonException("Cannot memory-map file: " + input_file);
+        }
+        outcome.bytes_in = mapped->size();
+
+        fs::path target_dir = output_dir;
+        if (opts.shards > 0) {
+            size_t shard = std::hash<std::string>{}(input_file) % opts.shards;
+            target_dir /= "shard-" + std::to_string(shard);
+        }
+        fs::path output_file =
+            target_dir / (fs::path(input_file).stem().string() +
+                          (opts.encode ? ".btoon" : ".json"));
+
+        if (opts.encode) {
+            json j = json::parse(mapped->data(), mapped->data() + mapped->size());
+            Value v = json_to_btoon(j);
+            EncodeOptions encode_opts;
+            encode_opts.compress = opts.compress;
+            auto encoded = encode(v, encode_opts);
+            std::ofstream ofs(output_file, std::ios::binary);
+            if (!ofs) throw BtoonException("Cannot create file: " + output_file.string());
+            ofs.write(reinterpret_cast<const char*>(encoded.data()),
+                      static_cast<std::streamsize>(encoded.size()));
+        } else {
+            DecodeOptions decode_opts;
+            decode_opts.auto_decompress = true;
+            Value v = decode({mapped->data(), mapped->size()}, decode_opts);
+            json j = btoon_to_json(v);
+            std::ofstream ofs(output_file);
+            if (!ofs) throw BtoonException("Cannot create file: " + output_file.string());
+            ofs << j.dump(2);
+        }
+        outcome.ok = true;
+    } catch (const std::exception& e) {
+        outcome.error = e.what();
+    }
+    return outcome;
+}
+
+static int run_batch(const std::string& input_dir,
+                     const std::string& output_dir,
+                     const BatchJobOptions& opts) {
+    std::vector<std::string> files;
+    for (const auto& entry : fs::directory_iterator(input_dir)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::cerr << "No input files in " << input_dir << std::endl;
+        return 1;
+    }
+
+    fs::create_directories(output_dir);
+    for (size_t s = 0; s < opts.shards; ++s) {
+        fs::create_directories(fs::path(output_dir) / ("shard-" + std::to_string(s)));
+    }
+
+    batch::BatchOptions batch_opts;
+    batch_opts.worker_threads = opts.jobs;
+    batch_opts.batch_size = 1;  // one file per batch so stealing balances skewed sizes
+
+    auto start = std::chrono::steady_clock::now();
+    batch::ParallelBatchProcessor<std::string, FileOutcome> processor(
+        [&](const std::string& file) {
+            return process_one_file(file, output_dir, opts);
+        },
+        batch_opts);
+    auto outcomes = processor.process(files);
+    auto elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    size_t succeeded = 0;
+    size_t total_bytes = 0;
+    for (const auto& outcome : outcomes) {
+        if (outcome.ok) {
+            succeeded++;
+            total_bytes += outcome.bytes_in;
+        } else {
+            std::cerr << "✗ " << outcome.file << ": " << outcome.error << std::endl;
+        }
+    }
+
+    double seconds = elapsed > 0.0 ? elapsed : 1e-9;
+    std::cout << (opts.encode ? "Encoded " : "Decoded ") << succeeded << "/"
+              << files.size() << " files in " << std::fixed
+              << std::setprecision(2) << elapsed << "s ("
+              << static_cast<double>(succeeded) / seconds << " files/s, "
+              << static_cast<double>(total_bytes) / (1024.0 * 1024.0) / seconds
+              << " MB/s)" << std::endl;
+    return succeeded == files.size() ? 0 : 1;
+}
+
 // --- Main CLI Logic ---
 
 void printUsage(const char* name) {
     std::cerr << "Usage: btoon [command] <input> <output> [options]" << std::endl;
     std::cerr << "Commands:" << std::endl;
-    std::cerr << "  encode <input> <output>    Encode JSON to BTOON" << std::endl;
-    std::cerr << "  decode <input> <output>    Decode BTOON to JSON" << std::endl;
+    std::cerr << "  encode <input> <output>          Encode JSON to BTOON" << std::endl;
+    std::cerr << "  decode <input> <output>          Decode BTOON to JSON" << std::endl;
+    std::cerr << "  batch-encode <in_dir> <out_dir>  Encode every file in a directory in parallel" << std::endl;
+    std::cerr << "  batch-decode <in_dir> <out_dir>  Decode every file in a directory in parallel" << std::endl;
     std::cerr << "Options:" << std::endl;
     std::cerr << "  --compress    Enable compression (default: zlib)" << std::endl;
+    std::cerr << "  --jobs <n>    Worker threads for batch mode (default: all cores)" << std::endl;
+    std::cerr << "  --shards <n>  Split batch output across n shard subdirectories" << std::endl;
     std::cerr << "  --version     Print version information" << std::endl;
     std::cerr << "  --help        Print this usage information" << std::endl;
 }
@@ -107,7 +239,33 @@ int main(int argc, char** argv) {
 
     std::string input_file = argv[2];
     std::string output_file = argv[3];
-    bool compress = (argc > 4 && std::string(argv[4]) == "--compress");
+    bool compress = false;
+    size_t jobs = 0;
+    size_t shards = 0;
+    for (int i = 4; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--compress") {
+            compress = true;
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            jobs = std::stoull(argv[++i]);
+        } else if (arg == "--shards" && i + 1 < argc) {
+            shards = std::stoull(argv[++i]);
+        }
+    }
+
+    if (command == "batch-encode" || command == "batch-decode") {
+        BatchJobOptions batch_opts;
+        batch_opts.encode = (command == "batch-encode");
+        batch_opts.compress = compress;
+        batch_opts.jobs = jobs;
+        batch_opts.shards = shards;
+        try {
+            return run_batch(input_file, output_file, batch_opts);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
 
     try {
         if (command == "encode") {